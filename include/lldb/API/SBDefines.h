@@ -65,6 +65,7 @@ class LLDB_API SBModuleSpecList;
 class LLDB_API SBProcess;
 class LLDB_API SBQueue;
 class LLDB_API SBQueueItem;
+class LLDB_API SBResolvedAddressList;
 class LLDB_API SBSection;
 class LLDB_API SBSourceManager;
 class LLDB_API SBStream;
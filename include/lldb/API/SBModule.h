@@ -338,6 +338,7 @@ public:
 private:
     friend class SBAddress;
     friend class SBFrame;
+    friend class SBResolvedAddressList;
     friend class SBSection;
     friend class SBSymbolContext;
     friend class SBTarget;
@@ -0,0 +1,95 @@
+//===-- SBResolvedAddressList.h ---------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLDB_SBResolvedAddressList_h_
+#define LLDB_SBResolvedAddressList_h_
+
+#include "lldb/API/SBDefines.h"
+#include "lldb/API/SBModule.h"
+
+namespace lldb {
+
+//----------------------------------------------------------------------
+/// The module, symbol and line information for a batch of load
+/// addresses, as returned by SBTarget::ResolveLoadAddresses(). The
+/// results are accessed by index, in the same order as the addresses,
+/// without creating an object for each address.
+//----------------------------------------------------------------------
+class LLDB_API SBResolvedAddressList
+{
+public:
+    SBResolvedAddressList ();
+
+    SBResolvedAddressList (const lldb::SBResolvedAddressList &rhs);
+
+    const lldb::SBResolvedAddressList &
+    operator = (const lldb::SBResolvedAddressList &rhs);
+
+    ~SBResolvedAddressList ();
+
+    bool
+    IsValid () const;
+
+    uint32_t
+    GetSize () const;
+
+    lldb::addr_t
+    GetLoadAddressAtIndex (uint32_t idx) const;
+
+    //------------------------------------------------------------------
+    /// @return
+    ///     The address in the module's object file, or LLDB_INVALID_ADDRESS
+    ///     if the load address isn't in a module.
+    //------------------------------------------------------------------
+    lldb::addr_t
+    GetFileAddressAtIndex (uint32_t idx) const;
+
+    lldb::SBModule
+    GetModuleAtIndex (uint32_t idx) const;
+
+    //------------------------------------------------------------------
+    /// @return
+    ///     The name of the symbol containing the address, or NULL.
+    //------------------------------------------------------------------
+    const char *
+    GetSymbolNameAtIndex (uint32_t idx) const;
+
+    lldb::addr_t
+    GetSymbolOffsetAtIndex (uint32_t idx) const;
+
+    //------------------------------------------------------------------
+    /// @return
+    ///     The file name of the source line for the address, or NULL if
+    ///     it has no line information.
+    //------------------------------------------------------------------
+    const char *
+    GetFileNameAtIndex (uint32_t idx) const;
+
+    const char *
+    GetDirectoryAtIndex (uint32_t idx) const;
+
+    uint32_t
+    GetLineAtIndex (uint32_t idx) const;
+
+    uint32_t
+    GetColumnAtIndex (uint32_t idx) const;
+
+protected:
+    friend class SBTarget;
+
+    lldb_private::Symbolicator &
+    ref ();
+
+private:
+    std::shared_ptr<lldb_private::Symbolicator> m_opaque_sp;
+};
+
+} // namespace lldb
+
+#endif // LLDB_SBResolvedAddressList_h_
@@ -17,6 +17,7 @@
 #include "lldb/API/SBFileSpec.h"
 #include "lldb/API/SBFileSpecList.h"
 #include "lldb/API/SBLaunchInfo.h"
+#include "lldb/API/SBResolvedAddressList.h"
 #include "lldb/API/SBSymbolContextList.h"
 #include "lldb/API/SBType.h"
 #include "lldb/API/SBValue.h"
@@ -582,6 +583,28 @@ public:
     lldb::SBAddress
     ResolvePastLoadAddress (uint32_t stop_id, lldb::addr_t vm_addr);
 
+    //------------------------------------------------------------------
+    /// Resolve many current load addresses to their modules, symbols
+    /// and source lines at once.
+    ///
+    /// This is much faster than resolving each address on its own: the
+    /// addresses are sorted so each module's symbol and line tables are
+    /// searched together, and different modules are searched on
+    /// different threads.
+    ///
+    /// @param[in] array
+    ///     The load addresses to resolve, in any order.
+    ///
+    /// @param[in] array_len
+    ///     The number of addresses in \a array.
+    ///
+    /// @return
+    ///     A list with an entry for each address, in the same order as
+    ///     \a array.
+    //------------------------------------------------------------------
+    lldb::SBResolvedAddressList
+    ResolveLoadAddresses (uint64_t* array, size_t array_len);
+
     SBSymbolContext
     ResolveSymbolContextForAddress (const SBAddress& addr, 
                                     uint32_t resolve_scope);
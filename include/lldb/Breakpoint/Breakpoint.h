@@ -276,6 +276,20 @@ public:
     void
     ModuleReplaced (lldb::ModuleSP old_module_sp, lldb::ModuleSP new_module_sp);
     
+    //------------------------------------------------------------------
+    /// Get a count that changes every time modules are loaded, unloaded
+    /// or replaced.  Locations compare it to decide whether their compiled
+    /// conditions may refer to code or data that has gone away.
+    ///
+    /// @return
+    ///     The current module generation.
+    //------------------------------------------------------------------
+    uint32_t
+    GetModulesGeneration () const
+    {
+        return m_modules_generation;
+    }
+    
     //------------------------------------------------------------------
     // The next set of methods provide access to the breakpoint locations
     // for this breakpoint.
@@ -795,6 +809,7 @@ private:
     uint32_t    m_hit_count;                   // Number of times this breakpoint/watchpoint has been hit.  This is kept
                                                // separately from the locations hit counts, since locations can go away when
                                                // their backing library gets unloaded, and we would lose hit counts.
+    uint32_t    m_modules_generation;          // Bumped whenever modules change, so locations know to recompile their conditions.
 
     void
     SendBreakpointChangedEvent (lldb::BreakpointEventType eventKind);
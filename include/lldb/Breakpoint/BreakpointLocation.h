@@ -464,6 +464,7 @@ private:
     lldb::ClangUserExpressionSP m_user_expression_sp; ///< The compiled expression to use in testing our condition.
     Mutex m_condition_mutex; ///< Guards parsing and evaluation of the condition, which could be evaluated by multiple processes.
     size_t m_condition_hash; ///< For testing whether the condition source code changed.
+    uint32_t m_condition_modules_generation; ///< The owner's module generation when the condition was compiled.
 
     void
     SetShouldResolveIndirectFunctions (bool do_resolve)
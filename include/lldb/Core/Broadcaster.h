@@ -12,6 +12,7 @@
 
 // C Includes
 // C++ Includes
+#include <atomic>
 #include <map>
 #include <string>
 #include <vector>
@@ -442,6 +443,10 @@ protected:
     void
     PrivateBroadcastEvent (lldb::EventSP &event_sp, bool unique);
 
+    // Recompute m_listened_event_mask, must be called with m_listeners_mutex held
+    void
+    UpdateListenedEventMask ();
+
     //------------------------------------------------------------------
     // Classes that inherit from Broadcaster can see and modify these
     //------------------------------------------------------------------
@@ -456,6 +461,7 @@ protected:
     std::vector<Listener *> m_hijacking_listeners;  // A simple mechanism to intercept events from a broadcaster 
     std::vector<uint32_t> m_hijacking_masks;        // At some point we may want to have a stack or Listener
                                                     // collections, but for now this is just for private hijacking.
+    std::atomic<uint32_t> m_listened_event_mask;    // The event bits anyone listens for, so broadcasts nobody wants don't take m_listeners_mutex
     BroadcasterManager *m_manager;
     
 private:
@@ -12,6 +12,7 @@
 #if defined(__cplusplus)
 
 #include <assert.h>
+#include <vector>
 
 #include "lldb/lldb-private.h"
 #include "llvm/ADT/StringRef.h"
@@ -475,6 +476,16 @@ public:
     }
     
 
+    //------------------------------------------------------------------
+    /// Statistics for one of the independently locked shards that make
+    /// up the global string pool.
+    //------------------------------------------------------------------
+    struct PoolShardStats
+    {
+        size_t num_strings;     ///< The number of uniqued strings in the shard
+        size_t memory_size;     ///< The number of bytes used by those strings
+    };
+
     //------------------------------------------------------------------
     /// Get the size in bytes of the current global string pool.
     ///
@@ -482,12 +493,16 @@ public:
     /// containers and any other values as a byte size for the
     /// entire string pool.
     ///
+    /// @param[out] shard_stats
+    ///     If non-NULL, filled in with one entry per string pool shard
+    ///     so the distribution of strings across shards can be checked.
+    ///
     /// @return
     ///     The number of bytes that the global string pool occupies
     ///     in memory.
     //------------------------------------------------------------------
     static size_t
-    StaticMemorySize ();
+    StaticMemorySize (std::vector<PoolShardStats> *shard_stats = NULL);
 
 protected:
     //------------------------------------------------------------------
@@ -434,6 +434,8 @@ protected:
     IOHandlerStack m_input_reader_stack;
     typedef std::map<std::string, lldb::StreamWP> LogStreamMap;
     LogStreamMap m_log_streams;
+    typedef std::map<std::string, std::weak_ptr<StreamAsyncLog> > AsyncLogStreamMap;
+    AsyncLogStreamMap m_async_log_streams;
     lldb::StreamSP m_log_callback_stream_sp;
     ConstString m_instance_name;
     static LoadPluginCallbackType g_load_plugin_callback;
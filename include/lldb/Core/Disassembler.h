@@ -323,6 +323,15 @@ public:
     static lldb::DisassemblerSP
     FindPluginForTarget(const lldb::TargetSP target_sp, const ArchSpec &arch, const char *flavor, const char *plugin_name);
 
+    //------------------------------------------------------------------
+    /// Disassemble the instructions in \a disasm_range.
+    ///
+    /// If \a prefer_file_cache is true and the range is in a module's
+    /// object file, the instructions are decoded from the file and
+    /// cached, and later calls for the same range share them. The
+    /// instruction list is cleared when the last reference to the
+    /// returned disassembler goes away.
+    //------------------------------------------------------------------
     static lldb::DisassemblerSP
     DisassembleRange (const ArchSpec &arch,
                       const char *plugin_name,
@@ -341,6 +350,12 @@ public:
                       uint32_t max_num_instructions,
                       bool data_from_file);
 
+    //------------------------------------------------------------------
+    /// Drop the instructions cached for \a module by DisassembleRange.
+    //------------------------------------------------------------------
+    static void
+    RemoveCachedInstructions (const Module *module);
+
     static bool
     Disassemble (Debugger &debugger,
                  const ArchSpec &arch,
@@ -12,6 +12,7 @@
 
 // C Includes
 // C++ Includes
+#include <deque>
 #include <list>
 #include <map>
 #include <set>
@@ -137,7 +138,9 @@ private:
     };
 
     typedef std::multimap<Broadcaster*, BroadcasterInfo> broadcaster_collection;
-    typedef std::list<lldb::EventSP> event_collection;
+    // A deque allocates its elements in blocks, so queueing an event
+    // doesn't allocate a list node
+    typedef std::deque<lldb::EventSP> event_collection;
     typedef std::vector<BroadcasterManager *> broadcaster_manager_collection;
 
     bool
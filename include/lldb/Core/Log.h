@@ -37,6 +37,7 @@
 #define LLDB_LOG_OPTION_PREPEND_THREAD_NAME     (1U << 6)
 #define LLDB_LOG_OPTION_BACKTRACE               (1U << 7)
 #define LLDB_LOG_OPTION_APPEND                  (1U << 8)
+#define LLDB_LOG_OPTION_ASYNC                   (1U << 9)
 
 //----------------------------------------------------------------------
 // Logging Functions
@@ -1237,6 +1237,42 @@ namespace lldb_private {
             }
             return UINT32_MAX;
         }
+
+        // Same as FindEntryIndexThatContains for callers that look up
+        // addresses in increasing order. "start_idx" must start at zero and
+        // is updated to where the search for the next address can start, so
+        // a sorted batch of lookups is a single pass over the entries.
+        uint32_t
+        FindEntryIndexThatContainsSorted (B addr, size_t &start_idx) const
+        {
+#ifdef ASSERT_RANGEMAP_ARE_SORTED
+            assert (IsSorted());
+#endif
+            if ( !m_entries.empty() )
+            {
+                typename Collection::const_iterator begin = m_entries.begin();
+                typename Collection::const_iterator end = m_entries.end();
+                typename Collection::const_iterator pos = begin + std::min<size_t> (start_idx, m_entries.size());
+
+                // Nearby addresses are found faster by stepping than by
+                // searching the rest of the entries
+                for (int i = 0; i < 8 && pos != end && pos->GetRangeBase() < addr; ++i)
+                    ++pos;
+                if (pos != end && pos->GetRangeBase() < addr)
+                {
+                    Entry entry (addr, 1);
+                    pos = std::lower_bound (pos, end, entry, BaseLessThan);
+                }
+                start_idx = std::distance (begin, pos);
+
+                while(pos != begin && pos[-1].Contains(addr))
+                    --pos;
+
+                if (pos != end && pos->Contains(addr))
+                    return std::distance (begin, pos);
+            }
+            return UINT32_MAX;
+        }
         
         Entry *
         FindEntryThatContains (B addr)
@@ -0,0 +1,162 @@
+//===-- StreamAsyncLog.h ----------------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef liblldb_StreamAsyncLog_h_
+#define liblldb_StreamAsyncLog_h_
+
+// C Includes
+// C++ Includes
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+// Other libraries and framework includes
+// Project includes
+#include "lldb/lldb-private.h"
+#include "lldb/Core/Stream.h"
+#include "lldb/Host/HostThread.h"
+#include "lldb/Host/Mutex.h"
+
+namespace lldb_private {
+
+//----------------------------------------------------------------------
+/// @class StreamAsyncLog StreamAsyncLog.h "lldb/Core/StreamAsyncLog.h"
+/// @brief A log sink that hands records to a background thread.
+///
+/// Every Write() call is one log record. It is copied into a ring buffer
+/// that belongs to the writing thread, without taking any locks, and a
+/// drain thread writes the records to the wrapped stream later. When a
+/// thread's ring buffer is full, its records are dropped and counted
+/// rather than making the thread wait; the drain thread notes how many
+/// records were dropped in the output.
+///
+/// A thread's ring buffer is retired when the thread exits, and the drain
+/// thread frees it once its last records are written out, so threads
+/// that come and go don't leave their buffers behind.
+///
+/// Records from one thread stay in order. Records from different threads
+/// can be written out of order, so use sequence IDs or timestamps to
+/// merge them.
+//----------------------------------------------------------------------
+class StreamAsyncLog : public Stream
+{
+public:
+    //------------------------------------------------------------------
+    /// Constructor.
+    ///
+    /// @param[in] stream_sp
+    ///     The stream the drain thread writes the records to.
+    ///
+    /// @param[in] buffer_size
+    ///     The size in bytes of each thread's ring buffer, rounded up to
+    ///     a power of two.
+    //------------------------------------------------------------------
+    StreamAsyncLog (const lldb::StreamSP &stream_sp, size_t buffer_size = 256 * 1024);
+
+    //------------------------------------------------------------------
+    /// Stops the drain thread and writes out all the buffered records.
+    //------------------------------------------------------------------
+    virtual
+    ~StreamAsyncLog ();
+
+    //------------------------------------------------------------------
+    /// Start the thread that drains the buffers. Until it runs, records
+    /// are only written by Drain() and the destructor.
+    //------------------------------------------------------------------
+    bool
+    StartDrainThread ();
+
+    //------------------------------------------------------------------
+    /// Write out all the records buffered so far on the calling thread.
+    //------------------------------------------------------------------
+    void
+    Drain ();
+
+    //------------------------------------------------------------------
+    /// When set, each record is stamped with the time it was written in
+    /// binary form, and the timestamp is formatted when the record is
+    /// drained.
+    //------------------------------------------------------------------
+    void
+    SetPrependTimestamps (bool timestamps)
+    {
+        m_timestamps = timestamps;
+    }
+
+    bool
+    GetPrependTimestamps () const
+    {
+        return m_timestamps;
+    }
+
+    uint64_t
+    GetDroppedRecordCount () const
+    {
+        return m_dropped_records;
+    }
+
+    //------------------------------------------------------------------
+    /// The number of per-thread ring buffers that haven't been freed.
+    //------------------------------------------------------------------
+    size_t
+    GetBufferCount ();
+
+    // The records are written out by the drain thread, so there is
+    // nothing to flush on the logging thread.
+    virtual void
+    Flush ();
+
+    virtual size_t
+    Write (const void *src, size_t src_len);
+
+private:
+    class RingBuffer;
+    struct ThreadBuffers;
+    typedef std::shared_ptr<RingBuffer> RingBufferSP;
+    typedef std::vector<RingBufferSP> collection;
+
+    RingBuffer *
+    GetBufferForCurrentThread ();
+
+    // Write out the records of all the buffers and free the buffers of
+    // threads that have exited, returns true if there were any records
+    bool
+    DrainBuffers ();
+
+    static lldb::thread_key_t
+    GetThreadBuffersKey ();
+
+    static void
+    ThreadBuffersCleanup (void *p);
+
+    static lldb::thread_result_t
+    DrainThread (lldb::thread_arg_t arg);
+
+    lldb::StreamSP m_stream_sp;
+    const size_t m_buffer_size;
+    const uint64_t m_stream_id;             // Never reused, so stale per-thread caches can't match a new stream
+    std::atomic<bool> m_timestamps;
+    std::atomic<uint64_t> m_dropped_records;
+    uint64_t m_reported_dropped_records;    // Only used while holding m_drain_mutex
+    Mutex m_buffers_mutex;                  // Protects m_buffers
+    collection m_buffers;
+    std::mutex m_drain_mutex;               // Serializes draining and guards m_stop
+    std::condition_variable m_drain_condition;
+    std::atomic<bool> m_drain_requested;
+    bool m_stop;
+    HostThread m_drain_thread;
+
+    DISALLOW_COPY_AND_ASSIGN (StreamAsyncLog);
+};
+
+} // namespace lldb_private
+
+#endif // liblldb_StreamAsyncLog_h_
@@ -56,9 +56,31 @@ public:
     static void
     SetQuiet (bool value);
 
+    //--------------------------------------------------------------
+    /// Dump the accumulated time of every timer category.
+    ///
+    /// Each thread accumulates its category times into its own
+    /// buffer, the buffers are only merged when the times are dumped
+    /// so timing hot code paths doesn't serialize threads on a lock.
+    ///
+    /// @param[in] s
+    ///     The stream to dump the times to. Categories are sorted
+    ///     by the time spent in the category itself, excluding time
+    ///     spent in nested timers.
+    //--------------------------------------------------------------
     static void
     DumpCategoryTimes (Stream *s);
 
+    //--------------------------------------------------------------
+    /// Dump the accumulated category times as a JSON object.
+    ///
+    /// The object contains a "categories" array whose entries have
+    /// "name", "count", "total_nsec" and "self_nsec" keys, sorted the
+    /// same way as DumpCategoryTimes().
+    //--------------------------------------------------------------
+    static void
+    DumpCategoryTimesAsJSON (Stream *s);
+
     static void
     ResetCategoryTimes ();
 
@@ -84,7 +106,6 @@ protected:
     TimeValue m_timer_start;
     uint64_t m_total_ticks; // Total running time for this timer including when other timers below this are running
     uint64_t m_timer_ticks; // Ticks for this timer that do not include when other timers below this one are running
-    static uint32_t g_depth;
     static uint32_t g_display_depth;
     static FILE * g_file;
 private:
@@ -69,6 +69,7 @@ public:
     AddHandLoadedClangModule(ClangModulesDeclVendor::ModuleID module)
     {
         m_hand_loaded_clang_modules.push_back(module);
+        m_declaration_generation++;
     }
     
     const ClangModulesDeclVendor::ModuleVector &GetHandLoadedClangModules()
@@ -76,8 +77,23 @@ public:
         return m_hand_loaded_clang_modules;
     }
     
+    //----------------------------------------------------------------------
+    /// Get a count that changes whenever an expression declares a
+    /// persistent variable or type, or imports a module.  Any of those can
+    /// change how later expressions parse.
+    ///
+    /// @return
+    ///     The current declaration generation.
+    //----------------------------------------------------------------------
+    uint32_t
+    GetDeclarationGeneration () const
+    {
+        return m_declaration_generation;
+    }
+    
 private:
     uint32_t                                                m_next_persistent_variable_id;  ///< The counter used by GetNextResultName().
+    uint32_t                                                m_declaration_generation;       ///< Bumped for every new persistent declaration.
     
     typedef llvm::DenseMap<const char *, clang::TypeDecl *> PersistentTypeMap;
     PersistentTypeMap                                       m_persistent_types;             ///< The persistent types declared by the user.
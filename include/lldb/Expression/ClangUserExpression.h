@@ -113,6 +113,16 @@ public:
     
     bool
     MatchesContext (ExecutionContext &exe_ctx);
+
+    //------------------------------------------------------------------
+    /// Move a parsed expression to another frame in the block it was
+    /// parsed in, so that it can be executed there without reparsing.
+    //------------------------------------------------------------------
+    void
+    ReuseInContext (ExecutionContext &exe_ctx)
+    {
+        InstallContext (exe_ctx);
+    }
     
     //------------------------------------------------------------------
     /// Execute the parsed expression
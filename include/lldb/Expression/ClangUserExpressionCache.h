@@ -0,0 +1,112 @@
+//===-- ClangUserExpressionCache.h ------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef liblldb_ClangUserExpressionCache_h_
+#define liblldb_ClangUserExpressionCache_h_
+
+// C Includes
+// C++ Includes
+#include <list>
+#include <map>
+#include <string>
+
+// Other libraries and framework includes
+// Project includes
+#include "lldb/lldb-private.h"
+#include "lldb/Expression/ClangExpression.h"
+#include "lldb/Host/Mutex.h"
+
+namespace lldb_private
+{
+
+//----------------------------------------------------------------------
+/// @class ClangUserExpressionCache ClangUserExpressionCache.h "lldb/Expression/ClangUserExpressionCache.h"
+/// @brief Keeps parsed user expressions so they can be run again.
+///
+/// Most of the time spent evaluating a simple expression goes into
+/// setting up the compiler, parsing and JIT compiling it. Scripts tend to
+/// evaluate the same few expressions at every stop, so each target keeps
+/// its most recently used parsed expressions. They are keyed by their
+/// text and options, the block they were parsed in, the process, and the
+/// module and persistent declaration generations at parse time. A cached
+/// expression is executed again with a new materialized argument struct,
+/// the same way a breakpoint condition is.
+//----------------------------------------------------------------------
+class ClangUserExpressionCache
+{
+public:
+    struct Key
+    {
+        std::string expr_text;
+        std::string expr_prefix;
+        lldb::LanguageType language;
+        ClangExpression::ResultType desired_type;
+        ExecutionPolicy execution_policy;
+        const Process *process;
+        const void *decl_context;   // The Block, or the Symbol with no debug info, the frame is in
+        uint32_t modules_generation;
+        uint32_t declaration_generation;
+
+        bool
+        operator < (const Key &rhs) const;
+    };
+
+    ClangUserExpressionCache ();
+
+    ~ClangUserExpressionCache ();
+
+    //------------------------------------------------------------------
+    /// Make the key for an expression evaluated in \a exe_ctx.
+    ///
+    /// @return
+    ///     False if expressions in this context can't be cached.
+    //------------------------------------------------------------------
+    static bool
+    MakeKey (ExecutionContext &exe_ctx,
+             const char *expr_text,
+             const char *expr_prefix,
+             lldb::LanguageType language,
+             ClangExpression::ResultType desired_type,
+             ExecutionPolicy execution_policy,
+             Key &key);
+
+    //------------------------------------------------------------------
+    /// Find a parsed expression that nobody else is using.
+    //------------------------------------------------------------------
+    lldb::ClangUserExpressionSP
+    Find (const Key &key);
+
+    //------------------------------------------------------------------
+    /// Add a parsed expression, evicting the least recently used ones to
+    /// keep at most \a max_entries.
+    //------------------------------------------------------------------
+    void
+    Add (const Key &key, const lldb::ClangUserExpressionSP &expr_sp, size_t max_entries);
+
+    void
+    Remove (const Key &key);
+
+    void
+    Clear ();
+
+private:
+    // Most recently used entries are at the front
+    typedef std::list<std::pair<Key, lldb::ClangUserExpressionSP> > EntryList;
+    typedef std::map<Key, EntryList::iterator> EntryMap;
+
+    Mutex m_mutex;
+    EntryList m_entries;
+    EntryMap m_entry_map;
+
+    DISALLOW_COPY_AND_ASSIGN (ClangUserExpressionCache);
+};
+
+} // namespace lldb_private
+
+#endif  // liblldb_ClangUserExpressionCache_h_
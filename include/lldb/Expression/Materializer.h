@@ -90,6 +90,15 @@ public:
     uint32_t AddSymbol (const Symbol &symbol_sp, Error &err);
     uint32_t AddRegister (const RegisterInfo &register_info, Error &err);
     
+    //------------------------------------------------------------------
+    /// Sets where the entities put the temporaries they make while
+    /// materializing, such as the result and copies of variables that
+    /// live in registers.  An interpreted expression never runs in the
+    /// process, so it can keep them on the host instead of allocating
+    /// memory in the inferior on every execution.
+    //------------------------------------------------------------------
+    void SetTemporaryAllocationPolicy (IRMemoryMap::AllocationPolicy policy);
+    
     uint32_t GetStructAlignment ()
     {
         return m_struct_alignment;
@@ -114,7 +123,8 @@ public:
         Entity () :
             m_alignment(1),
             m_size(0),
-            m_offset(0)
+            m_offset(0),
+            m_temporary_policy(IRMemoryMap::eAllocationPolicyMirror)
         {
         }
         
@@ -147,12 +157,18 @@ public:
         {
             m_offset = offset;
         }
+        
+        void SetTemporaryAllocationPolicy (IRMemoryMap::AllocationPolicy policy)
+        {
+            m_temporary_policy = policy;
+        }
     protected:
         void SetSizeAndAlignmentFromType (ClangASTType &type);
         
         uint32_t    m_alignment;
         uint32_t    m_size;
         uint32_t    m_offset;
+        IRMemoryMap::AllocationPolicy m_temporary_policy;
     };
 
 private:
@@ -0,0 +1,74 @@
+//===-- AgentExpression.h ---------------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef liblldb_AgentExpression_h_
+#define liblldb_AgentExpression_h_
+
+#include "lldb/lldb-types.h"
+#include "lldb/Core/Error.h"
+
+#include <functional>
+#include <vector>
+
+namespace lldb_private
+{
+    //------------------------------------------------------------------
+    /// @class AgentExpression AgentExpression.h "lldb/Host/common/AgentExpression.h"
+    /// @brief A bytecode expression in the GDB agent expression format.
+    ///
+    /// A debugger can attach these to Z packets as breakpoint conditions.
+    /// The stub evaluates them against the stopped thread without a round
+    /// trip to the debugger.  Only the integer subset of the bytecodes is
+    /// supported; floating point and trace collection bytecodes make
+    /// evaluation fail.
+    //------------------------------------------------------------------
+    class AgentExpression
+    {
+    public:
+        typedef std::function<Error (uint32_t reg_num, uint64_t &value)> ReadRegisterFunc;
+        typedef std::function<Error (lldb::addr_t addr, size_t size, uint64_t &value)> ReadMemoryFunc;
+
+        AgentExpression ();
+
+        AgentExpression (const uint8_t *bytes, size_t size);
+
+        const std::vector<uint8_t> &
+        GetBytes () const
+        {
+            return m_bytes;
+        }
+
+        //------------------------------------------------------------------
+        /// Run the expression.
+        ///
+        /// @param[in] read_register
+        ///     Reads the register with the given gdb-remote register number.
+        ///
+        /// @param[in] read_memory
+        ///     Reads an unsigned value of 1, 2, 4 or 8 bytes in the target's
+        ///     byte order.
+        ///
+        /// @param[out] result
+        ///     The value on top of the stack when the expression ended.
+        ///
+        /// @return
+        ///     An error if the expression is malformed, uses an unsupported
+        ///     bytecode or can't read the registers or memory it refers to.
+        //------------------------------------------------------------------
+        Error
+        Evaluate (const ReadRegisterFunc &read_register,
+                  const ReadMemoryFunc &read_memory,
+                  uint64_t &result) const;
+
+    private:
+        std::vector<uint8_t> m_bytes;
+    };
+}
+
+#endif // ifndef liblldb_AgentExpression_h_
@@ -11,6 +11,9 @@
 #define liblldb_NativeBreakpoint_h_
 
 #include "lldb/lldb-types.h"
+#include "lldb/Host/common/AgentExpression.h"
+
+#include <vector>
 
 namespace lldb_private
 {
@@ -42,9 +45,41 @@ namespace lldb_private
         virtual bool
         IsSoftwareBreakpoint () const = 0;
 
+        // -----------------------------------------------------------
+        // Conditions sent along with the Z packet.  The breakpoint only
+        // needs to stop the process if one of them is true.
+        // -----------------------------------------------------------
+        void
+        SetConditions (std::vector<AgentExpression> &&conditions) { m_conditions = std::move (conditions); }
+
+        bool
+        HasConditions () const { return !m_conditions.empty (); }
+
+        // Returns false only if there are conditions and all of them are
+        // false, in which case the hit is counted as skipped.
+        bool
+        ConditionSaysStop (const AgentExpression::ReadRegisterFunc &read_register,
+                           const AgentExpression::ReadMemoryFunc &read_memory);
+
+        // Called for every trap at the breakpoint, whether or not its
+        // conditions get evaluated.
+        void
+        CountHit () { ++m_hit_count; }
+
+        // The number of times the breakpoint was hit, and how many of those
+        // hits were passed over because the conditions were false.
+        uint64_t
+        GetHitCount () const { return m_hit_count; }
+
+        uint64_t
+        GetSkippedHitCount () const { return m_skipped_hit_count; }
+
     protected:
         const lldb::addr_t m_addr;
         int32_t m_ref_count;
+        std::vector<AgentExpression> m_conditions;
+        uint64_t m_hit_count;
+        uint64_t m_skipped_hit_count;
 
         virtual Error
         DoEnable () = 0;
@@ -17,6 +17,7 @@
 #include "lldb/Core/Error.h"
 #include "lldb/Host/Mutex.h"
 
+#include "AgentExpression.h"
 #include "NativeBreakpointList.h"
 #include "NativeWatchpointList.h"
 
@@ -131,6 +132,16 @@ namespace lldb_private
         virtual Error
         DisableBreakpoint (lldb::addr_t addr);
 
+        //------------------------------------------------------------------
+        /// Replace the conditions of the breakpoint at \a addr.  With no
+        /// conditions every hit stops the process.
+        //------------------------------------------------------------------
+        virtual Error
+        SetBreakpointConditions (lldb::addr_t addr, std::vector<AgentExpression> &&conditions);
+
+        Error
+        GetBreakpointHitCounts (lldb::addr_t addr, uint64_t &hit_count, uint64_t &skipped_hit_count);
+
         //----------------------------------------------------------------------
         // Watchpoint functions
         //----------------------------------------------------------------------
@@ -337,6 +348,26 @@ namespace lldb_private
         virtual Error
         GetSoftwareBreakpointTrapOpcode (size_t trap_opcode_size_hint, size_t &actual_opcode_size, const uint8_t *&trap_opcode_bytes) = 0;
 
+        //------------------------------------------------------------------
+        /// Count a hit of the breakpoint at \a addr.  Every trap at a
+        /// breakpoint must be counted, including the ones whose conditions
+        /// never get evaluated.
+        //------------------------------------------------------------------
+        void
+        CountBreakpointHit (lldb::addr_t addr);
+
+        //------------------------------------------------------------------
+        /// Evaluate the conditions of the breakpoint at \a addr against
+        /// \a thread.
+        ///
+        /// @return
+        ///     \b false if the breakpoint has conditions and all of them
+        ///     are false, so the thread can carry on without telling the
+        ///     debugger.  \b true otherwise.
+        //------------------------------------------------------------------
+        bool
+        BreakpointConditionSaysStop (NativeThreadProtocol &thread, lldb::addr_t addr);
+
         // -----------------------------------------------------------
         /// Notify the delegate that an exec occurred.
         ///
@@ -120,6 +120,20 @@ public:
     virtual Error
     WriteRegisterValueToMemory (const lldb_private::RegisterInfo *reg_info, lldb::addr_t dst_addr, size_t dst_len, const RegisterValue &reg_value);
 
+    //------------------------------------------------------------------
+    /// Read all user registers into a buffer that holds each register
+    /// at its RegisterInfo::byte_offset, which is the layout of a
+    /// gdb-remote "g" packet.
+    ///
+    /// Registers that are slices of other registers are skipped. If any
+    /// other register can't be read an error is returned, so the client
+    /// falls back to reading registers one at a time. Subclasses
+    /// that can fetch whole register sets at once should override this
+    /// to avoid one fetch per register.
+    //------------------------------------------------------------------
+    virtual Error
+    ReadAllUserRegisterValues (lldb::DataBufferSP &data_sp);
+
     //------------------------------------------------------------------
     // Subclasses should not override these
     //------------------------------------------------------------------
@@ -0,0 +1,73 @@
+//===-- EPoll.h -------------------------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef lldb_Host_linux_EPoll_h_
+#define lldb_Host_linux_EPoll_h_
+
+#include <stdint.h>
+#include <vector>
+
+#include "lldb/lldb-defines.h"
+#include "lldb/Core/Error.h"
+
+namespace lldb_private
+{
+
+//----------------------------------------------------------------------
+/// @class EPoll EPoll.h "lldb/Host/linux/EPoll.h"
+/// @brief Waits for any of a set of file descriptors to become readable.
+///
+/// Unlike select(), the descriptors are registered with the kernel once
+/// and there is no limit on their values. Register a descriptor edge
+/// triggered when its reader always reads until it would block.
+//----------------------------------------------------------------------
+class EPoll
+{
+  public:
+    EPoll();
+    ~EPoll();
+
+    Error Open();
+    void Close();
+
+    bool
+    IsValid() const
+    {
+        return m_fd >= 0;
+    }
+
+    Error AddReadFileDescriptor(int fd, bool edge_triggered);
+    Error RemoveFileDescriptor(int fd);
+
+    //------------------------------------------------------------------
+    /// Wait for the registered descriptors.
+    ///
+    /// @param[in] timeout_usec
+    ///     How long to wait, UINT32_MAX waits forever.
+    ///
+    /// @param[out] ready_fds
+    ///     Filled in with the descriptors that can be read, or that hung
+    ///     up or got an error so that reading them tells why. Empty if
+    ///     the wait timed out.
+    ///
+    /// @return
+    ///     An error if the wait failed, which includes being interrupted
+    ///     by a signal (EINTR).
+    //------------------------------------------------------------------
+    Error Wait(uint32_t timeout_usec, std::vector<int> &ready_fds);
+
+  private:
+    int m_fd;
+
+    DISALLOW_COPY_AND_ASSIGN(EPoll);
+};
+
+} // namespace lldb_private
+
+#endif // lldb_Host_linux_EPoll_h_
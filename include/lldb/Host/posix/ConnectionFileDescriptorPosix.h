@@ -108,6 +108,16 @@ class ConnectionFileDescriptor : public Connection
   private:
     void InitializeSocket(Socket* socket);
 
+#if defined(__linux__)
+    class SocketReader;
+
+    // Returns the reader for the current socket, or NULL if we aren't
+    // connected to a socket and reads should use select()
+    SocketReader *GetSocketReader();
+
+    std::unique_ptr<SocketReader> m_socket_reader_up;
+#endif
+
     DISALLOW_COPY_AND_ASSIGN(ConnectionFileDescriptor);
 };
 
@@ -365,11 +365,18 @@ public:
     /// Section list parsing can be deferred by ObjectFile instances
     /// until this accessor is called the first time.
     ///
+    /// @param[in] update_module_section_list
+    ///     If \b true, the sections are also merged into the unified
+    ///     section list of the owning module. Object files that are
+    ///     only opened to read their contents on behalf of a module,
+    ///     like split DWARF .dwo files, must pass \b false so they
+    ///     don't replace the sections of the module itself.
+    ///
     /// @return
     ///     The list of sections contained in this object file.
     //------------------------------------------------------------------
     virtual SectionList *
-    GetSectionList ();
+    GetSectionList (bool update_module_section_list = true);
 
     virtual void
     CreateSections (SectionList &unified_section_list) = 0;
@@ -830,6 +837,15 @@ public:
     size_t
     MemoryMapSectionData (const Section *section, 
                           DataExtractor& section_data) const;
+
+    //------------------------------------------------------------------
+    /// Returns true if the section is stored compressed in the file.
+    ///
+    /// ReadSectionData() returns the uncompressed contents of these
+    /// sections, which is expensive the first time it is done.
+    //------------------------------------------------------------------
+    virtual bool
+    SectionIsCompressed (const Section *section) const;
     
     bool
     IsInMemory () const
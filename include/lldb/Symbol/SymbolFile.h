@@ -163,6 +163,15 @@ public:
     { 
     }
 
+    //------------------------------------------------------------------
+    /// Dump statistics about the debug information this symbol file has
+    /// parsed, such as how much memory it takes up.
+    //------------------------------------------------------------------
+    virtual void
+    Dump (Stream &s)
+    {
+    }
+
     
 protected:
     ObjectFile*             m_obj_file; // The object file that symbols can be extracted from.
@@ -81,6 +81,7 @@ public:
             Symbol *    FindFirstSymbolWithNameAndType (const ConstString &name, lldb::SymbolType symbol_type, Debug symbol_debug_type, Visibility symbol_visibility);
             Symbol *    FindSymbolContainingFileAddress (lldb::addr_t file_addr, const uint32_t* indexes, uint32_t num_indexes);
             Symbol *    FindSymbolContainingFileAddress (lldb::addr_t file_addr);
+            void        FindSymbolsContainingFileAddresses (const lldb::addr_t *file_addrs, size_t num_addrs, Symbol **symbols);
             size_t      FindFunctionSymbols (const ConstString &name, uint32_t name_type_mask, SymbolContextList& sc_list);
             void        CalculateSymbolSizes ();
 
@@ -115,6 +116,8 @@ protected:
     typedef RangeDataVector<lldb::addr_t, lldb::addr_t, uint32_t> FileRangeToIndexMap;
             void        InitNameIndexes ();
             void        InitAddressIndexes ();
+            bool        LoadNameIndexesFromCache ();
+            void        SaveNameIndexesToCache () const;
 
     ObjectFile *        m_objfile;
     collection          m_symbols;
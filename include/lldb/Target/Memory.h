@@ -26,6 +26,13 @@ namespace lldb_private {
     //----------------------------------------------------------------------
     // A class to track memory that was read from a live process between 
     // runs. 
+    //
+    // Memory is cached in fixed size, aligned lines that live in a single
+    // contiguous slab. Once the cache reaches its maximum size the least
+    // recently used line is evicted. Misses on consecutive lines grow a
+    // read-ahead window so walking an array or a list needs fewer reads
+    // from the inferior. Lines that lie in read-only sections of loaded
+    // modules (code, C strings, read-only data) stay valid across resumes.
     //----------------------------------------------------------------------
     class MemoryCache
     {
@@ -39,6 +46,15 @@ namespace lldb_private {
         
         void
         Clear(bool clear_invalid_ranges = false);
+
+        //------------------------------------------------------------------
+        // Called when the process stops: drops every line that the
+        // inferior may have modified while it was running and keeps the
+        // ones in read-only sections that are still loaded at the same
+        // address.
+        //------------------------------------------------------------------
+        void
+        ClearMutableLines ();
         
         void
         Flush (lldb::addr_t addr, size_t size);
@@ -48,6 +64,18 @@ namespace lldb_private {
               void *dst, 
               size_t dst_len,
               Error &error);
+
+        //------------------------------------------------------------------
+        // Read [addr, addr + size) from the inferior in one go and add the
+        // lines it covers to the cache, so later small reads in the range
+        // (like an unwinder walking a stack) don't each go to the inferior.
+        // At most a quarter of the cache is filled. The memory is read
+        // without holding the cache mutex so prefetches for several
+        // threads can be in flight at once. Returns the number of bytes
+        // added to the cache.
+        //------------------------------------------------------------------
+        size_t
+        Prefetch (lldb::addr_t addr, size_t size);
         
         uint32_t
         GetMemoryCacheLineSize() const
@@ -61,17 +89,73 @@ namespace lldb_private {
         bool
         RemoveInvalidRange (lldb::addr_t base_addr, lldb::addr_t byte_size);
 
+        void
+        DumpStatistics (Stream &strm);
+
     protected:
-        typedef std::map<lldb::addr_t, lldb::DataBufferSP> BlockMap;
+        struct CacheLine
+        {
+            lldb::addr_t addr;
+            uint32_t byte_size;     // Number of valid bytes, less than the line size if the read came up short
+            uint32_t prev;          // Index of the next more recently used line
+            uint32_t next;          // Index of the next less recently used line
+            bool immutable;
+            lldb::SectionWP section_wp; // The read-only section an immutable line was found in
+        };
+
+        typedef std::map<lldb::addr_t, uint32_t> LineMap; // Line address to line index
         typedef RangeArray<lldb::addr_t, lldb::addr_t, 4> InvalidRanges;
+
+        uint32_t
+        FindLine (lldb::addr_t line_addr);
+
+        uint32_t
+        FillLines (lldb::addr_t line_addr, Error &error);
+
+        uint32_t
+        AllocateLine ();
+
+        void
+        RemoveLine (LineMap::iterator pos);
+
+        void
+        LinkLineAtFront (uint32_t line_idx);
+
+        void
+        UnlinkLine (uint32_t line_idx);
+
+        bool
+        IsImmutable (lldb::addr_t line_addr, lldb::SectionSP &section_sp) const;
+
+        uint8_t *
+        GetLineBytes (uint32_t line_idx)
+        {
+            return m_slab.data() + (size_t)line_idx * m_cache_line_byte_size;
+        }
+
         //------------------------------------------------------------------
         // Classes that inherit from MemoryCache can see and modify these
         //------------------------------------------------------------------
         Process &m_process;
         uint32_t m_cache_line_byte_size;
+        uint32_t m_max_lines;
         Mutex m_mutex;
-        BlockMap m_cache;
+        LineMap m_cache;
+        std::vector<CacheLine> m_lines;
+        std::vector<uint8_t> m_slab;
+        std::vector<uint32_t> m_free_lines;
+        std::vector<uint8_t> m_read_buffer;
+        uint32_t m_lru_head;    // Most recently used line
+        uint32_t m_lru_tail;    // Least recently used line
+        lldb::addr_t m_last_miss_addr;
+        uint32_t m_read_ahead_lines;
         InvalidRanges m_invalid_ranges;
+        uint64_t m_hits;
+        uint64_t m_misses;
+        uint64_t m_read_ahead_count;
+        uint64_t m_evictions;
+        uint64_t m_prefetch_count;
+        uint32_t m_flush_id;    // Bumped whenever lines are dropped, so a prefetch can tell its data went stale
     private:
         DISALLOW_COPY_AND_ASSIGN (MemoryCache);
     };
@@ -66,6 +66,15 @@ public:
     uint64_t
     GetMemoryCacheLineSize () const;
 
+    uint64_t
+    GetMemoryCacheMaxSize () const;
+
+    uint64_t
+    GetUnwindThreadCount () const;
+
+    uint64_t
+    GetStackPrefetchSize () const;
+
     Args
     GetExtraStartupCommands () const;
 
@@ -2065,6 +2074,18 @@ public:
                 size_t size,
                 Error &error);
 
+    //------------------------------------------------------------------
+    /// Read a range of memory into the memory cache in a single read so
+    /// later small reads inside it are answered from the cache.
+    ///
+    /// Does nothing if the memory cache is disabled.
+    ///
+    /// @return
+    ///     The number of bytes that were added to the cache.
+    //------------------------------------------------------------------
+    size_t
+    PrefetchMemory (lldb::addr_t vm_addr, size_t size);
+
     //------------------------------------------------------------------
     /// Read a NULL terminated string from memory
     ///
@@ -60,6 +60,17 @@ public:
     bool
     ResolveLoadAddress (lldb::addr_t load_addr, Address &so_addr) const;
 
+    //------------------------------------------------------------------
+    /// Resolve \a num_addrs load addresses, which must be sorted in
+    /// increasing order, into \a so_addrs. Addresses that aren't in a
+    /// loaded section are cleared.
+    ///
+    /// @return
+    ///     The number of addresses that were resolved.
+    //------------------------------------------------------------------
+    size_t
+    ResolveLoadAddresses (const lldb::addr_t *load_addrs, size_t num_addrs, Address *so_addrs) const;
+
     bool
     SetSectionLoadAddress (const lldb::SectionSP &section_sp, lldb::addr_t load_addr, bool warn_multiple = false);
 
@@ -0,0 +1,106 @@
+//===-- Symbolicator.h ------------------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef liblldb_Symbolicator_h_
+#define liblldb_Symbolicator_h_
+
+// C Includes
+// C++ Includes
+#include <vector>
+
+// Other libraries and framework includes
+// Project includes
+#include "lldb/lldb-private.h"
+#include "lldb/Core/ConstString.h"
+#include "lldb/Host/FileSpec.h"
+
+namespace lldb_private
+{
+
+//----------------------------------------------------------------------
+/// @class Symbolicator Symbolicator.h "lldb/Target/Symbolicator.h"
+/// @brief Resolves large batches of load addresses to symbols and lines.
+///
+/// Resolving addresses one at a time looks each one up in the section
+/// load list, the module's symbol table and its line tables from
+/// scratch. A symbolicator sorts the whole batch by module and address
+/// instead, so each module's symbol table is walked once, neighbouring
+/// addresses reuse the line table entry or compile unit found for the
+/// previous one, and different modules are resolved on different
+/// threads.
+///
+/// Only the symbol, file, line and column are resolved; use
+/// Target::ResolveLoadAddress for the full symbol context of an address.
+//----------------------------------------------------------------------
+class Symbolicator
+{
+public:
+    struct Entry
+    {
+        lldb::addr_t load_addr;
+        lldb::addr_t file_addr;     // LLDB_INVALID_ADDRESS if load_addr isn't in a module's section
+        lldb::addr_t symbol_offset; // Offset of file_addr from the start of symbol_name
+        ConstString symbol_name;
+        FileSpec file;
+        uint32_t module_idx;        // Index into the modules, UINT32_MAX if there is no module
+        uint32_t line;              // Zero if there is no line information
+        uint16_t column;
+    };
+
+    Symbolicator ();
+
+    ~Symbolicator ();
+
+    //------------------------------------------------------------------
+    /// Resolve \a num_addrs load addresses in \a target, replacing any
+    /// previous results. The entries are in the same order as the
+    /// addresses. If no sections have been loaded, as when there is no
+    /// process, the addresses are looked up as file addresses.
+    ///
+    /// @param[in] num_threads
+    ///     The most threads to resolve modules on, or zero for the
+    ///     default.
+    //------------------------------------------------------------------
+    void
+    Symbolicate (Target &target,
+                 const lldb::addr_t *load_addrs,
+                 size_t num_addrs,
+                 uint32_t num_threads = 0);
+
+    void
+    Clear ();
+
+    size_t
+    GetSize () const
+    {
+        return m_entries.size();
+    }
+
+    // Clients must ensure that "idx" is a valid index
+    const Entry &
+    GetEntryAtIndex (size_t idx) const
+    {
+        return m_entries[idx];
+    }
+
+    lldb::ModuleSP
+    GetModuleForEntry (const Entry &entry) const;
+
+private:
+    std::vector<Entry> m_entries;
+    // The modules are kept here rather than in each entry, which keeps the
+    // entries small and holds a single reference to each module
+    std::vector<lldb::ModuleSP> m_modules;
+
+    DISALLOW_COPY_AND_ASSIGN (Symbolicator);
+};
+
+} // namespace lldb_private
+
+#endif  // liblldb_Symbolicator_h_
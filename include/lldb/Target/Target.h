@@ -129,6 +129,9 @@ public:
 
     FileSpecList &
     GetDebugFileSearchPaths ();
+
+    FileSpec
+    GetIndexCachePath () const;
     
     FileSpecList &
     GetClangModuleSearchPaths ();
@@ -147,6 +150,9 @@ public:
 
     uint32_t
     GetMaximumMemReadSize () const;
+
+    uint32_t
+    GetExpressionCacheSize () const;
     
     FileSpec
     GetStandardInputPath () const;
@@ -572,6 +578,9 @@ public:
 
     static FileSpecList
     GetDefaultDebugFileSearchPaths ();
+
+    static FileSpec
+    GetDefaultIndexCachePath ();
     
     static FileSpecList
     GetDefaultClangModuleSearchPaths ();
@@ -1251,6 +1260,28 @@ public:
     ClangPersistentVariables &
     GetPersistentVariables();
 
+    //------------------------------------------------------------------
+    /// Get the parsed user expressions kept for reuse by
+    /// ClangUserExpression::Evaluate.
+    //------------------------------------------------------------------
+    ClangUserExpressionCache &
+    GetUserExpressionCache ();
+
+    //------------------------------------------------------------------
+    /// Get a count that changes every time modules are loaded, unloaded,
+    /// replaced or have their symbols loaded.  Anything that was computed
+    /// from the target's modules can compare it to decide whether it is
+    /// out of date.
+    ///
+    /// @return
+    ///     The current module generation.
+    //------------------------------------------------------------------
+    uint32_t
+    GetModulesGeneration () const
+    {
+        return m_modules_generation;
+    }
+
     //------------------------------------------------------------------
     // Target Stop Hooks
     //------------------------------------------------------------------
@@ -1453,6 +1484,8 @@ protected:
     lldb::ClangASTImporterUP m_ast_importer_ap;
     lldb::ClangModulesDeclVendorUP m_clang_modules_decl_vendor_ap;
     lldb::ClangPersistentVariablesUP m_persistent_variables;      ///< These are the persistent variables associated with this process for the expression parser.
+    lldb::ClangUserExpressionCacheUP m_user_expression_cache_ap;  ///< Parsed expressions that can be run again without reparsing.
+    uint32_t        m_modules_generation;
 
     lldb::SourceManagerUP m_source_manager_ap;
 
@@ -122,6 +122,22 @@ public:
     void
     DiscardThreadPlans();
 
+    //------------------------------------------------------------------
+    /// Unwind the stacks of all threads concurrently so that walking
+    /// their frames afterwards, as "thread backtrace all" does, finds
+    /// them already computed.
+    ///
+    /// Each thread's stack memory above its stack pointer is read in one
+    /// go before it is unwound. This only does anything while the process
+    /// is stopped.
+    ///
+    /// @param[in] num_frames
+    ///     How many frames to compute for each thread, UINT32_MAX for
+    ///     all of them.
+    //------------------------------------------------------------------
+    void
+    PrefetchStackFrames (uint32_t num_frames);
+
     uint32_t
     GetStopID () const;
 
@@ -0,0 +1,42 @@
+//===-- HexCoding.h ---------------------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLDB_UTILITY_HEXCODING_H
+#define LLDB_UTILITY_HEXCODING_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace lldb_private
+{
+//----------------------------------------------------------------------
+// Bulk conversions between bytes and ASCII hex, and the modulo 256 sum
+// that gdb-remote packets are checked with. These use SSE2 or AVX2 when
+// the host has them, which is picked once at run time.
+//----------------------------------------------------------------------
+
+// Writes two lower case hex digits for each byte of src to dst, which
+// must have room for 2 * src_len characters. Returns the number of
+// characters written.
+size_t
+HexEncode (const void *src, size_t src_len, char *dst);
+
+// Decodes pairs of hex digits of either case from src into dst, stopping
+// at the first pair that isn't valid hex, after dst_len bytes or at the
+// end of src. Returns the number of bytes decoded; twice that many
+// characters of src were used.
+size_t
+HexDecode (const char *src, size_t src_len, void *dst, size_t dst_len);
+
+// Returns the sum of the bytes modulo 256
+uint8_t
+Checksum8 (const void *src, size_t src_len);
+}
+
+#endif
@@ -0,0 +1,61 @@
+//===-- TaskPool.h ----------------------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef utility_TaskPool_h_
+#define utility_TaskPool_h_
+
+#include <stdint.h>
+#include <functional>
+
+namespace lldb_private {
+
+//----------------------------------------------------------------------
+// A minimal fork/join helper for running independent pieces of work on
+// a set of short lived worker threads.
+//
+// The calling thread always participates in the work, so a thread count
+// of one (or a range containing a single item) runs everything inline
+// without spawning any threads.
+//----------------------------------------------------------------------
+class TaskPool
+{
+public:
+    //------------------------------------------------------------------
+    // Returns the number of worker threads to use when the caller did
+    // not request a specific number (i.e. passed zero).
+    //------------------------------------------------------------------
+    static uint32_t
+    GetDefaultThreadCount ();
+
+    //------------------------------------------------------------------
+    // Call "func" once for each integer in [begin, end). Indexes are
+    // handed out dynamically so that uneven work items are balanced
+    // across at most "num_threads" threads. The function returns once
+    // every call has completed. Each invocation of "func" receives the
+    // index it should process and the zero based index of the worker
+    // thread that is running it, so callers can keep per-worker state
+    // without any locking.
+    //------------------------------------------------------------------
+    static void
+    MapOverInt (uint32_t begin,
+                uint32_t end,
+                uint32_t num_threads,
+                const std::function<void(uint32_t idx, uint32_t worker_idx)> &func);
+
+    //------------------------------------------------------------------
+    // Returns the number of workers MapOverInt() will use for the given
+    // item count and requested thread count.
+    //------------------------------------------------------------------
+    static uint32_t
+    GetNumWorkers (uint32_t num_items, uint32_t num_threads);
+};
+
+} // namespace lldb_private
+
+#endif  // utility_TaskPool_h_
@@ -61,6 +61,7 @@ class   ClangFunction;
 class   ClangModulesDeclVendor;
 class   ClangPersistentVariables;
 class   ClangUserExpression;
+class   ClangUserExpressionCache;
 class   ClangUtilityFunction;
 class   CommandInterpreter;
 class   CommandInterpreterRunOptions;
@@ -202,6 +203,7 @@ class   Stoppoint;
 class   StoppointCallbackContext;
 class   StoppointLocation;
 class   Stream;
+class   StreamAsyncLog;
 template <unsigned N> class StreamBuffer;
 class   StreamFile;
 class   StreamString;
@@ -211,6 +213,7 @@ class   SystemRuntime;
 class   TypeSummaryImpl;
 class   TypeSummaryOptions;
 class   Symbol;
+class   Symbolicator;
 class   SymbolContext;
 class   SymbolContextList;
 class   SymbolContextScope;
@@ -307,6 +310,7 @@ namespace lldb {
     typedef std::unique_ptr<lldb_private::ClangModulesDeclVendor> ClangModulesDeclVendorUP;
     typedef std::unique_ptr<lldb_private::ClangPersistentVariables> ClangPersistentVariablesUP;
     typedef std::shared_ptr<lldb_private::ClangUserExpression> ClangUserExpressionSP;
+    typedef std::unique_ptr<lldb_private::ClangUserExpressionCache> ClangUserExpressionCacheUP;
     typedef std::shared_ptr<lldb_private::CommandObject> CommandObjectSP;
     typedef std::shared_ptr<lldb_private::Communication> CommunicationSP;
     typedef std::shared_ptr<lldb_private::Connection> ConnectionSP;
@@ -109,6 +109,7 @@ HEADER_FILES="${SRC_ROOT}/include/lldb/lldb.h"\
 " ${SRC_ROOT}/include/lldb/API/SBProcess.h"\
 " ${SRC_ROOT}/include/lldb/API/SBQueue.h"\
 " ${SRC_ROOT}/include/lldb/API/SBQueueItem.h"\
+" ${SRC_ROOT}/include/lldb/API/SBResolvedAddressList.h"\
 " ${SRC_ROOT}/include/lldb/API/SBSourceManager.h"\
 " ${SRC_ROOT}/include/lldb/API/SBStream.h"\
 " ${SRC_ROOT}/include/lldb/API/SBStringList.h"\
@@ -165,6 +166,7 @@ INTERFACE_FILES="${SRC_ROOT}/scripts/interface/SBAddress.i"\
 " ${SRC_ROOT}/scripts/interface/SBProcess.i"\
 " ${SRC_ROOT}/scripts/interface/SBQueue.i"\
 " ${SRC_ROOT}/scripts/interface/SBQueueItem.i"\
+" ${SRC_ROOT}/scripts/interface/SBResolvedAddressList.i"\
 " ${SRC_ROOT}/scripts/interface/SBSourceManager.i"\
 " ${SRC_ROOT}/scripts/interface/SBStream.i"\
 " ${SRC_ROOT}/scripts/interface/SBStringList.i"\
@@ -0,0 +1,71 @@
+//===-- SWIG Interface for SBResolvedAddressList ----------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+namespace lldb {
+
+%feature("docstring",
+"The module, symbol and line information for a batch of load addresses,
+as returned by SBTarget.ResolveLoadAddresses(). The results are accessed
+by index, in the same order as the addresses.
+
+For example,
+
+    pcs = [frame.GetPC() for frame in thread]
+    resolved = target.ResolveLoadAddresses(pcs)
+    for i in range(resolved.GetSize()):
+        print '0x%x %s + %u at %s:%u' % (resolved.GetLoadAddressAtIndex(i),
+                                         resolved.GetSymbolNameAtIndex(i),
+                                         resolved.GetSymbolOffsetAtIndex(i),
+                                         resolved.GetFileNameAtIndex(i),
+                                         resolved.GetLineAtIndex(i))
+") SBResolvedAddressList;
+class SBResolvedAddressList
+{
+public:
+    SBResolvedAddressList ();
+
+    SBResolvedAddressList (const lldb::SBResolvedAddressList &rhs);
+
+    ~SBResolvedAddressList ();
+
+    bool
+    IsValid () const;
+
+    uint32_t
+    GetSize () const;
+
+    lldb::addr_t
+    GetLoadAddressAtIndex (uint32_t idx) const;
+
+    lldb::addr_t
+    GetFileAddressAtIndex (uint32_t idx) const;
+
+    lldb::SBModule
+    GetModuleAtIndex (uint32_t idx) const;
+
+    const char *
+    GetSymbolNameAtIndex (uint32_t idx) const;
+
+    lldb::addr_t
+    GetSymbolOffsetAtIndex (uint32_t idx) const;
+
+    const char *
+    GetFileNameAtIndex (uint32_t idx) const;
+
+    const char *
+    GetDirectoryAtIndex (uint32_t idx) const;
+
+    uint32_t
+    GetLineAtIndex (uint32_t idx) const;
+
+    uint32_t
+    GetColumnAtIndex (uint32_t idx) const;
+};
+
+} // namespace lldb
@@ -548,6 +548,20 @@ public:
     lldb::SBAddress
     ResolvePastLoadAddress (uint32_t stop_id, lldb::addr_t vm_addr);
 
+    %feature("docstring", "
+    //------------------------------------------------------------------
+    /// Resolve a list of current load addresses to their modules,
+    /// symbols and source lines at once. This is much faster than
+    /// resolving each address on its own.
+    ///
+    /// @return
+    ///     An SBResolvedAddressList with an entry for each address, in
+    ///     the same order as the addresses.
+    //------------------------------------------------------------------
+    ") ResolveLoadAddresses;
+    lldb::SBResolvedAddressList
+    ResolveLoadAddresses (uint64_t* array, size_t array_len);
+
     SBSymbolContext
     ResolveSymbolContextForAddress (const SBAddress& addr, 
                                     uint32_t resolve_scope);
@@ -0,0 +1,135 @@
+//===-- SBResolvedAddressList.cpp -------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "lldb/API/SBResolvedAddressList.h"
+
+#include "lldb/Core/Module.h"
+#include "lldb/Target/Symbolicator.h"
+
+using namespace lldb;
+using namespace lldb_private;
+
+// The results are never changed once they have been resolved, so copies
+// of a list share them rather than copying every entry.
+SBResolvedAddressList::SBResolvedAddressList () :
+    m_opaque_sp ()
+{
+}
+
+SBResolvedAddressList::SBResolvedAddressList (const SBResolvedAddressList &rhs) :
+    m_opaque_sp (rhs.m_opaque_sp)
+{
+}
+
+const SBResolvedAddressList &
+SBResolvedAddressList::operator = (const SBResolvedAddressList &rhs)
+{
+    if (this != &rhs)
+        m_opaque_sp = rhs.m_opaque_sp;
+    return *this;
+}
+
+SBResolvedAddressList::~SBResolvedAddressList ()
+{
+}
+
+lldb_private::Symbolicator &
+SBResolvedAddressList::ref ()
+{
+    if (m_opaque_sp.get() == NULL)
+        m_opaque_sp.reset (new Symbolicator());
+    return *m_opaque_sp;
+}
+
+bool
+SBResolvedAddressList::IsValid () const
+{
+    return m_opaque_sp.get() != NULL;
+}
+
+uint32_t
+SBResolvedAddressList::GetSize () const
+{
+    if (m_opaque_sp)
+        return m_opaque_sp->GetSize();
+    return 0;
+}
+
+lldb::addr_t
+SBResolvedAddressList::GetLoadAddressAtIndex (uint32_t idx) const
+{
+    if (idx < GetSize())
+        return m_opaque_sp->GetEntryAtIndex(idx).load_addr;
+    return LLDB_INVALID_ADDRESS;
+}
+
+lldb::addr_t
+SBResolvedAddressList::GetFileAddressAtIndex (uint32_t idx) const
+{
+    if (idx < GetSize())
+        return m_opaque_sp->GetEntryAtIndex(idx).file_addr;
+    return LLDB_INVALID_ADDRESS;
+}
+
+SBModule
+SBResolvedAddressList::GetModuleAtIndex (uint32_t idx) const
+{
+    SBModule sb_module;
+    if (idx < GetSize())
+        sb_module.SetSP (m_opaque_sp->GetModuleForEntry (m_opaque_sp->GetEntryAtIndex(idx)));
+    return sb_module;
+}
+
+const char *
+SBResolvedAddressList::GetSymbolNameAtIndex (uint32_t idx) const
+{
+    if (idx < GetSize())
+        return m_opaque_sp->GetEntryAtIndex(idx).symbol_name.AsCString();
+    return NULL;
+}
+
+lldb::addr_t
+SBResolvedAddressList::GetSymbolOffsetAtIndex (uint32_t idx) const
+{
+    if (idx < GetSize())
+        return m_opaque_sp->GetEntryAtIndex(idx).symbol_offset;
+    return 0;
+}
+
+const char *
+SBResolvedAddressList::GetFileNameAtIndex (uint32_t idx) const
+{
+    if (idx < GetSize())
+        return m_opaque_sp->GetEntryAtIndex(idx).file.GetFilename().AsCString();
+    return NULL;
+}
+
+const char *
+SBResolvedAddressList::GetDirectoryAtIndex (uint32_t idx) const
+{
+    if (idx < GetSize())
+        return m_opaque_sp->GetEntryAtIndex(idx).file.GetDirectory().AsCString();
+    return NULL;
+}
+
+uint32_t
+SBResolvedAddressList::GetLineAtIndex (uint32_t idx) const
+{
+    if (idx < GetSize())
+        return m_opaque_sp->GetEntryAtIndex(idx).line;
+    return 0;
+}
+
+uint32_t
+SBResolvedAddressList::GetColumnAtIndex (uint32_t idx) const
+{
+    if (idx < GetSize())
+        return m_opaque_sp->GetEntryAtIndex(idx).column;
+    return 0;
+}
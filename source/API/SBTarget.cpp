@@ -58,6 +58,7 @@
 #include "lldb/Target/ObjCLanguageRuntime.h"
 #include "lldb/Target/Process.h"
 #include "lldb/Target/StackFrame.h"
+#include "lldb/Target/Symbolicator.h"
 #include "lldb/Target/Target.h"
 #include "lldb/Target/TargetList.h"
 
@@ -749,6 +750,26 @@ SBTarget::ResolvePastLoadAddress (uint32_t stop_id, lldb::addr_t vm_addr)
     return sb_addr;
 }
 
+SBResolvedAddressList
+SBTarget::ResolveLoadAddresses (uint64_t* array, size_t array_len)
+{
+    Log *log(GetLogIfAllCategoriesSet (LIBLLDB_LOG_API));
+
+    SBResolvedAddressList sb_list;
+    TargetSP target_sp(GetSP());
+    if (target_sp)
+    {
+        Mutex::Locker api_locker (target_sp->GetAPIMutex());
+        sb_list.ref().Symbolicate (*target_sp, array, array_len);
+    }
+
+    if (log)
+        log->Printf ("SBTarget(%p)::ResolveLoadAddresses (%" PRIu64 " addresses)",
+                     static_cast<void*>(target_sp.get()), (uint64_t)array_len);
+
+    return sb_list;
+}
+
 SBSymbolContext
 SBTarget::ResolveSymbolContextForAddress (const SBAddress& addr,
                                           uint32_t resolve_scope)
@@ -60,7 +60,8 @@ Breakpoint::Breakpoint(Target &target,
     m_options (),
     m_locations (*this),
     m_resolve_indirect_symbols(resolve_indirect_symbols),
-    m_hit_count(0)
+    m_hit_count(0),
+    m_modules_generation(0)
 {
     m_being_created = false;
 }
@@ -73,7 +74,8 @@ Breakpoint::Breakpoint (Target &new_target, Breakpoint &source_bp) :
     m_options (source_bp.m_options),
     m_locations(*this),
     m_resolve_indirect_symbols(source_bp.m_resolve_indirect_symbols),
-    m_hit_count(0)
+    m_hit_count(0),
+    m_modules_generation(0)
 {
     // Now go through and copy the filter & resolver:
     m_resolver_sp = source_bp.m_resolver_sp->CopyForBreakpoint(*this);
@@ -414,6 +416,8 @@ Breakpoint::ModulesChanged (ModuleList &module_list, bool load, bool delete_loca
         log->Printf ("Breakpoint::ModulesChanged: num_modules: %zu load: %i delete_locations: %i\n",
                      module_list.GetSize(), load, delete_locations);
     
+    m_modules_generation++;
+
     Mutex::Locker modules_mutex(module_list.GetMutex());
     if (load)
     {
@@ -577,6 +581,9 @@ Breakpoint::ModuleReplaced (ModuleSP old_module_sp, ModuleSP new_module_sp)
     if (log)
         log->Printf ("Breakpoint::ModulesReplaced for %s\n",
                      old_module_sp->GetSpecificationDescription().c_str());
+
+    m_modules_generation++;
+
     // First find all the locations that are in the old module
     
     BreakpointLocationCollection old_break_locs;
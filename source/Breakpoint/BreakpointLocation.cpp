@@ -52,7 +52,9 @@ BreakpointLocation::BreakpointLocation
     m_owner (owner),
     m_options_ap (),
     m_bp_site_sp (),
-    m_condition_mutex ()
+    m_condition_mutex (),
+    m_condition_hash (0),
+    m_condition_modules_generation (0)
 {
     if (check_for_resolver)
     {
@@ -276,7 +278,14 @@ BreakpointLocation::ConditionSaysStop (ExecutionContext &exe_ctx, Error &error)
         return false;
     }
     
+    // The condition is compiled once and then reused for every hit.  The
+    // compiled form can have addresses of functions and globals baked into
+    // it, so it is only thrown away when the text changes, the process
+    // changes or modules have come or gone since it was compiled.
+    const uint32_t modules_generation = m_owner.GetModulesGeneration();
+
     if (condition_hash != m_condition_hash ||
+        modules_generation != m_condition_modules_generation ||
         !m_user_expression_sp ||
         !m_user_expression_sp->MatchesContext(exe_ctx))
     {
@@ -287,10 +296,16 @@ BreakpointLocation::ConditionSaysStop (ExecutionContext &exe_ctx, Error &error)
         
         StreamString errors;
         
+        // Conditions the IR interpreter can handle are evaluated entirely in
+        // the debugger, without allocating or running anything in the
+        // inferior; the rest still get JIT compiled.  The result is read
+        // once per hit, so it doesn't need to be kept in memory.
+        const bool keep_result_in_memory = false;
+
         if (!m_user_expression_sp->Parse(errors,
                                          exe_ctx,
                                          eExecutionPolicyOnlyWhenNeeded,
-                                         true,
+                                         keep_result_in_memory,
                                          false))
         {
             error.SetErrorStringWithFormat("Couldn't parse conditional expression:\n%s",
@@ -300,6 +315,12 @@ BreakpointLocation::ConditionSaysStop (ExecutionContext &exe_ctx, Error &error)
         }
         
         m_condition_hash = condition_hash;
+        m_condition_modules_generation = modules_generation;
+
+        if (log)
+            log->Printf("Compiled condition \"%s\", it will be %s.\n",
+                        condition_text,
+                        m_user_expression_sp->CanInterpret() ? "interpreted" : "run in the process");
     }
 
     // We need to make sure the user sees any parse errors in their condition, so we'll hook the
@@ -311,6 +332,7 @@ BreakpointLocation::ConditionSaysStop (ExecutionContext &exe_ctx, Error &error)
     options.SetUnwindOnError(true);
     options.SetIgnoreBreakpoints(true);
     options.SetTryAllThreads(true);
+    options.SetResultIsInternal(true);
     
     Error expr_error;
     
@@ -325,6 +347,15 @@ BreakpointLocation::ConditionSaysStop (ExecutionContext &exe_ctx, Error &error)
                                   m_user_expression_sp,
                                   result_variable_sp);
     
+    // Don't use up a $N name and leave a persistent variable behind for
+    // every hit
+    if (result_variable_sp)
+    {
+        Target *target = exe_ctx.GetTargetPtr();
+        if (target)
+            target->GetPersistentVariables().RemovePersistentVariable(result_variable_sp);
+    }
+
     bool ret;
     
     if (result_code == eExpressionCompleted)
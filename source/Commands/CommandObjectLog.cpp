@@ -147,6 +147,7 @@ public:
             case 'n':  log_options |= LLDB_LOG_OPTION_PREPEND_THREAD_NAME;    break;
             case 'S':  log_options |= LLDB_LOG_OPTION_BACKTRACE;              break;
             case 'a':  log_options |= LLDB_LOG_OPTION_APPEND;                 break;
+            case 'A':  log_options |= LLDB_LOG_OPTION_ASYNC;                  break;
             default:
                 error.SetErrorStringWithFormat ("unrecognized option '%c'", short_option);
                 break;
@@ -225,6 +226,7 @@ CommandObjectLogEnable::CommandOptions::g_option_table[] =
 { LLDB_OPT_SET_1, false, "thread-name",'n', OptionParser::eNoArgument,       NULL, NULL, 0, eArgTypeNone,       "Prepend all log lines with the thread name for the thread that generates the log line." },
 { LLDB_OPT_SET_1, false, "stack",      'S', OptionParser::eNoArgument,       NULL, NULL, 0, eArgTypeNone,       "Append a stack backtrace to each log line." },
 { LLDB_OPT_SET_1, false, "append",     'a', OptionParser::eNoArgument,       NULL, NULL, 0, eArgTypeNone,       "Append to the log file instead of overwriting." },
+{ LLDB_OPT_SET_1, false, "async",      'A', OptionParser::eNoArgument,       NULL, NULL, 0, eArgTypeNone,       "Buffer the log lines and write them to the log file on a background thread. Lines are dropped rather than slowing down the debugger when the buffers fill up. Only used when logging to a file." },
 { 0, false, NULL,                       0,  0,                 NULL, NULL, 0, eArgTypeNone,       NULL }
 };
 
@@ -394,7 +396,7 @@ public:
         CommandObjectParsed (interpreter,
                            "log timers",
                            "Enable, disable, dump, and reset LLDB internal performance timers.",
-                           "log timers < enable <depth> | disable | dump | increment <bool> | reset >")
+                           "log timers < enable <depth> | disable | dump [json] | increment <bool> | reset >")
     {
     }
 
@@ -454,7 +456,18 @@ protected:
                 else
                     result.AppendError("Could not convert enable depth to an unsigned integer.");
             }
-            if (strcasecmp(sub_command, "increment") == 0)
+            else if (strcasecmp(sub_command, "dump") == 0)
+            {
+                if (strcasecmp(args.GetArgumentAtIndex(1), "json") == 0)
+                {
+                    Timer::DumpCategoryTimesAsJSON (&result.GetOutputStream());
+                    result.GetOutputStream().EOL();
+                    result.SetStatus(eReturnStatusSuccessFinishResult);
+                }
+                else
+                    result.AppendErrorWithFormat("Unknown timer dump format '%s'.", args.GetArgumentAtIndex(1));
+            }
+            else if (strcasecmp(sub_command, "increment") == 0)
             {
                 bool success;
                 bool increment = Args::StringToBoolean(args.GetArgumentAtIndex(1), false, &success);
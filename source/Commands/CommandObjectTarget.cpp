@@ -13,11 +13,13 @@
 
 // C Includes
 #include <errno.h>
+#include <stdlib.h>
 
 // C++ Includes
 // Other libraries and framework includes
 // Project includes
 #include "lldb/Interpreter/Args.h"
+#include "lldb/Core/DataBuffer.h"
 #include "lldb/Core/Debugger.h"
 #include "lldb/Core/IOHandler.h"
 #include "lldb/Core/Module.h"
@@ -54,6 +56,7 @@
 #include "lldb/Target/Process.h"
 #include "lldb/Target/SectionLoadList.h"
 #include "lldb/Target/StackFrame.h"
+#include "lldb/Target/Symbolicator.h"
 #include "lldb/Target/Thread.h"
 #include "lldb/Target/ThreadSpec.h"
 
@@ -4844,6 +4847,163 @@ private:
 };
 
 
+#pragma mark CommandObjectTargetSymbolicate
+
+//-------------------------------------------------------------------------
+// CommandObjectTargetSymbolicate
+//-------------------------------------------------------------------------
+
+class CommandObjectTargetSymbolicate : public CommandObjectParsed
+{
+public:
+    CommandObjectTargetSymbolicate (CommandInterpreter &interpreter) :
+        CommandObjectParsed (interpreter,
+                             "target symbolicate",
+                             "Look up the module, symbol and source line of every load address in a file. "
+                             "The file has one address per line, in hex with a '0x' prefix or in decimal. "
+                             "Large numbers of addresses are resolved much faster than with 'image lookup --address'.",
+                             NULL,
+                             eFlagRequiresTarget),
+        m_option_group (interpreter),
+        m_threads_option (LLDB_OPT_SET_1, false, "threads", 't', 0, eArgTypeCount, "The most threads to resolve addresses with, or zero to pick a number based on the host.", 0)
+    {
+        CommandArgumentEntry arg;
+        CommandArgumentData file_arg;
+
+        file_arg.arg_type = eArgTypeFilename;
+        file_arg.arg_repetition = eArgRepeatPlain;
+        arg.push_back (file_arg);
+        m_arguments.push_back (arg);
+
+        m_option_group.Append (&m_threads_option, LLDB_OPT_SET_ALL, LLDB_OPT_SET_1);
+        m_option_group.Finalize();
+    }
+
+    virtual
+    ~CommandObjectTargetSymbolicate ()
+    {
+    }
+
+    virtual Options *
+    GetOptions ()
+    {
+        return &m_option_group;
+    }
+
+    virtual int
+    HandleArgumentCompletion (Args &input,
+                              int &cursor_index,
+                              int &cursor_char_position,
+                              OptionElementVector &opt_element_vector,
+                              int match_start_point,
+                              int max_return_elements,
+                              bool &word_complete,
+                              StringList &matches)
+    {
+        std::string completion_str (input.GetArgumentAtIndex(cursor_index));
+        completion_str.erase (cursor_char_position);
+
+        CommandCompletions::InvokeCommonCompletionCallbacks (m_interpreter,
+                                                             CommandCompletions::eDiskFileCompletion,
+                                                             completion_str.c_str(),
+                                                             match_start_point,
+                                                             max_return_elements,
+                                                             NULL,
+                                                             word_complete,
+                                                             matches);
+        return matches.GetSize();
+    }
+
+protected:
+    virtual bool
+    DoExecute (Args& command,
+               CommandReturnObject &result)
+    {
+        Target *target = m_exe_ctx.GetTargetPtr();
+        if (command.GetArgumentCount() != 1)
+        {
+            result.AppendErrorWithFormat ("'%s' takes exactly one address file argument.\n", m_cmd_name.c_str());
+            result.SetStatus (eReturnStatusFailed);
+            return false;
+        }
+
+        FileSpec address_file (command.GetArgumentAtIndex(0), true);
+        Error error;
+        DataBufferSP data_sp (address_file.ReadFileContentsAsCString (&error));
+        if (!data_sp)
+        {
+            result.AppendErrorWithFormat ("unable to read '%s': %s\n",
+                                          command.GetArgumentAtIndex(0),
+                                          error.AsCString("unknown error"));
+            result.SetStatus (eReturnStatusFailed);
+            return false;
+        }
+
+        std::vector<addr_t> load_addrs;
+        const char *p = (const char *)data_sp->GetBytes();
+        for (uint32_t line_num = 1; *p; ++line_num)
+        {
+            while (*p == ' ' || *p == '\t' || *p == '\r')
+                ++p;
+            if (*p != '\n' && *p != '\0')
+            {
+                char *end = NULL;
+                errno = 0;
+                const addr_t load_addr = ::strtoull (p, &end, 0);
+                while (*end == ' ' || *end == '\t' || *end == '\r')
+                    ++end;
+                if (end == p || errno != 0 || (*end != '\n' && *end != '\0'))
+                {
+                    result.AppendErrorWithFormat ("invalid address on line %u of '%s'\n",
+                                                  line_num,
+                                                  command.GetArgumentAtIndex(0));
+                    result.SetStatus (eReturnStatusFailed);
+                    return false;
+                }
+                load_addrs.push_back (load_addr);
+                p = end;
+            }
+            if (*p == '\n')
+                ++p;
+        }
+
+        Symbolicator symbolicator;
+        symbolicator.Symbolicate (*target,
+                                  load_addrs.data(),
+                                  load_addrs.size(),
+                                  m_threads_option.GetOptionValue().GetCurrentValue());
+
+        Stream &strm = result.GetOutputStream();
+        const uint32_t addr_width = target->GetArchitecture().GetAddressByteSize() * 2;
+        const size_t num_entries = symbolicator.GetSize();
+        for (size_t i = 0; i < num_entries; ++i)
+        {
+            const Symbolicator::Entry &entry = symbolicator.GetEntryAtIndex(i);
+            strm.Printf ("0x%*.*" PRIx64, addr_width, addr_width, entry.load_addr);
+            ModuleSP module_sp (symbolicator.GetModuleForEntry (entry));
+            if (module_sp)
+            {
+                strm.Printf (" %s", module_sp->GetFileSpec().GetFilename().AsCString("<unknown>"));
+                if (entry.symbol_name)
+                    strm.Printf ("`%s + %" PRIu64, entry.symbol_name.GetCString(), entry.symbol_offset);
+                if (entry.line != 0)
+                {
+                    strm.Printf (" at %s:%u", entry.file.GetFilename().AsCString("<unknown>"), entry.line);
+                    if (entry.column != 0)
+                        strm.Printf (":%u", entry.column);
+                }
+            }
+            strm.EOL();
+        }
+        result.SetStatus (eReturnStatusSuccessFinishResult);
+        return result.Succeeded();
+    }
+
+    OptionGroupOptions m_option_group;
+    OptionGroupUInt64 m_threads_option;
+};
+
+
 #pragma mark CommandObjectTargetStopHookAdd
 
 //-------------------------------------------------------------------------
@@ -5462,6 +5622,7 @@ CommandObjectMultiwordTarget::CommandObjectMultiwordTarget (CommandInterpreter &
     LoadSubCommand ("select",    CommandObjectSP (new CommandObjectTargetSelect (interpreter)));
     LoadSubCommand ("stop-hook", CommandObjectSP (new CommandObjectMultiwordTargetStopHooks (interpreter)));
     LoadSubCommand ("modules",   CommandObjectSP (new CommandObjectTargetModules (interpreter)));
+    LoadSubCommand ("symbolicate", CommandObjectSP (new CommandObjectTargetSymbolicate (interpreter)));
     LoadSubCommand ("symbols",   CommandObjectSP (new CommandObjectTargetSymbols (interpreter)));
     LoadSubCommand ("variable",  CommandObjectSP (new CommandObjectTargetVariable (interpreter)));
 }
@@ -75,6 +75,7 @@ public:
         else if (command.GetArgumentCount() == 1 && ::strcmp (command.GetArgumentAtIndex(0), "all") == 0)
         {
             Process *process = m_exe_ctx.GetProcessPtr();
+            WillHandleAllThreads (*process);
             uint32_t idx = 0;
             for (ThreadSP thread_sp : process->Threads())
             {
@@ -140,6 +141,13 @@ protected:
     virtual bool
     HandleOneThread (Thread &thread, CommandReturnObject &result) = 0;
 
+    // Called before HandleOneThread is called for every thread in "process", so
+    // work for all the threads can be done up front.
+    virtual void
+    WillHandleAllThreads (Process &process)
+    {
+    }
+
     ReturnStatus m_success_return = eReturnStatusSuccessFinishResult;
     bool m_add_return = true;
 
@@ -287,6 +295,17 @@ protected:
         }
     }
 
+    virtual void
+    WillHandleAllThreads (Process &process)
+    {
+        // Unwind all the threads at once, the backtraces are then printed in
+        // order from the frames that were computed.
+        uint32_t num_frames = UINT32_MAX;
+        if (m_options.m_count != UINT32_MAX && m_options.m_start < UINT32_MAX - m_options.m_count)
+            num_frames = m_options.m_start + m_options.m_count;
+        process.GetThreadList().PrefetchStackFrames (num_frames);
+    }
+
     virtual bool
     HandleOneThread (Thread &thread, CommandReturnObject &result)
     {
@@ -26,6 +26,7 @@ Broadcaster::Broadcaster (BroadcasterManager *manager, const char *name) :
     m_listeners_mutex (Mutex::eMutexTypeRecursive),
     m_hijacking_listeners(),
     m_hijacking_masks(),
+    m_listened_event_mask (0),
     m_manager (manager)
 {
     Log *log(lldb_private::GetLogIfAllCategoriesSet (LIBLLDB_LOG_OBJECT));
@@ -67,6 +68,7 @@ Broadcaster::Clear()
         pos->first->BroadcasterWillDestruct (this);
     
     m_listeners.clear();
+    UpdateListenedEventMask ();
 }
 const ConstString &
 Broadcaster::GetBroadcasterName ()
@@ -149,6 +151,7 @@ Broadcaster::AddListener (Listener* listener, uint32_t event_mask)
             // Grant the existing listener the available event bits
             existing_pos->second |= available_event_types;
         }
+        UpdateListenedEventMask ();
 
         // Individual broadcasters decide whether they have outstanding data when a
         // listener attaches, and insert it into the listener with this method.
@@ -163,21 +166,19 @@ Broadcaster::AddListener (Listener* listener, uint32_t event_mask)
 bool
 Broadcaster::EventTypeHasListeners (uint32_t event_type)
 {
-    Mutex::Locker locker (m_listeners_mutex);
-    
-    if (m_hijacking_listeners.size() > 0 && event_type & m_hijacking_masks.back())
-        return true;
-        
-    if (m_listeners.empty())
-        return false;
+    return (m_listened_event_mask & event_type) != 0;
+}
 
-    collection::iterator pos, end = m_listeners.end();
+void
+Broadcaster::UpdateListenedEventMask ()
+{
+    uint32_t event_mask = 0;
+    if (!m_hijacking_masks.empty())
+        event_mask = m_hijacking_masks.back();
+    collection::const_iterator pos, end = m_listeners.end();
     for (pos = m_listeners.begin(); pos != end; ++pos)
-    {
-        if (pos->second & event_type)
-            return true;
-    }
-    return false;
+        event_mask |= pos->second;
+    m_listened_event_mask = event_mask;
 }
 
 bool
@@ -195,6 +196,7 @@ Broadcaster::RemoveListener (Listener* listener, uint32_t event_mask)
             // If all bits have been relinquished then remove this listener
             if (pos->second == 0)
                 m_listeners.erase (pos);
+            UpdateListenedEventMask ();
             return true;
         }
     }
@@ -225,6 +227,11 @@ Broadcaster::PrivateBroadcastEvent (EventSP &event_sp, bool unique)
 
     const uint32_t event_type = event_sp->GetType();
 
+    // Most broadcasts, like STDIO and thread events in a process nobody
+    // asked about, have no listeners. Drop them without taking the lock.
+    if ((m_listened_event_mask & event_type) == 0)
+        return;
+
     Mutex::Locker event_types_locker(m_listeners_mutex);
 
     Listener *hijacking_listener = NULL;
@@ -299,6 +306,7 @@ Broadcaster::HijackBroadcaster (Listener *listener, uint32_t event_mask)
                      listener->m_name.c_str(), static_cast<void*>(listener));
     m_hijacking_listeners.push_back(listener);
     m_hijacking_masks.push_back(event_mask);
+    UpdateListenedEventMask ();
     return true;
 }
 
@@ -332,6 +340,7 @@ Broadcaster::RestoreBroadcaster ()
     }
     if (!m_hijacking_masks.empty())
         m_hijacking_masks.pop_back();
+    UpdateListenedEventMask ();
 }
 
 ConstString &
@@ -9,6 +9,7 @@
 #include "lldb/Core/ConstString.h"
 #include "lldb/Core/Stream.h"
 #include "lldb/Host/Mutex.h"
+#include "llvm/ADT/StringExtras.h"
 #include "llvm/ADT/StringMap.h"
 
 #include <mutex> // std::once
@@ -22,15 +23,22 @@ public:
     typedef const char * StringPoolValueType;
     typedef llvm::StringMap<StringPoolValueType, llvm::BumpPtrAllocator> StringPool;
     typedef llvm::StringMapEntry<StringPoolValueType> StringPoolEntryType;
-    
+
+    //------------------------------------------------------------------
+    // The pool is split into a number of independently locked shards
+    // that are selected by hashing the string contents. A given string
+    // always hashes to the same shard, so each string still has a single
+    // unique entry and pointer identity is preserved, but threads that
+    // are uniquing different strings rarely contend for the same lock.
+    //------------------------------------------------------------------
+    enum { kNumShards = 256 };
+
     //------------------------------------------------------------------
     // Default constructor
     //
     // Initialize the member variables and create the empty string.
     //------------------------------------------------------------------
-    Pool () :
-        m_mutex (Mutex::eMutexTypeRecursive),
-        m_string_map ()
+    Pool ()
     {
     }
 
@@ -54,6 +62,8 @@ public:
     {
         if (ccstr)
         {
+            // The key of an entry never changes once it has been inserted
+            // so no locking is needed to get its length.
             const StringPoolEntryType&entry = GetStringMapEntryFromKeyData (ccstr);
             return entry.getKey().size();
         }
@@ -64,7 +74,11 @@ public:
     GetMangledCounterpart (const char *ccstr) const
     {
         if (ccstr)
+        {
+            const PoolShard &shard = GetShardForConstCString (ccstr);
+            Mutex::Locker locker (shard.m_mutex);
             return GetStringMapEntryFromKeyData (ccstr).getValue();
+        }
         return 0;
     }
 
@@ -73,8 +87,8 @@ public:
     {
         if (key_ccstr && value_ccstr)
         {
-            GetStringMapEntryFromKeyData (key_ccstr).setValue(value_ccstr);
-            GetStringMapEntryFromKeyData (value_ccstr).setValue(key_ccstr);
+            SetMangledCounterpart (key_ccstr, value_ccstr);
+            SetMangledCounterpart (value_ccstr, key_ccstr);
             return true;
         }
         return false;
@@ -92,12 +106,7 @@ public:
     GetConstCStringWithLength (const char *cstr, size_t cstr_len)
     {
         if (cstr)
-        {
-            Mutex::Locker locker (m_mutex);
-            llvm::StringRef string_ref (cstr, cstr_len);
-            StringPoolEntryType& entry = *m_string_map.insert (std::make_pair (string_ref, (StringPoolValueType)NULL)).first;
-            return entry.getKeyData();
-        }
+            return GetConstCStringWithStringRef (llvm::StringRef (cstr, cstr_len));
         return NULL;
     }
 
@@ -106,8 +115,9 @@ public:
     {
         if (string_ref.data())
         {
-            Mutex::Locker locker (m_mutex);
-            StringPoolEntryType& entry = *m_string_map.insert (std::make_pair (string_ref, (StringPoolValueType)NULL)).first;
+            PoolShard &shard = GetShardForString (string_ref);
+            Mutex::Locker locker (shard.m_mutex);
+            StringPoolEntryType& entry = *shard.m_string_map.insert (std::make_pair (string_ref, (StringPoolValueType)NULL)).first;
             return entry.getKeyData();
         }
         return NULL;
@@ -118,15 +128,24 @@ public:
     {
         if (demangled_cstr)
         {
-            Mutex::Locker locker (m_mutex);
-            // Make string pool entry with the mangled counterpart already set
-            StringPoolEntryType& entry = *m_string_map.insert (std::make_pair (llvm::StringRef (demangled_cstr), mangled_ccstr)).first;
+            const char *demangled_ccstr = NULL;
+            {
+                llvm::StringRef string_ref (demangled_cstr);
+                PoolShard &shard = GetShardForString (string_ref);
+                Mutex::Locker locker (shard.m_mutex);
+                // Make string pool entry with the mangled counterpart already set
+                StringPoolEntryType& entry = *shard.m_string_map.insert (std::make_pair (string_ref, mangled_ccstr)).first;
+
+                // Extract the const version of the demangled_cstr
+                demangled_ccstr = entry.getKeyData();
+            }
 
-            // Extract the const version of the demangled_cstr
-            const char *demangled_ccstr = entry.getKeyData();
             // Now assign the demangled const string as the counterpart of the
-            // mangled const string...
-            GetStringMapEntryFromKeyData (mangled_ccstr).setValue(demangled_ccstr);
+            // mangled const string. The mangled string may live in another
+            // shard, so this is done after the first lock has been released
+            // to avoid having to order the shard locks.
+            SetMangledCounterpart (mangled_ccstr, demangled_ccstr);
+
             // Return the constant demangled C string
             return demangled_ccstr;
         }
@@ -147,17 +166,35 @@ public:
     //------------------------------------------------------------------
     // Return the size in bytes that this object and any items in its
     // collection of uniqued strings + data count values takes in
-    // memory.
+    // memory. If "shard_stats" is not NULL, it is filled in with the
+    // number of strings and the memory used by each shard.
     //------------------------------------------------------------------
     size_t
-    MemorySize() const
+    MemorySize (std::vector<ConstString::PoolShardStats> *shard_stats) const
     {
-        Mutex::Locker locker (m_mutex);
         size_t mem_size = sizeof(Pool);
-        const_iterator end = m_string_map.end();
-        for (const_iterator pos = m_string_map.begin(); pos != end; ++pos)
+        if (shard_stats)
         {
-            mem_size += sizeof(StringPoolEntryType) + pos->getKey().size();
+            shard_stats->clear();
+            shard_stats->reserve (kNumShards);
+        }
+        for (const PoolShard &shard : m_shards)
+        {
+            Mutex::Locker locker (shard.m_mutex);
+            size_t shard_mem_size = 0;
+            const_iterator end = shard.m_string_map.end();
+            for (const_iterator pos = shard.m_string_map.begin(); pos != end; ++pos)
+            {
+                shard_mem_size += sizeof(StringPoolEntryType) + pos->getKey().size();
+            }
+            mem_size += shard_mem_size;
+            if (shard_stats)
+            {
+                ConstString::PoolShardStats stats;
+                stats.num_strings = shard.m_string_map.size();
+                stats.memory_size = shard_mem_size;
+                shard_stats->push_back (stats);
+            }
         }
         return mem_size;
     }
@@ -169,11 +206,49 @@ protected:
     typedef StringPool::iterator iterator;
     typedef StringPool::const_iterator const_iterator;
 
+    struct PoolShard
+    {
+        PoolShard () :
+            m_mutex (Mutex::eMutexTypeNormal),
+            m_string_map ()
+        {
+        }
+
+        mutable Mutex m_mutex;
+        StringPool m_string_map;    // Each map owns its own BumpPtrAllocator
+    };
+
+    static uint8_t
+    GetShardIndex (const llvm::StringRef &string_ref)
+    {
+        const uint32_t h = llvm::HashString (string_ref);
+        return ((h >> 24) ^ (h >> 16) ^ (h >> 8) ^ h) & 0xff;
+    }
+
+    PoolShard &
+    GetShardForString (const llvm::StringRef &string_ref)
+    {
+        return m_shards[GetShardIndex (string_ref)];
+    }
+
+    const PoolShard &
+    GetShardForConstCString (const char *ccstr) const
+    {
+        return m_shards[GetShardIndex (GetStringMapEntryFromKeyData (ccstr).getKey())];
+    }
+
+    void
+    SetMangledCounterpart (const char *key_ccstr, const char *value_ccstr)
+    {
+        const PoolShard &shard = GetShardForConstCString (key_ccstr);
+        Mutex::Locker locker (shard.m_mutex);
+        GetStringMapEntryFromKeyData (key_ccstr).setValue(value_ccstr);
+    }
+
     //------------------------------------------------------------------
     // Member variables
     //------------------------------------------------------------------
-    mutable Mutex m_mutex;
-    StringPool m_string_map;
+    PoolShard m_shards[kNumShards];
 };
 
 //----------------------------------------------------------------------
@@ -331,8 +406,8 @@ ConstString::SetTrimmedCStringWithLength (const char *cstr, size_t cstr_len)
 }
 
 size_t
-ConstString::StaticMemorySize()
+ConstString::StaticMemorySize(std::vector<PoolShardStats> *shard_stats)
 {
     // Get the size of the static string pool
-    return StringPool().MemorySize();
+    return StringPool().MemorySize(shard_stats);
 }
@@ -23,6 +23,7 @@
 #include "lldb/Core/PluginManager.h"
 #include "lldb/Core/RegisterValue.h"
 #include "lldb/Core/State.h"
+#include "lldb/Core/StreamAsyncLog.h"
 #include "lldb/Core/StreamAsynchronousIO.h"
 #include "lldb/Core/StreamCallback.h"
 #include "lldb/Core/StreamFile.h"
@@ -1301,6 +1302,12 @@ Debugger::EnableLog (const char *channel, const char **categories, const char *l
     Log::Callbacks log_callbacks;
 
     StreamSP log_stream_sp;
+    if (m_log_callback_stream_sp || log_file == NULL || *log_file == '\0')
+    {
+        // Only log files get a drain thread
+        log_options &= ~LLDB_LOG_OPTION_ASYNC;
+    }
+
     if (m_log_callback_stream_sp)
     {
         log_stream_sp = m_log_callback_stream_sp;
@@ -1326,6 +1333,30 @@ Debugger::EnableLog (const char *channel, const char **categories, const char *l
             log_stream_sp.reset (new StreamFile (log_file, options));
             m_log_streams[log_file] = log_stream_sp;
         }
+
+        if (log_options & LLDB_LOG_OPTION_ASYNC)
+        {
+            // All the channels logging to this file asynchronously share one
+            // drain thread, and timestamps are on for all of them once any
+            // of them asks for timestamps
+            std::shared_ptr<StreamAsyncLog> async_stream_sp;
+            AsyncLogStreamMap::iterator async_pos = m_async_log_streams.find(log_file);
+            if (async_pos != m_async_log_streams.end())
+                async_stream_sp = async_pos->second.lock();
+            if (!async_stream_sp)
+            {
+                async_stream_sp.reset (new StreamAsyncLog (log_stream_sp));
+                if (!async_stream_sp->StartDrainThread())
+                {
+                    error_stream.Printf ("Unable to start the asynchronous log thread for '%s'.\n", log_file);
+                    return false;
+                }
+                m_async_log_streams[log_file] = async_stream_sp;
+            }
+            if (log_options & LLDB_LOG_OPTION_PREPEND_TIMESTAMP)
+                async_stream_sp->SetPrependTimestamps (true);
+            log_stream_sp = async_stream_sp;
+        }
     }
     assert (log_stream_sp.get());
     
@@ -13,6 +13,9 @@
 
 // C Includes
 // C++ Includes
+#include <list>
+#include <map>
+
 // Other libraries and framework includes
 // Project includes
 #include "lldb/lldb-private.h"
@@ -24,7 +27,9 @@
 #include "lldb/Core/Module.h"
 #include "lldb/Core/PluginManager.h"
 #include "lldb/Core/RegularExpression.h"
+#include "lldb/Core/Section.h"
 #include "lldb/Core/Timer.h"
+#include "lldb/Host/Mutex.h"
 #include "lldb/Interpreter/OptionValue.h"
 #include "lldb/Interpreter/OptionValueArray.h"
 #include "lldb/Interpreter/OptionValueDictionary.h"
@@ -80,8 +85,8 @@ Disassembler::FindPlugin (const ArchSpec &arch, const char *flavor, const char *
     return DisassemblerSP();
 }
 
-DisassemblerSP
-Disassembler::FindPluginForTarget(const TargetSP target_sp, const ArchSpec &arch, const char *flavor, const char *plugin_name)
+static const char *
+GetFlavorForTarget (const TargetSP &target_sp, const ArchSpec &arch, const char *flavor)
 {
     if (target_sp && flavor == NULL)
     {
@@ -91,7 +96,272 @@ Disassembler::FindPluginForTarget(const TargetSP target_sp, const ArchSpec &arch
             || arch.GetTriple().getArch() == llvm::Triple::x86_64)
            flavor = target_sp->GetDisassemblyFlavor();
     }
-    return FindPlugin(arch, flavor, plugin_name);
+    return flavor;
+}
+
+DisassemblerSP
+Disassembler::FindPluginForTarget(const TargetSP target_sp, const ArchSpec &arch, const char *flavor, const char *plugin_name)
+{
+    return FindPlugin(arch, GetFlavorForTarget (target_sp, arch, flavor), plugin_name);
+}
+
+namespace
+{
+    //----------------------------------------------------------------------
+    // The instructions a disassembler decodes hold a reference back to it,
+    // so a disassembler never goes away unless its instruction list is
+    // cleared. This holds a disassembler for the pointers we hand out and
+    // clears the list when the last of them goes away.
+    //----------------------------------------------------------------------
+    struct InstructionListOwner
+    {
+        InstructionListOwner (const DisassemblerSP &disasm_sp) :
+            m_disasm_sp (disasm_sp)
+        {
+        }
+
+        ~InstructionListOwner ()
+        {
+            m_disasm_sp->GetInstructionList().Clear();
+        }
+
+        DisassemblerSP m_disasm_sp;
+    };
+
+    DisassemblerSP
+    MakeOwnedDisassembler (const DisassemblerSP &disasm_sp)
+    {
+        std::shared_ptr<InstructionListOwner> owner_sp (new InstructionListOwner (disasm_sp));
+        return DisassemblerSP (owner_sp, disasm_sp.get());
+    }
+
+    //----------------------------------------------------------------------
+    // A bounded cache of decoded module code, keyed by module and file
+    // address range. Stepping and the instruction emulation unwinder
+    // disassemble the same functions over and over, and since they only
+    // look at code from the object file the result can be shared. Entries
+    // are evicted least recently used first once they hold more than
+    // kMaxInstructions, and all of a module's entries are dropped when it
+    // is unloaded or destroyed.
+    //----------------------------------------------------------------------
+    class InstructionCache
+    {
+    public:
+        static InstructionCache &
+        GetSharedCache ()
+        {
+            // Never destroyed, since modules can outlive static destructors
+            static InstructionCache *g_cache = new InstructionCache();
+            return *g_cache;
+        }
+
+        DisassemblerSP
+        GetDisassembler (const ArchSpec &arch,
+                         const char *plugin_name,
+                         const char *flavor,
+                         const TargetSP &target_sp,
+                         const AddressRange &range);
+
+        void
+        RemoveModule (const Module *module);
+
+    private:
+        enum { kMaxInstructions = 128 * 1024 };
+
+        struct Key
+        {
+            const Module *module;
+            addr_t file_addr;
+            addr_t byte_size;
+            std::string triple;
+            std::string flavor;
+            std::string plugin_name;
+
+            bool
+            operator < (const Key &rhs) const
+            {
+                if (module != rhs.module)
+                    return module < rhs.module;
+                if (file_addr != rhs.file_addr)
+                    return file_addr < rhs.file_addr;
+                if (byte_size != rhs.byte_size)
+                    return byte_size < rhs.byte_size;
+                if (triple != rhs.triple)
+                    return triple < rhs.triple;
+                if (flavor != rhs.flavor)
+                    return flavor < rhs.flavor;
+                return plugin_name < rhs.plugin_name;
+            }
+        };
+
+        // Most recently used entries are at the front
+        typedef std::list<std::pair<Key, DisassemblerSP> > EntryList;
+        typedef std::map<Key, EntryList::iterator> EntryMap;
+
+        InstructionCache () :
+            m_mutex (Mutex::eMutexTypeNormal),
+            m_entries (),
+            m_entry_map (),
+            m_num_instructions (0)
+        {
+        }
+
+        static DisassemblerSP
+        DecodeFromObjectFile (const ArchSpec &arch,
+                              const char *plugin_name,
+                              const char *flavor,
+                              const AddressRange &range);
+
+        void
+        EvictIfNeeded ();
+
+        Mutex m_mutex;
+        EntryList m_entries;
+        EntryMap m_entry_map;
+        size_t m_num_instructions;
+    };
+
+    DisassemblerSP
+    InstructionCache::GetDisassembler (const ArchSpec &arch,
+                                       const char *plugin_name,
+                                       const char *flavor,
+                                       const TargetSP &target_sp,
+                                       const AddressRange &range)
+    {
+        const Address &base_addr = range.GetBaseAddress();
+        ModuleSP module_sp (base_addr.GetModule());
+        if (!module_sp || !base_addr.IsSectionOffset())
+            return DisassemblerSP();
+
+        flavor = GetFlavorForTarget (target_sp, arch, flavor);
+
+        Key key;
+        key.module = module_sp.get();
+        key.file_addr = base_addr.GetFileAddress();
+        key.byte_size = range.GetByteSize();
+        key.triple = arch.GetTriple().getTriple();
+        key.flavor = flavor ? flavor : "";
+        key.plugin_name = plugin_name ? plugin_name : "";
+
+        {
+            Mutex::Locker locker (m_mutex);
+            EntryMap::iterator pos = m_entry_map.find (key);
+            if (pos != m_entry_map.end())
+            {
+                m_entries.splice (m_entries.begin(), m_entries, pos->second);
+                return pos->second->second;
+            }
+        }
+
+        // Decode without the lock so other threads unwinding or stepping
+        // through different code don't wait on us
+        DisassemblerSP disasm_sp (DecodeFromObjectFile (arch, plugin_name, flavor, range));
+        if (!disasm_sp)
+            return disasm_sp;
+
+        Mutex::Locker locker (m_mutex);
+        EntryMap::iterator pos = m_entry_map.find (key);
+        if (pos != m_entry_map.end())
+        {
+            // Another thread decoded the same range first
+            m_entries.splice (m_entries.begin(), m_entries, pos->second);
+            return pos->second->second;
+        }
+        m_entries.push_front (std::make_pair (key, disasm_sp));
+        m_entry_map[key] = m_entries.begin();
+        m_num_instructions += disasm_sp->GetInstructionList().GetSize();
+        EvictIfNeeded ();
+        return disasm_sp;
+    }
+
+    void
+    InstructionCache::RemoveModule (const Module *module)
+    {
+        Mutex::Locker locker (m_mutex);
+        EntryList::iterator pos = m_entries.begin();
+        while (pos != m_entries.end())
+        {
+            if (pos->first.module == module)
+            {
+                m_num_instructions -= pos->second->GetInstructionList().GetSize();
+                m_entry_map.erase (pos->first);
+                pos = m_entries.erase (pos);
+            }
+            else
+                ++pos;
+        }
+    }
+
+    DisassemblerSP
+    InstructionCache::DecodeFromObjectFile (const ArchSpec &arch,
+                                            const char *plugin_name,
+                                            const char *flavor,
+                                            const AddressRange &range)
+    {
+        // Only cache code we can read from the object file itself. Code read
+        // from memory can change under us, and the file never has any of our
+        // breakpoint opcodes in it.
+        const Address &base_addr = range.GetBaseAddress();
+        SectionSP section_sp (base_addr.GetSection());
+        if (!section_sp || section_sp->IsEncrypted())
+            return DisassemblerSP();
+        const addr_t byte_size = range.GetByteSize();
+        if (base_addr.GetOffset() + byte_size > section_sp->GetByteSize())
+            return DisassemblerSP();
+        ModuleSP module_sp (section_sp->GetModule());
+        ObjectFile *objfile = module_sp ? module_sp->GetObjectFile() : NULL;
+        if (objfile == NULL || objfile->IsInMemory())
+            return DisassemblerSP();
+
+        DataBufferHeap *heap_buffer = new DataBufferHeap (byte_size, '\0');
+        DataBufferSP data_sp (heap_buffer);
+        if (objfile->ReadSectionData (section_sp.get(), base_addr.GetOffset(), heap_buffer->GetBytes(), byte_size) != byte_size)
+            return DisassemblerSP();
+
+        DisassemblerSP disasm_sp (Disassembler::FindPlugin (arch, flavor, plugin_name));
+        if (!disasm_sp)
+            return disasm_sp;
+        DataExtractor data (data_sp, arch.GetByteOrder(), arch.GetAddressByteSize());
+        const bool append = false;
+        const bool data_from_file = true;
+        if (disasm_sp->DecodeInstructions (base_addr, data, 0, UINT32_MAX, append, data_from_file) == 0)
+            return DisassemblerSP();
+
+        // Once the list is in the cache any number of threads can read it at
+        // once, so fill in everything the instructions would otherwise work
+        // out lazily while only this thread can see them. Without an
+        // execution context the strings use the default immediate style and
+        // have no symbol comments, which is all stepping and unwinding need.
+        InstructionList &inst_list = disasm_sp->GetInstructionList();
+        const size_t num_instructions = inst_list.GetSize();
+        for (size_t i = 0; i < num_instructions; ++i)
+        {
+            InstructionSP inst_sp (inst_list.GetInstructionAtIndex (i));
+            inst_sp->GetAddressClass ();
+            inst_sp->GetMnemonic (NULL);
+            inst_sp->DoesBranch ();
+        }
+        return MakeOwnedDisassembler (disasm_sp);
+    }
+
+    void
+    InstructionCache::EvictIfNeeded ()
+    {
+        // Always keep the entry we just added
+        while (m_num_instructions > kMaxInstructions && m_entries.size() > 1)
+        {
+            EntryList::iterator last = --m_entries.end();
+            m_num_instructions -= last->second->GetInstructionList().GetSize();
+            m_entry_map.erase (last->first);
+            m_entries.erase (last);
+        }
+    }
+}
+
+void
+Disassembler::RemoveCachedInstructions (const Module *module)
+{
+    InstructionCache::GetSharedCache().RemoveModule (module);
 }
 
 
@@ -243,6 +513,15 @@ Disassembler::DisassembleRange
     lldb::DisassemblerSP disasm_sp;
     if (range.GetByteSize() > 0 && range.GetBaseAddress().IsValid())
     {
+        // Callers that are happy with the object file's contents can share
+        // what was decoded for them before
+        if (prefer_file_cache)
+        {
+            disasm_sp = InstructionCache::GetSharedCache().GetDisassembler (arch, plugin_name, flavor, exe_ctx.GetTargetSP(), range);
+            if (disasm_sp)
+                return disasm_sp;
+        }
+
         disasm_sp = Disassembler::FindPluginForTarget(exe_ctx.GetTargetSP(), arch, flavor, plugin_name);
 
         if (disasm_sp)
@@ -250,6 +529,8 @@ Disassembler::DisassembleRange
             size_t bytes_disassembled = disasm_sp->ParseInstructions (&exe_ctx, range, NULL, prefer_file_cache);
             if (bytes_disassembled == 0)
                 disasm_sp.reset();
+            else
+                disasm_sp = MakeOwnedDisassembler (disasm_sp);
         }
     }
     return disasm_sp;
@@ -199,7 +199,9 @@ Listener::AddEvent (EventSP &event_sp)
         Mutex::Locker locker(m_events_mutex);
         m_events.push_back (event_sp);
     }
-    m_cond_wait.SetValue (true, eBroadcastAlways);
+    // Waiters only block while the value is false, so there is nobody to
+    // wake up if earlier events are still waiting to be consumed
+    m_cond_wait.SetValue (true, eBroadcastOnChange);
 }
 
 class EventBroadcasterMatches
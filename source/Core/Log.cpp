@@ -115,8 +115,9 @@ Log::VAPrintf(const char *format, va_list args)
         if (m_options.Test (LLDB_LOG_OPTION_PREPEND_SEQUENCE))
             header.Printf ("%u ", ++g_sequence_id);
 
-        // Timestamp if requested
-        if (m_options.Test (LLDB_LOG_OPTION_PREPEND_TIMESTAMP))
+        // Timestamp if requested. Asynchronous log streams stamp the
+        // records themselves and format the time when they write them out.
+        if (m_options.Test (LLDB_LOG_OPTION_PREPEND_TIMESTAMP) && !m_options.Test (LLDB_LOG_OPTION_ASYNC))
         {
             TimeValue now = TimeValue::Now();
             header.Printf ("%9d.%6.6d ", now.seconds(), now.nanoseconds());
@@ -146,7 +147,13 @@ Log::VAPrintf(const char *format, va_list args)
             header.PutCString(back_trace.c_str());
         }
 
-        if (m_options.Test(LLDB_LOG_OPTION_THREADSAFE))
+        if (m_options.Test(LLDB_LOG_OPTION_ASYNC))
+        {
+            // The stream queues the record for its drain thread without
+            // locking, and there is nothing to flush
+            stream_sp->PutCString(header.GetString().c_str());
+        }
+        else if (m_options.Test(LLDB_LOG_OPTION_THREADSAFE))
         {
             static Mutex g_LogThreadedMutex(Mutex::eMutexTypeRecursive);
             Mutex::Locker locker(g_LogThreadedMutex);
@@ -9,6 +9,7 @@
 
 #include "lldb/Core/Stream.h"
 #include "lldb/Host/Endian.h"
+#include "lldb/Utility/HexCoding.h"
 #include <stddef.h>
 #include <stdio.h>
 #include <string.h>
@@ -16,6 +17,8 @@
 
 #include <inttypes.h>
 
+#include <algorithm>
+
 using namespace lldb;
 using namespace lldb_private;
 
@@ -701,23 +704,26 @@ Stream::PutBytesAsRawHex8 (const void *s, size_t src_len, ByteOrder src_byte_ord
     if (dst_byte_order == eByteOrderInvalid)
         dst_byte_order = m_byte_order;
 
+    // Encode a chunk at a time and write each chunk at once, rather than
+    // making a Write() call for every byte
     size_t bytes_written = 0;
     const uint8_t *src = (const uint8_t *)s;
-    bool binary_is_set = m_flags.Test(eBinary);
-    m_flags.Clear(eBinary);
-    if (src_byte_order == dst_byte_order)
-    {
-        for (size_t i = 0; i < src_len; ++i)
-            bytes_written += _PutHex8 (src[i], false);
-    }
-    else
+    uint8_t reversed[1024];
+    char hex[2 * sizeof(reversed)];
+    for (size_t offset = 0; offset < src_len; )
     {
-        for (size_t i = src_len-1; i < src_len; --i)
-            bytes_written += _PutHex8 (src[i], false);
+        const size_t chunk_len = std::min<size_t> (sizeof(reversed), src_len - offset);
+        const uint8_t *chunk = src + offset;
+        if (src_byte_order != dst_byte_order)
+        {
+            // Walk backwards from the end of the source
+            for (size_t i = 0; i < chunk_len; ++i)
+                reversed[i] = src[src_len - 1 - offset - i];
+            chunk = reversed;
+        }
+        bytes_written += Write (hex, HexEncode (chunk, chunk_len, hex));
+        offset += chunk_len;
     }
-    if (binary_is_set)
-        m_flags.Set(eBinary);
-
     return bytes_written;
 }
 
@@ -0,0 +1,400 @@
+//===-- StreamAsyncLog.cpp --------------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "lldb/Core/StreamAsyncLog.h"
+
+// C Includes
+#include <string.h>
+
+// C++ Includes
+#include <algorithm>
+#include <chrono>
+#include <string>
+#include <vector>
+
+// Other libraries and framework includes
+// Project includes
+#include "lldb/Core/StreamString.h"
+#include "lldb/Host/Host.h"
+#include "lldb/Host/ThreadLauncher.h"
+#include "lldb/Host/TimeValue.h"
+
+using namespace lldb;
+using namespace lldb_private;
+
+namespace
+{
+    // How long the drain thread sleeps when no buffer is filling up
+    const std::chrono::milliseconds k_drain_interval (50);
+
+    // Every record in a ring buffer starts with one of these
+    struct RecordHeader
+    {
+        uint32_t length;
+        uint32_t has_timestamp;
+        uint64_t timestamp;     // Nanoseconds since Jan 1, 1970
+    };
+
+    std::atomic<uint64_t> g_next_stream_id (1);
+}
+
+//----------------------------------------------------------------------
+// A byte ring buffer with one writer, the thread that owns it, and one
+// reader, whoever holds the drain mutex. The positions only ever grow and
+// are masked to index into the data.
+//----------------------------------------------------------------------
+class StreamAsyncLog::RingBuffer
+{
+public:
+    RingBuffer (size_t size) :
+        m_at_line_start (true),
+        m_data (new uint8_t[size]),
+        m_size (size),
+        m_head (0),
+        m_tail (0),
+        m_retired (false)
+    {
+    }
+
+    // Called by the owning thread when it exits, after its last Push()
+    void
+    Retire ()
+    {
+        m_retired.store (true, std::memory_order_release);
+    }
+
+    // Once this returns true the owner won't push any more records, and
+    // every record it did push can be popped
+    bool
+    IsRetired () const
+    {
+        return m_retired.load (std::memory_order_acquire);
+    }
+
+    size_t
+    GetUsedSize () const
+    {
+        return m_head.load (std::memory_order_relaxed) - m_tail.load (std::memory_order_relaxed);
+    }
+
+    size_t
+    GetSize () const
+    {
+        return m_size;
+    }
+
+    // Called by the owning thread only
+    bool
+    Push (const RecordHeader &header, const void *src)
+    {
+        const uint64_t head = m_head.load (std::memory_order_relaxed);
+        const uint64_t tail = m_tail.load (std::memory_order_acquire);
+        const uint64_t record_size = sizeof(header) + header.length;
+        if (record_size > m_size - (head - tail))
+            return false;
+        CopyIn (head, &header, sizeof(header));
+        CopyIn (head + sizeof(header), src, header.length);
+        m_head.store (head + record_size, std::memory_order_release);
+        return true;
+    }
+
+    // Called with the drain mutex held only
+    bool
+    Pop (RecordHeader &header, std::string &record)
+    {
+        const uint64_t tail = m_tail.load (std::memory_order_relaxed);
+        const uint64_t head = m_head.load (std::memory_order_acquire);
+        if (head == tail)
+            return false;
+        CopyOut (tail, &header, sizeof(header));
+        record.resize (header.length);
+        if (header.length > 0)
+            CopyOut (tail + sizeof(header), &record[0], header.length);
+        m_tail.store (tail + sizeof(header) + header.length, std::memory_order_release);
+        return true;
+    }
+
+    // Whether the last record drained ended a line, so the next one needs
+    // a timestamp. Only used by the reader.
+    bool m_at_line_start;
+
+private:
+    void
+    CopyIn (uint64_t pos, const void *src, size_t len)
+    {
+        const size_t offset = pos & (m_size - 1);
+        const size_t first = std::min (len, m_size - offset);
+        ::memcpy (m_data.get () + offset, src, first);
+        ::memcpy (m_data.get (), (const uint8_t *)src + first, len - first);
+    }
+
+    void
+    CopyOut (uint64_t pos, void *dst, size_t len)
+    {
+        const size_t offset = pos & (m_size - 1);
+        const size_t first = std::min (len, m_size - offset);
+        ::memcpy (dst, m_data.get () + offset, first);
+        ::memcpy ((uint8_t *)dst + first, m_data.get (), len - first);
+    }
+
+    std::unique_ptr<uint8_t[]> m_data;
+    const size_t m_size;
+    std::atomic<uint64_t> m_head;   // Where the next record will be written
+    std::atomic<uint64_t> m_tail;   // Where the next record will be read
+    std::atomic<bool> m_retired;
+};
+
+//----------------------------------------------------------------------
+// The ring buffers of the current thread, one for each stream it has
+// written to. The buffers are shared with the streams so that whichever
+// of the thread and the stream goes away first, the other can still use
+// them, and the thread retires them when it exits.
+//----------------------------------------------------------------------
+struct StreamAsyncLog::ThreadBuffers
+{
+    struct Entry
+    {
+        uint64_t stream_id;
+        RingBufferSP buffer_sp;
+    };
+
+    std::vector<Entry> entries;
+};
+
+lldb::thread_key_t
+StreamAsyncLog::GetThreadBuffersKey ()
+{
+    static std::once_flag g_once_flag;
+    static lldb::thread_key_t g_key;
+    std::call_once (g_once_flag, [] () {
+        g_key = Host::ThreadLocalStorageCreate (ThreadBuffersCleanup);
+    });
+    return g_key;
+}
+
+void
+StreamAsyncLog::ThreadBuffersCleanup (void *p)
+{
+    ThreadBuffers *thread_buffers = (ThreadBuffers *)p;
+    for (ThreadBuffers::Entry &entry : thread_buffers->entries)
+        entry.buffer_sp->Retire ();
+    delete thread_buffers;
+}
+
+static size_t
+RoundUpToPowerOfTwo (size_t size)
+{
+    size_t result = 1024;
+    while (result < size)
+        result <<= 1;
+    return result;
+}
+
+StreamAsyncLog::StreamAsyncLog (const StreamSP &stream_sp, size_t buffer_size) :
+    Stream (0, 4, eByteOrderBig),
+    m_stream_sp (stream_sp),
+    m_buffer_size (RoundUpToPowerOfTwo (buffer_size)),
+    m_stream_id (g_next_stream_id++),
+    m_timestamps (false),
+    m_dropped_records (0),
+    m_reported_dropped_records (0),
+    m_buffers_mutex (),
+    m_buffers (),
+    m_drain_mutex (),
+    m_drain_condition (),
+    m_drain_requested (false),
+    m_stop (false),
+    m_drain_thread ()
+{
+}
+
+StreamAsyncLog::~StreamAsyncLog ()
+{
+    {
+        std::lock_guard<std::mutex> guard (m_drain_mutex);
+        m_stop = true;
+    }
+    m_drain_condition.notify_all ();
+    if (m_drain_thread.IsJoinable ())
+        m_drain_thread.Join (nullptr);
+    Drain ();
+}
+
+bool
+StreamAsyncLog::StartDrainThread ()
+{
+    if (m_drain_thread.IsJoinable ())
+        return true;
+    Error error;
+    m_drain_thread = ThreadLauncher::LaunchThread ("lldb.log.async-drain", DrainThread, this, &error);
+    return error.Success () && m_drain_thread.IsJoinable ();
+}
+
+void
+StreamAsyncLog::Drain ()
+{
+    std::lock_guard<std::mutex> guard (m_drain_mutex);
+    DrainBuffers ();
+}
+
+void
+StreamAsyncLog::Flush ()
+{
+}
+
+size_t
+StreamAsyncLog::Write (const void *src, size_t src_len)
+{
+    if (src_len == 0)
+        return 0;
+
+    RecordHeader header;
+    header.length = src_len;
+    header.has_timestamp = m_timestamps;
+    header.timestamp = header.has_timestamp ? TimeValue::Now ().GetAsNanoSecondsSinceJan1_1970 () : 0;
+
+    RingBuffer *buffer = GetBufferForCurrentThread ();
+    if (src_len > UINT32_MAX || !buffer->Push (header, src))
+    {
+        // Never make the logging thread wait for the drain thread
+        ++m_dropped_records;
+    }
+    else if (buffer->GetUsedSize () > buffer->GetSize () / 2 && !m_drain_requested.exchange (true))
+    {
+        // Wake the drain thread early. It wakes up on its own shortly if it
+        // misses this because it wasn't waiting yet.
+        m_drain_condition.notify_one ();
+    }
+    return src_len;
+}
+
+StreamAsyncLog::RingBuffer *
+StreamAsyncLog::GetBufferForCurrentThread ()
+{
+    const lldb::thread_key_t key = GetThreadBuffersKey ();
+    ThreadBuffers *thread_buffers = (ThreadBuffers *)Host::ThreadLocalStorageGet (key);
+    if (thread_buffers == NULL)
+    {
+        thread_buffers = new ThreadBuffers;
+        Host::ThreadLocalStorageSet (key, thread_buffers);
+    }
+
+    // Threads rarely write to more than one or two streams
+    std::vector<ThreadBuffers::Entry> &entries = thread_buffers->entries;
+    for (const ThreadBuffers::Entry &entry : entries)
+    {
+        if (entry.stream_id == m_stream_id)
+            return entry.buffer_sp.get ();
+    }
+
+    // Forget the buffers of streams that have been destroyed, which are
+    // only referenced from here
+    entries.erase (std::remove_if (entries.begin (), entries.end (),
+                                   [] (const ThreadBuffers::Entry &entry) { return entry.buffer_sp.unique (); }),
+                   entries.end ());
+
+    ThreadBuffers::Entry entry = { m_stream_id, RingBufferSP (new RingBuffer (m_buffer_size)) };
+    {
+        Mutex::Locker locker (m_buffers_mutex);
+        m_buffers.push_back (entry.buffer_sp);
+    }
+    entries.push_back (entry);
+    return entry.buffer_sp.get ();
+}
+
+size_t
+StreamAsyncLog::GetBufferCount ()
+{
+    Mutex::Locker locker (m_buffers_mutex);
+    return m_buffers.size ();
+}
+
+bool
+StreamAsyncLog::DrainBuffers ()
+{
+    // Hold references to the buffers so they can be drained without the
+    // lock while new threads add theirs
+    collection buffers;
+    {
+        Mutex::Locker locker (m_buffers_mutex);
+        buffers = m_buffers;
+    }
+
+    bool wrote_records = false;
+    RecordHeader header;
+    std::string record;
+    StreamString timestamp;
+    std::vector<RingBuffer *> drained_retired_buffers;
+    for (const RingBufferSP &buffer_sp : buffers)
+    {
+        RingBuffer *buffer = buffer_sp.get ();
+        // Check this before draining so that a retired buffer is known to
+        // be empty afterwards
+        const bool retired = buffer->IsRetired ();
+        while (buffer->Pop (header, record))
+        {
+            if (header.has_timestamp && buffer->m_at_line_start)
+            {
+                timestamp.Clear ();
+                timestamp.Printf ("%9d.%6.6d ",
+                                  (uint32_t)(header.timestamp / TimeValue::NanoSecPerSec),
+                                  (uint32_t)(header.timestamp % TimeValue::NanoSecPerSec));
+                m_stream_sp->Write (timestamp.GetData (), timestamp.GetSize ());
+            }
+            m_stream_sp->Write (record.data (), record.size ());
+            buffer->m_at_line_start = !record.empty () && record[record.size () - 1] == '\n';
+            wrote_records = true;
+        }
+        if (retired)
+            drained_retired_buffers.push_back (buffer);
+    }
+
+    if (!drained_retired_buffers.empty ())
+    {
+        // Buffers that were retired while they were being drained may
+        // still have records in them, so leave those for the next pass
+        Mutex::Locker locker (m_buffers_mutex);
+        m_buffers.erase (std::remove_if (m_buffers.begin (), m_buffers.end (),
+                                         [&drained_retired_buffers] (const RingBufferSP &buffer_sp) {
+                                             return std::find (drained_retired_buffers.begin (),
+                                                               drained_retired_buffers.end (),
+                                                               buffer_sp.get ()) != drained_retired_buffers.end ();
+                                         }),
+                         m_buffers.end ());
+    }
+
+    const uint64_t dropped_records = m_dropped_records;
+    if (dropped_records != m_reported_dropped_records)
+    {
+        m_stream_sp->Printf ("warning: %" PRIu64 " log records were dropped because the log buffers were full\n",
+                             dropped_records - m_reported_dropped_records);
+        m_reported_dropped_records = dropped_records;
+        wrote_records = true;
+    }
+
+    if (wrote_records)
+        m_stream_sp->Flush ();
+    return wrote_records;
+}
+
+lldb::thread_result_t
+StreamAsyncLog::DrainThread (lldb::thread_arg_t arg)
+{
+    StreamAsyncLog *stream = (StreamAsyncLog *)arg;
+    std::unique_lock<std::mutex> lock (stream->m_drain_mutex);
+    while (!stream->m_stop)
+    {
+        stream->m_drain_condition.wait_for (lock, k_drain_interval, [stream] () {
+            return stream->m_stop || stream->m_drain_requested;
+        });
+        stream->m_drain_requested = false;
+        stream->DrainBuffers ();
+    }
+    return NULL;
+}
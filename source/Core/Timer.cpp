@@ -8,6 +8,7 @@
 //===----------------------------------------------------------------------===//
 #include "lldb/Core/Timer.h"
 
+#include <atomic>
 #include <map>
 #include <vector>
 #include <algorithm>
@@ -15,6 +16,7 @@
 #include "lldb/Core/Stream.h"
 #include "lldb/Host/Mutex.h"
 #include "lldb/Host/Host.h"
+#include "lldb/Utility/JSON.h"
 
 #include <stdio.h>
 
@@ -22,13 +24,150 @@ using namespace lldb_private;
 
 #define TIMER_INDENT_AMOUNT 2
 static bool g_quiet = true;
-uint32_t Timer::g_depth = 0;
 uint32_t Timer::g_display_depth = 0;
 FILE * Timer::g_file = NULL;
 typedef std::vector<Timer *> TimerStack;
-typedef std::map<const char *, uint64_t> TimerCategoryMap;
 static lldb::thread_key_t g_key;
 
+namespace {
+
+struct TimerCategoryStats
+{
+    TimerCategoryStats () :
+        count (0),
+        total_nsec (0),
+        self_nsec (0)
+    {
+    }
+
+    uint64_t count;      // Number of timers that completed in this category
+    uint64_t total_nsec; // Time including the time spent in nested timers
+    uint64_t self_nsec;  // Time excluding the time spent in nested timers
+};
+
+typedef std::map<const char *, TimerCategoryStats> TimerCategoryMap;
+typedef std::pair<const char *, TimerCategoryStats> TimerCategoryEntry;
+
+//----------------------------------------------------------------------
+// Timer state for a single thread.
+//
+// Only the owning thread ever writes to the category slots, so
+// accumulating a category time is a couple of relaxed atomic stores.
+// Other threads only read the slots when the category times are
+// dumped. Categories are the constant strings passed to the Timer
+// constructor, so the slots are keyed by pointer.
+//----------------------------------------------------------------------
+class TimerThreadData
+{
+public:
+    TimerThreadData () :
+        m_stack (),
+        m_depth (0)
+    {
+        for (size_t i=0; i<kNumSlots; ++i)
+        {
+            m_slots[i].category.store (NULL, std::memory_order_relaxed);
+            m_slots[i].count.store (0, std::memory_order_relaxed);
+            m_slots[i].total_nsec.store (0, std::memory_order_relaxed);
+            m_slots[i].self_nsec.store (0, std::memory_order_relaxed);
+        }
+    }
+
+    TimerStack &
+    GetStack ()
+    {
+        return m_stack;
+    }
+
+    uint32_t &
+    GetDepth ()
+    {
+        return m_depth;
+    }
+
+    // Returns false if all slots are taken by other categories.
+    bool
+    Accumulate (const char *category, uint64_t total_nsec, uint64_t self_nsec)
+    {
+        const size_t hash = (size_t)((uintptr_t)category >> 3);
+        for (size_t i=0; i<kNumSlots; ++i)
+        {
+            Slot &slot = m_slots[(hash + i) & (kNumSlots - 1)];
+            const char *slot_category = slot.category.load (std::memory_order_relaxed);
+            if (slot_category == NULL)
+            {
+                slot.category.store (category, std::memory_order_release);
+                slot_category = category;
+            }
+            if (slot_category == category)
+            {
+                slot.count.store (slot.count.load (std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+                slot.total_nsec.store (slot.total_nsec.load (std::memory_order_relaxed) + total_nsec, std::memory_order_relaxed);
+                slot.self_nsec.store (slot.self_nsec.load (std::memory_order_relaxed) + self_nsec, std::memory_order_relaxed);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void
+    MergeInto (TimerCategoryMap &category_map) const
+    {
+        for (size_t i=0; i<kNumSlots; ++i)
+        {
+            const Slot &slot = m_slots[i];
+            const char *category = slot.category.load (std::memory_order_acquire);
+            if (category == NULL)
+                continue;
+            const uint64_t count = slot.count.load (std::memory_order_relaxed);
+            if (count == 0)
+                continue;
+            TimerCategoryStats &stats = category_map[category];
+            stats.count += count;
+            stats.total_nsec += slot.total_nsec.load (std::memory_order_relaxed);
+            stats.self_nsec += slot.self_nsec.load (std::memory_order_relaxed);
+        }
+    }
+
+    // A timer that completes on the owning thread while we reset
+    // may still add its time to the old totals.
+    void
+    Reset ()
+    {
+        for (size_t i=0; i<kNumSlots; ++i)
+        {
+            m_slots[i].count.store (0, std::memory_order_relaxed);
+            m_slots[i].total_nsec.store (0, std::memory_order_relaxed);
+            m_slots[i].self_nsec.store (0, std::memory_order_relaxed);
+        }
+    }
+
+private:
+    enum { kNumSlots = 256 }; // Must be a power of two
+
+    struct Slot
+    {
+        std::atomic<const char *> category;
+        std::atomic<uint64_t> count;
+        std::atomic<uint64_t> total_nsec;
+        std::atomic<uint64_t> self_nsec;
+    };
+
+    TimerStack m_stack;
+    uint32_t m_depth;
+    Slot m_slots[kNumSlots];
+};
+
+typedef std::vector<TimerThreadData *> TimerThreadDataList;
+
+} // anonymous namespace
+
+//----------------------------------------------------------------------
+// The category mutex protects the list of live thread data and the
+// category map. The category map holds the times of threads that have
+// exited, and the times of categories that didn't fit in a thread's
+// slots.
+//----------------------------------------------------------------------
 static Mutex &
 GetCategoryMutex()
 {
@@ -43,23 +182,43 @@ GetCategoryMap()
     return g_category_map;
 }
 
+static TimerThreadDataList &
+GetThreadDataList()
+{
+    static TimerThreadDataList g_thread_data_list;
+    return g_thread_data_list;
+}
 
-static TimerStack *
-GetTimerStackForCurrentThread ()
+static TimerThreadData *
+GetTimerThreadDataForCurrentThread ()
 {
-    void *timer_stack = Host::ThreadLocalStorageGet(g_key);
-    if (timer_stack == NULL)
+    void *thread_data = Host::ThreadLocalStorageGet(g_key);
+    if (thread_data == NULL)
     {
-        Host::ThreadLocalStorageSet(g_key, new TimerStack);
-        timer_stack = Host::ThreadLocalStorageGet(g_key);
+        TimerThreadData *new_thread_data = new TimerThreadData;
+        {
+            Mutex::Locker locker (GetCategoryMutex());
+            GetThreadDataList().push_back (new_thread_data);
+        }
+        Host::ThreadLocalStorageSet(g_key, new_thread_data);
+        thread_data = Host::ThreadLocalStorageGet(g_key);
     }
-    return (TimerStack *)timer_stack;
+    return (TimerThreadData *)thread_data;
 }
 
 void
 ThreadSpecificCleanup (void *p)
 {
-    delete (TimerStack *)p;
+    TimerThreadData *thread_data = (TimerThreadData *)p;
+    {
+        // Keep the times of exiting threads around for the next dump
+        Mutex::Locker locker (GetCategoryMutex());
+        thread_data->MergeInto (GetCategoryMap());
+        TimerThreadDataList &thread_data_list = GetThreadDataList();
+        thread_data_list.erase (std::remove (thread_data_list.begin(), thread_data_list.end(), thread_data),
+                                thread_data_list.end());
+    }
+    delete thread_data;
 }
 
 void
@@ -82,12 +241,14 @@ Timer::Timer (const char *category, const char *format, ...) :
     m_total_ticks (0),
     m_timer_ticks (0)
 {
-    if (g_depth++ < g_display_depth)
+    TimerThreadData *thread_data = GetTimerThreadDataForCurrentThread ();
+    uint32_t &depth = thread_data->GetDepth();
+    if (depth++ < g_display_depth)
     {
         if (g_quiet == false)
         {
             // Indent
-            ::fprintf (g_file, "%*s", g_depth * TIMER_INDENT_AMOUNT, "");
+            ::fprintf (g_file, "%*s", depth * TIMER_INDENT_AMOUNT, "");
             // Print formatted string
             va_list args;
             va_start (args, format);
@@ -100,19 +261,18 @@ Timer::Timer (const char *category, const char *format, ...) :
         TimeValue start_time(TimeValue::Now());
         m_total_start = start_time;
         m_timer_start = start_time;
-        TimerStack *stack = GetTimerStackForCurrentThread ();
-        if (stack)
-        {
-            if (stack->empty() == false)
-                stack->back()->ChildStarted (start_time);
-            stack->push_back(this);
-        }
+        TimerStack &stack = thread_data->GetStack();
+        if (stack.empty() == false)
+            stack.back()->ChildStarted (start_time);
+        stack.push_back(this);
     }
 }
 
 
 Timer::~Timer()
 {
+    TimerThreadData *thread_data = GetTimerThreadDataForCurrentThread ();
+    uint32_t &depth = thread_data->GetDepth();
     if (m_total_start.IsValid())
     {
         TimeValue stop_time = TimeValue::Now();
@@ -127,14 +287,11 @@ Timer::~Timer()
             m_timer_start.Clear();
         }
 
-        TimerStack *stack = GetTimerStackForCurrentThread ();
-        if (stack)
-        {
-            assert (stack->back() == this);
-            stack->pop_back();
-            if (stack->empty() == false)
-                stack->back()->ChildStopped(stop_time);
-        }
+        TimerStack &stack = thread_data->GetStack();
+        assert (stack.back() == this);
+        stack.pop_back();
+        if (stack.empty() == false)
+            stack.back()->ChildStopped(stop_time);
 
         const uint64_t total_nsec_uint = GetTotalElapsedNanoSeconds();
         const uint64_t timer_nsec_uint = GetTimerElapsedNanoSeconds();
@@ -146,18 +303,23 @@ Timer::~Timer()
 
             ::fprintf (g_file,
                        "%*s%.9f sec (%.9f sec)\n",
-                       (g_depth - 1) *TIMER_INDENT_AMOUNT, "",
+                       (depth - 1) *TIMER_INDENT_AMOUNT, "",
                        total_nsec / 1000000000.0,
                        timer_nsec / 1000000000.0);
         }
 
         // Keep total results for each category so we can dump results.
-        Mutex::Locker locker (GetCategoryMutex());
-        TimerCategoryMap &category_map = GetCategoryMap();
-        category_map[m_category] += timer_nsec_uint;
+        if (!thread_data->Accumulate (m_category, total_nsec_uint, timer_nsec_uint))
+        {
+            Mutex::Locker locker (GetCategoryMutex());
+            TimerCategoryStats &stats = GetCategoryMap()[m_category];
+            ++stats.count;
+            stats.total_nsec += total_nsec_uint;
+            stats.self_nsec += timer_nsec_uint;
+        }
     }
-    if (g_depth > 0)
-        --g_depth;
+    if (depth > 0)
+        --depth;
 }
 
 uint64_t
@@ -210,41 +372,71 @@ Timer::SetDisplayDepth (uint32_t depth)
 }
 
 
-/* binary function predicate:
- * - returns whether a person is less than another person
- */
 static bool
-CategoryMapIteratorSortCriterion (const TimerCategoryMap::const_iterator& lhs, const TimerCategoryMap::const_iterator& rhs)
+CategoryEntrySortCriterion (const TimerCategoryEntry& lhs, const TimerCategoryEntry& rhs)
 {
-    return lhs->second > rhs->second;
+    return lhs.second.self_nsec > rhs.second.self_nsec;
 }
 
+static void
+GetSortedCategoryTimes (std::vector<TimerCategoryEntry> &sorted_entries)
+{
+    TimerCategoryMap category_map;
+    {
+        Mutex::Locker locker (GetCategoryMutex());
+        category_map = GetCategoryMap();
+        for (const TimerThreadData *thread_data : GetThreadDataList())
+            thread_data->MergeInto (category_map);
+    }
+    sorted_entries.assign (category_map.begin(), category_map.end());
+    std::sort (sorted_entries.begin(), sorted_entries.end(), CategoryEntrySortCriterion);
+}
 
 void
 Timer::ResetCategoryTimes ()
 {
     Mutex::Locker locker (GetCategoryMutex());
-    TimerCategoryMap &category_map = GetCategoryMap();
-    category_map.clear();
+    GetCategoryMap().clear();
+    for (TimerThreadData *thread_data : GetThreadDataList())
+        thread_data->Reset();
 }
 
 void
 Timer::DumpCategoryTimes (Stream *s)
 {
-    Mutex::Locker locker (GetCategoryMutex());
-    TimerCategoryMap &category_map = GetCategoryMap();
-    std::vector<TimerCategoryMap::const_iterator> sorted_iterators;
-    TimerCategoryMap::const_iterator pos, end = category_map.end();
-    for (pos = category_map.begin(); pos != end; ++pos)
+    std::vector<TimerCategoryEntry> sorted_entries;
+    GetSortedCategoryTimes (sorted_entries);
+
+    for (const TimerCategoryEntry &entry : sorted_entries)
     {
-        sorted_iterators.push_back (pos);
+        const double timer_nsec = entry.second.self_nsec;
+        const double total_nsec = entry.second.total_nsec;
+        s->Printf("%.9f sec (%.9f sec total, %" PRIu64 " calls) for %s\n",
+                  timer_nsec / 1000000000.0,
+                  total_nsec / 1000000000.0,
+                  entry.second.count,
+                  entry.first);
     }
-    std::sort (sorted_iterators.begin(), sorted_iterators.end(), CategoryMapIteratorSortCriterion);
+}
 
-    const size_t count = sorted_iterators.size();
-    for (size_t i=0; i<count; ++i)
+void
+Timer::DumpCategoryTimesAsJSON (Stream *s)
+{
+    std::vector<TimerCategoryEntry> sorted_entries;
+    GetSortedCategoryTimes (sorted_entries);
+
+    JSONArray::SP categories_sp (new JSONArray());
+    for (const TimerCategoryEntry &entry : sorted_entries)
     {
-        const double timer_nsec = sorted_iterators[i]->second;
-        s->Printf("%.9f sec for %s\n", timer_nsec / 1000000000.0, sorted_iterators[i]->first);
+        JSONObject::SP category_sp (new JSONObject());
+        category_sp->SetObject ("name", JSONString::SP (new JSONString (entry.first)));
+        category_sp->SetObject ("count", JSONNumber::SP (new JSONNumber ((int64_t)entry.second.count)));
+        category_sp->SetObject ("total_nsec", JSONNumber::SP (new JSONNumber ((int64_t)entry.second.total_nsec)));
+        category_sp->SetObject ("self_nsec", JSONNumber::SP (new JSONNumber ((int64_t)entry.second.self_nsec)));
+        categories_sp->AppendObject (category_sp);
     }
+
+    JSONObject report;
+    report.SetObject ("categories", categories_sp);
+    report.Write (*s);
 }
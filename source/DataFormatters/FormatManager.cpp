@@ -1035,15 +1035,15 @@ FormatManager::LoadLibStdcppFormatters()
     SyntheticChildren::Flags stl_synth_flags;
     stl_synth_flags.SetCascades(true).SetSkipPointers(false).SetSkipReferences(false);
     
-    gnu_category_sp->GetRegexTypeSyntheticsContainer()->Add(RegularExpressionSP(new RegularExpression("^std::vector<.+>(( )?&)?$")),
-                                                       SyntheticChildrenSP(new ScriptedSyntheticChildren(stl_synth_flags,
-                                                                                                 "lldb.formatters.cpp.gnu_libstdcpp.StdVectorSynthProvider")));
-    gnu_category_sp->GetRegexTypeSyntheticsContainer()->Add(RegularExpressionSP(new RegularExpression("^std::map<.+> >(( )?&)?$")),
-                                                       SyntheticChildrenSP(new ScriptedSyntheticChildren(stl_synth_flags,
-                                                                                                 "lldb.formatters.cpp.gnu_libstdcpp.StdMapSynthProvider")));
-    gnu_category_sp->GetRegexTypeSyntheticsContainer()->Add(RegularExpressionSP(new RegularExpression("^std::list<.+>(( )?&)?$")),
-                                                       SyntheticChildrenSP(new ScriptedSyntheticChildren(stl_synth_flags,
-                                                                                                 "lldb.formatters.cpp.gnu_libstdcpp.StdListSynthProvider")));
+    AddCXXSynthetic(gnu_category_sp, lldb_private::formatters::LibStdcppVectorSyntheticFrontEndCreator, "libstdc++ std::vector synthetic children", ConstString("^std::vector<.+>(( )?&)?$"), stl_synth_flags, true);
+    AddCXXSynthetic(gnu_category_sp, lldb_private::formatters::LibStdcppListSyntheticFrontEndCreator, "libstdc++ std::list synthetic children", ConstString("^std::(__cxx11::)?list<.+>(( )?&)?$"), stl_synth_flags, true);
+    AddCXXSynthetic(gnu_category_sp, lldb_private::formatters::LibStdcppRbTreeSyntheticFrontEndCreator, "libstdc++ std::map synthetic children", ConstString("^std::map<.+> >(( )?&)?$"), stl_synth_flags, true);
+    AddCXXSynthetic(gnu_category_sp, lldb_private::formatters::LibStdcppRbTreeSyntheticFrontEndCreator, "libstdc++ std::multimap synthetic children", ConstString("^std::multimap<.+> >(( )?&)?$"), stl_synth_flags, true);
+    AddCXXSynthetic(gnu_category_sp, lldb_private::formatters::LibStdcppRbTreeSyntheticFrontEndCreator, "libstdc++ std::set synthetic children", ConstString("^std::set<.+> >(( )?&)?$"), stl_synth_flags, true);
+    AddCXXSynthetic(gnu_category_sp, lldb_private::formatters::LibStdcppRbTreeSyntheticFrontEndCreator, "libstdc++ std::multiset synthetic children", ConstString("^std::multiset<.+> >(( )?&)?$"), stl_synth_flags, true);
+    AddCXXSynthetic(gnu_category_sp, lldb_private::formatters::LibStdcppUnorderedSyntheticFrontEndCreator, "libstdc++ std::unordered containers synthetic children", ConstString("^std::unordered_(multi)?(map|set)<.+> >(( )?&)?$"), stl_synth_flags, true);
+    AddCXXSynthetic(gnu_category_sp, lldb_private::formatters::LibStdcppSharedPtrSyntheticFrontEndCreator, "libstdc++ std::shared_ptr synthetic children", ConstString("^std::shared_ptr<.+>(( )?&)?$"), stl_synth_flags, true);
+    AddCXXSynthetic(gnu_category_sp, lldb_private::formatters::LibStdcppSharedPtrSyntheticFrontEndCreator, "libstdc++ std::weak_ptr synthetic children", ConstString("^std::weak_ptr<.+>(( )?&)?$"), stl_synth_flags, true);
     
     stl_summary_flags.SetDontShowChildren(false);stl_summary_flags.SetSkipPointers(true);
     gnu_category_sp->GetRegexTypeSummariesContainer()->Add(RegularExpressionSP(new RegularExpression("^std::vector<.+>(( )?&)?$")),
@@ -1052,9 +1052,24 @@ FormatManager::LoadLibStdcppFormatters()
     gnu_category_sp->GetRegexTypeSummariesContainer()->Add(RegularExpressionSP(new RegularExpression("^std::map<.+> >(( )?&)?$")),
                                                      TypeSummaryImplSP(new StringSummaryFormat(stl_summary_flags,
                                                                                                "size=${svar%#}")));
-    gnu_category_sp->GetRegexTypeSummariesContainer()->Add(RegularExpressionSP(new RegularExpression("^std::list<.+>(( )?&)?$")),
+    gnu_category_sp->GetRegexTypeSummariesContainer()->Add(RegularExpressionSP(new RegularExpression("^std::(__cxx11::)?list<.+>(( )?&)?$")),
                                                      TypeSummaryImplSP(new StringSummaryFormat(stl_summary_flags,
                                                                                                "size=${svar%#}")));
+    gnu_category_sp->GetRegexTypeSummariesContainer()->Add(RegularExpressionSP(new RegularExpression("^std::multimap<.+> >(( )?&)?$")),
+                                                     TypeSummaryImplSP(new StringSummaryFormat(stl_summary_flags,
+                                                                                               "size=${svar%#}")));
+    gnu_category_sp->GetRegexTypeSummariesContainer()->Add(RegularExpressionSP(new RegularExpression("^std::set<.+> >(( )?&)?$")),
+                                                     TypeSummaryImplSP(new StringSummaryFormat(stl_summary_flags,
+                                                                                               "size=${svar%#}")));
+    gnu_category_sp->GetRegexTypeSummariesContainer()->Add(RegularExpressionSP(new RegularExpression("^std::multiset<.+> >(( )?&)?$")),
+                                                     TypeSummaryImplSP(new StringSummaryFormat(stl_summary_flags,
+                                                                                               "size=${svar%#}")));
+    gnu_category_sp->GetRegexTypeSummariesContainer()->Add(RegularExpressionSP(new RegularExpression("^std::unordered_(multi)?(map|set)<.+> >(( )?&)?$")),
+                                                     TypeSummaryImplSP(new StringSummaryFormat(stl_summary_flags,
+                                                                                               "size=${svar%#}")));
+
+    AddCXXSummary(gnu_category_sp, lldb_private::formatters::LibStdcppSmartPointerSummaryProvider, "libstdc++ std::shared_ptr summary provider", ConstString("^std::shared_ptr<.+>(( )?&)?$"), stl_summary_flags, true);
+    AddCXXSummary(gnu_category_sp, lldb_private::formatters::LibStdcppSmartPointerSummaryProvider, "libstdc++ std::weak_ptr summary provider", ConstString("^std::weak_ptr<.+>(( )?&)?$"), stl_summary_flags, true);
 
     AddCXXSynthetic(gnu_category_sp, lldb_private::formatters::LibStdcppVectorIteratorSyntheticFrontEndCreator, "std::vector iterator synthetic children", ConstString("^__gnu_cxx::__normal_iterator<.+>$"), stl_synth_flags, true);
     
@@ -160,3 +160,165 @@ lldb_private::formatters::LibStdcppVectorIteratorSyntheticFrontEndCreator (CXXSy
         return NULL;
     return (new VectorIteratorSyntheticFrontEnd(valobj_sp,g_item_name));
 }
+
+/*
+ (std::shared_ptr<int>) sp = {
+   _M_ptr = 0x0000000000603010
+   _M_refcount = {
+     _M_pi = 0x0000000000603000 {
+       _M_use_count = 1
+       _M_weak_count = 1
+     }
+   }
+ }
+ */
+
+namespace lldb_private {
+    namespace formatters {
+        class LibStdcppSharedPtrSyntheticFrontEnd : public SyntheticChildrenFrontEnd
+        {
+        public:
+            LibStdcppSharedPtrSyntheticFrontEnd (lldb::ValueObjectSP valobj_sp);
+
+            virtual size_t
+            CalculateNumChildren ();
+
+            virtual lldb::ValueObjectSP
+            GetChildAtIndex (size_t idx);
+
+            virtual bool
+            Update();
+
+            virtual bool
+            MightHaveChildren ();
+
+            virtual size_t
+            GetIndexOfChildWithName (const ConstString &name);
+
+            virtual
+            ~LibStdcppSharedPtrSyntheticFrontEnd ();
+        private:
+            ValueObject* m_ptr;
+            ValueObject* m_counts;
+        };
+    }
+}
+
+lldb_private::formatters::LibStdcppSharedPtrSyntheticFrontEnd::LibStdcppSharedPtrSyntheticFrontEnd (lldb::ValueObjectSP valobj_sp) :
+    SyntheticChildrenFrontEnd(*valobj_sp.get()),
+    m_ptr(NULL),
+    m_counts(NULL)
+{
+    if (valobj_sp)
+        Update();
+}
+
+size_t
+lldb_private::formatters::LibStdcppSharedPtrSyntheticFrontEnd::CalculateNumChildren ()
+{
+    if (!m_ptr)
+        return 0;
+    return (m_counts ? 3 : 1);
+}
+
+lldb::ValueObjectSP
+lldb_private::formatters::LibStdcppSharedPtrSyntheticFrontEnd::GetChildAtIndex (size_t idx)
+{
+    if (idx >= CalculateNumChildren())
+        return lldb::ValueObjectSP();
+    if (idx == 0)
+        return m_ptr->GetSP();
+    if (idx == 1)
+        return m_counts->GetChildMemberWithName(ConstString("_M_use_count"), true);
+    return m_counts->GetChildMemberWithName(ConstString("_M_weak_count"), true);
+}
+
+bool
+lldb_private::formatters::LibStdcppSharedPtrSyntheticFrontEnd::Update()
+{
+    // store raw pointers or end up with a circular dependency
+    m_ptr = m_backend.GetChildMemberWithName(ConstString("_M_ptr"), true).get();
+    m_counts = NULL;
+    ValueObjectSP pi_sp(m_backend.GetChildAtNamePath({ConstString("_M_refcount"), ConstString("_M_pi")}));
+    if (pi_sp && pi_sp->GetValueAsUnsigned(0) != 0)
+        m_counts = pi_sp.get();
+    return false;
+}
+
+bool
+lldb_private::formatters::LibStdcppSharedPtrSyntheticFrontEnd::MightHaveChildren ()
+{
+    return true;
+}
+
+size_t
+lldb_private::formatters::LibStdcppSharedPtrSyntheticFrontEnd::GetIndexOfChildWithName (const ConstString &name)
+{
+    if (name == ConstString("_M_ptr"))
+        return 0;
+    if (name == ConstString("_M_use_count"))
+        return 1;
+    if (name == ConstString("_M_weak_count"))
+        return 2;
+    return UINT32_MAX;
+}
+
+lldb_private::formatters::LibStdcppSharedPtrSyntheticFrontEnd::~LibStdcppSharedPtrSyntheticFrontEnd ()
+{}
+
+SyntheticChildrenFrontEnd*
+lldb_private::formatters::LibStdcppSharedPtrSyntheticFrontEndCreator (CXXSyntheticChildren*, lldb::ValueObjectSP valobj_sp)
+{
+    if (!valobj_sp)
+        return NULL;
+    return (new LibStdcppSharedPtrSyntheticFrontEnd(valobj_sp));
+}
+
+bool
+lldb_private::formatters::LibStdcppSmartPointerSummaryProvider (ValueObject& valobj, Stream& stream, const TypeSummaryOptions& options)
+{
+    ValueObjectSP valobj_sp(valobj.GetNonSyntheticValue());
+    if (!valobj_sp)
+        return false;
+    ValueObjectSP ptr_sp(valobj_sp->GetChildMemberWithName(ConstString("_M_ptr"), true));
+    if (!ptr_sp)
+        return false;
+
+    if (ptr_sp->GetValueAsUnsigned(0) == 0)
+    {
+        stream.Printf("nullptr");
+        return true;
+    }
+
+    bool print_pointee = false;
+    Error error;
+    ValueObjectSP pointee_sp = ptr_sp->Dereference(error);
+    if (pointee_sp && error.Success())
+    {
+        if (pointee_sp->DumpPrintableRepresentation(stream,
+                                                    ValueObject::eValueObjectRepresentationStyleSummary,
+                                                    lldb::eFormatInvalid,
+                                                    ValueObject::ePrintableRepresentationSpecialCasesDisable,
+                                                    false))
+            print_pointee = true;
+    }
+    if (!print_pointee)
+        stream.Printf("ptr = 0x%" PRIx64, ptr_sp->GetValueAsUnsigned(0));
+
+    ValueObjectSP use_count_sp(valobj_sp->GetChildAtNamePath({ConstString("_M_refcount"), ConstString("_M_pi"), ConstString("_M_use_count")}));
+    ValueObjectSP weak_count_sp(valobj_sp->GetChildAtNamePath({ConstString("_M_refcount"), ConstString("_M_pi"), ConstString("_M_weak_count")}));
+    if (use_count_sp)
+    {
+        const uint64_t use_count = use_count_sp->GetValueAsUnsigned(0);
+        stream.Printf(" strong=%" PRIu64, use_count);
+        // All the strong references together hold one weak reference
+        if (weak_count_sp)
+        {
+            uint64_t weak_count = weak_count_sp->GetValueAsUnsigned(0);
+            if (use_count > 0 && weak_count > 0)
+                --weak_count;
+            stream.Printf(" weak=%" PRIu64, weak_count);
+        }
+    }
+    return true;
+}
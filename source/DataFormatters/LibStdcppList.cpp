@@ -0,0 +1,231 @@
+//===-- LibStdcppList.cpp ----------------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "lldb/lldb-python.h"
+
+#include "lldb/DataFormatters/CXXFormatterFunctions.h"
+
+#include "lldb/Core/ConstString.h"
+#include "lldb/Core/Error.h"
+#include "lldb/Core/Stream.h"
+#include "lldb/Core/ValueObject.h"
+#include "lldb/Target/Process.h"
+#include "lldb/Target/Target.h"
+
+using namespace lldb;
+using namespace lldb_private;
+using namespace lldb_private::formatters;
+
+namespace lldb_private {
+    namespace formatters {
+        class LibStdcppListSyntheticFrontEnd : public SyntheticChildrenFrontEnd
+        {
+        public:
+            LibStdcppListSyntheticFrontEnd (lldb::ValueObjectSP valobj_sp);
+
+            virtual size_t
+            CalculateNumChildren ();
+
+            virtual lldb::ValueObjectSP
+            GetChildAtIndex (size_t idx);
+
+            virtual bool
+            Update();
+
+            virtual bool
+            MightHaveChildren ();
+
+            virtual size_t
+            GetIndexOfChildWithName (const ConstString &name);
+
+            virtual
+            ~LibStdcppListSyntheticFrontEnd ();
+        private:
+            bool
+            FindNodes (size_t count);
+
+            size_t m_list_capping_size;
+            lldb::addr_t m_header_address;
+            lldb::addr_t m_next_node;
+            std::vector<lldb::addr_t> m_nodes;
+            ClangASTType m_element_type;
+            uint32_t m_data_offset;
+            size_t m_count;
+            std::map<size_t,lldb::ValueObjectSP> m_children;
+        };
+    }
+}
+
+/*
+ (std::list<int, std::allocator<int> >) numbers_list = {
+   _M_impl = {
+     _M_node = {
+       _M_next = 0x0000000000603010
+       _M_prev = 0x0000000000603070
+     }
+   }
+ }
+ Each _List_node<int> is a _List_node_base (_M_next and _M_prev) followed
+ by the element. The last node points back at _M_impl._M_node.
+ */
+
+lldb_private::formatters::LibStdcppListSyntheticFrontEnd::LibStdcppListSyntheticFrontEnd (lldb::ValueObjectSP valobj_sp) :
+SyntheticChildrenFrontEnd(*valobj_sp.get()),
+m_list_capping_size(0),
+m_header_address(0),
+m_next_node(0),
+m_nodes(),
+m_element_type(),
+m_data_offset(0),
+m_count(UINT32_MAX),
+m_children()
+{
+    if (valobj_sp)
+        Update();
+}
+
+bool
+lldb_private::formatters::LibStdcppListSyntheticFrontEnd::FindNodes (size_t count)
+{
+    // Walk the links with plain pointer reads rather than making a
+    // ValueObject for every hop. Nodes that were allocated together end up
+    // in the same process memory cache lines, so most hops don't go to the
+    // inferior at all.
+    if (m_nodes.size() >= count)
+        return true;
+    ProcessSP process_sp(m_backend.GetProcessSP());
+    if (!process_sp)
+        return false;
+    while (m_nodes.size() < count)
+    {
+        if (m_next_node == 0 || m_next_node == m_header_address || m_next_node == LLDB_INVALID_ADDRESS)
+            return false;
+        m_nodes.push_back(m_next_node);
+        Error error;
+        m_next_node = process_sp->ReadPointerFromMemory(m_next_node, error);
+        if (error.Fail())
+            m_next_node = 0;
+    }
+    return true;
+}
+
+size_t
+lldb_private::formatters::LibStdcppListSyntheticFrontEnd::CalculateNumChildren ()
+{
+    if (m_count != UINT32_MAX)
+        return m_count;
+    if (m_header_address == 0)
+        return 0;
+    // Without a stored size the list must be walked, so stop at the
+    // number of children we will show. A list with a loop in it also
+    // stops there.
+    FindNodes(m_list_capping_size);
+    return (m_count = m_nodes.size());
+}
+
+lldb::ValueObjectSP
+lldb_private::formatters::LibStdcppListSyntheticFrontEnd::GetChildAtIndex (size_t idx)
+{
+    if (idx >= CalculateNumChildren())
+        return lldb::ValueObjectSP();
+
+    auto cached = m_children.find(idx);
+    if (cached != m_children.end())
+        return cached->second;
+
+    if (!FindNodes(idx + 1))
+        return lldb::ValueObjectSP();
+
+    StreamString name;
+    name.Printf("[%" PRIu64 "]", (uint64_t)idx);
+    return (m_children[idx] = CreateValueObjectFromAddress(name.GetData(), m_nodes[idx] + m_data_offset, m_backend.GetExecutionContextRef(), m_element_type));
+}
+
+bool
+lldb_private::formatters::LibStdcppListSyntheticFrontEnd::Update()
+{
+    m_header_address = 0;
+    m_next_node = 0;
+    m_nodes.clear();
+    m_count = UINT32_MAX;
+    m_children.clear();
+    m_list_capping_size = 0;
+    if (m_backend.GetTargetSP())
+        m_list_capping_size = m_backend.GetTargetSP()->GetMaximumNumberOfChildrenToDisplay();
+    if (m_list_capping_size == 0)
+        m_list_capping_size = 255;
+
+    ProcessSP process_sp(m_backend.GetProcessSP());
+    if (!process_sp)
+        return false;
+    ValueObjectSP node_sp(m_backend.GetChildAtNamePath({ConstString("_M_impl"), ConstString("_M_node")}));
+    if (!node_sp)
+        return false;
+    AddressType addr_type = eAddressTypeInvalid;
+    m_header_address = node_sp->GetAddressOf(true, &addr_type);
+    if (addr_type != eAddressTypeLoad || m_header_address == LLDB_INVALID_ADDRESS)
+    {
+        m_header_address = 0;
+        return false;
+    }
+    ValueObjectSP next_sp(node_sp->GetChildMemberWithName(ConstString("_M_next"), true));
+    if (!next_sp)
+    {
+        m_header_address = 0;
+        return false;
+    }
+    m_next_node = next_sp->GetValueAsUnsigned(0);
+
+    ClangASTType list_type = m_backend.GetClangType();
+    if (list_type.IsReferenceType())
+        list_type = list_type.GetNonReferenceType();
+    if (list_type.GetNumTemplateArguments() == 0)
+    {
+        m_header_address = 0;
+        return false;
+    }
+    lldb::TemplateArgumentKind kind;
+    m_element_type = list_type.GetTemplateArgument(0, kind);
+
+    // The element follows _M_next and _M_prev, aligned for its type
+    const uint32_t link_size = 2 * process_sp->GetAddressByteSize();
+    const uint32_t element_align = m_element_type.GetTypeBitAlign() / 8;
+    m_data_offset = link_size;
+    if (element_align > 1)
+        m_data_offset = (link_size + element_align - 1) / element_align * element_align;
+
+    // The C++11 ABI keeps the size in the list header
+    ValueObjectSP size_sp(node_sp->GetChildMemberWithName(ConstString("_M_size"), true));
+    if (size_sp)
+        m_count = size_sp->GetValueAsUnsigned(UINT32_MAX);
+    return false;
+}
+
+bool
+lldb_private::formatters::LibStdcppListSyntheticFrontEnd::MightHaveChildren ()
+{
+    return true;
+}
+
+size_t
+lldb_private::formatters::LibStdcppListSyntheticFrontEnd::GetIndexOfChildWithName (const ConstString &name)
+{
+    return ExtractIndexFromString(name.GetCString());
+}
+
+lldb_private::formatters::LibStdcppListSyntheticFrontEnd::~LibStdcppListSyntheticFrontEnd ()
+{}
+
+SyntheticChildrenFrontEnd*
+lldb_private::formatters::LibStdcppListSyntheticFrontEndCreator (CXXSyntheticChildren*, lldb::ValueObjectSP valobj_sp)
+{
+    if (!valobj_sp)
+        return NULL;
+    return (new LibStdcppListSyntheticFrontEnd(valobj_sp));
+}
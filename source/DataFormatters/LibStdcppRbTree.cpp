@@ -0,0 +1,273 @@
+//===-- LibStdcppRbTree.cpp --------------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "lldb/lldb-python.h"
+
+#include "lldb/DataFormatters/CXXFormatterFunctions.h"
+
+#include "lldb/Core/ConstString.h"
+#include "lldb/Core/DataExtractor.h"
+#include "lldb/Core/Error.h"
+#include "lldb/Core/Stream.h"
+#include "lldb/Core/ValueObject.h"
+#include "lldb/Target/Process.h"
+
+using namespace lldb;
+using namespace lldb_private;
+using namespace lldb_private::formatters;
+
+namespace lldb_private {
+    namespace formatters {
+        class LibStdcppRbTreeSyntheticFrontEnd : public SyntheticChildrenFrontEnd
+        {
+        public:
+            LibStdcppRbTreeSyntheticFrontEnd (lldb::ValueObjectSP valobj_sp);
+
+            virtual size_t
+            CalculateNumChildren ();
+
+            virtual lldb::ValueObjectSP
+            GetChildAtIndex (size_t idx);
+
+            virtual bool
+            Update();
+
+            virtual bool
+            MightHaveChildren ();
+
+            virtual size_t
+            GetIndexOfChildWithName (const ConstString &name);
+
+            virtual
+            ~LibStdcppRbTreeSyntheticFrontEnd ();
+        private:
+            struct PendingNode
+            {
+                lldb::addr_t node;
+                lldb::addr_t right;
+            };
+
+            bool
+            PushLeftSpine (lldb::addr_t node);
+
+            bool
+            FindNodes (size_t count);
+
+            size_t m_count;
+            uint32_t m_ptr_size;
+            uint32_t m_data_offset;
+            ClangASTType m_element_type;
+            std::vector<PendingNode> m_pending;     // The in-order walk's stack
+            std::vector<lldb::addr_t> m_nodes;      // The nodes found so far, in order
+            size_t m_num_nodes_read;
+            bool m_garbage;
+            std::map<size_t,lldb::ValueObjectSP> m_children;
+        };
+    }
+}
+
+/*
+ (std::map<int, int, std::less<int>, std::allocator<std::pair<const int, int> > >) ii = {
+   _M_t = {
+     _M_impl = {
+       _M_header = {
+         _M_color = _S_red
+         _M_parent = 0x0000000000603010
+         _M_left = 0x0000000000603010
+         _M_right = 0x0000000000603040
+       }
+       _M_node_count = 2
+     }
+   }
+ }
+ Every _Rb_tree_node is an _Rb_tree_node_base (the color and the parent,
+ left and right links) followed by the element.
+ */
+
+lldb_private::formatters::LibStdcppRbTreeSyntheticFrontEnd::LibStdcppRbTreeSyntheticFrontEnd (lldb::ValueObjectSP valobj_sp) :
+SyntheticChildrenFrontEnd(*valobj_sp.get()),
+m_count(0),
+m_ptr_size(0),
+m_data_offset(0),
+m_element_type(),
+m_pending(),
+m_nodes(),
+m_num_nodes_read(0),
+m_garbage(false),
+m_children()
+{
+    if (valobj_sp)
+        Update();
+}
+
+bool
+lldb_private::formatters::LibStdcppRbTreeSyntheticFrontEnd::PushLeftSpine (lldb::addr_t node)
+{
+    ProcessSP process_sp(m_backend.GetProcessSP());
+    if (!process_sp)
+        return false;
+    while (node != 0)
+    {
+        // A node can't be reached more times than there are nodes, unless
+        // the tree is garbage (say, because it isn't constructed yet)
+        if (++m_num_nodes_read > m_count)
+        {
+            m_garbage = true;
+            return false;
+        }
+        // Read the color and all three links at once
+        uint8_t node_base[4 * sizeof(uint64_t)];
+        const size_t node_base_size = 4 * m_ptr_size;
+        Error error;
+        if (process_sp->ReadMemory(node, node_base, node_base_size, error) != node_base_size)
+        {
+            m_garbage = true;
+            return false;
+        }
+        DataExtractor data(node_base, node_base_size, process_sp->GetByteOrder(), m_ptr_size);
+        lldb::offset_t offset = 2 * m_ptr_size;
+        const lldb::addr_t left = data.GetPointer(&offset);
+        const lldb::addr_t right = data.GetPointer(&offset);
+        m_pending.push_back({node, right});
+        node = left;
+    }
+    return true;
+}
+
+bool
+lldb_private::formatters::LibStdcppRbTreeSyntheticFrontEnd::FindNodes (size_t count)
+{
+    // An in-order walk with an explicit stack reads every node once, where
+    // stepping an iterator from the start for every child would read the
+    // upper nodes over and over.
+    while (m_nodes.size() < count)
+    {
+        if (m_garbage || m_pending.empty())
+            return false;
+        PendingNode pending = m_pending.back();
+        m_pending.pop_back();
+        m_nodes.push_back(pending.node);
+        if (!PushLeftSpine(pending.right))
+            return false;
+    }
+    return true;
+}
+
+size_t
+lldb_private::formatters::LibStdcppRbTreeSyntheticFrontEnd::CalculateNumChildren ()
+{
+    return m_count;
+}
+
+lldb::ValueObjectSP
+lldb_private::formatters::LibStdcppRbTreeSyntheticFrontEnd::GetChildAtIndex (size_t idx)
+{
+    if (idx >= m_count)
+        return lldb::ValueObjectSP();
+
+    auto cached = m_children.find(idx);
+    if (cached != m_children.end())
+        return cached->second;
+
+    if (!FindNodes(idx + 1))
+        return lldb::ValueObjectSP();
+
+    StreamString name;
+    name.Printf("[%" PRIu64 "]", (uint64_t)idx);
+    return (m_children[idx] = CreateValueObjectFromAddress(name.GetData(), m_nodes[idx] + m_data_offset, m_backend.GetExecutionContextRef(), m_element_type));
+}
+
+bool
+lldb_private::formatters::LibStdcppRbTreeSyntheticFrontEnd::Update()
+{
+    m_count = 0;
+    m_pending.clear();
+    m_nodes.clear();
+    m_num_nodes_read = 0;
+    m_garbage = false;
+    m_children.clear();
+
+    ProcessSP process_sp(m_backend.GetProcessSP());
+    if (!process_sp)
+        return false;
+    m_ptr_size = process_sp->GetAddressByteSize();
+    if (m_ptr_size != 4 && m_ptr_size != 8)
+        return false;
+
+    ValueObjectSP tree_sp(m_backend.GetChildMemberWithName(ConstString("_M_t"), true));
+    if (!tree_sp)
+        return false;
+    ValueObjectSP header_sp(tree_sp->GetChildAtNamePath({ConstString("_M_impl"), ConstString("_M_header")}));
+    ValueObjectSP node_count_sp(tree_sp->GetChildAtNamePath({ConstString("_M_impl"), ConstString("_M_node_count")}));
+    if (!header_sp || !node_count_sp)
+        return false;
+    ValueObjectSP root_sp(header_sp->GetChildMemberWithName(ConstString("_M_parent"), true));
+    if (!root_sp)
+        return false;
+
+    // _Rb_tree<Key, Value, KeyOfValue, Compare, Alloc> has the element type
+    // for maps and sets alike. GCC doesn't always describe the template
+    // parameters of the tree, so fall back to the container's allocator.
+    lldb::TemplateArgumentKind kind;
+    ClangASTType tree_type = tree_sp->GetClangType().GetCanonicalType();
+    if (tree_type.GetNumTemplateArguments() >= 2)
+        m_element_type = tree_type.GetTemplateArgument(1, kind);
+    if (!m_element_type)
+    {
+        ClangASTType container_type = m_backend.GetClangType();
+        if (container_type.IsReferenceType())
+            container_type = container_type.GetNonReferenceType();
+        const size_t num_args = container_type.GetNumTemplateArguments();
+        if (num_args == 0)
+            return false;
+        ClangASTType allocator_type = container_type.GetTemplateArgument(num_args - 1, kind);
+        if (allocator_type.GetNumTemplateArguments() == 0)
+            return false;
+        m_element_type = allocator_type.GetTemplateArgument(0, kind);
+        if (!m_element_type)
+            return false;
+    }
+
+    m_data_offset = header_sp->GetClangType().GetByteSize(nullptr);
+    if (m_data_offset < 4 * m_ptr_size)
+        return false;
+    const uint32_t element_align = m_element_type.GetTypeBitAlign() / 8;
+    if (element_align > 1)
+        m_data_offset = (m_data_offset + element_align - 1) / element_align * element_align;
+
+    const lldb::addr_t root = root_sp->GetValueAsUnsigned(0);
+    if (root == 0)
+        return false;
+    m_count = node_count_sp->GetValueAsUnsigned(0);
+    PushLeftSpine(root);
+    return false;
+}
+
+bool
+lldb_private::formatters::LibStdcppRbTreeSyntheticFrontEnd::MightHaveChildren ()
+{
+    return true;
+}
+
+size_t
+lldb_private::formatters::LibStdcppRbTreeSyntheticFrontEnd::GetIndexOfChildWithName (const ConstString &name)
+{
+    return ExtractIndexFromString(name.GetCString());
+}
+
+lldb_private::formatters::LibStdcppRbTreeSyntheticFrontEnd::~LibStdcppRbTreeSyntheticFrontEnd ()
+{}
+
+SyntheticChildrenFrontEnd*
+lldb_private::formatters::LibStdcppRbTreeSyntheticFrontEndCreator (CXXSyntheticChildren*, lldb::ValueObjectSP valobj_sp)
+{
+    if (!valobj_sp)
+        return NULL;
+    return (new LibStdcppRbTreeSyntheticFrontEnd(valobj_sp));
+}
@@ -0,0 +1,215 @@
+//===-- LibStdcppUnorderedMap.cpp --------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "lldb/lldb-python.h"
+
+#include "lldb/DataFormatters/CXXFormatterFunctions.h"
+
+#include "lldb/Core/ConstString.h"
+#include "lldb/Core/Error.h"
+#include "lldb/Core/Stream.h"
+#include "lldb/Core/ValueObject.h"
+#include "lldb/Target/Process.h"
+
+using namespace lldb;
+using namespace lldb_private;
+using namespace lldb_private::formatters;
+
+namespace lldb_private {
+    namespace formatters {
+        class LibStdcppUnorderedSyntheticFrontEnd : public SyntheticChildrenFrontEnd
+        {
+        public:
+            LibStdcppUnorderedSyntheticFrontEnd (lldb::ValueObjectSP valobj_sp);
+
+            virtual size_t
+            CalculateNumChildren ();
+
+            virtual lldb::ValueObjectSP
+            GetChildAtIndex (size_t idx);
+
+            virtual bool
+            Update();
+
+            virtual bool
+            MightHaveChildren ();
+
+            virtual size_t
+            GetIndexOfChildWithName (const ConstString &name);
+
+            virtual
+            ~LibStdcppUnorderedSyntheticFrontEnd ();
+        private:
+            bool
+            FindNodes (size_t count);
+
+            size_t m_count;
+            lldb::addr_t m_next_node;
+            std::vector<lldb::addr_t> m_nodes;
+            ClangASTType m_element_type;
+            uint32_t m_data_offset;
+            std::map<size_t,lldb::ValueObjectSP> m_children;
+        };
+    }
+}
+
+/*
+ (std::unordered_map<int, int, std::hash<int>, std::equal_to<int>, std::allocator<std::pair<const int, int> > >) um = {
+   _M_h = {
+     _M_buckets = 0x0000000000603010
+     _M_bucket_count = 11
+     _M_before_begin = {
+       _M_nxt = 0x0000000000603090
+     }
+     _M_element_count = 3
+     ...
+   }
+ }
+ All the elements are in one singly linked list that starts at
+ _M_before_begin. Each _Hash_node is an _M_nxt link followed by the
+ element (and the cached hash code for some key types).
+ */
+
+lldb_private::formatters::LibStdcppUnorderedSyntheticFrontEnd::LibStdcppUnorderedSyntheticFrontEnd (lldb::ValueObjectSP valobj_sp) :
+SyntheticChildrenFrontEnd(*valobj_sp.get()),
+m_count(0),
+m_next_node(0),
+m_nodes(),
+m_element_type(),
+m_data_offset(0),
+m_children()
+{
+    if (valobj_sp)
+        Update();
+}
+
+bool
+lldb_private::formatters::LibStdcppUnorderedSyntheticFrontEnd::FindNodes (size_t count)
+{
+    // Follow the links with plain pointer reads, which the process memory
+    // cache mostly answers without going to the inferior
+    if (m_nodes.size() >= count)
+        return true;
+    ProcessSP process_sp(m_backend.GetProcessSP());
+    if (!process_sp)
+        return false;
+    while (m_nodes.size() < count)
+    {
+        if (m_next_node == 0 || m_next_node == LLDB_INVALID_ADDRESS)
+            return false;
+        m_nodes.push_back(m_next_node);
+        Error error;
+        m_next_node = process_sp->ReadPointerFromMemory(m_next_node, error);
+        if (error.Fail())
+            m_next_node = 0;
+    }
+    return true;
+}
+
+size_t
+lldb_private::formatters::LibStdcppUnorderedSyntheticFrontEnd::CalculateNumChildren ()
+{
+    return m_count;
+}
+
+lldb::ValueObjectSP
+lldb_private::formatters::LibStdcppUnorderedSyntheticFrontEnd::GetChildAtIndex (size_t idx)
+{
+    if (idx >= m_count)
+        return lldb::ValueObjectSP();
+
+    auto cached = m_children.find(idx);
+    if (cached != m_children.end())
+        return cached->second;
+
+    if (!FindNodes(idx + 1))
+        return lldb::ValueObjectSP();
+
+    StreamString name;
+    name.Printf("[%" PRIu64 "]", (uint64_t)idx);
+    return (m_children[idx] = CreateValueObjectFromAddress(name.GetData(), m_nodes[idx] + m_data_offset, m_backend.GetExecutionContextRef(), m_element_type));
+}
+
+bool
+lldb_private::formatters::LibStdcppUnorderedSyntheticFrontEnd::Update()
+{
+    m_count = 0;
+    m_next_node = 0;
+    m_nodes.clear();
+    m_children.clear();
+
+    ProcessSP process_sp(m_backend.GetProcessSP());
+    if (!process_sp)
+        return false;
+    ValueObjectSP table_sp(m_backend.GetChildMemberWithName(ConstString("_M_h"), true));
+    if (!table_sp)
+        return false;
+    ValueObjectSP first_sp(table_sp->GetChildAtNamePath({ConstString("_M_before_begin"), ConstString("_M_nxt")}));
+    ValueObjectSP count_sp(table_sp->GetChildMemberWithName(ConstString("_M_element_count"), true));
+    if (!first_sp || !count_sp)
+        return false;
+
+    // _Hashtable<Key, Value, Alloc, ...> has the element type for maps and
+    // sets alike, otherwise use the container's allocator
+    lldb::TemplateArgumentKind kind;
+    ClangASTType table_type = table_sp->GetClangType().GetCanonicalType();
+    if (table_type.GetNumTemplateArguments() >= 2)
+        m_element_type = table_type.GetTemplateArgument(1, kind);
+    if (!m_element_type)
+    {
+        ClangASTType container_type = m_backend.GetClangType();
+        if (container_type.IsReferenceType())
+            container_type = container_type.GetNonReferenceType();
+        const size_t num_args = container_type.GetNumTemplateArguments();
+        if (num_args == 0)
+            return false;
+        ClangASTType allocator_type = container_type.GetTemplateArgument(num_args - 1, kind);
+        if (allocator_type.GetNumTemplateArguments() == 0)
+            return false;
+        m_element_type = allocator_type.GetTemplateArgument(0, kind);
+        if (!m_element_type)
+            return false;
+    }
+
+    // The element follows the _M_nxt link, aligned for its type
+    const uint32_t link_size = process_sp->GetAddressByteSize();
+    const uint32_t element_align = m_element_type.GetTypeBitAlign() / 8;
+    m_data_offset = link_size;
+    if (element_align > 1)
+        m_data_offset = (link_size + element_align - 1) / element_align * element_align;
+
+    m_next_node = first_sp->GetValueAsUnsigned(0);
+    if (m_next_node == 0)
+        return false;
+    m_count = count_sp->GetValueAsUnsigned(0);
+    return false;
+}
+
+bool
+lldb_private::formatters::LibStdcppUnorderedSyntheticFrontEnd::MightHaveChildren ()
+{
+    return true;
+}
+
+size_t
+lldb_private::formatters::LibStdcppUnorderedSyntheticFrontEnd::GetIndexOfChildWithName (const ConstString &name)
+{
+    return ExtractIndexFromString(name.GetCString());
+}
+
+lldb_private::formatters::LibStdcppUnorderedSyntheticFrontEnd::~LibStdcppUnorderedSyntheticFrontEnd ()
+{}
+
+SyntheticChildrenFrontEnd*
+lldb_private::formatters::LibStdcppUnorderedSyntheticFrontEndCreator (CXXSyntheticChildren*, lldb::ValueObjectSP valobj_sp)
+{
+    if (!valobj_sp)
+        return NULL;
+    return (new LibStdcppUnorderedSyntheticFrontEnd(valobj_sp));
+}
@@ -0,0 +1,275 @@
+//===-- LibStdcppVector.cpp --------------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "lldb/lldb-python.h"
+
+#include "lldb/DataFormatters/CXXFormatterFunctions.h"
+
+#include "lldb/Core/ConstString.h"
+#include "lldb/Core/DataBufferHeap.h"
+#include "lldb/Core/DataExtractor.h"
+#include "lldb/Core/Error.h"
+#include "lldb/Core/Stream.h"
+#include "lldb/Core/ValueObject.h"
+#include "lldb/Target/Process.h"
+
+using namespace lldb;
+using namespace lldb_private;
+using namespace lldb_private::formatters;
+
+namespace lldb_private {
+    namespace formatters {
+        class LibStdcppVectorSyntheticFrontEnd : public SyntheticChildrenFrontEnd
+        {
+        public:
+            LibStdcppVectorSyntheticFrontEnd (lldb::ValueObjectSP valobj_sp);
+
+            virtual size_t
+            CalculateNumChildren ();
+
+            virtual lldb::ValueObjectSP
+            GetChildAtIndex (size_t idx);
+
+            virtual bool
+            Update();
+
+            virtual bool
+            MightHaveChildren ();
+
+            virtual size_t
+            GetIndexOfChildWithName (const ConstString &name);
+
+            virtual
+            ~LibStdcppVectorSyntheticFrontEnd ();
+        private:
+            bool
+            UpdateBool (ValueObject &impl);
+
+            bool
+            ReadBoolWords (size_t word_idx);
+
+            lldb::ValueObjectSP
+            GetBoolChildAtIndex (size_t idx);
+
+            bool m_is_bool;
+            lldb::addr_t m_start;
+            size_t m_count;
+            ClangASTType m_element_type;
+            uint32_t m_element_size;
+            DataExtractor m_bool_words;     // The words of a std::vector<bool> read so far
+            std::map<size_t,lldb::ValueObjectSP> m_children;
+        };
+    }
+}
+
+// std::vector<bool> words are read this many at a time
+static const size_t k_bool_words_per_read = 64;
+
+lldb_private::formatters::LibStdcppVectorSyntheticFrontEnd::LibStdcppVectorSyntheticFrontEnd (lldb::ValueObjectSP valobj_sp) :
+SyntheticChildrenFrontEnd(*valobj_sp.get()),
+m_is_bool(false),
+m_start(0),
+m_count(0),
+m_element_type(),
+m_element_size(0),
+m_bool_words(),
+m_children()
+{
+    if (valobj_sp)
+        Update();
+}
+
+size_t
+lldb_private::formatters::LibStdcppVectorSyntheticFrontEnd::CalculateNumChildren ()
+{
+    return m_count;
+}
+
+lldb::ValueObjectSP
+lldb_private::formatters::LibStdcppVectorSyntheticFrontEnd::GetChildAtIndex (size_t idx)
+{
+    if (idx >= m_count)
+        return lldb::ValueObjectSP();
+
+    auto cached = m_children.find(idx);
+    if (cached != m_children.end())
+        return cached->second;
+
+    if (m_is_bool)
+        return (m_children[idx] = GetBoolChildAtIndex(idx));
+
+    StreamString name;
+    name.Printf("[%" PRIu64 "]", (uint64_t)idx);
+    ValueObjectSP child_sp = CreateValueObjectFromAddress(name.GetData(), m_start + idx * m_element_size, m_backend.GetExecutionContextRef(), m_element_type);
+    m_children[idx] = child_sp;
+    return child_sp;
+}
+
+bool
+lldb_private::formatters::LibStdcppVectorSyntheticFrontEnd::ReadBoolWords (size_t word_idx)
+{
+    // Read the bits in large blocks instead of a word for every child
+    ProcessSP process_sp(m_backend.GetProcessSP());
+    if (!process_sp)
+        return false;
+    const size_t num_words = (m_count + m_element_size * 8 - 1) / (m_element_size * 8);
+    const size_t end_word_idx = std::min<size_t>(num_words, word_idx + k_bool_words_per_read);
+    const size_t first_word_idx = m_bool_words.GetByteSize() / m_element_size;
+    if (first_word_idx > word_idx || end_word_idx <= first_word_idx)
+        return false;
+
+    DataBufferSP buffer_sp(new DataBufferHeap(end_word_idx * m_element_size, 0));
+    if (m_bool_words.GetByteSize() > 0)
+        memcpy(buffer_sp->GetBytes(), m_bool_words.GetDataStart(), m_bool_words.GetByteSize());
+    Error error;
+    const size_t bytes_to_read = (end_word_idx - first_word_idx) * m_element_size;
+    if (process_sp->ReadMemory(m_start + first_word_idx * m_element_size,
+                               buffer_sp->GetBytes() + first_word_idx * m_element_size,
+                               bytes_to_read,
+                               error) != bytes_to_read)
+        return false;
+    m_bool_words.SetData(buffer_sp);
+    m_bool_words.SetByteOrder(process_sp->GetByteOrder());
+    m_bool_words.SetAddressByteSize(process_sp->GetAddressByteSize());
+    return true;
+}
+
+lldb::ValueObjectSP
+lldb_private::formatters::LibStdcppVectorSyntheticFrontEnd::GetBoolChildAtIndex (size_t idx)
+{
+    // The bits are packed into _Bit_type words, from the least significant bit up
+    const size_t bits_per_word = m_element_size * 8;
+    const size_t word_idx = idx / bits_per_word;
+    if ((word_idx + 1) * m_element_size > m_bool_words.GetByteSize() && !ReadBoolWords(word_idx))
+        return lldb::ValueObjectSP();
+    lldb::offset_t offset = word_idx * m_element_size;
+    const uint64_t word = m_bool_words.GetMaxU64(&offset, m_element_size);
+    const bool bit_set = ((word >> (idx % bits_per_word)) & 1) != 0;
+
+    ClangASTType bool_type = m_element_type.GetBasicTypeFromAST(lldb::eBasicTypeBool);
+    if (!bool_type)
+        return lldb::ValueObjectSP();
+    DataBufferSP buffer_sp(new DataBufferHeap(bool_type.GetByteSize(nullptr), 0));
+    if (bit_set && buffer_sp->GetByteSize() > 0)
+        *(buffer_sp->GetBytes()) = 1; // regardless of endianness, anything non-zero is true
+    StreamString name;
+    name.Printf("[%" PRIu64 "]", (uint64_t)idx);
+    return CreateValueObjectFromData(name.GetData(),
+                                     DataExtractor(buffer_sp, m_bool_words.GetByteOrder(), m_bool_words.GetAddressByteSize()),
+                                     m_backend.GetExecutionContextRef(),
+                                     bool_type);
+}
+
+bool
+lldb_private::formatters::LibStdcppVectorSyntheticFrontEnd::UpdateBool (ValueObject &impl)
+{
+    /*
+     std::vector<bool> is a _Bvector_base with a _Bit_iterator start and finish:
+     (std::_Bvector_base<std::allocator<bool> >::_Bvector_impl) _M_impl = {
+       (std::_Bit_iterator) _M_start = { _M_p = 0x0000000000603010, _M_offset = 0 }
+       (std::_Bit_iterator) _M_finish = { _M_p = 0x0000000000603018, _M_offset = 17 }
+       (std::_Bit_type *) _M_end_of_storage = 0x0000000000603020
+     }
+     */
+    ValueObjectSP start_p_sp(impl.GetChildAtNamePath({ConstString("_M_start"), ConstString("_M_p")}));
+    ValueObjectSP finish_p_sp(impl.GetChildAtNamePath({ConstString("_M_finish"), ConstString("_M_p")}));
+    ValueObjectSP finish_offset_sp(impl.GetChildAtNamePath({ConstString("_M_finish"), ConstString("_M_offset")}));
+    if (!start_p_sp || !finish_p_sp || !finish_offset_sp)
+        return false;
+    m_element_type = start_p_sp->GetClangType().GetPointeeType();
+    m_element_size = m_element_type.GetByteSize(nullptr);
+    if (m_element_size == 0 || m_element_size > 8)
+        return false;
+    const lldb::addr_t start = start_p_sp->GetValueAsUnsigned(0);
+    const lldb::addr_t finish = finish_p_sp->GetValueAsUnsigned(0);
+    if (start == 0 || finish < start)
+        return false;
+    m_start = start;
+    m_count = (finish - start) * 8 + finish_offset_sp->GetValueAsUnsigned(0);
+    return false;
+}
+
+bool
+lldb_private::formatters::LibStdcppVectorSyntheticFrontEnd::Update()
+{
+    m_is_bool = false;
+    m_start = 0;
+    m_count = 0;
+    m_element_size = 0;
+    m_bool_words.Clear();
+    m_children.clear();
+
+    ValueObjectSP impl_sp(m_backend.GetChildMemberWithName(ConstString("_M_impl"), true));
+    if (!impl_sp)
+        return false;
+
+    ClangASTType vector_type = m_backend.GetClangType();
+    if (vector_type.IsReferenceType())
+        vector_type = vector_type.GetNonReferenceType();
+    if (vector_type.GetNumTemplateArguments() > 0)
+    {
+        lldb::TemplateArgumentKind kind;
+        ClangASTType first_arg_type = vector_type.GetTemplateArgument(0, kind);
+        if (first_arg_type && first_arg_type.GetCanonicalType().GetBasicTypeEnumeration() == lldb::eBasicTypeBool)
+        {
+            m_is_bool = true;
+            return UpdateBool(*impl_sp);
+        }
+    }
+
+    ValueObjectSP start_sp(impl_sp->GetChildMemberWithName(ConstString("_M_start"), true));
+    ValueObjectSP finish_sp(impl_sp->GetChildMemberWithName(ConstString("_M_finish"), true));
+    ValueObjectSP end_sp(impl_sp->GetChildMemberWithName(ConstString("_M_end_of_storage"), true));
+    if (!start_sp || !finish_sp || !end_sp)
+        return false;
+    m_element_type = start_sp->GetClangType().GetPointeeType();
+    m_element_size = m_element_type.GetByteSize(nullptr);
+    if (m_element_size == 0)
+        return false;
+
+    // Before a vector has been constructed it holds garbage, so make sure
+    // the pointers make sense before trusting the size they give
+    const lldb::addr_t start = start_sp->GetValueAsUnsigned(0);
+    const lldb::addr_t finish = finish_sp->GetValueAsUnsigned(0);
+    const lldb::addr_t end = end_sp->GetValueAsUnsigned(0);
+    if (start == 0 || finish == 0 || end == 0)
+        return false;
+    if (start >= finish || finish > end)
+        return false;
+    if ((finish - start) % m_element_size)
+        return false;
+    m_start = start;
+    m_count = (finish - start) / m_element_size;
+    return false;
+}
+
+bool
+lldb_private::formatters::LibStdcppVectorSyntheticFrontEnd::MightHaveChildren ()
+{
+    return true;
+}
+
+size_t
+lldb_private::formatters::LibStdcppVectorSyntheticFrontEnd::GetIndexOfChildWithName (const ConstString &name)
+{
+    if (m_count == 0)
+        return UINT32_MAX;
+    return ExtractIndexFromString(name.GetCString());
+}
+
+lldb_private::formatters::LibStdcppVectorSyntheticFrontEnd::~LibStdcppVectorSyntheticFrontEnd ()
+{}
+
+SyntheticChildrenFrontEnd*
+lldb_private::formatters::LibStdcppVectorSyntheticFrontEndCreator (CXXSyntheticChildren*, lldb::ValueObjectSP valobj_sp)
+{
+    if (!valobj_sp)
+        return NULL;
+    return (new LibStdcppVectorSyntheticFrontEnd(valobj_sp));
+}
@@ -20,7 +20,8 @@ using namespace lldb_private;
 
 ClangPersistentVariables::ClangPersistentVariables () :
     ClangExpressionVariableList(),
-    m_next_persistent_variable_id (0)
+    m_next_persistent_variable_id (0),
+    m_declaration_generation (0)
 {
 }
 
@@ -41,7 +42,10 @@ ClangPersistentVariables::CreatePersistentVariable (ExecutionContextScope *exe_s
     ClangExpressionVariableSP var_sp (GetVariable(name));
     
     if (!var_sp)
+    {
         var_sp = CreateVariable(exe_scope, name, user_type, byte_order, addr_byte_size);
+        m_declaration_generation++;
+    }
 
     return var_sp;
 }
@@ -75,6 +79,7 @@ ClangPersistentVariables::RegisterPersistentType (const ConstString &name,
                                                   clang::TypeDecl *type_decl)
 {
     m_persistent_types.insert(std::pair<const char*, clang::TypeDecl*>(name.GetCString(), type_decl));
+    m_declaration_generation++;
 }
 
 clang::TypeDecl *
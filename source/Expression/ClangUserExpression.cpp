@@ -29,6 +29,7 @@
 #include "lldb/Expression/ClangModulesDeclVendor.h"
 #include "lldb/Expression/ClangPersistentVariables.h"
 #include "lldb/Expression/ClangUserExpression.h"
+#include "lldb/Expression/ClangUserExpressionCache.h"
 #include "lldb/Expression/ExpressionSourceCode.h"
 #include "lldb/Expression/IRExecutionUnit.h"
 #include "lldb/Expression/IRInterpreter.h"
@@ -781,6 +782,11 @@ ClangUserExpression::PrepareToExecuteJITExpression (Stream &error_stream,
             }
         }
 
+        // An interpreted expression doesn't need its temporaries in the
+        // process either
+        if (m_can_interpret)
+            m_materializer_ap->SetTemporaryAllocationPolicy(IRMemoryMap::eAllocationPolicyHostOnly);
+
         Error materialize_error;
 
         m_dematerializer_sp = m_materializer_ap->Materialize(frame, *m_execution_unit_sp, struct_address, materialize_error);
@@ -1043,13 +1049,8 @@ ClangUserExpression::Evaluate (ExecutionContext &exe_ctx,
     if (process == NULL || !process->CanJIT())
         execution_policy = eExecutionPolicyNever;
 
-    lldb::ClangUserExpressionSP user_expression_sp (new ClangUserExpression (expr_cstr, expr_prefix, language, desired_type));
-
     StreamString error_stream;
 
-    if (log)
-        log->Printf("== [ClangUserExpression::Evaluate] Parsing expression %s ==", expr_cstr);
-
     const bool keep_expression_in_memory = true;
     const bool generate_debug_info = options.GetGenerateDebugInfo();
 
@@ -1060,11 +1061,48 @@ ClangUserExpression::Evaluate (ExecutionContext &exe_ctx,
         return lldb::eExpressionInterrupted;
     }
 
-    if (!user_expression_sp->Parse (error_stream,
-                                    exe_ctx,
-                                    execution_policy,
-                                    keep_expression_in_memory,
-                                    generate_debug_info))
+    // Expressions with debug info add a module to the target for each
+    // parse, so they aren't worth keeping
+    Target *target = exe_ctx.GetTargetPtr();
+    ClangUserExpressionCache::Key cache_key;
+    const bool use_cache = target &&
+                           !generate_debug_info &&
+                           target->GetExpressionCacheSize() > 0 &&
+                           ClangUserExpressionCache::MakeKey (exe_ctx, expr_cstr, expr_prefix, language, desired_type, execution_policy, cache_key);
+
+    lldb::ClangUserExpressionSP user_expression_sp;
+    if (use_cache)
+        user_expression_sp = target->GetUserExpressionCache().Find (cache_key);
+
+    bool parsed = true;
+    if (user_expression_sp)
+    {
+        if (log)
+            log->Printf("== [ClangUserExpression::Evaluate] Reusing parsed expression %s ==", expr_cstr);
+
+        user_expression_sp->ReuseInContext (exe_ctx);
+    }
+    else
+    {
+        if (log)
+            log->Printf("== [ClangUserExpression::Evaluate] Parsing expression %s ==", expr_cstr);
+
+        user_expression_sp.reset (new ClangUserExpression (expr_cstr, expr_prefix, language, desired_type));
+
+        parsed = user_expression_sp->Parse (error_stream,
+                                            exe_ctx,
+                                            execution_policy,
+                                            keep_expression_in_memory,
+                                            generate_debug_info);
+
+        // An expression that declared something would declare it again if
+        // it were run again, so only keep expressions that didn't
+        if (parsed && use_cache &&
+            target->GetPersistentVariables().GetDeclarationGeneration() == cache_key.declaration_generation)
+            target->GetUserExpressionCache().Add (cache_key, user_expression_sp, target->GetExpressionCacheSize());
+    }
+
+    if (!parsed)
     {
         execution_results = lldb::eExpressionParseError;
         if (error_stream.GetString().empty())
@@ -1115,6 +1153,11 @@ ClangUserExpression::Evaluate (ExecutionContext &exe_ctx,
                 if (log)
                     log->Printf("== [ClangUserExpression::Evaluate] Execution completed abnormally ==");
 
+                // Its materialized state may still be in use on the stack
+                // of the thread that stopped, so don't hand it out again
+                if (use_cache)
+                    target->GetUserExpressionCache().Remove (cache_key);
+
                 if (error_stream.GetString().empty())
                     error.SetExpressionError (execution_results, "expression failed to execute, unknown error");
                 else
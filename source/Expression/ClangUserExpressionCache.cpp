@@ -0,0 +1,175 @@
+//===-- ClangUserExpressionCache.cpp ----------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "lldb/Expression/ClangUserExpressionCache.h"
+
+// C Includes
+// C++ Includes
+#include <vector>
+
+// Other libraries and framework includes
+// Project includes
+#include "lldb/Expression/ClangPersistentVariables.h"
+#include "lldb/Expression/ClangUserExpression.h"
+#include "lldb/Symbol/SymbolContext.h"
+#include "lldb/Target/ExecutionContext.h"
+#include "lldb/Target/StackFrame.h"
+#include "lldb/Target/Target.h"
+
+using namespace lldb;
+using namespace lldb_private;
+
+bool
+ClangUserExpressionCache::Key::operator < (const Key &rhs) const
+{
+    if (decl_context != rhs.decl_context)
+        return decl_context < rhs.decl_context;
+    if (process != rhs.process)
+        return process < rhs.process;
+    if (modules_generation != rhs.modules_generation)
+        return modules_generation < rhs.modules_generation;
+    if (declaration_generation != rhs.declaration_generation)
+        return declaration_generation < rhs.declaration_generation;
+    if (language != rhs.language)
+        return language < rhs.language;
+    if (desired_type != rhs.desired_type)
+        return desired_type < rhs.desired_type;
+    if (execution_policy != rhs.execution_policy)
+        return execution_policy < rhs.execution_policy;
+    if (expr_text != rhs.expr_text)
+        return expr_text < rhs.expr_text;
+    return expr_prefix < rhs.expr_prefix;
+}
+
+ClangUserExpressionCache::ClangUserExpressionCache () :
+    m_mutex (Mutex::eMutexTypeNormal),
+    m_entries (),
+    m_entry_map ()
+{
+}
+
+ClangUserExpressionCache::~ClangUserExpressionCache ()
+{
+}
+
+bool
+ClangUserExpressionCache::MakeKey (ExecutionContext &exe_ctx,
+                                   const char *expr_text,
+                                   const char *expr_prefix,
+                                   lldb::LanguageType language,
+                                   ClangExpression::ResultType desired_type,
+                                   ExecutionPolicy execution_policy,
+                                   Key &key)
+{
+    Target *target = exe_ctx.GetTargetPtr();
+    if (target == NULL || expr_text == NULL)
+        return false;
+
+    // The variables an expression can see are the ones in scope in its
+    // block, so it can be reused anywhere in that block. Without debug
+    // info the best we can do is the function's symbol.
+    key.decl_context = NULL;
+    StackFrame *frame = exe_ctx.GetFramePtr();
+    if (frame)
+    {
+        const SymbolContext &sc = frame->GetSymbolContext (eSymbolContextBlock | eSymbolContextSymbol);
+        if (sc.block)
+            key.decl_context = sc.block;
+        else if (sc.symbol)
+            key.decl_context = sc.symbol;
+        else
+            return false;
+    }
+
+    key.expr_text = expr_text;
+    key.expr_prefix = expr_prefix ? expr_prefix : "";
+    key.language = language;
+    key.desired_type = desired_type;
+    key.execution_policy = execution_policy;
+    key.process = exe_ctx.GetProcessPtr();
+    key.modules_generation = target->GetModulesGeneration();
+    key.declaration_generation = target->GetPersistentVariables().GetDeclarationGeneration();
+    return true;
+}
+
+ClangUserExpressionSP
+ClangUserExpressionCache::Find (const Key &key)
+{
+    Mutex::Locker locker (m_mutex);
+    EntryMap::iterator pos = m_entry_map.find (key);
+    if (pos == m_entry_map.end())
+        return ClangUserExpressionSP();
+
+    // An expression that is still running, or that was left on a thread's
+    // stack after it stopped, has its materialized state in use
+    if (!pos->second->second.unique())
+        return ClangUserExpressionSP();
+
+    m_entries.splice (m_entries.begin(), m_entries, pos->second);
+    return pos->second->second;
+}
+
+void
+ClangUserExpressionCache::Add (const Key &key, const ClangUserExpressionSP &expr_sp, size_t max_entries)
+{
+    // Declared before the locker so that evicted expressions are destroyed
+    // after the lock is released, since that frees their memory in the
+    // process
+    std::vector<ClangUserExpressionSP> evicted;
+
+    Mutex::Locker locker (m_mutex);
+    if (max_entries == 0)
+        return;
+
+    EntryMap::iterator pos = m_entry_map.find (key);
+    if (pos != m_entry_map.end())
+    {
+        evicted.push_back (pos->second->second);
+        pos->second->second = expr_sp;
+        m_entries.splice (m_entries.begin(), m_entries, pos->second);
+    }
+    else
+    {
+        m_entries.push_front (std::make_pair (key, expr_sp));
+        m_entry_map[key] = m_entries.begin();
+    }
+
+    while (m_entries.size() > max_entries)
+    {
+        EntryList::iterator last = --m_entries.end();
+        evicted.push_back (last->second);
+        m_entry_map.erase (last->first);
+        m_entries.erase (last);
+    }
+}
+
+void
+ClangUserExpressionCache::Remove (const Key &key)
+{
+    ClangUserExpressionSP removed_sp;
+
+    Mutex::Locker locker (m_mutex);
+    EntryMap::iterator pos = m_entry_map.find (key);
+    if (pos != m_entry_map.end())
+    {
+        removed_sp = pos->second->second;
+        m_entries.erase (pos->second);
+        m_entry_map.erase (pos);
+    }
+}
+
+void
+ClangUserExpressionCache::Clear ()
+{
+    EntryList entries;
+
+    Mutex::Locker locker (m_mutex);
+    entries.swap (m_entries);
+    m_entry_map.clear();
+}
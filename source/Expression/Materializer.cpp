@@ -533,7 +533,7 @@ public:
                 
                 Error alloc_error;
                 
-                m_temporary_allocation = map.Malloc(data.GetByteSize(), byte_align, lldb::ePermissionsReadable | lldb::ePermissionsWritable, IRMemoryMap::eAllocationPolicyMirror, alloc_error);
+                m_temporary_allocation = map.Malloc(data.GetByteSize(), byte_align, lldb::ePermissionsReadable | lldb::ePermissionsWritable, m_temporary_policy, alloc_error);
                 m_temporary_allocation_size = data.GetByteSize();
                 
                 m_original_data.reset(new DataBufferHeap(data.GetDataStart(), data.GetByteSize()));
@@ -790,7 +790,7 @@ public:
             
             Error alloc_error;
             
-            m_temporary_allocation = map.Malloc(byte_size, byte_align, lldb::ePermissionsReadable | lldb::ePermissionsWritable, IRMemoryMap::eAllocationPolicyMirror, alloc_error);
+            m_temporary_allocation = map.Malloc(byte_size, byte_align, lldb::ePermissionsReadable | lldb::ePermissionsWritable, m_temporary_policy, alloc_error);
             m_temporary_allocation_size = byte_size;
             
             if (!alloc_error.Success())
@@ -1349,6 +1349,13 @@ Materializer::~Materializer ()
         dematerializer_sp->Wipe();
 }
 
+void
+Materializer::SetTemporaryAllocationPolicy (IRMemoryMap::AllocationPolicy policy)
+{
+    for (EntityUP &entity_up : m_entities)
+        entity_up->SetTemporaryAllocationPolicy(policy);
+}
+
 Materializer::DematerializerSP
 Materializer::Materialize (lldb::StackFrameSP &frame_sp, IRMemoryMap &map, lldb::addr_t process_address, Error &error)
 {
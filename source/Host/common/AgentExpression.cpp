@@ -0,0 +1,317 @@
+//===-- AgentExpression.cpp -------------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "lldb/Host/common/AgentExpression.h"
+
+using namespace lldb_private;
+
+namespace
+{
+    // The bytecodes from GDB's agent expression format that we evaluate
+    enum AgentOpcode
+    {
+        eOpcodeAdd          = 0x02,
+        eOpcodeSub          = 0x03,
+        eOpcodeMul          = 0x04,
+        eOpcodeDivSigned    = 0x05,
+        eOpcodeDivUnsigned  = 0x06,
+        eOpcodeRemSigned    = 0x07,
+        eOpcodeRemUnsigned  = 0x08,
+        eOpcodeLsh          = 0x09,
+        eOpcodeRshSigned    = 0x0a,
+        eOpcodeRshUnsigned  = 0x0b,
+        eOpcodeLogNot       = 0x0e,
+        eOpcodeBitAnd       = 0x0f,
+        eOpcodeBitOr        = 0x10,
+        eOpcodeBitXor       = 0x11,
+        eOpcodeBitNot       = 0x12,
+        eOpcodeEqual        = 0x13,
+        eOpcodeLessSigned   = 0x14,
+        eOpcodeLessUnsigned = 0x15,
+        eOpcodeExt          = 0x16,
+        eOpcodeRef8         = 0x17,
+        eOpcodeRef16        = 0x18,
+        eOpcodeRef32        = 0x19,
+        eOpcodeRef64        = 0x1a,
+        eOpcodeIfGoto       = 0x20,
+        eOpcodeGoto         = 0x21,
+        eOpcodeConst8       = 0x22,
+        eOpcodeConst16      = 0x23,
+        eOpcodeConst32      = 0x24,
+        eOpcodeConst64      = 0x25,
+        eOpcodeReg          = 0x26,
+        eOpcodeEnd          = 0x27,
+        eOpcodeDup          = 0x28,
+        eOpcodePop          = 0x29,
+        eOpcodeZeroExt      = 0x2a,
+        eOpcodeSwap         = 0x2b,
+        eOpcodePick         = 0x32,
+        eOpcodeRot          = 0x33
+    };
+
+    // GDB's own agent has a stack of this many entries
+    const size_t k_max_stack_size = 100;
+
+    // Expressions can jump backwards, so put a bound on how long one can run
+    const size_t k_max_steps = 100000;
+}
+
+static Error
+TruncatedOperandError (size_t opcode_offset)
+{
+    Error error;
+    error.SetErrorStringWithFormat ("agent expression operand at offset %" PRIu64 " is truncated", (uint64_t)opcode_offset);
+    return error;
+}
+
+AgentExpression::AgentExpression () :
+    m_bytes ()
+{
+}
+
+AgentExpression::AgentExpression (const uint8_t *bytes, size_t size) :
+    m_bytes (bytes, bytes + size)
+{
+}
+
+Error
+AgentExpression::Evaluate (const ReadRegisterFunc &read_register,
+                           const ReadMemoryFunc &read_memory,
+                           uint64_t &result) const
+{
+    Error error;
+    std::vector<uint64_t> stack;
+    const size_t size = m_bytes.size ();
+    size_t pc = 0;
+
+    // Immediate operands are big endian no matter what the target is
+    auto read_operand = [&] (size_t operand_size, uint64_t &value) -> bool
+    {
+        if (pc + operand_size > size)
+            return false;
+        value = 0;
+        for (size_t i = 0; i < operand_size; ++i)
+            value = (value << 8) | m_bytes[pc++];
+        return true;
+    };
+
+    for (size_t steps = 0; steps < k_max_steps; ++steps)
+    {
+        if (pc >= size)
+        {
+            error.SetErrorString ("agent expression ran off its end");
+            return error;
+        }
+
+        const size_t opcode_offset = pc;
+        const uint8_t opcode = m_bytes[pc++];
+
+        // Check there are enough operands on the stack before doing anything
+        size_t needed = 0;
+        switch (opcode)
+        {
+            case eOpcodeAdd: case eOpcodeSub: case eOpcodeMul:
+            case eOpcodeDivSigned: case eOpcodeDivUnsigned:
+            case eOpcodeRemSigned: case eOpcodeRemUnsigned:
+            case eOpcodeLsh: case eOpcodeRshSigned: case eOpcodeRshUnsigned:
+            case eOpcodeBitAnd: case eOpcodeBitOr: case eOpcodeBitXor:
+            case eOpcodeEqual: case eOpcodeLessSigned: case eOpcodeLessUnsigned:
+            case eOpcodeSwap:
+                needed = 2;
+                break;
+            case eOpcodeRot:
+                needed = 3;
+                break;
+            case eOpcodeLogNot: case eOpcodeBitNot: case eOpcodeExt: case eOpcodeZeroExt:
+            case eOpcodeRef8: case eOpcodeRef16: case eOpcodeRef32: case eOpcodeRef64:
+            case eOpcodeIfGoto: case eOpcodeEnd: case eOpcodeDup: case eOpcodePop:
+                needed = 1;
+                break;
+            default:
+                break;
+        }
+        if (stack.size () < needed)
+        {
+            error.SetErrorStringWithFormat ("agent expression stack underflow at offset %" PRIu64, (uint64_t)opcode_offset);
+            return error;
+        }
+
+        uint64_t operand = 0;
+        switch (opcode)
+        {
+            case eOpcodeAdd: case eOpcodeSub: case eOpcodeMul:
+            case eOpcodeDivSigned: case eOpcodeDivUnsigned:
+            case eOpcodeRemSigned: case eOpcodeRemUnsigned:
+            case eOpcodeLsh: case eOpcodeRshSigned: case eOpcodeRshUnsigned:
+            case eOpcodeBitAnd: case eOpcodeBitOr: case eOpcodeBitXor:
+            case eOpcodeEqual: case eOpcodeLessSigned: case eOpcodeLessUnsigned:
+            {
+                // The top of the stack is the right hand side
+                const uint64_t b = stack.back ();
+                stack.pop_back ();
+                const uint64_t a = stack.back ();
+                uint64_t value = 0;
+                switch (opcode)
+                {
+                    case eOpcodeAdd:            value = a + b; break;
+                    case eOpcodeSub:            value = a - b; break;
+                    case eOpcodeMul:            value = a * b; break;
+                    case eOpcodeLsh:            value = b < 64 ? a << b : 0; break;
+                    case eOpcodeRshSigned:      value = (uint64_t)((int64_t)a >> (b < 64 ? b : 63)); break;
+                    case eOpcodeRshUnsigned:    value = b < 64 ? a >> b : 0; break;
+                    case eOpcodeBitAnd:         value = a & b; break;
+                    case eOpcodeBitOr:          value = a | b; break;
+                    case eOpcodeBitXor:         value = a ^ b; break;
+                    case eOpcodeEqual:          value = a == b; break;
+                    case eOpcodeLessSigned:     value = (int64_t)a < (int64_t)b; break;
+                    case eOpcodeLessUnsigned:   value = a < b; break;
+                    default:
+                        if (b == 0)
+                        {
+                            error.SetErrorStringWithFormat ("agent expression divides by zero at offset %" PRIu64, (uint64_t)opcode_offset);
+                            return error;
+                        }
+                        if (opcode == eOpcodeDivSigned)
+                            value = (int64_t)b == -1 ? 0 - a : (uint64_t)((int64_t)a / (int64_t)b);
+                        else if (opcode == eOpcodeRemSigned)
+                            value = (int64_t)b == -1 ? 0 : (uint64_t)((int64_t)a % (int64_t)b);
+                        else if (opcode == eOpcodeDivUnsigned)
+                            value = a / b;
+                        else
+                            value = a % b;
+                        break;
+                }
+                stack.back () = value;
+                break;
+            }
+
+            case eOpcodeLogNot:
+                stack.back () = stack.back () == 0;
+                break;
+
+            case eOpcodeBitNot:
+                stack.back () = ~stack.back ();
+                break;
+
+            case eOpcodeExt:
+            case eOpcodeZeroExt:
+                if (!read_operand (1, operand))
+                    return TruncatedOperandError (opcode_offset);
+                if (operand > 0 && operand < 64)
+                {
+                    const uint64_t mask = (1ull << operand) - 1;
+                    uint64_t value = stack.back () & mask;
+                    if (opcode == eOpcodeExt && (value & (1ull << (operand - 1))))
+                        value |= ~mask;
+                    stack.back () = value;
+                }
+                continue;
+
+            case eOpcodeRef8:
+            case eOpcodeRef16:
+            case eOpcodeRef32:
+            case eOpcodeRef64:
+            {
+                const size_t byte_size = 1u << (opcode - eOpcodeRef8);
+                uint64_t value = 0;
+                error = read_memory (stack.back (), byte_size, value);
+                if (error.Fail ())
+                    return error;
+                stack.back () = value;
+                break;
+            }
+
+            case eOpcodeIfGoto:
+            case eOpcodeGoto:
+                if (!read_operand (2, operand))
+                    return TruncatedOperandError (opcode_offset);
+                if (opcode == eOpcodeIfGoto)
+                {
+                    const uint64_t condition = stack.back ();
+                    stack.pop_back ();
+                    if (condition == 0)
+                        continue;
+                }
+                pc = operand;
+                continue;
+
+            case eOpcodeConst8:
+            case eOpcodeConst16:
+            case eOpcodeConst32:
+            case eOpcodeConst64:
+                if (!read_operand (1u << (opcode - eOpcodeConst8), operand))
+                    return TruncatedOperandError (opcode_offset);
+                stack.push_back (operand);
+                break;
+
+            case eOpcodeReg:
+            {
+                if (!read_operand (2, operand))
+                    return TruncatedOperandError (opcode_offset);
+                uint64_t value = 0;
+                error = read_register ((uint32_t)operand, value);
+                if (error.Fail ())
+                    return error;
+                stack.push_back (value);
+                break;
+            }
+
+            case eOpcodeEnd:
+                result = stack.back ();
+                return error;
+
+            case eOpcodeDup:
+                stack.push_back (stack.back ());
+                break;
+
+            case eOpcodePop:
+                stack.pop_back ();
+                continue;
+
+            case eOpcodeSwap:
+                std::swap (stack[stack.size () - 1], stack[stack.size () - 2]);
+                continue;
+
+            case eOpcodePick:
+                if (!read_operand (1, operand))
+                    return TruncatedOperandError (opcode_offset);
+                if (operand >= stack.size ())
+                {
+                    error.SetErrorStringWithFormat ("agent expression stack underflow at offset %" PRIu64, (uint64_t)opcode_offset);
+                    return error;
+                }
+                stack.push_back (stack[stack.size () - 1 - operand]);
+                break;
+
+            case eOpcodeRot:
+            {
+                // a b c => c a b
+                const size_t top = stack.size () - 1;
+                const uint64_t c = stack[top];
+                stack[top] = stack[top - 1];
+                stack[top - 1] = stack[top - 2];
+                stack[top - 2] = c;
+                continue;
+            }
+
+            default:
+                error.SetErrorStringWithFormat ("unsupported agent expression bytecode 0x%2.2x at offset %" PRIu64, opcode, (uint64_t)opcode_offset);
+                return error;
+        }
+
+        if (stack.size () > k_max_stack_size)
+        {
+            error.SetErrorString ("agent expression stack overflow");
+            return error;
+        }
+    }
+
+    error.SetErrorString ("agent expression took too many steps");
+    return error;
+}
@@ -18,6 +18,9 @@ using namespace lldb_private;
 NativeBreakpoint::NativeBreakpoint (lldb::addr_t addr) :
     m_addr (addr),
     m_ref_count (1),
+    m_conditions (),
+    m_hit_count (0),
+    m_skipped_hit_count (0),
     m_enabled (true)
 {
     assert (addr != LLDB_INVALID_ADDRESS && "breakpoint set for invalid address");
@@ -114,3 +117,33 @@ NativeBreakpoint::Disable ()
 
     return error;
 }
+
+bool
+NativeBreakpoint::ConditionSaysStop (const AgentExpression::ReadRegisterFunc &read_register,
+                                     const AgentExpression::ReadMemoryFunc &read_memory)
+{
+    Log *log (GetLogIfAnyCategoriesSet (LIBLLDB_LOG_BREAKPOINTS));
+
+    if (m_conditions.empty () || !read_register || !read_memory)
+        return true;
+
+    for (const AgentExpression &condition : m_conditions)
+    {
+        uint64_t result = 0;
+        Error error = condition.Evaluate (read_register, read_memory, result);
+        if (error.Fail ())
+        {
+            // Let the debugger sort out a condition we couldn't evaluate.
+            if (log)
+                log->Printf ("NativeBreakpoint::%s addr = 0x%" PRIx64 " condition failed: %s", __FUNCTION__, m_addr, error.AsCString ());
+            return true;
+        }
+        if (result != 0)
+            return true;
+    }
+
+    ++m_skipped_hit_count;
+    if (log)
+        log->Printf ("NativeBreakpoint::%s addr = 0x%" PRIx64 " conditions are false, skipped %" PRIu64 " of %" PRIu64 " hits", __FUNCTION__, m_addr, m_skipped_hit_count, m_hit_count);
+    return false;
+}
@@ -11,7 +11,9 @@
 
 #include "lldb/lldb-enumerations.h"
 #include "lldb/Core/ArchSpec.h"
+#include "lldb/Core/DataExtractor.h"
 #include "lldb/Core/Log.h"
+#include "lldb/Core/RegisterValue.h"
 #include "lldb/Core/State.h"
 #include "lldb/Host/Host.h"
 #include "lldb/Host/common/NativeRegisterContext.h"
@@ -391,6 +393,90 @@ NativeProcessProtocol::DisableBreakpoint (lldb::addr_t addr)
     return m_breakpoint_list.DisableBreakpoint (addr);
 }
 
+Error
+NativeProcessProtocol::SetBreakpointConditions (lldb::addr_t addr, std::vector<AgentExpression> &&conditions)
+{
+    NativeBreakpointSP breakpoint_sp;
+    Error error = m_breakpoint_list.GetBreakpoint (addr, breakpoint_sp);
+    if (error.Fail ())
+        return error;
+    breakpoint_sp->SetConditions (std::move (conditions));
+    return error;
+}
+
+Error
+NativeProcessProtocol::GetBreakpointHitCounts (lldb::addr_t addr, uint64_t &hit_count, uint64_t &skipped_hit_count)
+{
+    NativeBreakpointSP breakpoint_sp;
+    Error error = m_breakpoint_list.GetBreakpoint (addr, breakpoint_sp);
+    if (error.Fail ())
+        return error;
+    hit_count = breakpoint_sp->GetHitCount ();
+    skipped_hit_count = breakpoint_sp->GetSkippedHitCount ();
+    return error;
+}
+
+void
+NativeProcessProtocol::CountBreakpointHit (lldb::addr_t addr)
+{
+    NativeBreakpointSP breakpoint_sp;
+    if (m_breakpoint_list.GetBreakpoint (addr, breakpoint_sp).Success () && breakpoint_sp)
+        breakpoint_sp->CountHit ();
+}
+
+bool
+NativeProcessProtocol::BreakpointConditionSaysStop (NativeThreadProtocol &thread, lldb::addr_t addr)
+{
+    NativeBreakpointSP breakpoint_sp;
+    if (m_breakpoint_list.GetBreakpoint (addr, breakpoint_sp).Fail () || !breakpoint_sp)
+        return true;
+
+    if (!breakpoint_sp->HasConditions ())
+        return breakpoint_sp->ConditionSaysStop (nullptr, nullptr);
+
+    NativeRegisterContextSP reg_ctx_sp = thread.GetRegisterContext ();
+    ByteOrder byte_order = eByteOrderInvalid;
+    if (!reg_ctx_sp || !GetByteOrder (byte_order))
+        return breakpoint_sp->ConditionSaysStop (nullptr, nullptr);
+
+    // Registers are numbered the way qRegisterInfo reports them
+    auto read_register = [&reg_ctx_sp] (uint32_t reg_num, uint64_t &value) -> Error
+    {
+        Error error;
+        const RegisterInfo *reg_info = reg_ctx_sp->GetRegisterInfoAtIndex (reg_num);
+        if (!reg_info)
+        {
+            error.SetErrorStringWithFormat ("invalid register number %" PRIu32, reg_num);
+            return error;
+        }
+        RegisterValue reg_value;
+        error = reg_ctx_sp->ReadRegister (reg_info, reg_value);
+        if (error.Success ())
+            value = reg_value.GetAsUInt64 ();
+        return error;
+    };
+
+    auto read_memory = [this, byte_order] (lldb::addr_t addr, size_t size, uint64_t &value) -> Error
+    {
+        uint8_t buffer[8];
+        size_t bytes_read = 0;
+        Error error = ReadMemoryWithoutTrap (addr, buffer, size, bytes_read);
+        if (error.Fail ())
+            return error;
+        if (bytes_read != size)
+        {
+            error.SetErrorStringWithFormat ("only read %" PRIu64 " of %" PRIu64 " bytes at 0x%" PRIx64, (uint64_t)bytes_read, (uint64_t)size, addr);
+            return error;
+        }
+        DataExtractor data (buffer, size, byte_order, size);
+        lldb::offset_t offset = 0;
+        value = data.GetMaxU64 (&offset, size);
+        return error;
+    };
+
+    return breakpoint_sp->ConditionSaysStop (read_register, read_memory);
+}
+
 lldb::StateType
 NativeProcessProtocol::GetState () const
 {
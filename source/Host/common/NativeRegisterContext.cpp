@@ -9,6 +9,7 @@
 
 #include "lldb/Host/common/NativeRegisterContext.h"
 
+#include "lldb/Core/DataBufferHeap.h"
 #include "lldb/Core/Log.h"
 #include "lldb/Core/RegisterValue.h"
 
@@ -484,6 +485,55 @@ NativeRegisterContext::WriteRegisterValueToMemory (
     return error;
 }
 
+Error
+NativeRegisterContext::ReadAllUserRegisterValues (lldb::DataBufferSP &data_sp)
+{
+    const uint32_t num_regs = GetUserRegisterCount ();
+
+    // Size the buffer to cover the register that ends the furthest out.
+    size_t byte_size = 0;
+    for (uint32_t reg_idx = 0; reg_idx < num_regs; ++reg_idx)
+    {
+        const RegisterInfo *reg_info = GetRegisterInfoAtIndex (reg_idx);
+        if (reg_info && (reg_info->byte_offset + reg_info->byte_size > byte_size))
+            byte_size = reg_info->byte_offset + reg_info->byte_size;
+    }
+
+    if (byte_size == 0)
+        return Error ("no user registers available");
+
+    data_sp.reset (new DataBufferHeap (byte_size, 0));
+    uint8_t *const dst = data_sp->GetBytes ();
+
+    for (uint32_t reg_idx = 0; reg_idx < num_regs; ++reg_idx)
+    {
+        const RegisterInfo *reg_info = GetRegisterInfoAtIndex (reg_idx);
+
+        // Skip registers that are slices of real registers, their bytes are
+        // provided by the containing register.
+        if (!reg_info || reg_info->value_regs)
+            continue;
+
+        // A "g" reply has no way to mark a register as unavailable, so fail
+        // the whole read rather than hand back zeros the client would trust.
+        RegisterValue reg_value;
+        Error read_error = ReadRegister (reg_info, reg_value);
+        if (read_error.Fail ())
+        {
+            data_sp.reset ();
+            Error error;
+            error.SetErrorStringWithFormat ("failed to read register %s: %s", reg_info->name, read_error.AsCString ());
+            return error;
+        }
+
+        const size_t reg_size = std::min<size_t> (reg_value.GetByteSize (), reg_info->byte_size);
+        if (reg_value.GetBytes () && reg_size > 0)
+            ::memcpy (dst + reg_info->byte_offset, reg_value.GetBytes (), reg_size);
+    }
+
+    return Error ();
+}
+
 uint32_t
 NativeRegisterContext::ConvertRegisterKindToRegisterNumber (uint32_t kind, uint32_t num) const
 {
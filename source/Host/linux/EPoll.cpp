@@ -0,0 +1,103 @@
+//===-- EPoll.cpp -----------------------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "lldb/Host/linux/EPoll.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/epoll.h>
+#include <unistd.h>
+
+using namespace lldb_private;
+
+EPoll::EPoll()
+    : m_fd(-1)
+{
+}
+
+EPoll::~EPoll()
+{
+    Close();
+}
+
+Error
+EPoll::Open()
+{
+    Error error;
+    Close();
+    // epoll_create1() isn't available on older Android releases
+    m_fd = ::epoll_create(1);
+    if (m_fd < 0)
+    {
+        error.SetErrorToErrno();
+        return error;
+    }
+    ::fcntl(m_fd, F_SETFD, FD_CLOEXEC);
+    return error;
+}
+
+void
+EPoll::Close()
+{
+    if (m_fd >= 0)
+    {
+        ::close(m_fd);
+        m_fd = -1;
+    }
+}
+
+Error
+EPoll::AddReadFileDescriptor(int fd, bool edge_triggered)
+{
+    Error error;
+    struct epoll_event event;
+    event.events = EPOLLIN | EPOLLRDHUP;
+    if (edge_triggered)
+        event.events |= EPOLLET;
+    event.data.fd = fd;
+    if (::epoll_ctl(m_fd, EPOLL_CTL_ADD, fd, &event) < 0)
+        error.SetErrorToErrno();
+    return error;
+}
+
+Error
+EPoll::RemoveFileDescriptor(int fd)
+{
+    Error error;
+    // Kernels before 2.6.9 want an event even though it is ignored
+    struct epoll_event event;
+    event.events = 0;
+    event.data.fd = fd;
+    if (::epoll_ctl(m_fd, EPOLL_CTL_DEL, fd, &event) < 0)
+        error.SetErrorToErrno();
+    return error;
+}
+
+Error
+EPoll::Wait(uint32_t timeout_usec, std::vector<int> &ready_fds)
+{
+    Error error;
+    ready_fds.clear();
+
+    // Round up so a short timeout doesn't turn into a poll
+    int timeout_msec = -1;
+    if (timeout_usec != UINT32_MAX)
+        timeout_msec = static_cast<int>((static_cast<uint64_t>(timeout_usec) + 999) / 1000);
+
+    struct epoll_event events[8];
+    const int num_events = ::epoll_wait(m_fd, events, sizeof(events) / sizeof(events[0]), timeout_msec);
+    if (num_events < 0)
+    {
+        error.SetErrorToErrno();
+        return error;
+    }
+    for (int i = 0; i < num_events; ++i)
+        ready_fds.push_back(events[i].data.fd);
+    return error;
+}
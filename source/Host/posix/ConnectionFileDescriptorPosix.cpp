@@ -32,7 +32,14 @@
 #include <termios.h>
 #endif
 
+#if defined(__linux__)
+#include <sys/socket.h>
+#endif
+
 // C++ Includes
+#include <algorithm>
+#include <vector>
+
 // Other libraries and framework includes
 #include "llvm/Support/ErrorHandling.h"
 #if defined(__APPLE__)
@@ -47,9 +54,145 @@
 #include "lldb/Host/Socket.h"
 #include "lldb/Interpreter/Args.h"
 
+#if defined(__linux__)
+#include "lldb/Host/linux/EPoll.h"
+#endif
+
 using namespace lldb;
 using namespace lldb_private;
 
+#if defined(__linux__)
+//----------------------------------------------------------------------
+// Reads a socket through a large buffer so that a burst of packets takes
+// one recv() instead of a select() and a small read() for every Read().
+// The socket is registered edge triggered with an epoll instance once,
+// and we only wait on it after recv() has emptied it. The command pipe is
+// registered level triggered so no interrupt or quit request is lost.
+//----------------------------------------------------------------------
+class ConnectionFileDescriptor::SocketReader
+{
+  public:
+    SocketReader(int socket_fd, int pipe_fd)
+        : m_socket_fd(socket_fd)
+        , m_pipe_fd(pipe_fd)
+        , m_epoll()
+        , m_buffer(64 * 1024)
+        , m_buffer_offset(0)
+        , m_buffer_size(0)
+        , m_drained(false)
+        , m_ready_fds()
+    {
+    }
+
+    Error
+    Initialize()
+    {
+        Error error = m_epoll.Open();
+        if (error.Success())
+            error = m_epoll.AddReadFileDescriptor(m_socket_fd, true);
+        if (error.Success() && m_pipe_fd >= 0)
+            error = m_epoll.AddReadFileDescriptor(m_pipe_fd, false);
+        return error;
+    }
+
+    bool
+    Matches(int socket_fd, int pipe_fd) const
+    {
+        return m_socket_fd == socket_fd && m_pipe_fd == pipe_fd;
+    }
+
+    // Returns eConnectionStatusSuccess when there was something to read,
+    // with bytes_read set to zero at end of file or if recv() failed, in
+    // which case error says why.
+    ConnectionStatus
+    Read(void *dst, size_t dst_len, uint32_t timeout_usec, size_t &bytes_read, Error &error)
+    {
+        bytes_read = 0;
+        while (m_buffer_offset == m_buffer_size)
+        {
+            if (!m_drained)
+            {
+                ssize_t n;
+                do
+                {
+                    n = ::recv(m_socket_fd, m_buffer.data(), m_buffer.size(), MSG_DONTWAIT);
+                } while (n < 0 && errno == EINTR);
+
+                if (n > 0)
+                {
+                    m_buffer_offset = 0;
+                    m_buffer_size = n;
+                    // A short read took all the queued data, so any new data
+                    // triggers a new edge
+                    m_drained = static_cast<size_t>(n) < m_buffer.size();
+                    break;
+                }
+                if (n == 0)
+                    return eConnectionStatusSuccess; // End of file
+                if (errno != EAGAIN && errno != EWOULDBLOCK)
+                {
+                    error.SetErrorToErrno();
+                    return eConnectionStatusSuccess;
+                }
+                m_drained = true;
+            }
+
+            error = m_epoll.Wait(timeout_usec, m_ready_fds);
+            if (error.Fail())
+            {
+                if (error.GetError() == EINTR)
+                {
+                    error.Clear();
+                    continue;
+                }
+                return eConnectionStatusError;
+            }
+            if (m_ready_fds.empty())
+                return eConnectionStatusTimedOut;
+
+            // Like the select() version, data on the socket wins over the
+            // command pipe, which stays readable for the next Read()
+            bool pipe_ready = false;
+            for (int fd : m_ready_fds)
+            {
+                if (fd == m_socket_fd)
+                    m_drained = false;
+                else if (fd == m_pipe_fd)
+                    pipe_ready = true;
+            }
+            if (!m_drained || !pipe_ready)
+                continue;
+
+            char command = 0;
+            ssize_t command_bytes;
+            do
+            {
+                command_bytes = ::read(m_pipe_fd, &command, 1);
+            } while (command_bytes < 0 && errno == EINTR);
+            if (command == 'q')
+                return eConnectionStatusEndOfFile;
+            if (command == 'i')
+                return eConnectionStatusInterrupted;
+        }
+
+        bytes_read = std::min(dst_len, m_buffer_size - m_buffer_offset);
+        ::memcpy(dst, m_buffer.data() + m_buffer_offset, bytes_read);
+        m_buffer_offset += bytes_read;
+        return eConnectionStatusSuccess;
+    }
+
+  private:
+    const int m_socket_fd;
+    const int m_pipe_fd;
+    EPoll m_epoll;
+    std::vector<uint8_t> m_buffer;
+    size_t m_buffer_offset;     // The next byte to hand out
+    size_t m_buffer_size;       // The number of bytes in m_buffer
+    bool m_drained;             // recv() got all there was, so wait for the next edge
+    std::vector<int> m_ready_fds;
+};
+#endif
+
 ConnectionFileDescriptor::ConnectionFileDescriptor(bool child_processes_inherit)
     : Connection()
     , m_pipe()
@@ -372,6 +515,11 @@ ConnectionFileDescriptor::Disconnect(Error *error_ptr)
     if (error_ptr)
         *error_ptr = error.Fail() ? error : error2;
 
+#if defined(__linux__)
+    // Drop anything buffered from the old connection
+    m_socket_reader_up.reset();
+#endif
+
     m_uri.clear();
     m_shutting_down = false;
     return status;
@@ -401,13 +549,30 @@ ConnectionFileDescriptor::Read(void *dst, size_t dst_len, uint32_t timeout_usec,
         return 0;
     }
 
-    status = BytesAvailable(timeout_usec, error_ptr);
-    if (status != eConnectionStatusSuccess)
-        return 0;
-
     Error error;
-    size_t bytes_read = dst_len;
-    error = m_read_sp->Read(dst, bytes_read);
+    size_t bytes_read = 0;
+#if defined(__linux__)
+    SocketReader *socket_reader = GetSocketReader();
+    if (socket_reader)
+    {
+        status = socket_reader->Read(dst, dst_len, timeout_usec, bytes_read, error);
+        if (status != eConnectionStatusSuccess)
+        {
+            if (error_ptr)
+                *error_ptr = error;
+            return 0;
+        }
+    }
+    else
+#endif
+    {
+        status = BytesAvailable(timeout_usec, error_ptr);
+        if (status != eConnectionStatusSuccess)
+            return 0;
+
+        bytes_read = dst_len;
+        error = m_read_sp->Read(dst, bytes_read);
+    }
 
     if (log)
     {
@@ -542,7 +707,8 @@ ConnectionFileDescriptor::GetURI()
     return m_uri;
 }
 
-// This ConnectionFileDescriptor::BytesAvailable() uses select().
+// This ConnectionFileDescriptor::BytesAvailable() uses select(). On Linux,
+// Read() waits for sockets with SocketReader instead.
 //
 // PROS:
 //  - select is consistent across most unix platforms
@@ -850,6 +1016,51 @@ ConnectionFileDescriptor::SetChildProcessesInherit(bool child_processes_inherit)
     m_child_processes_inherit = child_processes_inherit;
 }
 
+#if defined(__linux__)
+ConnectionFileDescriptor::SocketReader *
+ConnectionFileDescriptor::GetSocketReader()
+{
+    // Only sockets can be read without blocking through MSG_DONTWAIT, all
+    // other descriptors keep using select()
+    if (!m_read_sp || !m_read_sp->IsValid() || m_read_sp->GetFdType() != IOObject::eFDTypeSocket)
+    {
+        m_socket_reader_up.reset();
+        return nullptr;
+    }
+
+    const int socket_fd = m_read_sp->GetWaitableHandle();
+    const int pipe_fd = m_pipe.GetReadFileDescriptor();
+    if (m_socket_reader_up && m_socket_reader_up->Matches(socket_fd, pipe_fd))
+        return m_socket_reader_up.get();
+
+    // SocketReader takes a short recv() to mean the socket is empty, which
+    // only holds for stream sockets. A datagram socket returns one datagram
+    // per recv() with more still queued, and we'd wait for an edge that
+    // never comes.
+    int socket_type = 0;
+    socklen_t socket_type_len = sizeof(socket_type);
+    if (::getsockopt(socket_fd, SOL_SOCKET, SO_TYPE, &socket_type, &socket_type_len) != 0 || socket_type != SOCK_STREAM)
+    {
+        m_socket_reader_up.reset();
+        return nullptr;
+    }
+
+    std::unique_ptr<SocketReader> socket_reader_up(new SocketReader(socket_fd, pipe_fd));
+    Error error = socket_reader_up->Initialize();
+    if (error.Fail())
+    {
+        Log *log(lldb_private::GetLogIfAnyCategoriesSet(LIBLLDB_LOG_CONNECTION));
+        if (log)
+            log->Printf("%p ConnectionFileDescriptor::GetSocketReader() - falling back to select: %s", static_cast<void *>(this),
+                        error.AsCString());
+        m_socket_reader_up.reset();
+        return nullptr;
+    }
+    m_socket_reader_up = std::move(socket_reader_up);
+    return m_socket_reader_up.get();
+}
+#endif
+
 void
 ConnectionFileDescriptor::InitializeSocket(Socket* socket)
 {
@@ -14,6 +14,7 @@
 
 #include "lldb/Core/ArchSpec.h"
 #include "lldb/Core/DataBuffer.h"
+#include "lldb/Core/DataBufferHeap.h"
 #include "lldb/Core/Error.h"
 #include "lldb/Core/FileSpecList.h"
 #include "lldb/Core/Log.h"
@@ -29,7 +30,9 @@
 #include "lldb/Target/Target.h"
 
 #include "llvm/ADT/PointerUnion.h"
+#include "llvm/ADT/SmallVector.h"
 #include "llvm/ADT/StringRef.h"
+#include "llvm/Support/Compression.h"
 #include "llvm/Support/MathExtras.h"
 
 #define CASE_AND_STREAM(s, def, width)                  \
@@ -788,7 +791,10 @@ ObjectFileELF::ObjectFileELF (const lldb::ModuleSP &module_sp,
     m_dynamic_symbols(),
     m_filespec_ap(),
     m_entry_point_address(),
-    m_arch_spec()
+    m_arch_spec(),
+    m_decompressed_sections_mutex(Mutex::eMutexTypeNormal),
+    m_decompressed_sections(),
+    m_decompressed_sections_byte_size(0)
 {
     if (file)
         m_file = *file;
@@ -809,7 +815,10 @@ ObjectFileELF::ObjectFileELF (const lldb::ModuleSP &module_sp,
     m_dynamic_symbols(),
     m_filespec_ap(),
     m_entry_point_address(),
-    m_arch_spec()
+    m_arch_spec(),
+    m_decompressed_sections_mutex(Mutex::eMutexTypeNormal),
+    m_decompressed_sections(),
+    m_decompressed_sections_byte_size(0)
 {
     ::memset(&m_header, 0, sizeof(m_header));
 }
@@ -1516,6 +1525,176 @@ ObjectFileELF::StripLinkerSymbolAnnotations(llvm::StringRef symbol_name) const
     return symbol_name.substr(0, pos).str();
 }
 
+// The flag and compression type of sections with a compression header,
+// they might not be in the ELF definitions we build against.
+static const elf_xword g_shf_compressed = 0x800;
+static const elf_word g_elfcompress_zlib = 1;
+
+// Keep up to this many bytes of uncompressed section contents around so
+// that sections read by several clients are only inflated once. The
+// buffers handed out stay valid after they are evicted.
+static const size_t g_max_decompressed_sections_byte_size = 256 * 1024 * 1024;
+
+bool
+ObjectFileELF::SectionIsCompressed (const Section *section) const
+{
+    // If some other objectfile owns this section, pass this to them.
+    if (section->GetObjectFile() != this)
+        return section->GetObjectFile()->SectionIsCompressed (section);
+
+    if (IsInMemory() || section->GetFileSize() == 0)
+        return false;
+    return section->Test(g_shf_compressed) ||
+           section->GetName().GetStringRef().startswith(".zdebug");
+}
+
+size_t
+ObjectFileELF::ReadSectionData (const Section *section,
+                                lldb::offset_t section_offset,
+                                void *dst,
+                                size_t dst_len) const
+{
+    if (!SectionIsCompressed (section) || section->GetObjectFile() != this)
+        return ObjectFile::ReadSectionData (section, section_offset, dst, dst_len);
+
+    DataBufferSP data_sp (GetDecompressedSectionData (section));
+    if (!data_sp || section_offset >= data_sp->GetByteSize())
+        return 0;
+    const size_t bytes_left = data_sp->GetByteSize() - section_offset;
+    if (dst_len > bytes_left)
+        dst_len = bytes_left;
+    ::memcpy (dst, data_sp->GetBytes() + section_offset, dst_len);
+    return dst_len;
+}
+
+size_t
+ObjectFileELF::ReadSectionData (const Section *section,
+                                DataExtractor& section_data) const
+{
+    if (!SectionIsCompressed (section) || section->GetObjectFile() != this)
+        return ObjectFile::ReadSectionData (section, section_data);
+
+    DataBufferSP data_sp (GetDecompressedSectionData (section));
+    if (!data_sp)
+    {
+        section_data.Clear();
+        return 0;
+    }
+    section_data.SetData (data_sp, 0, data_sp->GetByteSize());
+    section_data.SetByteOrder (m_data.GetByteOrder());
+    section_data.SetAddressByteSize (m_data.GetAddressByteSize());
+    return section_data.GetByteSize();
+}
+
+DataBufferSP
+ObjectFileELF::GetDecompressedSectionData (const Section *section) const
+{
+    const user_id_t section_id = section->GetID();
+    {
+        Mutex::Locker locker (m_decompressed_sections_mutex);
+        for (DecompressedSectionColl::iterator pos = m_decompressed_sections.begin(), end = m_decompressed_sections.end(); pos != end; ++pos)
+        {
+            if (pos->first == section_id)
+            {
+                m_decompressed_sections.splice (m_decompressed_sections.begin(), m_decompressed_sections, pos);
+                return pos->second;
+            }
+        }
+    }
+
+    // Inflate without holding the lock so different sections can be
+    // decompressed on different threads at the same time.
+    DataBufferSP data_sp (DecompressSectionData (section));
+    const size_t byte_size = data_sp ? data_sp->GetByteSize() : 0;
+    if (byte_size > g_max_decompressed_sections_byte_size)
+        return data_sp;
+
+    Mutex::Locker locker (m_decompressed_sections_mutex);
+    for (const DecompressedSection &decompressed_section : m_decompressed_sections)
+    {
+        // Another thread beat us to it
+        if (decompressed_section.first == section_id)
+            return decompressed_section.second;
+    }
+    m_decompressed_sections.push_front (DecompressedSection (section_id, data_sp));
+    m_decompressed_sections_byte_size += byte_size;
+    while (m_decompressed_sections_byte_size > g_max_decompressed_sections_byte_size)
+    {
+        const DataBufferSP &evicted_sp = m_decompressed_sections.back().second;
+        if (evicted_sp)
+            m_decompressed_sections_byte_size -= evicted_sp->GetByteSize();
+        m_decompressed_sections.pop_back();
+    }
+    return data_sp;
+}
+
+DataBufferSP
+ObjectFileELF::DecompressSectionData (const Section *section) const
+{
+    Timer scoped_timer (__PRETTY_FUNCTION__,
+                        "ObjectFileELF::DecompressSectionData (%s)",
+                        section->GetName().AsCString(""));
+
+    DataExtractor compressed_data;
+    if (ObjectFile::ReadSectionData (section, compressed_data) == 0)
+        return DataBufferSP();
+
+    lldb::offset_t offset = 0;
+    uint64_t uncompressed_size = 0;
+    if (section->Test(g_shf_compressed))
+    {
+        // Elf32_Chdr or Elf64_Chdr
+        const elf_word ch_type = compressed_data.GetU32 (&offset);
+        if (m_header.Is64Bit())
+        {
+            compressed_data.GetU32 (&offset); // ch_reserved
+            uncompressed_size = compressed_data.GetU64 (&offset);
+            compressed_data.GetU64 (&offset); // ch_addralign
+        }
+        else
+        {
+            uncompressed_size = compressed_data.GetU32 (&offset);
+            compressed_data.GetU32 (&offset); // ch_addralign
+        }
+        if (ch_type != g_elfcompress_zlib)
+        {
+            GetModule()->ReportWarning ("section '%s' uses unsupported compression type %u",
+                                        section->GetName().AsCString(""), ch_type);
+            return DataBufferSP();
+        }
+    }
+    else
+    {
+        // "ZLIB" followed by the big endian uncompressed size
+        const char *magic = (const char *)compressed_data.GetData (&offset, 4);
+        if (magic == NULL || ::memcmp (magic, "ZLIB", 4) != 0)
+            return DataBufferSP();
+        compressed_data.SetByteOrder (eByteOrderBig);
+        uncompressed_size = compressed_data.GetU64 (&offset);
+    }
+
+    if (offset > compressed_data.GetByteSize())
+        return DataBufferSP();
+
+    if (!llvm::zlib::isAvailable())
+    {
+        GetModule()->ReportWarning ("unable to decompress section '%s', lldb was built without zlib support",
+                                    section->GetName().AsCString(""));
+        return DataBufferSP();
+    }
+
+    llvm::StringRef compressed_bytes ((const char *)compressed_data.GetDataStart() + offset,
+                                      compressed_data.GetByteSize() - offset);
+    llvm::SmallVector<char, 0> uncompressed_bytes;
+    if (llvm::zlib::uncompress (compressed_bytes, uncompressed_bytes, uncompressed_size) != llvm::zlib::StatusOK)
+    {
+        GetModule()->ReportWarning ("unable to decompress section '%s'",
+                                    section->GetName().AsCString(""));
+        return DataBufferSP();
+    }
+    return DataBufferSP (new DataBufferHeap (uncompressed_bytes.data(), uncompressed_bytes.size()));
+}
+
 //----------------------------------------------------------------------
 // ParseSectionHeaders
 //----------------------------------------------------------------------
@@ -1561,6 +1740,15 @@ ObjectFileELF::CreateSections(SectionList &unified_section_list)
             const ELFSectionHeaderInfo &header = *I;
 
             ConstString& name = I->section_name;
+            // Sections compressed by the GNU tools are named .zdebug_*
+            // instead of .debug_*, but they are the same DWARF sections.
+            ConstString type_name (name);
+            if (name.GetStringRef().startswith(".zdebug"))
+                type_name.SetString (std::string(".debug") + name.GetStringRef().substr(7).str());
+            // Split DWARF .dwo and .dwp files name their DWARF sections
+            // .debug_*.dwo, they are read just like the regular ones.
+            if (type_name.GetStringRef().startswith(".debug") && type_name.GetStringRef().endswith(".dwo"))
+                type_name.SetString (type_name.GetStringRef().drop_back(4));
             const uint64_t file_size = header.sh_type == SHT_NOBITS ? 0 : header.sh_size;
             const uint64_t vm_size = header.sh_flags & SHF_ALLOC ? header.sh_size : 0;
 
@@ -1570,6 +1758,7 @@ ObjectFileELF::CreateSections(SectionList &unified_section_list)
             static ConstString g_sect_name_tdata (".tdata");
             static ConstString g_sect_name_tbss (".tbss");
             static ConstString g_sect_name_dwarf_debug_abbrev (".debug_abbrev");
+            static ConstString g_sect_name_dwarf_debug_addr (".debug_addr");
             static ConstString g_sect_name_dwarf_debug_aranges (".debug_aranges");
             static ConstString g_sect_name_dwarf_debug_frame (".debug_frame");
             static ConstString g_sect_name_dwarf_debug_info (".debug_info");
@@ -1580,6 +1769,7 @@ ObjectFileELF::CreateSections(SectionList &unified_section_list)
             static ConstString g_sect_name_dwarf_debug_pubtypes (".debug_pubtypes");
             static ConstString g_sect_name_dwarf_debug_ranges (".debug_ranges");
             static ConstString g_sect_name_dwarf_debug_str (".debug_str");
+            static ConstString g_sect_name_dwarf_debug_str_offsets (".debug_str_offsets");
             static ConstString g_sect_name_eh_frame (".eh_frame");
 
             SectionType sect_type = eSectionTypeOther;
@@ -1600,6 +1790,7 @@ ObjectFileELF::CreateSections(SectionList &unified_section_list)
                 is_thread_specific = true;   
             }
             // .debug_abbrev – Abbreviations used in the .debug_info section
+            // .debug_addr – Address table used by split DWARF DW_FORM_GNU_addr_index values
             // .debug_aranges – Lookup table for mapping addresses to compilation units
             // .debug_frame – Call frame information
             // .debug_info – The core DWARF information section
@@ -1610,20 +1801,23 @@ ObjectFileELF::CreateSections(SectionList &unified_section_list)
             // .debug_pubtypes – Lookup table for mapping type names to compilation units
             // .debug_ranges – Address ranges used in DW_AT_ranges attributes
             // .debug_str – String table used in .debug_info
+            // .debug_str_offsets – String offsets used by split DWARF DW_FORM_GNU_str_index values
             // MISSING? .gnu_debugdata - "mini debuginfo / MiniDebugInfo" section, http://sourceware.org/gdb/onlinedocs/gdb/MiniDebugInfo.html
             // MISSING? .debug-index - http://src.chromium.org/viewvc/chrome/trunk/src/build/gdb-add-index?pathrev=144644
             // MISSING? .debug_types - Type descriptions from DWARF 4? See http://gcc.gnu.org/wiki/DwarfSeparateTypeInfo
-            else if (name == g_sect_name_dwarf_debug_abbrev)    sect_type = eSectionTypeDWARFDebugAbbrev;
-            else if (name == g_sect_name_dwarf_debug_aranges)   sect_type = eSectionTypeDWARFDebugAranges;
-            else if (name == g_sect_name_dwarf_debug_frame)     sect_type = eSectionTypeDWARFDebugFrame;
-            else if (name == g_sect_name_dwarf_debug_info)      sect_type = eSectionTypeDWARFDebugInfo;
-            else if (name == g_sect_name_dwarf_debug_line)      sect_type = eSectionTypeDWARFDebugLine;
-            else if (name == g_sect_name_dwarf_debug_loc)       sect_type = eSectionTypeDWARFDebugLoc;
-            else if (name == g_sect_name_dwarf_debug_macinfo)   sect_type = eSectionTypeDWARFDebugMacInfo;
-            else if (name == g_sect_name_dwarf_debug_pubnames)  sect_type = eSectionTypeDWARFDebugPubNames;
-            else if (name == g_sect_name_dwarf_debug_pubtypes)  sect_type = eSectionTypeDWARFDebugPubTypes;
-            else if (name == g_sect_name_dwarf_debug_ranges)    sect_type = eSectionTypeDWARFDebugRanges;
-            else if (name == g_sect_name_dwarf_debug_str)       sect_type = eSectionTypeDWARFDebugStr;
+            else if (type_name == g_sect_name_dwarf_debug_abbrev)    sect_type = eSectionTypeDWARFDebugAbbrev;
+            else if (type_name == g_sect_name_dwarf_debug_addr)      sect_type = eSectionTypeDWARFDebugAddr;
+            else if (type_name == g_sect_name_dwarf_debug_aranges)   sect_type = eSectionTypeDWARFDebugAranges;
+            else if (type_name == g_sect_name_dwarf_debug_frame)     sect_type = eSectionTypeDWARFDebugFrame;
+            else if (type_name == g_sect_name_dwarf_debug_info)      sect_type = eSectionTypeDWARFDebugInfo;
+            else if (type_name == g_sect_name_dwarf_debug_line)      sect_type = eSectionTypeDWARFDebugLine;
+            else if (type_name == g_sect_name_dwarf_debug_loc)       sect_type = eSectionTypeDWARFDebugLoc;
+            else if (type_name == g_sect_name_dwarf_debug_macinfo)   sect_type = eSectionTypeDWARFDebugMacInfo;
+            else if (type_name == g_sect_name_dwarf_debug_pubnames)  sect_type = eSectionTypeDWARFDebugPubNames;
+            else if (type_name == g_sect_name_dwarf_debug_pubtypes)  sect_type = eSectionTypeDWARFDebugPubTypes;
+            else if (type_name == g_sect_name_dwarf_debug_ranges)    sect_type = eSectionTypeDWARFDebugRanges;
+            else if (type_name == g_sect_name_dwarf_debug_str)       sect_type = eSectionTypeDWARFDebugStr;
+            else if (type_name == g_sect_name_dwarf_debug_str_offsets) sect_type = eSectionTypeDWARFDebugStrOffsets;
             else if (name == g_sect_name_eh_frame)              sect_type = eSectionTypeEHFrame;
 
             switch (header.sh_type)
@@ -1689,12 +1883,14 @@ ObjectFileELF::CreateSections(SectionList &unified_section_list)
         {
             static const SectionType g_sections[] =
             {
+                eSectionTypeDWARFDebugAddr,
                 eSectionTypeDWARFDebugAranges,
                 eSectionTypeDWARFDebugInfo,
                 eSectionTypeDWARFDebugAbbrev,
                 eSectionTypeDWARFDebugFrame,
                 eSectionTypeDWARFDebugLine,
                 eSectionTypeDWARFDebugStr,
+                eSectionTypeDWARFDebugStrOffsets,
                 eSectionTypeDWARFDebugLoc,
                 eSectionTypeDWARFDebugMacInfo,
                 eSectionTypeDWARFDebugPubNames,
@@ -2425,6 +2621,11 @@ ObjectFileELF::RelocateDebugSections(const ELFSectionHeader *rel_hdr, user_id_t
     if (!debug)
         return 0;
 
+    // Relocations are applied in place in the file data, which doesn't
+    // contain the uncompressed contents of compressed sections.
+    if (SectionIsCompressed(debug))
+        return 0;
+
     DataExtractor rel_data;
     DataExtractor symtab_data;
     DataExtractor debug_data;
@@ -11,6 +11,7 @@
 #define liblldb_ObjectFileELF_h_
 
 #include <stdint.h>
+#include <list>
 #include <vector>
 
 #include "lldb/lldb-private.h"
@@ -18,6 +19,7 @@
 #include "lldb/Symbol/ObjectFile.h"
 #include "lldb/Core/UUID.h"
 #include "lldb/Core/ArchSpec.h"
+#include "lldb/Host/Mutex.h"
 
 #include "ELFHeader.h"
 
@@ -190,6 +192,19 @@ public:
     std::string
     StripLinkerSymbolAnnotations(llvm::StringRef symbol_name) const override;
 
+    size_t
+    ReadSectionData (const lldb_private::Section *section,
+                     lldb::offset_t section_offset,
+                     void *dst,
+                     size_t dst_len) const override;
+
+    size_t
+    ReadSectionData (const lldb_private::Section *section,
+                     lldb_private::DataExtractor& section_data) const override;
+
+    bool
+    SectionIsCompressed (const lldb_private::Section *section) const override;
+
 private:
     ObjectFileELF(const lldb::ModuleSP &module_sp,
                   lldb::DataBufferSP& data_sp,
@@ -221,6 +236,9 @@ private:
 
     typedef std::map<lldb::addr_t, lldb::AddressClass> FileAddressToAddressClassMap;
 
+    typedef std::pair<lldb::user_id_t, lldb::DataBufferSP> DecompressedSection;
+    typedef std::list<DecompressedSection>      DecompressedSectionColl;
+
     /// Version of this reader common to all plugins based on this class.
     static const uint32_t m_plugin_version = 1;
     static const uint32_t g_core_uuid_magic;
@@ -257,6 +275,20 @@ private:
     /// The address class for each symbol in the elf file
     FileAddressToAddressClassMap m_address_class_map;
 
+    /// Contents of compressed sections that were recently read, most
+    /// recently used first. A NULL buffer means the section couldn't be
+    /// decompressed.
+    mutable lldb_private::Mutex m_decompressed_sections_mutex;
+    mutable DecompressedSectionColl m_decompressed_sections;
+    mutable size_t m_decompressed_sections_byte_size;
+
+    /// Returns the uncompressed contents of a compressed section.
+    lldb::DataBufferSP
+    GetDecompressedSectionData(const lldb_private::Section *section) const;
+
+    lldb::DataBufferSP
+    DecompressSectionData(const lldb_private::Section *section) const;
+
     /// Returns a 1 based index of the given section header.
     size_t
     SectionIndex(const SectionHeaderCollIter &I);
@@ -13,12 +13,15 @@
 
 // C Includes
 #include <errno.h>
+#include <fcntl.h>
 #include <poll.h>
 #include <string.h>
 #include <stdint.h>
+#include <stdlib.h>
 #include <unistd.h>
 
 // C++ Includes
+#include <atomic>
 #include <fstream>
 #include <sstream>
 #include <string>
@@ -270,6 +273,136 @@ namespace
     }
 #endif
 
+    //------------------------------------------------------------------------------
+    // Bulk memory transfers.
+    //
+    // process_vm_readv/process_vm_writev move a whole buffer between address
+    // spaces with one system call and, unlike ptrace, may be used from any thread
+    // of the tracing process. They honor the page protections of the inferior
+    // though, so they can't read PROT_NONE pages or write to code. Reads and
+    // writes through /proc/<pid>/mem are also done in bulk but ignore page
+    // protections just like PTRACE_PEEKDATA/POKEDATA do.
+    //
+    // Not every kernel (or libc, older Android ones in particular) provides the
+    // process_vm calls, so they are called through syscall() and we remember
+    // when the kernel doesn't support them.
+    std::atomic<bool> g_process_vm_supported (true);
+
+    size_t
+    DoProcessVMTransfer (bool write, lldb::pid_t pid, lldb::addr_t vm_addr, void *buf, size_t size)
+    {
+#if defined (__NR_process_vm_readv) && defined (__NR_process_vm_writev)
+        if (!g_process_vm_supported)
+            return 0;
+
+        unsigned char *local = static_cast<unsigned char*>(buf);
+        size_t bytes_transferred = 0;
+        while (bytes_transferred < size)
+        {
+            struct iovec local_iov;
+            local_iov.iov_base = local + bytes_transferred;
+            local_iov.iov_len = size - bytes_transferred;
+            struct iovec remote_iov;
+            remote_iov.iov_base = reinterpret_cast<void *>(vm_addr + bytes_transferred);
+            remote_iov.iov_len = size - bytes_transferred;
+
+            // A partial transfer means we hit a page we can't access, the next
+            // call will tell us if there is anything more we can do.
+            const long result = syscall (write ? __NR_process_vm_writev : __NR_process_vm_readv,
+                                         static_cast< ::pid_t>(pid), &local_iov, 1, &remote_iov, 1, 0);
+            if (result <= 0)
+            {
+                if (result < 0 && errno == ENOSYS)
+                    g_process_vm_supported = false;
+                break;
+            }
+            bytes_transferred += result;
+        }
+        return bytes_transferred;
+#else
+        return 0;
+#endif
+    }
+
+    size_t
+    DoProcMemTransfer (bool write, lldb::pid_t pid, lldb::addr_t vm_addr, void *buf, size_t size)
+    {
+        char mem_path[64];
+        ::snprintf (mem_path, sizeof(mem_path), "/proc/%" PRIu64 "/mem", pid);
+        const int fd = ::open (mem_path, (write ? O_RDWR : O_RDONLY) | O_CLOEXEC);
+        if (fd < 0)
+            return 0;
+
+        unsigned char *local = static_cast<unsigned char*>(buf);
+        size_t bytes_transferred = 0;
+        while (bytes_transferred < size)
+        {
+            const off64_t offset = static_cast<off64_t>(vm_addr + bytes_transferred);
+            const ssize_t result = write ? ::pwrite64 (fd, local + bytes_transferred, size - bytes_transferred, offset)
+                                         : ::pread64 (fd, local + bytes_transferred, size - bytes_transferred, offset);
+            if (result <= 0)
+            {
+                if (result < 0 && errno == EINTR)
+                    continue;
+                break;
+            }
+            bytes_transferred += result;
+        }
+        ::close (fd);
+        return bytes_transferred;
+    }
+
+    void
+    LogBulkMemoryTransfer (const char *function, const char *method, lldb::pid_t pid, lldb::addr_t vm_addr, size_t size, size_t bytes_transferred)
+    {
+        Log *log (ProcessPOSIXLog::GetLogIfAllCategoriesSet (POSIX_LOG_MEMORY));
+        if (log)
+            log->Printf ("NativeProcessLinux::%s(%" PRIu64 ", 0x%" PRIx64 ", %zu) %s transferred %zu bytes", function,
+                         pid, vm_addr, size, method, bytes_transferred);
+    }
+
+    // Memory reads try process_vm_readv, then /proc/<pid>/mem, then ptrace.
+    // Setting LLDB_SERVER_MEMORY_READ_METHOD to "process_vm_readv",
+    // "proc_mem" or "ptrace" skips the other bulk method (or both), so the
+    // benchmarks can time each one. Whatever the chosen method can't read
+    // is still read with ptrace.
+    enum MemoryReadMethod
+    {
+        eMemoryReadMethodDefault,
+        eMemoryReadMethodProcessVM,
+        eMemoryReadMethodProcMem,
+        eMemoryReadMethodPtrace
+    };
+
+    MemoryReadMethod
+    GetMemoryReadMethodFromEnvironment ()
+    {
+        const char *method_cstr = getenv ("LLDB_SERVER_MEMORY_READ_METHOD");
+        if (method_cstr == NULL || method_cstr[0] == '\0')
+            return eMemoryReadMethodDefault;
+
+        MemoryReadMethod method = eMemoryReadMethodDefault;
+        if (::strcmp (method_cstr, "process_vm_readv") == 0)
+            method = eMemoryReadMethodProcessVM;
+        else if (::strcmp (method_cstr, "proc_mem") == 0)
+            method = eMemoryReadMethodProcMem;
+        else if (::strcmp (method_cstr, "ptrace") == 0)
+            method = eMemoryReadMethodPtrace;
+
+        Log *log (ProcessPOSIXLog::GetLogIfAllCategoriesSet (POSIX_LOG_MEMORY));
+        if (log)
+            log->Printf ("NativeProcessLinux::%s LLDB_SERVER_MEMORY_READ_METHOD=%s%s", __FUNCTION__, method_cstr,
+                         method == eMemoryReadMethodDefault ? " isn't a known method, using the default" : "");
+        return method;
+    }
+
+    MemoryReadMethod
+    GetMemoryReadMethod ()
+    {
+        static const MemoryReadMethod g_method = GetMemoryReadMethodFromEnvironment ();
+        return g_method;
+    }
+
     //------------------------------------------------------------------------------
     // Static implementations of NativeProcessLinux::ReadMemory and
     // NativeProcessLinux::WriteMemory.  This enables mutual recursion between these
@@ -481,7 +614,19 @@ namespace
     void
     ReadOperation::Execute (NativeProcessLinux *process)
     {
-        m_result = DoReadMemory (process->GetID (), m_addr, m_buff, m_size, m_error);
+        // Whatever /proc/<pid>/mem can't provide is read a word at a time with
+        // ptrace so that we still get the same partial read semantics.
+        const lldb::pid_t pid = process->GetID ();
+        const MemoryReadMethod method = GetMemoryReadMethod ();
+        size_t bulk_bytes = 0;
+        if (method == eMemoryReadMethodDefault || method == eMemoryReadMethodProcMem)
+        {
+            bulk_bytes = DoProcMemTransfer (false, pid, m_addr, m_buff, m_size);
+            LogBulkMemoryTransfer (__FUNCTION__, "/proc/pid/mem", pid, m_addr, m_size, bulk_bytes);
+        }
+        m_result = bulk_bytes;
+        if (bulk_bytes < m_size)
+            m_result += DoReadMemory (pid, m_addr + bulk_bytes, static_cast<unsigned char*>(m_buff) + bulk_bytes, m_size - bulk_bytes, m_error);
     }
 
     //------------------------------------------------------------------------------
@@ -515,7 +660,12 @@ namespace
     void
     WriteOperation::Execute(NativeProcessLinux *process)
     {
-        m_result = DoWriteMemory (process->GetID (), m_addr, m_buff, m_size, m_error);
+        const lldb::pid_t pid = process->GetID ();
+        const size_t bulk_bytes = DoProcMemTransfer (true, pid, m_addr, const_cast<void*>(m_buff), m_size);
+        LogBulkMemoryTransfer (__FUNCTION__, "/proc/pid/mem", pid, m_addr, m_size, bulk_bytes);
+        m_result = bulk_bytes;
+        if (bulk_bytes < m_size)
+            m_result += DoWriteMemory (pid, m_addr + bulk_bytes, static_cast<const unsigned char*>(m_buff) + bulk_bytes, m_size - bulk_bytes, m_error);
     }
 
     //------------------------------------------------------------------------------
@@ -2383,6 +2533,16 @@ NativeProcessLinux::MonitorSIGTRAP(const siginfo_t *info, lldb::pid_t pid)
 
     Mutex::Locker locker (m_threads_mutex);
 
+    // Any SIGTRAP other than the end of the step means a step over a
+    // breakpoint was cut short, by a clone or exit event for instance.  Put
+    // the breakpoint back and let the other threads go again.
+    if (info->si_code != 0 && info->si_code != TRAP_TRACE && info->si_code != TRAP_HWBKPT)
+    {
+        ThreadIDSet stopped_tids;
+        if (FinishSteppingOverBreakpoint(pid, stopped_tids))
+            ResumeThreadsStoppedForStepOver(stopped_tids);
+    }
+
     // See if we can find a thread for this signal.
     NativeThreadProtocolSP thread_sp = GetThreadByID (pid);
     if (!thread_sp)
@@ -2425,6 +2585,7 @@ NativeProcessLinux::MonitorSIGTRAP(const siginfo_t *info, lldb::pid_t pid)
 
         // Exec clears any pending notifications.
         m_pending_notification_up.reset ();
+        m_pending_step_over_up.reset ();
 
         // Remove all but the main thread here.  Linux fork creates a new process which only copies the main thread.  Mutexes are in undefined state.
         if (log)
@@ -2513,6 +2674,10 @@ NativeProcessLinux::MonitorSIGTRAP(const siginfo_t *info, lldb::pid_t pid)
     case 0:
     case TRAP_TRACE:  // We receive this on single stepping.
     case TRAP_HWBKPT: // We receive this on watchpoint hit
+    {
+        ThreadIDSet stopped_tids;
+        const bool stepped_over_breakpoint = FinishSteppingOverBreakpoint(pid, stopped_tids);
+
         if (thread_sp)
         {
             // If a watchpoint was hit, report it
@@ -2529,9 +2694,33 @@ NativeProcessLinux::MonitorSIGTRAP(const siginfo_t *info, lldb::pid_t pid)
                 break;
             }
         }
+
+        if (stepped_over_breakpoint)
+        {
+            if (m_pending_notification_up)
+            {
+                // Something else stopped the process while the thread was
+                // stepping, so it stays stopped along with the others.
+                if (thread_sp)
+                    std::static_pointer_cast<NativeThreadLinux>(thread_sp)->SetStoppedBySignal(0);
+                ThreadDidStop(pid, false);
+            }
+            else
+            {
+                // The thread stepped over a breakpoint whose conditions were
+                // false, so nobody needs to hear about it.
+                if (thread_sp)
+                    std::static_pointer_cast<NativeThreadLinux>(thread_sp)->SetRunning();
+                Resume(pid, LLDB_INVALID_SIGNAL_NUMBER);
+                ResumeThreadsStoppedForStepOver(stopped_tids);
+            }
+            break;
+        }
+
         // Otherwise, report step over
         MonitorTrace(pid, thread_sp);
         break;
+    }
 
     case SI_KERNEL:
     case TRAP_BRKPT:
@@ -2588,20 +2777,47 @@ NativeProcessLinux::MonitorBreakpoint(lldb::pid_t pid, NativeThreadProtocolSP th
         log->Printf("NativeProcessLinux::%s() received breakpoint event, pid = %" PRIu64,
                 __FUNCTION__, pid);
 
-    // This thread is currently stopped.
-    ThreadDidStop(pid, false);
+    const bool stepping_with_breakpoint =
+        m_threads_stepping_with_breakpoint.find(pid) != m_threads_stepping_with_breakpoint.end();
 
-    // Mark the thread as stopped at breakpoint.
     if (thread_sp)
     {
-        std::static_pointer_cast<NativeThreadLinux>(thread_sp)->SetStoppedByBreakpoint();
         Error error = FixupBreakpointPCAsNeeded(thread_sp);
         if (error.Fail())
             if (log)
                 log->Printf("NativeProcessLinux::%s() pid = %" PRIu64 " fixup: %s",
                         __FUNCTION__, pid, error.AsCString());
 
-        if (m_threads_stepping_with_breakpoint.find(pid) != m_threads_stepping_with_breakpoint.end())
+        // Count the hit whatever happens next, then evaluate the conditions
+        // that came with the breakpoint, and if they are all false step
+        // over it and carry on without waking the debugger.  When a stop is
+        // already on its way the debugger will look at its own condition
+        // anyway.
+        NativeRegisterContextSP reg_ctx_sp = thread_sp->GetRegisterContext();
+        const lldb::addr_t bp_addr = reg_ctx_sp ? reg_ctx_sp->GetPC() : LLDB_INVALID_ADDRESS;
+        if (bp_addr != LLDB_INVALID_ADDRESS)
+            CountBreakpointHit(bp_addr);
+        if (!stepping_with_breakpoint && !m_pending_notification_up && !m_pending_step_over_up && SupportHardwareSingleStepping() &&
+            bp_addr != LLDB_INVALID_ADDRESS && !BreakpointConditionSaysStop(*thread_sp, bp_addr))
+        {
+            error = StepOverBreakpoint(pid, bp_addr);
+            if (error.Success())
+                return;
+            if (log)
+                log->Printf("NativeProcessLinux::%s() pid = %" PRIu64 " couldn't step over breakpoint: %s",
+                        __FUNCTION__, pid, error.AsCString());
+        }
+    }
+
+    // This thread is currently stopped.
+    ThreadDidStop(pid, false);
+
+    // Mark the thread as stopped at breakpoint.
+    if (thread_sp)
+    {
+        std::static_pointer_cast<NativeThreadLinux>(thread_sp)->SetStoppedByBreakpoint();
+
+        if (stepping_with_breakpoint)
             std::static_pointer_cast<NativeThreadLinux>(thread_sp)->SetStoppedByTrace();
     }
     else
@@ -2615,6 +2831,127 @@ NativeProcessLinux::MonitorBreakpoint(lldb::pid_t pid, NativeThreadProtocolSP th
     StopRunningThreads(pid);
 }
 
+Error
+NativeProcessLinux::StepOverBreakpoint(lldb::tid_t tid, lldb::addr_t bp_addr)
+{
+    if (!SupportHardwareSingleStepping())
+        return Error("stepping over a breakpoint needs hardware single stepping");
+    if (m_pending_step_over_up)
+        return Error("already stepping a thread over a breakpoint");
+
+    // The trap has to come out for one instruction.  Any other thread that
+    // got to the breakpoint in the meantime would run past it unnoticed, so
+    // stop them all first.
+    m_pending_step_over_up.reset(new PendingStepOver(tid, bp_addr));
+    StartSteppingOverBreakpoint();
+    return Error();
+}
+
+void
+NativeProcessLinux::StartSteppingOverBreakpoint()
+{
+    Log *log(GetLogIfAnyCategoriesSet(LIBLLDB_LOG_PROCESS | LIBLLDB_LOG_BREAKPOINTS));
+    PendingStepOver &step_over = *m_pending_step_over_up;
+
+    // Threads may have been created since we last looked.
+    for (const auto &thread_sp: m_threads)
+    {
+        const lldb::tid_t tid = thread_sp->GetID();
+        if (tid == step_over.tid ||
+            StateIsStoppedState(thread_sp->GetState(), true) ||
+            step_over.wait_for_stop_tids.count(tid) > 0)
+            continue;
+
+        if (std::static_pointer_cast<NativeThreadLinux>(thread_sp)->RequestStop().Success())
+            step_over.wait_for_stop_tids.insert(tid);
+    }
+    if (!step_over.wait_for_stop_tids.empty())
+        return;
+
+    auto thread_sp = std::static_pointer_cast<NativeThreadLinux>(GetThreadByID(step_over.tid));
+    Error error = DisableBreakpoint(step_over.bp_addr);
+    if (error.Success())
+    {
+        if (thread_sp)
+            thread_sp->SetStepping();
+        error = SingleStep(step_over.tid, LLDB_INVALID_SIGNAL_NUMBER);
+        if (error.Fail())
+            EnableBreakpoint(step_over.bp_addr);
+    }
+    if (error.Success())
+    {
+        step_over.stepping = true;
+        return;
+    }
+
+    // Report the breakpoint hit after all, the debugger checks the condition
+    // itself.  The other threads are already stopped.
+    if (log)
+        log->Printf("NativeProcessLinux::%s() tid = %" PRIu64 " couldn't step over breakpoint at 0x%" PRIx64 ": %s",
+                __FUNCTION__, step_over.tid, step_over.bp_addr, error.AsCString());
+    const lldb::tid_t tid = step_over.tid;
+    m_pending_step_over_up.reset();
+    ThreadDidStop(tid, false);
+    if (thread_sp)
+        thread_sp->SetStoppedByBreakpoint();
+    StopRunningThreads(tid);
+}
+
+bool
+NativeProcessLinux::FinishSteppingOverBreakpoint(lldb::tid_t tid, ThreadIDSet &stopped_tids)
+{
+    if (!m_pending_step_over_up || m_pending_step_over_up->tid != tid)
+        return false;
+
+    PendingStepOverUP step_over_up(std::move(m_pending_step_over_up));
+    if (step_over_up->stepping)
+    {
+        // The breakpoint may have been removed while the thread was stepping.
+        Error error = EnableBreakpoint(step_over_up->bp_addr);
+        if (error.Fail())
+        {
+            Log *log(GetLogIfAnyCategoriesSet(LIBLLDB_LOG_PROCESS | LIBLLDB_LOG_BREAKPOINTS));
+            if (log)
+                log->Printf("NativeProcessLinux::%s() tid = %" PRIu64 " couldn't reenable breakpoint at 0x%" PRIx64 ": %s",
+                        __FUNCTION__, tid, step_over_up->bp_addr, error.AsCString());
+        }
+    }
+    else
+    {
+        // Nobody is waiting for the threads we asked to stop any more, so
+        // have them carry on when they do.
+        for (lldb::tid_t wait_tid: step_over_up->wait_for_stop_tids)
+        {
+            auto thread_sp = std::static_pointer_cast<NativeThreadLinux>(GetThreadByID(wait_tid));
+            if (thread_sp)
+                thread_sp->GetThreadContext().stop_requested = false;
+        }
+    }
+    stopped_tids.swap(step_over_up->stopped_tids);
+    return true;
+}
+
+void
+NativeProcessLinux::ResumeThreadsStoppedForStepOver(const ThreadIDSet &stopped_tids)
+{
+    Log *const log = GetLogIfAllCategoriesSet (LIBLLDB_LOG_THREAD);
+    for (lldb::tid_t tid: stopped_tids)
+    {
+        auto thread_sp = std::static_pointer_cast<NativeThreadLinux>(GetThreadByID(tid));
+        if (!thread_sp || !StateIsStoppedState(thread_sp->GetState(), true))
+            continue;
+
+        // Resume them the way they were running before, without the SIGSTOP.
+        auto &context = thread_sp->GetThreadContext();
+        if (!context.request_resume_function)
+            continue;
+        Error error = context.request_resume_function(tid, true);
+        if (error.Fail() && log)
+            log->Printf("NativeProcessLinux::%s failed to resume thread tid  %" PRIu64 ": %s",
+                    __FUNCTION__, tid, error.AsCString ());
+    }
+}
+
 void
 NativeProcessLinux::MonitorWatchpoint(lldb::pid_t pid, NativeThreadProtocolSP thread_sp, uint32_t wp_index)
 {
@@ -2771,6 +3108,15 @@ NativeProcessLinux::MonitorSignal(const siginfo_t *info, lldb::pid_t pid, bool e
     if (log)
         log->Printf ("NativeProcessLinux::%s() received signal %s", __FUNCTION__, GetUnixSignals ().GetSignalAsCString (signo));
 
+    // A signal stopped a thread before it finished stepping over a
+    // breakpoint.  Put the breakpoint back and let the other threads go
+    // again, the debugger steps over it itself when it resumes the thread.
+    {
+        ThreadIDSet stopped_tids;
+        if (FinishSteppingOverBreakpoint(pid, stopped_tids))
+            ResumeThreadsStoppedForStepOver(stopped_tids);
+    }
+
     // This thread is stopped.
     ThreadDidStop (pid, false);
 
@@ -3836,8 +4182,25 @@ NativeProcessLinux::RemoveWatchpoint (lldb::addr_t addr)
 Error
 NativeProcessLinux::ReadMemory (lldb::addr_t addr, void *buf, size_t size, size_t &bytes_read)
 {
-    ReadOperation op(addr, buf, size, bytes_read);
+    // process_vm_readv doesn't need to run on the monitor thread, so try it
+    // before funneling anything over there.
+    const MemoryReadMethod method = GetMemoryReadMethod ();
+    size_t vm_bytes = 0;
+    if (method == eMemoryReadMethodDefault || method == eMemoryReadMethodProcessVM)
+    {
+        vm_bytes = DoProcessVMTransfer (false, GetID (), addr, buf, size);
+        LogBulkMemoryTransfer (__FUNCTION__, "process_vm_readv", GetID (), addr, size, vm_bytes);
+    }
+    if (vm_bytes == size)
+    {
+        bytes_read = size;
+        return Error ();
+    }
+
+    size_t op_bytes_read = 0;
+    ReadOperation op(addr + vm_bytes, static_cast<unsigned char*>(buf) + vm_bytes, size - vm_bytes, op_bytes_read);
     m_monitor_up->DoOperation(&op);
+    bytes_read = vm_bytes + op_bytes_read;
     return op.GetError ();
 }
 
@@ -3852,8 +4215,20 @@ NativeProcessLinux::ReadMemoryWithoutTrap(lldb::addr_t addr, void *buf, size_t s
 Error
 NativeProcessLinux::WriteMemory(lldb::addr_t addr, const void *buf, size_t size, size_t &bytes_written)
 {
-    WriteOperation op(addr, buf, size, bytes_written);
+    // process_vm_writev can't write to read-only pages (e.g. when inserting
+    // breakpoints into code), anything it leaves behind goes to the monitor.
+    const size_t vm_bytes = DoProcessVMTransfer (true, GetID (), addr, const_cast<void*>(buf), size);
+    LogBulkMemoryTransfer (__FUNCTION__, "process_vm_writev", GetID (), addr, size, vm_bytes);
+    if (vm_bytes == size)
+    {
+        bytes_written = size;
+        return Error ();
+    }
+
+    size_t op_bytes_written = 0;
+    WriteOperation op(addr + vm_bytes, static_cast<const unsigned char*>(buf) + vm_bytes, size - vm_bytes, op_bytes_written);
     m_monitor_up->DoOperation(&op);
+    bytes_written = vm_bytes + op_bytes_written;
     return op.GetError ();
 }
 
@@ -4072,6 +4447,20 @@ NativeProcessLinux::StopTrackingThread (lldb::tid_t thread_id)
         SignalIfAllThreadsStopped();
     }
 
+    if (m_pending_step_over_up)
+    {
+        ThreadIDSet stopped_tids;
+        if (FinishSteppingOverBreakpoint(thread_id, stopped_tids))
+            ResumeThreadsStoppedForStepOver(stopped_tids);
+        else
+        {
+            m_pending_step_over_up->stopped_tids.erase(thread_id);
+            if (m_pending_step_over_up->wait_for_stop_tids.erase(thread_id) > 0 &&
+                m_pending_step_over_up->wait_for_stop_tids.empty())
+                StartSteppingOverBreakpoint();
+        }
+    }
+
     return found;
 }
 
@@ -4357,7 +4746,13 @@ NativeProcessLinux::RequestStopOnAllRunningThreads()
         if (StateIsStoppedState(thread_sp->GetState(), true))
             continue;
 
-        static_pointer_cast<NativeThreadLinux>(thread_sp)->RequestStop();
+        // A thread stepping over a breakpoint stops by itself after the
+        // step, and one already asked to stop doesn't need asking again.
+        auto linux_thread_sp = static_pointer_cast<NativeThreadLinux>(thread_sp);
+        const bool stepping_over_breakpoint = m_pending_step_over_up &&
+                                              m_pending_step_over_up->tid == thread_sp->GetID();
+        if (!stepping_over_breakpoint && !linux_thread_sp->GetThreadContext().stop_requested)
+            linux_thread_sp->RequestStop();
         sent_tids.insert (thread_sp->GetID());
     }
 
@@ -4384,6 +4779,16 @@ NativeProcessLinux::ThreadDidStop (lldb::tid_t tid, bool initiated_by_llgs)
     const auto stop_was_requested = context.stop_requested;
     context.stop_requested = false;
 
+    // Threads stopped so another can step over a breakpoint wait for it.
+    if (initiated_by_llgs && m_pending_step_over_up &&
+        m_pending_step_over_up->wait_for_stop_tids.erase(tid) > 0)
+    {
+        m_pending_step_over_up->stopped_tids.insert(tid);
+        if (m_pending_step_over_up->wait_for_stop_tids.empty())
+            StartSteppingOverBreakpoint();
+        return Error();
+    }
+
     // If we have a pending notification, remove this from the set.
     if (m_pending_notification_up)
     {
@@ -4421,6 +4826,21 @@ NativeProcessLinux::DoStopThreads(PendingNotificationUP &&notification_up)
                    m_pending_notification_up->triggering_tid,
                    notification_up->triggering_tid);
     }
+
+    // A thread still waiting to step over a breakpoint stays stopped at it
+    // instead.  The debugger checks the condition itself when it hears about
+    // the breakpoint hit.  The threads we asked to stop for it are still
+    // on their way and are waited for below.
+    if (m_pending_step_over_up && !m_pending_step_over_up->stepping)
+    {
+        const lldb::tid_t tid = m_pending_step_over_up->tid;
+        m_pending_step_over_up.reset();
+        ThreadDidStop(tid, false);
+        auto thread_sp = std::static_pointer_cast<NativeThreadLinux>(GetThreadByID(tid));
+        if (thread_sp)
+            thread_sp->SetStoppedByBreakpoint();
+    }
+
     m_pending_notification_up = std::move(notification_up);
 
     RequestStopOnAllRunningThreads();
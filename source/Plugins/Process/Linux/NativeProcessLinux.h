@@ -407,8 +407,49 @@ namespace process_linux {
         void
         ThreadWasCreated (lldb::tid_t tid);
 
+        // A thread single stepping past a breakpoint whose conditions were
+        // false.  The other threads are stopped first so none of them can run
+        // past the breakpoint while its trap is taken out.
+        struct PendingStepOver
+        {
+            PendingStepOver (lldb::tid_t tid, lldb::addr_t bp_addr):
+                tid (tid),
+                bp_addr (bp_addr),
+                wait_for_stop_tids (),
+                stopped_tids (),
+                stepping (false)
+            {
+            }
+
+            const lldb::tid_t  tid;
+            const lldb::addr_t bp_addr;
+            ThreadIDSet        wait_for_stop_tids;  // Threads asked to stop that haven't yet
+            ThreadIDSet        stopped_tids;        // Threads to resume once the step is done
+            bool               stepping;            // The trap is out and the thread is stepping
+        };
+        typedef std::unique_ptr<PendingStepOver> PendingStepOverUP;
+
+        // Step the thread with the given id over the breakpoint at bp_addr
+        // without reporting a stop.
+        Error
+        StepOverBreakpoint(lldb::tid_t tid, lldb::addr_t bp_addr);
+
+        // Single step the thread once all the other threads have stopped.
+        void
+        StartSteppingOverBreakpoint();
+
+        // If the thread with the given id was stepping over a breakpoint, put
+        // the breakpoint back and return true with the threads that were
+        // stopped for the step in stopped_tids.
+        bool
+        FinishSteppingOverBreakpoint(lldb::tid_t tid, ThreadIDSet &stopped_tids);
+
+        void
+        ResumeThreadsStoppedForStepOver(const ThreadIDSet &stopped_tids);
+
         // Member variables.
         PendingNotificationUP m_pending_notification_up;
+        PendingStepOverUP m_pending_step_over_up;
     };
 
 } // namespace process_linux
@@ -337,7 +337,8 @@ NativeRegisterContextLinux_x86_64::NativeRegisterContextLinux_x86_64 (NativeThre
     m_iovec (),
     m_ymm_set (),
     m_reg_info (),
-    m_gpr_x86_64 ()
+    m_gpr_x86_64 (),
+    m_reg_sets_cached (false)
 {
     // Set up data about ranges of valid registers.
     switch (reg_info_interface_p->GetTargetArchitecture ().GetMachine ())
@@ -469,6 +470,23 @@ NativeRegisterContextLinux_x86_64::ReadRegisterRaw (uint32_t reg_index, Register
                                         reg_value);
 }
 
+bool
+NativeRegisterContextLinux_x86_64::ReadCachedGPR (uint32_t reg_index, RegisterValue &reg_value) const
+{
+    // Only the x86_64 register offsets line up with the user_regs_struct
+    // layout that ReadGPR() fetches.
+    if (GetRegisterInfoInterface ().GetTargetArchitecture ().GetMachine () != llvm::Triple::x86_64)
+        return false;
+
+    const RegisterInfo *const reg_info = GetRegisterInfoAtIndex (reg_index);
+    if (!reg_info || reg_info->byte_size != sizeof(uint64_t) ||
+        reg_info->byte_offset + reg_info->byte_size > sizeof(m_gpr_x86_64))
+        return false;
+
+    reg_value.SetUInt64 (m_gpr_x86_64[reg_info->byte_offset / sizeof(uint64_t)]);
+    return true;
+}
+
 Error
 NativeRegisterContextLinux_x86_64::ReadRegister (const RegisterInfo *reg_info, RegisterValue &reg_value)
 {
@@ -490,7 +508,7 @@ NativeRegisterContextLinux_x86_64::ReadRegister (const RegisterInfo *reg_info, R
 
     if (IsFPR(reg, GetFPRType()))
     {
-        if (!ReadFPR())
+        if (!m_reg_sets_cached && !ReadFPR())
         {
             error.SetErrorString ("failed to read floating point register");
             return error;
@@ -507,7 +525,10 @@ NativeRegisterContextLinux_x86_64::ReadRegister (const RegisterInfo *reg_info, R
             full_reg = reg_info->invalidate_regs[0];
         }
 
-        error = ReadRegisterRaw(full_reg, reg_value);
+        if (m_reg_sets_cached && ReadCachedGPR(full_reg, reg_value))
+            error.Clear();
+        else
+            error = ReadRegisterRaw(full_reg, reg_value);
 
         if (error.Success ())
         {
@@ -723,6 +744,24 @@ NativeRegisterContextLinux_x86_64::WriteRegister (const RegisterInfo *reg_info,
     return Error ("failed - register wasn't recognized to be a GPR or an FPR, write strategy unknown");
 }
 
+Error
+NativeRegisterContextLinux_x86_64::ReadAllUserRegisterValues (lldb::DataBufferSP &data_sp)
+{
+    // Fetch the GPR and FPR sets with a single ptrace request each and serve
+    // every register from those copies, instead of one PTRACE_PEEKUSER or
+    // FPR fetch per register.
+    if (!ReadGPR ())
+        return Error ("ReadGPR() failed");
+
+    if (!ReadFPR ())
+        return Error ("ReadFPR() failed");
+
+    m_reg_sets_cached = true;
+    Error error = NativeRegisterContext::ReadAllUserRegisterValues (data_sp);
+    m_reg_sets_cached = false;
+    return error;
+}
+
 Error
 NativeRegisterContextLinux_x86_64::ReadAllRegisterValues (lldb::DataBufferSP &data_sp)
 {
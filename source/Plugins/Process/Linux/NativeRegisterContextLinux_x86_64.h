@@ -46,6 +46,9 @@ namespace process_linux {
         Error
         WriteAllRegisterValues (const lldb::DataBufferSP &data_sp) override;
 
+        Error
+        ReadAllUserRegisterValues (lldb::DataBufferSP &data_sp) override;
+
         Error
         IsWatchpointHit(uint32_t wp_index, bool &is_hit) override;
 
@@ -117,6 +120,7 @@ namespace process_linux {
         YMM m_ymm_set;
         RegInfo m_reg_info;
         uint64_t m_gpr_x86_64[k_num_gpr_registers_x86_64];
+        bool m_reg_sets_cached; // m_gpr_x86_64 and m_fpr are current, don't refetch them in ReadRegister().
 
         // Private member methods.
         Error
@@ -156,6 +160,9 @@ namespace process_linux {
         Error
         ReadRegisterRaw (uint32_t reg_index, RegisterValue &reg_value);
 
+        bool
+        ReadCachedGPR (uint32_t reg_index, RegisterValue &reg_value) const;
+
         bool
         ReadGPR();
 
@@ -115,7 +115,9 @@ ProcessElfCore::ProcessElfCore(Target& target, Listener &listener,
     m_os(llvm::Triple::UnknownOS),
     m_thread_data_valid(false),
     m_thread_data(),
-    m_core_aranges ()
+    m_core_aranges (),
+    m_core_range_data (),
+    m_core_range_data_mutex (Mutex::eMutexTypeNormal)
 {
 }
 
@@ -231,6 +233,11 @@ ProcessElfCore::DoLoadCore ()
     if (!ranges_are_sorted)
         m_core_aranges.Sort();
 
+    // The core file data for each range is looked up lazily, only the
+    // ranges that are actually read from are touched.
+    m_core_range_data.clear();
+    m_core_range_data.resize(m_core_aranges.GetSize());
+
     // Even if the architecture is set in the target, we need to override
     // it to match the core file which is always single arch.
     ArchSpec arch (m_core_module_sp->GetArchitecture());
@@ -317,51 +324,85 @@ ProcessElfCore::ReadMemory (lldb::addr_t addr, void *buf, size_t size, Error &er
 size_t
 ProcessElfCore::DoReadMemory (lldb::addr_t addr, void *buf, size_t size, Error &error)
 {
-    ObjectFile *core_objfile = m_core_module_sp->GetObjectFile();
-
-    if (core_objfile == NULL)
-        return 0;
+    uint8_t *dst = (uint8_t *)buf;
+    size_t bytes_left = size;
+    lldb::addr_t curr_addr = addr;
 
-    // Get the address range
-    const VMRangeToFileOffset::Entry *address_range = m_core_aranges.FindEntryThatContains (addr);
-    if (address_range == NULL || address_range->GetRangeEnd() < addr)
+    // Copy straight out of the mapped core file, a read may span several
+    // adjacent segments.
+    while (bytes_left > 0)
     {
+        DataExtractor data;
+        const size_t bytes_available = PeekMemory (curr_addr, bytes_left, data);
+        if (bytes_available == 0)
+            break;
+
+        const uint8_t *src = data.GetDataStart();
+        if (src == NULL)
+            break;
+
+        ::memcpy (dst, src, bytes_available);
+        dst += bytes_available;
+        curr_addr += bytes_available;
+        bytes_left -= bytes_available;
+    }
+
+    if (bytes_left == size)
         error.SetErrorStringWithFormat ("core file does not contain 0x%" PRIx64, addr);
+    return size - bytes_left;
+}
+
+size_t
+ProcessElfCore::PeekMemory (lldb::addr_t addr, size_t size, DataExtractor &data)
+{
+    data.Clear();
+
+    const uint32_t range_idx = m_core_aranges.FindEntryIndexThatContains (addr);
+    if (range_idx == UINT32_MAX || size == 0)
         return 0;
-    }
 
-    // Convert the address into core file offset
+    const VMRangeToFileOffset::Entry *address_range = m_core_aranges.GetEntryAtIndex (range_idx);
     const lldb::addr_t offset = addr - address_range->GetRangeBase();
-    const lldb::addr_t file_start = address_range->data.GetRangeBase();
-    const lldb::addr_t file_end = address_range->data.GetRangeEnd();
-    size_t bytes_to_read = size; // Number of bytes to read from the core file
-    size_t bytes_copied = 0;     // Number of bytes actually read from the core file
-    size_t zero_fill_size = 0;   // Padding
-    lldb::addr_t bytes_left = 0; // Number of bytes available in the core file from the given address
-
-    // Figure out how many on-disk bytes remain in this segment
-    // starting at the given offset
-    if (file_end > file_start + offset)
-        bytes_left = file_end - (file_start + offset);
-
-    // Figure out how many bytes we need to zero-fill if we are
-    // reading more bytes than available in the on-disk segment
-    if (bytes_to_read > bytes_left)
+    size_t bytes_available = std::min<lldb::addr_t> (size, address_range->GetRangeEnd() - addr);
+    const lldb::addr_t file_size = address_range->data.GetByteSize();
+
+    if (offset < file_size)
     {
-        zero_fill_size = bytes_to_read - bytes_left;
-        bytes_to_read = bytes_left;
+        // The bytes are in the core file
+        bytes_available = std::min<lldb::addr_t> (bytes_available, file_size - offset);
+        return data.SetData (GetCoreRangeData (range_idx), offset, bytes_available);
     }
 
-    // If there is data available on the core file read it
-    if (bytes_to_read)
-        bytes_copied = core_objfile->CopyData(offset + file_start, bytes_to_read, buf);
-
-    assert(zero_fill_size <= size);
-    // Pad remaining bytes
-    if (zero_fill_size)
-        memset(((char *)buf) + bytes_copied, 0, zero_fill_size);
+    // The rest of the segment isn't stored in the core file (p_memsz is
+    // larger than p_filesz) and reads as zeros.
+    static lldb::DataBufferSP g_zero_page_sp (new DataBufferHeap (4096, 0));
+    bytes_available = std::min<size_t> (bytes_available, g_zero_page_sp->GetByteSize());
+    return data.SetData (g_zero_page_sp, 0, bytes_available);
+}
 
-    return bytes_copied + zero_fill_size;
+const DataExtractor &
+ProcessElfCore::GetCoreRangeData (size_t range_idx)
+{
+    Mutex::Locker locker (m_core_range_data_mutex);
+    DataExtractor &range_data = m_core_range_data[range_idx];
+    const VMRangeToFileOffset::Entry *address_range = m_core_aranges.GetEntryAtIndex (range_idx);
+    const lldb::offset_t file_offset = address_range->data.GetRangeBase();
+    const size_t file_size = address_range->data.GetByteSize();
+    if (range_data.GetByteSize() == 0 && file_size > 0)
+    {
+        // Share the core object file's mapping when it covers this range,
+        // otherwise map just this range of the core file.
+        ObjectFile *core_objfile = m_core_module_sp ? m_core_module_sp->GetObjectFile() : NULL;
+        if (core_objfile == NULL || core_objfile->GetData (file_offset, file_size, range_data) != file_size)
+        {
+            lldb::DataBufferSP data_sp (m_core_file.MemoryMapFileContents (file_offset, file_size));
+            if (data_sp && data_sp->GetByteSize() == file_size)
+                range_data.SetData (data_sp);
+            else
+                range_data.Clear();
+        }
+    }
+    return range_data;
 }
 
 void
@@ -24,6 +24,7 @@
 // Other libraries and framework includes
 #include "lldb/Core/ConstString.h"
 #include "lldb/Core/Error.h"
+#include "lldb/Host/Mutex.h"
 #include "lldb/Target/Process.h"
 
 #include "Plugins/ObjectFile/ELF/ELFHeader.h"
@@ -101,6 +102,16 @@ public:
 
     size_t DoReadMemory(lldb::addr_t addr, void *buf, size_t size, lldb_private::Error &error) override;
 
+    //------------------------------------------------------------------
+    // Point "data" at the core file bytes for [addr, addr + size) without
+    // copying them. The view ends where the segment does, so it can be
+    // shorter than "size". Parts of a segment that aren't stored in the
+    // core read as zeros from a shared zero page. Returns the number of
+    // bytes in the view, zero if the core doesn't contain "addr".
+    //------------------------------------------------------------------
+    size_t
+    PeekMemory (lldb::addr_t addr, size_t size, lldb_private::DataExtractor &data);
+
     lldb::addr_t GetImageInfoAddress() override;
 
     lldb_private::ArchSpec
@@ -143,6 +154,10 @@ private:
     // Address ranges found in the core
     VMRangeToFileOffset m_core_aranges;
 
+    // Core file data for each entry of m_core_aranges, mapped on first use
+    std::vector<lldb_private::DataExtractor> m_core_range_data;
+    lldb_private::Mutex m_core_range_data_mutex;
+
     // Parse thread(s) data structures(prstatus, prpsinfo) from given NOTE segment
     void
     ParseThreadContextsFromNoteSegment (const elf::ELFProgramHeader *segment_header,
@@ -155,6 +170,10 @@ private:
     // Parse a contiguous address range of the process from LOAD segment
     lldb::addr_t
     AddAddressRangeFromLoadSegment(const elf::ELFProgramHeader *header);
+
+    // Returns the core file data backing the address range at range_idx
+    const lldb_private::DataExtractor &
+    GetCoreRangeData (size_t range_idx);
 };
 
 #endif  // liblldb_ProcessElffCore_h_
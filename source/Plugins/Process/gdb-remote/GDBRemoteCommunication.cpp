@@ -30,6 +30,7 @@
 #include "lldb/Host/ThreadLauncher.h"
 #include "lldb/Host/TimeValue.h"
 #include "lldb/Target/Process.h"
+#include "lldb/Utility/HexCoding.h"
 #include "llvm/ADT/SmallString.h"
 
 // Project includes
@@ -173,12 +174,7 @@ GDBRemoteCommunication::~GDBRemoteCommunication()
 char
 GDBRemoteCommunication::CalculcateChecksum (const char *payload, size_t payload_length)
 {
-    int checksum = 0;
-
-    for (size_t i = 0; i < payload_length; ++i)
-        checksum += payload[i];
-
-    return checksum & 255;
+    return Checksum8 (payload, payload_length);
 }
 
 size_t
@@ -864,6 +860,15 @@ GDBRemoteCommunication::StartDebugserverProcess (const char *hostname,
             ::snprintf (arg_cstr, sizeof(arg_cstr), "--log-channels=%s", env_debugserver_log_channels);
             debugserver_args.AppendArgument(arg_cstr);
         }
+
+        // The stub doesn't inherit our environment, pass along the memory
+        // read method the benchmarks use to time each way of reading memory.
+        const char *env_server_memory_read_method = getenv("LLDB_SERVER_MEMORY_READ_METHOD");
+        if (env_server_memory_read_method)
+        {
+            ::snprintf (arg_cstr, sizeof(arg_cstr), "LLDB_SERVER_MEMORY_READ_METHOD=%s", env_server_memory_read_method);
+            launch_info.GetEnvironmentEntries().AppendArgument(arg_cstr);
+        }
 #endif
 
         // Add additional args, starting with LLDB_DEBUGSERVER_EXTRA_ARG_1 until an env var doesn't come back.
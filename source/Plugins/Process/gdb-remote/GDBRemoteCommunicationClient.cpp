@@ -75,6 +75,7 @@ GDBRemoteCommunicationClient::GDBRemoteCommunicationClient() :
     m_prepare_for_reg_writing_reply (eLazyBoolCalculate),
     m_supports_p (eLazyBoolCalculate),
     m_supports_x (eLazyBoolCalculate),
+    m_supports_g (eLazyBoolCalculate),
     m_avoid_g_packets (eLazyBoolCalculate),
     m_supports_QSaveRegisterState (eLazyBoolCalculate),
     m_supports_qXfer_auxv_read (eLazyBoolCalculate),
@@ -82,12 +83,14 @@ GDBRemoteCommunicationClient::GDBRemoteCommunicationClient() :
     m_supports_qXfer_libraries_svr4_read (eLazyBoolCalculate),
     m_supports_qXfer_features_read (eLazyBoolCalculate),
     m_supports_augmented_libraries_svr4_read (eLazyBoolCalculate),
+    m_supports_conditional_breakpoints (eLazyBoolCalculate),
     m_supports_jThreadExtendedInfo (eLazyBoolCalculate),
     m_supports_qProcessInfoPID (true),
     m_supports_qfProcessInfo (true),
     m_supports_qUserName (true),
     m_supports_qGroupName (true),
     m_supports_qThreadStopInfo (true),
+    m_supports_jThreadsInfo (true),
     m_supports_z0 (true),
     m_supports_z1 (true),
     m_supports_z2 (true),
@@ -225,6 +228,16 @@ GDBRemoteCommunicationClient::GetQXferFeaturesReadSupported ()
     return (m_supports_qXfer_features_read == eLazyBoolYes);
 }
 
+bool
+GDBRemoteCommunicationClient::GetConditionalBreakpointsSupported ()
+{
+    if (m_supports_conditional_breakpoints == eLazyBoolCalculate)
+    {
+        GetRemoteQSupported();
+    }
+    return (m_supports_conditional_breakpoints == eLazyBoolYes);
+}
+
 uint64_t
 GDBRemoteCommunicationClient::GetRemoteMaxPacketSize()
 {
@@ -333,6 +346,7 @@ GDBRemoteCommunicationClient::ResetDiscoverableSettings()
     m_supports_vCont_S = eLazyBoolCalculate;
     m_supports_p = eLazyBoolCalculate;
     m_supports_x = eLazyBoolCalculate;
+    m_supports_g = eLazyBoolCalculate;
     m_supports_QSaveRegisterState = eLazyBoolCalculate;
     m_qHostInfo_is_valid = eLazyBoolCalculate;
     m_curr_pid_is_valid = eLazyBoolCalculate;
@@ -348,12 +362,14 @@ GDBRemoteCommunicationClient::ResetDiscoverableSettings()
     m_supports_qXfer_libraries_svr4_read = eLazyBoolCalculate;
     m_supports_qXfer_features_read = eLazyBoolCalculate;
     m_supports_augmented_libraries_svr4_read = eLazyBoolCalculate;
+    m_supports_conditional_breakpoints = eLazyBoolCalculate;
 
     m_supports_qProcessInfoPID = true;
     m_supports_qfProcessInfo = true;
     m_supports_qUserName = true;
     m_supports_qGroupName = true;
     m_supports_qThreadStopInfo = true;
+    m_supports_jThreadsInfo = true;
     m_supports_z0 = true;
     m_supports_z1 = true;
     m_supports_z2 = true;
@@ -386,6 +402,7 @@ GDBRemoteCommunicationClient::GetRemoteQSupported ()
     m_supports_qXfer_libraries_svr4_read = eLazyBoolNo;
     m_supports_augmented_libraries_svr4_read = eLazyBoolNo;
     m_supports_qXfer_features_read = eLazyBoolNo;
+    m_supports_conditional_breakpoints = eLazyBoolNo;
     m_max_packet_size = UINT64_MAX;  // It's supposed to always be there, but if not, we assume no limit
 
     // build the qSupported packet
@@ -417,6 +434,8 @@ GDBRemoteCommunicationClient::GetRemoteQSupported ()
             m_supports_qXfer_libraries_read = eLazyBoolYes;
         if (::strstr (response_cstr, "qXfer:features:read+"))
             m_supports_qXfer_features_read = eLazyBoolYes;
+        if (::strstr (response_cstr, "ConditionalBreakpoints+"))
+            m_supports_conditional_breakpoints = eLazyBoolYes;
 
         const char *packet_size_str = ::strstr (response_cstr, "PacketSize=");
         if (packet_size_str)
@@ -534,6 +553,12 @@ GDBRemoteCommunicationClient::GetpPacketSupported (lldb::tid_t tid)
     return m_supports_p;
 }
 
+bool
+GDBRemoteCommunicationClient::GetgPacketSupported ()
+{
+    return m_supports_g != eLazyBoolNo;
+}
+
 bool
 GDBRemoteCommunicationClient::GetThreadExtendedInfoSupported ()
 {
@@ -3049,9 +3074,31 @@ GDBRemoteCommunicationClient::GetThreadStopInfo (lldb::tid_t tid, StringExtracto
     return false;
 }
 
+bool
+GDBRemoteCommunicationClient::GetThreadsInfo (StringExtractorGDBRemote &response)
+{
+    if (m_supports_jThreadsInfo)
+    {
+        if (SendPacketAndWaitForResponse("jThreadsInfo", response, false) == PacketResult::Success)
+        {
+            if (response.IsUnsupportedResponse())
+                m_supports_jThreadsInfo = false;
+            else if (response.IsNormalResponse())
+                return true;
+            else
+                return false;
+        }
+        else
+        {
+            m_supports_jThreadsInfo = false;
+        }
+    }
+    return false;
+}
+
 
 uint8_t
-GDBRemoteCommunicationClient::SendGDBStoppointTypePacket (GDBStoppointType type, bool insert,  addr_t addr, uint32_t length)
+GDBRemoteCommunicationClient::SendGDBStoppointTypePacket (GDBStoppointType type, bool insert,  addr_t addr, uint32_t length, const StoppointConditions *conditions)
 {
     Log *log (GetLogIfAnyCategoriesSet (LIBLLDB_LOG_BREAKPOINTS));
     if (log)
@@ -3062,19 +3109,20 @@ GDBRemoteCommunicationClient::SendGDBStoppointTypePacket (GDBStoppointType type,
     if (!SupportsGDBStoppointPacket(type))
         return UINT8_MAX;
     // Construct the breakpoint packet
-    char packet[64];
-    const int packet_len = ::snprintf (packet, 
-                                       sizeof(packet), 
-                                       "%c%i,%" PRIx64 ",%x",
-                                       insert ? 'Z' : 'z', 
-                                       type, 
-                                       addr, 
-                                       length);
-    // Check we haven't overwritten the end of the packet buffer
-    assert (packet_len + 1 < (int)sizeof(packet));
+    StreamString packet;
+    packet.Printf ("%c%i,%" PRIx64 ",%x", insert ? 'Z' : 'z', type, addr, length);
+    // Conditions go along as agent expressions, ";X<len>,<bytecode>"
+    if (insert && conditions && type == eBreakpointSoftware && GetConditionalBreakpointsSupported())
+    {
+        for (const std::vector<uint8_t> &condition : *conditions)
+        {
+            packet.Printf (";X%" PRIx64 ",", (uint64_t)condition.size());
+            packet.PutBytesAsRawHex8 (condition.data(), condition.size());
+        }
+    }
     StringExtractorGDBRemote response;
     // Try to send the breakpoint packet, and check that it was correctly sent
-    if (SendPacketAndWaitForResponse(packet, packet_len, response, true) == PacketResult::Success)
+    if (SendPacketAndWaitForResponse(packet.GetData(), packet.GetSize(), response, true) == PacketResult::Success)
     {
         // Receive and OK packet when the breakpoint successfully placed
         if (response.IsOKResponse())
@@ -3103,6 +3151,34 @@ GDBRemoteCommunicationClient::SendGDBStoppointTypePacket (GDBStoppointType type,
     return UINT8_MAX;
 }
 
+bool
+GDBRemoteCommunicationClient::GetBreakpointHitCounts (lldb::addr_t addr, uint64_t &hit_count, uint64_t &skipped_hit_count)
+{
+    if (!GetConditionalBreakpointsSupported())
+        return false;
+
+    char packet[64];
+    const int packet_len = ::snprintf (packet, sizeof(packet), "qBreakpointHitCount:%" PRIx64, addr);
+    assert (packet_len + 1 < (int)sizeof(packet));
+    StringExtractorGDBRemote response;
+    if (SendPacketAndWaitForResponse(packet, packet_len, response, false) != PacketResult::Success ||
+        !response.IsNormalResponse())
+        return false;
+
+    bool got_hits = false;
+    bool got_skipped = false;
+    std::string name;
+    std::string value;
+    while (response.GetNameColonValue(name, value))
+    {
+        if (name.compare("hits") == 0)
+            hit_count = StringConvert::ToUInt64(value.c_str(), 0, 16, &got_hits);
+        else if (name.compare("skipped") == 0)
+            skipped_hit_count = StringConvert::ToUInt64(value.c_str(), 0, 16, &got_skipped);
+    }
+    return got_hits && got_skipped;
+}
+
 size_t
 GDBRemoteCommunicationClient::GetCurrentThreadIDs (std::vector<lldb::tid_t> &thread_ids, 
                                                    bool &sequence_mutex_unavailable)
@@ -3678,7 +3754,18 @@ GDBRemoteCommunicationClient::ReadAllRegisters (lldb::tid_t tid, StringExtractor
             else
                 packet_len = ::snprintf (packet, sizeof(packet), "g");
             assert (packet_len < ((int)sizeof(packet) - 1));
-            return SendPacketAndWaitForResponse(packet, response, false) == PacketResult::Success;
+            if (SendPacketAndWaitForResponse(packet, response, false) == PacketResult::Success)
+            {
+                // An error means the stub couldn't read every register for
+                // this thread, which won't change for the next stop, so use
+                // "p" from now on instead of paying for a failed "g" on each
+                // register cache miss.
+                if (response.IsUnsupportedResponse() || response.IsErrorResponse())
+                    m_supports_g = eLazyBoolNo;
+                else if (response.IsNormalResponse())
+                    m_supports_g = eLazyBoolYes;
+                return true;
+            }
         }
     }
     return false;
@@ -307,6 +307,24 @@ public:
     bool
     GetxPacketSupported ();
 
+    //------------------------------------------------------------------
+    /// Check if a "g" packet can be used to fill a register context
+    /// cache in a single round trip.
+    ///
+    /// This doesn't send a probe packet: it returns true until a "g"
+    /// packet has been rejected by the remote stub, or until
+    /// SetgPacketSupported(false) is called because the "g" response
+    /// layout doesn't match the register info we were given.
+    //------------------------------------------------------------------
+    bool
+    GetgPacketSupported ();
+
+    void
+    SetgPacketSupported (bool supported)
+    {
+        m_supports_g = supported ? eLazyBoolYes : eLazyBoolNo;
+    }
+
     bool
     GetVAttachOrWaitSupported ();
     
@@ -377,6 +395,20 @@ public:
     GetThreadStopInfo (lldb::tid_t tid, 
                        StringExtractorGDBRemote &response);
 
+    //------------------------------------------------------------------
+    /// Get the stop information for all threads with a single
+    /// "jThreadsInfo" packet.
+    ///
+    /// @param[out] response
+    ///     The JSON array of thread dictionaries returned by the stub.
+    ///
+    /// @return
+    ///     True if the stub supports the packet and returned a valid
+    ///     response, false otherwise.
+    //------------------------------------------------------------------
+    bool
+    GetThreadsInfo (StringExtractorGDBRemote &response);
+
     bool
     SupportsGDBStoppointPacket (GDBStoppointType type)
     {
@@ -390,11 +422,23 @@ public:
         default:                    return false;
         }
     }
+    // Agent expression bytecodes for conditions a stub can evaluate itself
+    typedef std::vector<std::vector<uint8_t> > StoppointConditions;
+
     uint8_t
     SendGDBStoppointTypePacket (GDBStoppointType type,   // Type of breakpoint or watchpoint
                                 bool insert,              // Insert or remove?
                                 lldb::addr_t addr,        // Address of breakpoint or watchpoint
-                                uint32_t length);         // Byte Size of breakpoint or watchpoint
+                                uint32_t length,          // Byte Size of breakpoint or watchpoint
+                                const StoppointConditions *conditions = nullptr); // Conditions for a software breakpoint
+
+    //------------------------------------------------------------------
+    /// Get the number of times the stub saw the software breakpoint at
+    /// \a addr hit, and how many of those it continued from without
+    /// stopping because its conditions were false.
+    //------------------------------------------------------------------
+    bool
+    GetBreakpointHitCounts (lldb::addr_t addr, uint64_t &hit_count, uint64_t &skipped_hit_count);
 
     bool
     SetNonStopMode (const bool enable);
@@ -435,6 +479,9 @@ public:
     bool
     GetQXferFeaturesReadSupported ();
 
+    bool
+    GetConditionalBreakpointsSupported ();
+
     LazyBool
     SupportsAllocDeallocMemory () // const
     {
@@ -586,6 +633,7 @@ protected:
     LazyBool m_prepare_for_reg_writing_reply;
     LazyBool m_supports_p;
     LazyBool m_supports_x;
+    LazyBool m_supports_g;
     LazyBool m_avoid_g_packets;
     LazyBool m_supports_QSaveRegisterState;
     LazyBool m_supports_qXfer_auxv_read;
@@ -593,6 +641,7 @@ protected:
     LazyBool m_supports_qXfer_libraries_svr4_read;
     LazyBool m_supports_qXfer_features_read;
     LazyBool m_supports_augmented_libraries_svr4_read;
+    LazyBool m_supports_conditional_breakpoints;
     LazyBool m_supports_jThreadExtendedInfo;
 
     bool
@@ -601,6 +650,7 @@ protected:
         m_supports_qUserName:1,
         m_supports_qGroupName:1,
         m_supports_qThreadStopInfo:1,
+        m_supports_jThreadsInfo:1,
         m_supports_z0:1,
         m_supports_z1:1,
         m_supports_z2:1,
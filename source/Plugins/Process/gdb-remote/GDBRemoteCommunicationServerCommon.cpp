@@ -909,7 +909,7 @@ GDBRemoteCommunicationServerCommon::Handle_qSupported (StringExtractorGDBRemote
     StreamGDBRemote response;
 
     // Features common to lldb-platform and llgs.
-    uint32_t max_packet_size = 128 * 1024;  // 128KBytes is a reasonable max packet size--debugger can always use less
+    uint32_t max_packet_size = 512 * 1024;  // 512KBytes lets a single binary memory read move a lot of data--debugger can always use less
     response.Printf ("PacketSize=%x", max_packet_size);
 
     response.PutCString (";QStartNoAckMode+");
@@ -917,6 +917,7 @@ GDBRemoteCommunicationServerCommon::Handle_qSupported (StringExtractorGDBRemote
     response.PutCString (";QListThreadsInStopReply+");
 #if defined(__linux__)
     response.PutCString (";qXfer:auxv:read+");
+    response.PutCString (";ConditionalBreakpoints+");
 #endif
 
     return SendPacketNoLock(response.GetData(), response.GetSize());
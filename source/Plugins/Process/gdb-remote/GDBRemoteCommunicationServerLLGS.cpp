@@ -41,6 +41,8 @@
 #include "lldb/Target/MemoryRegionInfo.h"
 #include "lldb/Target/Platform.h"
 #include "lldb/Target/Process.h"
+#include "lldb/Utility/JSON.h"
+#include "lldb/Host/common/AgentExpression.h"
 #include "lldb/Host/common/NativeRegisterContext.h"
 #include "lldb/Host/common/NativeProcessProtocol.h"
 #include "lldb/Host/common/NativeThreadProtocol.h"
@@ -120,20 +122,28 @@ GDBRemoteCommunicationServerLLGS::RegisterPacketHandlers()
                                   &GDBRemoteCommunicationServerLLGS::Handle_c);
     RegisterMemberFunctionHandler(StringExtractorGDBRemote::eServerPacketType_D,
                                   &GDBRemoteCommunicationServerLLGS::Handle_D);
+    RegisterMemberFunctionHandler(StringExtractorGDBRemote::eServerPacketType_g,
+                                  &GDBRemoteCommunicationServerLLGS::Handle_g);
+    RegisterMemberFunctionHandler(StringExtractorGDBRemote::eServerPacketType_G,
+                                  &GDBRemoteCommunicationServerLLGS::Handle_G);
     RegisterMemberFunctionHandler(StringExtractorGDBRemote::eServerPacketType_H,
                                   &GDBRemoteCommunicationServerLLGS::Handle_H);
     RegisterMemberFunctionHandler(StringExtractorGDBRemote::eServerPacketType_I,
                                   &GDBRemoteCommunicationServerLLGS::Handle_I);
     RegisterMemberFunctionHandler(StringExtractorGDBRemote::eServerPacketType_interrupt,
                                   &GDBRemoteCommunicationServerLLGS::Handle_interrupt);
+    RegisterMemberFunctionHandler(StringExtractorGDBRemote::eServerPacketType_jThreadsInfo,
+                                  &GDBRemoteCommunicationServerLLGS::Handle_jThreadsInfo);
     RegisterMemberFunctionHandler(StringExtractorGDBRemote::eServerPacketType_m,
-                                  &GDBRemoteCommunicationServerLLGS::Handle_m);
+                                  &GDBRemoteCommunicationServerLLGS::Handle_memory_read);
     RegisterMemberFunctionHandler(StringExtractorGDBRemote::eServerPacketType_M,
                                   &GDBRemoteCommunicationServerLLGS::Handle_M);
     RegisterMemberFunctionHandler(StringExtractorGDBRemote::eServerPacketType_p,
                                   &GDBRemoteCommunicationServerLLGS::Handle_p);
     RegisterMemberFunctionHandler(StringExtractorGDBRemote::eServerPacketType_P,
                                   &GDBRemoteCommunicationServerLLGS::Handle_P);
+    RegisterMemberFunctionHandler(StringExtractorGDBRemote::eServerPacketType_qBreakpointHitCount,
+                                  &GDBRemoteCommunicationServerLLGS::Handle_qBreakpointHitCount);
     RegisterMemberFunctionHandler(StringExtractorGDBRemote::eServerPacketType_qC,
                                   &GDBRemoteCommunicationServerLLGS::Handle_qC);
     RegisterMemberFunctionHandler(StringExtractorGDBRemote::eServerPacketType_qfThreadInfo,
@@ -174,6 +184,8 @@ GDBRemoteCommunicationServerLLGS::RegisterPacketHandlers()
                                   &GDBRemoteCommunicationServerLLGS::Handle_vCont);
     RegisterMemberFunctionHandler(StringExtractorGDBRemote::eServerPacketType_vCont_actions,
                                   &GDBRemoteCommunicationServerLLGS::Handle_vCont_actions);
+    RegisterMemberFunctionHandler(StringExtractorGDBRemote::eServerPacketType_x,
+                                  &GDBRemoteCommunicationServerLLGS::Handle_memory_read);
     RegisterMemberFunctionHandler(StringExtractorGDBRemote::eServerPacketType_Z,
                                   &GDBRemoteCommunicationServerLLGS::Handle_Z);
     RegisterMemberFunctionHandler(StringExtractorGDBRemote::eServerPacketType_z,
@@ -411,17 +423,10 @@ GDBRemoteCommunicationServerLLGS::SendWResponse (NativeProcessProtocol *process)
 static void
 AppendHexValue (StreamString &response, const uint8_t* buf, uint32_t buf_size, bool swap)
 {
-    int64_t i;
     if (swap)
-    {
-        for (i = buf_size-1; i >= 0; i--)
-            response.PutHex8 (buf[i]);
-    }
+        response.PutBytesAsRawHex8 (buf, buf_size, eByteOrderLittle, eByteOrderBig);
     else
-    {
-        for (i = 0; i < buf_size; i++)
-            response.PutHex8 (buf[i]);
-    }
+        response.PutBytesAsRawHex8 (buf, buf_size);
 }
 
 static void
@@ -454,6 +459,33 @@ WriteRegisterValueInHexFixedWidth (StreamString &response,
     }
 }
 
+static const char *
+GetStopReasonString (StopReason stop_reason)
+{
+    switch (stop_reason)
+    {
+    case eStopReasonTrace:
+        return "trace";
+    case eStopReasonBreakpoint:
+        return "breakpoint";
+    case eStopReasonWatchpoint:
+        return "watchpoint";
+    case eStopReasonSignal:
+        return "signal";
+    case eStopReasonException:
+        return "exception";
+    case eStopReasonExec:
+        return "exec";
+    case eStopReasonInstrumentation:
+    case eStopReasonInvalid:
+    case eStopReasonPlanComplete:
+    case eStopReasonThreadExiting:
+    case eStopReasonNone:
+        break;
+    }
+    return nullptr;
+}
+
 GDBRemoteCommunication::PacketResult
 GDBRemoteCommunicationServerLLGS::SendStopReplyPacketForThread (lldb::tid_t tid)
 {
@@ -594,34 +626,7 @@ GDBRemoteCommunicationServerLLGS::SendStopReplyPacketForThread (lldb::tid_t tid)
         }
     }
 
-    const char* reason_str = nullptr;
-    switch (tid_stop_info.reason)
-    {
-    case eStopReasonTrace:
-        reason_str = "trace";
-        break;
-    case eStopReasonBreakpoint:
-        reason_str = "breakpoint";
-        break;
-    case eStopReasonWatchpoint:
-        reason_str = "watchpoint";
-        break;
-    case eStopReasonSignal:
-        reason_str = "signal";
-        break;
-    case eStopReasonException:
-        reason_str = "exception";
-        break;
-    case eStopReasonExec:
-        reason_str = "exec";
-        break;
-    case eStopReasonInstrumentation:
-    case eStopReasonInvalid:
-    case eStopReasonPlanComplete:
-    case eStopReasonThreadExiting:
-    case eStopReasonNone:
-        break;
-    }
+    const char* reason_str = GetStopReasonString (tid_stop_info.reason);
     if (reason_str != nullptr)
     {
         response.Printf ("reason:%s;", reason_str);
@@ -1493,6 +1498,111 @@ GDBRemoteCommunicationServerLLGS::Handle_qsThreadInfo (StringExtractorGDBRemote
     return SendPacketNoLock ("l", 1);
 }
 
+GDBRemoteCommunication::PacketResult
+GDBRemoteCommunicationServerLLGS::Handle_g (StringExtractorGDBRemote &packet)
+{
+    Log *log (GetLogIfAnyCategoriesSet(LIBLLDB_LOG_THREAD));
+
+    // Get the thread to use.
+    packet.SetFilePos (strlen("g"));
+    NativeThreadProtocolSP thread_sp = GetThreadFromSuffix (packet);
+    if (!thread_sp)
+    {
+        if (log)
+            log->Printf ("GDBRemoteCommunicationServerLLGS::%s failed, no thread available", __FUNCTION__);
+        return SendErrorResponse (0x15);
+    }
+
+    // Get the thread's register context.
+    NativeRegisterContextSP reg_context_sp (thread_sp->GetRegisterContext ());
+    if (!reg_context_sp)
+    {
+        if (log)
+            log->Printf ("GDBRemoteCommunicationServerLLGS::%s pid %" PRIu64 " tid %" PRIu64 " failed, no register context available for the thread", __FUNCTION__, m_debugged_process_sp->GetID (), thread_sp->GetID ());
+        return SendErrorResponse (0x15);
+    }
+
+    // Registers are laid out at the byte offsets we report in qRegisterInfo.
+    DataBufferSP data_sp;
+    Error error = reg_context_sp->ReadAllUserRegisterValues (data_sp);
+    if (error.Fail () || !data_sp)
+    {
+        if (log)
+            log->Printf ("GDBRemoteCommunicationServerLLGS::%s pid %" PRIu64 " tid %" PRIu64 " failed to read registers: %s", __FUNCTION__, m_debugged_process_sp->GetID (), thread_sp->GetID (), error.AsCString ());
+        return SendErrorResponse (0x15);
+    }
+
+    StreamGDBRemote response;
+    response.PutBytesAsRawHex8 (data_sp->GetBytes (), data_sp->GetByteSize ());
+
+    return SendPacketNoLock (response.GetData (), response.GetSize ());
+}
+
+GDBRemoteCommunication::PacketResult
+GDBRemoteCommunicationServerLLGS::Handle_G (StringExtractorGDBRemote &packet)
+{
+    Log *log (GetLogIfAnyCategoriesSet(LIBLLDB_LOG_THREAD));
+
+    // Get process architecture.
+    ArchSpec process_arch;
+    if (!m_debugged_process_sp || !m_debugged_process_sp->GetArchitecture (process_arch))
+    {
+        if (log)
+            log->Printf ("GDBRemoteCommunicationServerLLGS::%s failed to retrieve inferior architecture", __FUNCTION__);
+        return SendErrorResponse (0x49);
+    }
+
+    // Parse out the register data, it is followed by an optional thread suffix.
+    packet.SetFilePos (strlen("G"));
+    std::vector<uint8_t> reg_bytes (packet.GetBytesLeft () / 2);
+    const size_t reg_bytes_size = packet.GetHexBytesAvail (reg_bytes.data (), reg_bytes.size ());
+    if (reg_bytes_size == 0)
+        return SendIllFormedResponse (packet, "G packet missing register data");
+
+    // Get the thread to use.
+    NativeThreadProtocolSP thread_sp = GetThreadFromSuffix (packet);
+    if (!thread_sp)
+    {
+        if (log)
+            log->Printf ("GDBRemoteCommunicationServerLLGS::%s failed, no thread available", __FUNCTION__);
+        return SendErrorResponse (0x28);
+    }
+
+    // Get the thread's register context.
+    NativeRegisterContextSP reg_context_sp (thread_sp->GetRegisterContext ());
+    if (!reg_context_sp)
+    {
+        if (log)
+            log->Printf ("GDBRemoteCommunicationServerLLGS::%s pid %" PRIu64 " tid %" PRIu64 " failed, no register context available for the thread", __FUNCTION__, m_debugged_process_sp->GetID (), thread_sp->GetID ());
+        return SendErrorResponse (0x15);
+    }
+
+    // Write back every register the packet covers, using the same layout as
+    // the g packet. Slice registers are written through their containing
+    // register.
+    const uint32_t reg_count = reg_context_sp->GetUserRegisterCount ();
+    for (uint32_t reg_index = 0; reg_index < reg_count; ++reg_index)
+    {
+        const RegisterInfo *reg_info = reg_context_sp->GetRegisterInfoAtIndex (reg_index);
+        if (!reg_info || reg_info->value_regs)
+            continue;
+
+        if (reg_info->byte_offset + reg_info->byte_size > reg_bytes_size)
+            continue;
+
+        RegisterValue reg_value (reg_bytes.data () + reg_info->byte_offset, reg_info->byte_size, process_arch.GetByteOrder ());
+        Error error = reg_context_sp->WriteRegister (reg_info, reg_value);
+        if (error.Fail ())
+        {
+            if (log)
+                log->Printf ("GDBRemoteCommunicationServerLLGS::%s failed, write of register %" PRIu32 " (%s) failed: %s", __FUNCTION__, reg_index, reg_info->name, error.AsCString ());
+            return SendErrorResponse (0x32);
+        }
+    }
+
+    return SendOKResponse();
+}
+
 GDBRemoteCommunication::PacketResult
 GDBRemoteCommunicationServerLLGS::Handle_p (StringExtractorGDBRemote &packet)
 {
@@ -1564,8 +1674,7 @@ GDBRemoteCommunicationServerLLGS::Handle_p (StringExtractorGDBRemote &packet)
     }
 
     // FIXME flip as needed to get data in big/little endian format for this host.
-    for (uint32_t i = 0; i < reg_value.GetByteSize (); ++i)
-        response.PutHex8 (data[i]);
+    response.PutBytesAsRawHex8 (data, reg_value.GetByteSize ());
 
     return SendPacketNoLock (response.GetData (), response.GetSize ());
 }
@@ -1803,7 +1912,7 @@ GDBRemoteCommunicationServerLLGS::Handle_interrupt (StringExtractorGDBRemote &pa
 }
 
 GDBRemoteCommunication::PacketResult
-GDBRemoteCommunicationServerLLGS::Handle_m (StringExtractorGDBRemote &packet)
+GDBRemoteCommunicationServerLLGS::Handle_memory_read (StringExtractorGDBRemote &packet)
 {
     Log *log (GetLogIfAnyCategoriesSet(LIBLLDB_LOG_PROCESS));
 
@@ -1814,28 +1923,40 @@ GDBRemoteCommunicationServerLLGS::Handle_m (StringExtractorGDBRemote &packet)
         return SendErrorResponse (0x15);
     }
 
+    // "m" packets return the memory hex encoded, "x" packets return it as
+    // binary data using the 0x7d escaping, which halves the size on the wire.
+    // The lldb client sends "x" packet values with a "0x" prefix.
+    const bool binary = packet.GetStringRef()[0] == 'x';
+
     // Parse out the memory address.
-    packet.SetFilePos (strlen("m"));
+    packet.SetFilePos (1);
     if (packet.GetBytesLeft() < 1)
-        return SendIllFormedResponse(packet, "Too short m packet");
+        return SendIllFormedResponse(packet, "Too short memory read packet");
 
     // Read the address.  Punting on validation.
     // FIXME replace with Hex U64 read with no default value that fails on failed read.
+    if (binary && packet.GetBytesLeft() > 2 && ::strncmp (packet.Peek(), "0x", 2) == 0)
+        packet.SetFilePos (packet.GetFilePos() + 2);
     const lldb::addr_t read_addr = packet.GetHexMaxU64(false, 0);
 
     // Validate comma.
     if ((packet.GetBytesLeft() < 1) || (packet.GetChar() != ','))
-        return SendIllFormedResponse(packet, "Comma sep missing in m packet");
+        return SendIllFormedResponse(packet, "Comma sep missing in memory read packet");
 
     // Get # bytes to read.
     if (packet.GetBytesLeft() < 1)
-        return SendIllFormedResponse(packet, "Length missing in m packet");
+        return SendIllFormedResponse(packet, "Length missing in memory read packet");
 
+    if (binary && packet.GetBytesLeft() > 2 && ::strncmp (packet.Peek(), "0x", 2) == 0)
+        packet.SetFilePos (packet.GetFilePos() + 2);
     const uint64_t byte_count = packet.GetHexMaxU64(false, 0);
     if (byte_count == 0)
     {
         if (log)
             log->Printf ("GDBRemoteCommunicationServerLLGS::%s nothing to read: zero-length packet", __FUNCTION__);
+        // Clients probe for "x" packet support with a zero length read.
+        if (binary)
+            return SendOKResponse ();
         return PacketResult::Success;
     }
 
@@ -1863,8 +1984,10 @@ GDBRemoteCommunicationServerLLGS::Handle_m (StringExtractorGDBRemote &packet)
     }
 
     StreamGDBRemote response;
-    for (size_t i = 0; i < bytes_read; ++i)
-        response.PutHex8(buf[i]);
+    if (binary)
+        response.PutEscapedBytes(buf.data(), bytes_read);
+    else
+        response.PutBytesAsRawHex8(buf.data(), bytes_read);
 
     return SendPacketNoLock(response.GetData(), response.GetSize());
 }
@@ -2091,10 +2214,28 @@ GDBRemoteCommunicationServerLLGS::Handle_Z (StringExtractorGDBRemote &packet)
     if (size == std::numeric_limits<uint32_t>::max ())
         return SendIllFormedResponse(packet, "Malformed Z packet, failed to parse size argument");
 
+    // Parse out any conditions, each an agent expression: ";X<len>,<bytecode>"
+    std::vector<AgentExpression> conditions;
+    while (packet.GetBytesLeft() > 0)
+    {
+        if (packet.GetChar() != ';' || packet.GetChar() != 'X')
+            return SendIllFormedResponse(packet, "Malformed Z packet, only conditions are supported after the size");
+        const uint32_t condition_size = packet.GetHexMaxU32 (false, 0);
+        if (condition_size == 0 || packet.GetChar() != ',')
+            return SendIllFormedResponse(packet, "Malformed Z packet, failed to parse condition length");
+        std::vector<uint8_t> condition_bytes (condition_size);
+        if (packet.GetHexBytes (&condition_bytes[0], condition_size, 0) != condition_size)
+            return SendIllFormedResponse(packet, "Malformed Z packet, condition shorter than its length");
+        conditions.push_back (AgentExpression (&condition_bytes[0], condition_size));
+    }
+
     if (want_breakpoint)
     {
         // Try to set the breakpoint.
-        const Error error = m_debugged_process_sp->SetBreakpoint (addr, size, want_hardware);
+        Error error = m_debugged_process_sp->SetBreakpoint (addr, size, want_hardware);
+        // A Z packet replaces the conditions of a breakpoint that is already there.
+        if (error.Success ())
+            error = m_debugged_process_sp->SetBreakpointConditions (addr, std::move (conditions));
         if (error.Success ())
             return SendOKResponse ();
         Log *log (GetLogIfAnyCategoriesSet(LIBLLDB_LOG_BREAKPOINTS));
@@ -2584,6 +2725,108 @@ GDBRemoteCommunicationServerLLGS::Handle_qThreadStopInfo (StringExtractorGDBRemo
     return SendStopReplyPacketForThread (tid);
 }
 
+GDBRemoteCommunication::PacketResult
+GDBRemoteCommunicationServerLLGS::Handle_jThreadsInfo (StringExtractorGDBRemote &packet)
+{
+    Log *log (GetLogIfAnyCategoriesSet(LIBLLDB_LOG_PROCESS | LIBLLDB_LOG_THREAD));
+
+    // Ensure we have a debugged process.
+    if (!m_debugged_process_sp || (m_debugged_process_sp->GetID () == LLDB_INVALID_PROCESS_ID))
+        return SendErrorResponse (50);
+
+    if (log)
+        log->Printf ("GDBRemoteCommunicationServerLLGS::%s preparing packet for pid %" PRIu64,
+                     __FUNCTION__, m_debugged_process_sp->GetID ());
+
+    // Only the registers needed to get a backtrace started are expedited, the
+    // rest can be read on demand.
+    static const uint32_t k_expedited_registers[] = {
+        LLDB_REGNUM_GENERIC_PC,
+        LLDB_REGNUM_GENERIC_SP,
+        LLDB_REGNUM_GENERIC_FP
+    };
+
+    JSONArray threads_array;
+    uint32_t thread_index = 0;
+    NativeThreadProtocolSP thread_sp;
+    for (thread_sp = m_debugged_process_sp->GetThreadAtIndex (thread_index); thread_sp; ++thread_index, thread_sp = m_debugged_process_sp->GetThreadAtIndex (thread_index))
+    {
+        JSONObject::SP thread_obj_sp = std::make_shared<JSONObject> ();
+        thread_obj_sp->SetObject ("tid", std::make_shared<JSONNumber> (thread_sp->GetID ()));
+
+        const std::string thread_name = thread_sp->GetName ();
+        if (!thread_name.empty ())
+            thread_obj_sp->SetObject ("name", std::make_shared<JSONString> (thread_name));
+
+        struct ThreadStopInfo tid_stop_info;
+        std::string description;
+        if (thread_sp->GetStopReason (tid_stop_info, description))
+        {
+            thread_obj_sp->SetObject ("signal", std::make_shared<JSONNumber> (tid_stop_info.details.signal.signo));
+
+            const char *reason_str = GetStopReasonString (tid_stop_info.reason);
+            if (reason_str != nullptr)
+                thread_obj_sp->SetObject ("reason", std::make_shared<JSONString> (reason_str));
+
+            if (!description.empty ())
+                thread_obj_sp->SetObject ("description", std::make_shared<JSONString> (description));
+            else if ((tid_stop_info.reason == eStopReasonException) && tid_stop_info.details.exception.type)
+            {
+                thread_obj_sp->SetObject ("metype", std::make_shared<JSONNumber> (tid_stop_info.details.exception.type));
+
+                JSONArray::SP medata_array_sp = std::make_shared<JSONArray> ();
+                for (uint32_t i = 0; i < tid_stop_info.details.exception.data_count; ++i)
+                    medata_array_sp->AppendObject (std::make_shared<JSONNumber> (tid_stop_info.details.exception.data[i]));
+                thread_obj_sp->SetObject ("medata", medata_array_sp);
+            }
+        }
+
+        // Registers are keyed by their decimal register number and their values
+        // are hex encoded in target byte order, just like in a stop reply packet.
+        NativeRegisterContextSP reg_ctx_sp = thread_sp->GetRegisterContext ();
+        if (reg_ctx_sp)
+        {
+            JSONObject::SP registers_obj_sp = std::make_shared<JSONObject> ();
+            for (uint32_t generic_reg : k_expedited_registers)
+            {
+                const uint32_t reg_num = reg_ctx_sp->ConvertRegisterKindToRegisterNumber (eRegisterKindGeneric, generic_reg);
+                if (reg_num == LLDB_INVALID_REGNUM)
+                    continue;
+
+                const RegisterInfo *const reg_info_p = reg_ctx_sp->GetRegisterInfoAtIndex (reg_num);
+                if (reg_info_p == nullptr)
+                    continue;
+
+                RegisterValue reg_value;
+                Error error = reg_ctx_sp->ReadRegister (reg_info_p, reg_value);
+                if (error.Fail ())
+                {
+                    if (log)
+                        log->Printf ("GDBRemoteCommunicationServerLLGS::%s failed to read register '%s' index %" PRIu32 ": %s", __FUNCTION__, reg_info_p->name ? reg_info_p->name : "<unnamed-register>", reg_num, error.AsCString ());
+                    continue;
+                }
+
+                StreamString reg_key;
+                reg_key.Printf ("%" PRIu32, reg_num);
+                StreamString reg_value_hex;
+                WriteRegisterValueInHexFixedWidth (reg_value_hex, reg_ctx_sp, *reg_info_p, &reg_value);
+                registers_obj_sp->SetObject (reg_key.GetString (), std::make_shared<JSONString> (reg_value_hex.GetString ()));
+            }
+            thread_obj_sp->SetObject ("registers", registers_obj_sp);
+        }
+
+        threads_array.AppendObject (thread_obj_sp);
+    }
+
+    // JSON uses '}' which is the gdb-remote escape character, so the whole
+    // payload is sent with binary escaping.
+    StreamString json;
+    threads_array.Write (json);
+    StreamGDBRemote response;
+    response.PutEscapedBytes (json.GetData (), json.GetSize ());
+    return SendPacketNoLock (response.GetData (), response.GetSize ());
+}
+
 GDBRemoteCommunication::PacketResult
 GDBRemoteCommunicationServerLLGS::Handle_qWatchpointSupportInfo (StringExtractorGDBRemote &packet)
 {
@@ -2604,6 +2847,32 @@ GDBRemoteCommunicationServerLLGS::Handle_qWatchpointSupportInfo (StringExtractor
     return SendPacketNoLock(response.GetData(), response.GetSize());
 }
 
+GDBRemoteCommunication::PacketResult
+GDBRemoteCommunicationServerLLGS::Handle_qBreakpointHitCount (StringExtractorGDBRemote &packet)
+{
+    // Fail if we don't have a current process.
+    if (!m_debugged_process_sp ||
+            m_debugged_process_sp->GetID () == LLDB_INVALID_PROCESS_ID)
+        return SendErrorResponse (0x15);
+
+    packet.SetFilePos(strlen("qBreakpointHitCount:"));
+    if (packet.GetBytesLeft() < 1)
+        return SendIllFormedResponse(packet, "Too short qBreakpointHitCount packet, missing address");
+    const lldb::addr_t addr = packet.GetHexMaxU64(false, LLDB_INVALID_ADDRESS);
+
+    uint64_t hit_count = 0;
+    uint64_t skipped_hit_count = 0;
+    const Error error = m_debugged_process_sp->GetBreakpointHitCounts (addr, hit_count, skipped_hit_count);
+    if (error.Fail ())
+        return SendErrorResponse (0x09);
+
+    // The skipped hits are those where the conditions were false and the
+    // process went on without stopping.
+    StreamGDBRemote response;
+    response.Printf ("hits:%" PRIx64 ";skipped:%" PRIx64 ";", hit_count, skipped_hit_count);
+    return SendPacketNoLock(response.GetData(), response.GetSize());
+}
+
 void
 GDBRemoteCommunicationServerLLGS::FlushInferiorOutput ()
 {
@@ -181,6 +181,12 @@ protected:
     PacketResult
     Handle_qsThreadInfo (StringExtractorGDBRemote &packet);
 
+    PacketResult
+    Handle_g (StringExtractorGDBRemote &packet);
+
+    PacketResult
+    Handle_G (StringExtractorGDBRemote &packet);
+
     PacketResult
     Handle_p (StringExtractorGDBRemote &packet);
 
@@ -197,7 +203,10 @@ protected:
     Handle_interrupt (StringExtractorGDBRemote &packet);
 
     PacketResult
-    Handle_m (StringExtractorGDBRemote &packet);
+    Handle_jThreadsInfo (StringExtractorGDBRemote &packet);
+
+    PacketResult
+    Handle_memory_read (StringExtractorGDBRemote &packet);
 
     PacketResult
     Handle_M (StringExtractorGDBRemote &packet);
@@ -238,6 +247,9 @@ protected:
     PacketResult
     Handle_qWatchpointSupportInfo (StringExtractorGDBRemote &packet);
 
+    PacketResult
+    Handle_qBreakpointHitCount (StringExtractorGDBRemote &packet);
+
     void
     SetCurrentThreadID (lldb::tid_t tid);
 
@@ -150,6 +150,27 @@ GDBRemoteRegisterContext::PrivateSetRegisterValue (uint32_t reg, StringExtractor
     return success;
 }
 
+// Fill the whole register cache from the hex payload of a "g" response.
+// The payload must cover all of our register data, otherwise the layout
+// the stub uses doesn't match our register info and nothing is updated.
+bool
+GDBRemoteRegisterContext::PrivateSetAllRegisterValues (StringExtractor &response)
+{
+    const size_t reg_data_size = m_reg_data.GetByteSize();
+    if (reg_data_size == 0)
+        return false;
+
+    InvalidateIfNeeded(false);
+
+    DataBufferHeap buffer (reg_data_size, 0);
+    if (response.GetHexBytes (buffer.GetBytes(), reg_data_size, '\xcc') != reg_data_size)
+        return false;
+
+    ::memcpy (const_cast<uint8_t *>(m_reg_data.GetDataStart()), buffer.GetBytes(), reg_data_size);
+    SetAllRegisterValid (true);
+    return true;
+}
+
 // Helper function for GDBRemoteRegisterContext::ReadRegisterBytes().
 bool
 GDBRemoteRegisterContext::GetPrimordialRegister(const RegisterInfo *reg_info,
@@ -186,46 +207,62 @@ GDBRemoteRegisterContext::ReadRegisterBytes (const RegisterInfo *reg_info, DataE
             if (!gdb_comm.ReadAllRegisters(m_thread.GetProtocolID(), response))
                 return false;
             if (response.IsNormalResponse())
-                if (response.GetHexBytes ((void *)m_reg_data.GetDataStart(), m_reg_data.GetByteSize(), '\xcc') == m_reg_data.GetByteSize())
-                    SetAllRegisterValid (true);
+                PrivateSetAllRegisterValues (response);
         }
-        else if (reg_info->value_regs)
+        else if (gdb_comm.GetgPacketSupported() && !gdb_comm.AvoidGPackets ((ProcessGDBRemote *)process))
         {
-            // Process this composite register request by delegating to the constituent
-            // primordial registers.
-            
-            // Index of the primordial register.
-            bool success = true;
-            for (uint32_t idx = 0; success; ++idx)
+            // A single "g" costs the same round trip as a single "p" and fills
+            // the cache for every other register the unwinder or "register read"
+            // is about to ask for. If the stub's "g" layout doesn't match our
+            // register info, stop using "g" and fall back to "p" below.
+            StringExtractorGDBRemote response;
+            if (gdb_comm.ReadAllRegisters(m_thread.GetProtocolID(), response) && response.IsNormalResponse())
             {
-                const uint32_t prim_reg = reg_info->value_regs[idx];
-                if (prim_reg == LLDB_INVALID_REGNUM)
-                    break;
-                // We have a valid primordial register as our constituent.
-                // Grab the corresponding register info.
-                const RegisterInfo *prim_reg_info = GetRegisterInfoAtIndex(prim_reg);
-                if (prim_reg_info == NULL)
-                    success = false;
-                else
+                if (!PrivateSetAllRegisterValues (response))
+                    gdb_comm.SetgPacketSupported (false);
+            }
+        }
+
+        if (!GetRegisterIsValid(reg) && !m_read_all_at_once)
+        {
+            if (reg_info->value_regs)
+            {
+                // Process this composite register request by delegating to the constituent
+                // primordial registers.
+            
+                // Index of the primordial register.
+                bool success = true;
+                for (uint32_t idx = 0; success; ++idx)
                 {
-                    // Read the containing register if it hasn't already been read
-                    if (!GetRegisterIsValid(prim_reg))
-                        success = GetPrimordialRegister(prim_reg_info, gdb_comm);
+                    const uint32_t prim_reg = reg_info->value_regs[idx];
+                    if (prim_reg == LLDB_INVALID_REGNUM)
+                        break;
+                    // We have a valid primordial register as our constituent.
+                    // Grab the corresponding register info.
+                    const RegisterInfo *prim_reg_info = GetRegisterInfoAtIndex(prim_reg);
+                    if (prim_reg_info == NULL)
+                        success = false;
+                    else
+                    {
+                        // Read the containing register if it hasn't already been read
+                        if (!GetRegisterIsValid(prim_reg))
+                            success = GetPrimordialRegister(prim_reg_info, gdb_comm);
+                    }
                 }
-            }
 
-            if (success)
+                if (success)
+                {
+                    // If we reach this point, all primordial register requests have succeeded.
+                    // Validate this composite register.
+                    SetRegisterIsValid (reg_info, true);
+                }
+            }
+            else
             {
-                // If we reach this point, all primordial register requests have succeeded.
-                // Validate this composite register.
-                SetRegisterIsValid (reg_info, true);
+                // Get each register individually
+                GetPrimordialRegister(reg_info, gdb_comm);
             }
         }
-        else
-        {
-            // Get each register individually
-            GetPrimordialRegister(reg_info, gdb_comm);
-        }
 
         // Make sure we got a valid register value after reading it
         if (!GetRegisterIsValid(reg))
@@ -500,7 +537,10 @@ GDBRemoteRegisterContext::WriteAllRegisterValues (const RegisterCheckpoint &reg_
             return false;
         
         GDBRemoteCommunicationClient &gdb_comm (((ProcessGDBRemote *)process)->GetGDBRemote());
-        
+
+        // The stub restores the registers on its side, so nothing we have
+        // cached for this thread can be trusted afterwards.
+        SetAllRegisterValid (false);
         return gdb_comm.RestoreRegisterState(m_thread.GetProtocolID(), save_id);
     }
     else
@@ -544,31 +584,26 @@ GDBRemoteRegisterContext::ReadAllRegisterValues (lldb::DataBufferSP &data_sp)
 
             if (use_g_packet && gdb_comm.SendPacketAndWaitForResponse(packet, packet_len, response, false) == GDBRemoteCommunication::PacketResult::Success)
             {
-                int packet_len = 0;
-                if (thread_suffix_supported)
-                    packet_len = ::snprintf (packet, sizeof(packet), "g;thread:%4.4" PRIx64, m_thread.GetProtocolID());
-                else
-                    packet_len = ::snprintf (packet, sizeof(packet), "g");
-                assert (packet_len < ((int)sizeof(packet) - 1));
-    
-                if (gdb_comm.SendPacketAndWaitForResponse(packet, packet_len, response, false) == GDBRemoteCommunication::PacketResult::Success)
+                if (response.IsErrorResponse())
+                    return false;
+
+                std::string &response_str = response.GetStringRef();
+                if (isxdigit(response_str[0]))
                 {
-                    if (response.IsErrorResponse())
-                        return false;
-    
-                    std::string &response_str = response.GetStringRef();
-                    if (isxdigit(response_str[0]))
+                    // The register values we just fetched are as good as any
+                    // "p" response, so keep them in the register cache too.
+                    StringExtractor reg_data_extractor (response_str.c_str());
+                    PrivateSetAllRegisterValues (reg_data_extractor);
+
+                    response_str.insert(0, 1, 'G');
+                    if (thread_suffix_supported)
                     {
-                        response_str.insert(0, 1, 'G');
-                        if (thread_suffix_supported)
-                        {
-                            char thread_id_cstr[64];
-                            ::snprintf (thread_id_cstr, sizeof(thread_id_cstr), ";thread:%4.4" PRIx64 ";", m_thread.GetProtocolID());
-                            response_str.append (thread_id_cstr);
-                        }
-                        data_sp.reset (new DataBufferHeap (response_str.c_str(), response_str.size()));
-                        return true;
+                        char thread_id_cstr[64];
+                        ::snprintf (thread_id_cstr, sizeof(thread_id_cstr), ";thread:%4.4" PRIx64 ";", m_thread.GetProtocolID());
+                        response_str.append (thread_id_cstr);
                     }
+                    data_sp.reset (new DataBufferHeap (response_str.c_str(), response_str.size()));
+                    return true;
                 }
             }
             else
@@ -652,121 +687,137 @@ GDBRemoteRegisterContext::WriteAllRegisterValues (const lldb::DataBufferSP &data
                                                           response,
                                                           false) == GDBRemoteCommunication::PacketResult::Success)
             {
-                // The data_sp contains the entire G response packet including the
-                // G, and if the thread suffix is supported, it has the thread suffix
-                // as well.
-                const char *G_packet = (const char *)data_sp->GetBytes();
-                size_t G_packet_len = data_sp->GetByteSize();
-                if (gdb_comm.SendPacketAndWaitForResponse (G_packet,
-                                                           G_packet_len,
-                                                           response,
-                                                           false) == GDBRemoteCommunication::PacketResult::Success)
+                // Whatever we had cached for this thread is stale now.
+                SetAllRegisterValid (false);
+
+                if (response.IsOKResponse())
+                    return true;
+                else if (response.IsErrorResponse())
                 {
-                    if (response.IsOKResponse())
-                        return true;
-                    else if (response.IsErrorResponse())
+                    uint32_t num_restored = 0;
+                    // We need to manually go through all of the registers and
+                    // restore them manually
+
+                    response.GetStringRef().assign (G_packet, G_packet_len);
+                    response.SetFilePos(1); // Skip the leading 'G'
+
+                    // G_packet_len is hex-ascii characters plus prefix 'G' plus suffix thread specifier.
+                    // This means buffer will be a little more than 2x larger than necessary but we resize
+                    // it down once we've extracted all hex ascii chars from the packet.
+                    DataBufferHeap buffer (G_packet_len, 0);
+
+                    const uint32_t bytes_extracted = response.GetHexBytes (buffer.GetBytes(),
+                                                                           buffer.GetByteSize(),
+                                                                           '\xcc');
+
+                    DataExtractor restore_data (buffer.GetBytes(),
+                                                buffer.GetByteSize(),
+                                                m_reg_data.GetByteOrder(),
+                                                m_reg_data.GetAddressByteSize());
+
+                    if (bytes_extracted < restore_data.GetByteSize())
+                        restore_data.SetData(restore_data.GetDataStart(), bytes_extracted, m_reg_data.GetByteOrder());
+
+                    const RegisterInfo *reg_info;
+
+                    // The g packet contents may either include the slice registers (registers defined in
+                    // terms of other registers, e.g. eax is a subset of rax) or not.  The slice registers 
+                    // should NOT be in the g packet, but some implementations may incorrectly include them.
+                    // 
+                    // If the slice registers are included in the packet, we must step over the slice registers 
+                    // when parsing the packet -- relying on the RegisterInfo byte_offset field would be incorrect.
+                    // If the slice registers are not included, then using the byte_offset values into the
+                    // data buffer is the best way to find individual register values.
+
+                    uint64_t size_including_slice_registers = 0;
+                    uint64_t size_not_including_slice_registers = 0;
+                    uint64_t size_by_highest_offset = 0;
+
+                    for (uint32_t reg_idx=0; (reg_info = GetRegisterInfoAtIndex (reg_idx)) != NULL; ++reg_idx)
                     {
-                        uint32_t num_restored = 0;
-                        // We need to manually go through all of the registers and
-                        // restore them manually
-    
-                        response.GetStringRef().assign (G_packet, G_packet_len);
-                        response.SetFilePos(1); // Skip the leading 'G'
-
-                        // G_packet_len is hex-ascii characters plus prefix 'G' plus suffix thread specifier.
-                        // This means buffer will be a little more than 2x larger than necessary but we resize
-                        // it down once we've extracted all hex ascii chars from the packet.
-                        DataBufferHeap buffer (G_packet_len, 0);
+                        size_including_slice_registers += reg_info->byte_size;
+                        if (reg_info->value_regs == NULL)
+                            size_not_including_slice_registers += reg_info->byte_size;
+                        if (reg_info->byte_offset >= size_by_highest_offset)
+                            size_by_highest_offset = reg_info->byte_offset + reg_info->byte_size;
+                    }
 
-                        const uint32_t bytes_extracted = response.GetHexBytes (buffer.GetBytes(),
-                                                                               buffer.GetByteSize(),
-                                                                               '\xcc');
+                    bool use_byte_offset_into_buffer;
+                    if (size_by_highest_offset == restore_data.GetByteSize())
+                    {
+                        // The size of the packet agrees with the highest offset: + size in the register file
+                        use_byte_offset_into_buffer = true;
+                    }
+                    else if (size_not_including_slice_registers == restore_data.GetByteSize())
+                    {
+                        // The size of the packet is the same as concatenating all of the registers sequentially,
+                        // skipping the slice registers
+                        use_byte_offset_into_buffer = true;
+                    }
+                    else if (size_including_slice_registers == restore_data.GetByteSize())
+                    {
+                        // The slice registers are present in the packet (when they shouldn't be).
+                        // Don't try to use the RegisterInfo byte_offset into the restore_data, it will
+                        // point to the wrong place.
+                        use_byte_offset_into_buffer = false;
+                    }
+                    else {
+                        // None of our expected sizes match the actual g packet data we're looking at.
+                        // The most conservative approach here is to use the running total byte offset.
+                        use_byte_offset_into_buffer = false;
+                    }
 
-                        DataExtractor restore_data (buffer.GetBytes(),
-                                                    buffer.GetByteSize(),
-                                                    m_reg_data.GetByteOrder(),
-                                                    m_reg_data.GetAddressByteSize());
+                    // In case our register definitions don't include the correct offsets,
+                    // keep track of the size of each reg & compute offset based on that.
+                    uint32_t running_byte_offset = 0;
+                    for (uint32_t reg_idx=0; (reg_info = GetRegisterInfoAtIndex (reg_idx)) != NULL; ++reg_idx, running_byte_offset += reg_info->byte_size)
+                    {
+                        // Skip composite aka slice registers (e.g. eax is a slice of rax).
+                        if (reg_info->value_regs)
+                            continue;
 
-                        if (bytes_extracted < restore_data.GetByteSize())
-                            restore_data.SetData(restore_data.GetDataStart(), bytes_extracted, m_reg_data.GetByteOrder());
-    
-                        const RegisterInfo *reg_info;
-
-                        // The g packet contents may either include the slice registers (registers defined in
-                        // terms of other registers, e.g. eax is a subset of rax) or not.  The slice registers 
-                        // should NOT be in the g packet, but some implementations may incorrectly include them.
-                        // 
-                        // If the slice registers are included in the packet, we must step over the slice registers 
-                        // when parsing the packet -- relying on the RegisterInfo byte_offset field would be incorrect.
-                        // If the slice registers are not included, then using the byte_offset values into the
-                        // data buffer is the best way to find individual register values.
-
-                        uint64_t size_including_slice_registers = 0;
-                        uint64_t size_not_including_slice_registers = 0;
-                        uint64_t size_by_highest_offset = 0;
-
-                        for (uint32_t reg_idx=0; (reg_info = GetRegisterInfoAtIndex (reg_idx)) != NULL; ++reg_idx)
-                        {
-                            size_including_slice_registers += reg_info->byte_size;
-                            if (reg_info->value_regs == NULL)
-                                size_not_including_slice_registers += reg_info->byte_size;
-                            if (reg_info->byte_offset >= size_by_highest_offset)
-                                size_by_highest_offset = reg_info->byte_offset + reg_info->byte_size;
-                        }
+                        const uint32_t reg = reg_info->kinds[eRegisterKindLLDB];
 
-                        bool use_byte_offset_into_buffer;
-                        if (size_by_highest_offset == restore_data.GetByteSize())
+                        uint32_t register_offset;
+                        if (use_byte_offset_into_buffer)
                         {
-                            // The size of the packet agrees with the highest offset: + size in the register file
-                            use_byte_offset_into_buffer = true;
+                            register_offset = reg_info->byte_offset;
                         }
-                        else if (size_not_including_slice_registers == restore_data.GetByteSize())
+                        else
                         {
-                            // The size of the packet is the same as concatenating all of the registers sequentially,
-                            // skipping the slice registers
-                            use_byte_offset_into_buffer = true;
-                        }
-                        else if (size_including_slice_registers == restore_data.GetByteSize())
-                        {
-                            // The slice registers are present in the packet (when they shouldn't be).
-                            // Don't try to use the RegisterInfo byte_offset into the restore_data, it will
-                            // point to the wrong place.
-                            use_byte_offset_into_buffer = false;
-                        }
-                        else {
-                            // None of our expected sizes match the actual g packet data we're looking at.
-                            // The most conservative approach here is to use the running total byte offset.
-                            use_byte_offset_into_buffer = false;
+                            register_offset = running_byte_offset;
                         }
 
-                        // In case our register definitions don't include the correct offsets,
-                        // keep track of the size of each reg & compute offset based on that.
-                        uint32_t running_byte_offset = 0;
-                        for (uint32_t reg_idx=0; (reg_info = GetRegisterInfoAtIndex (reg_idx)) != NULL; ++reg_idx, running_byte_offset += reg_info->byte_size)
+                        // Only write down the registers that need to be written
+                        // if we are going to be doing registers individually.
+                        bool write_reg = true;
+                        const uint32_t reg_byte_size = reg_info->byte_size;
+
+                        const char *restore_src = (const char *)restore_data.PeekData(register_offset, reg_byte_size);
+                        if (restore_src)
                         {
-                            // Skip composite aka slice registers (e.g. eax is a slice of rax).
-                            if (reg_info->value_regs)
-                                continue;
+                            StreamString packet;
+                            packet.Printf ("P%x=", reg);
+                            packet.PutBytesAsRawHex8 (restore_src,
+                                                      reg_byte_size,
+                                                      lldb::endian::InlHostByteOrder(),
+                                                      lldb::endian::InlHostByteOrder());
 
-                            const uint32_t reg = reg_info->kinds[eRegisterKindLLDB];
+                            if (thread_suffix_supported)
+                                packet.Printf (";thread:%4.4" PRIx64 ";", m_thread.GetProtocolID());
 
-                            uint32_t register_offset;
-                            if (use_byte_offset_into_buffer)
-                            {
-                                register_offset = reg_info->byte_offset;
-                            }
-                            else
+                            SetRegisterIsValid(reg, false);
+                            if (gdb_comm.SendPacketAndWaitForResponse(packet.GetString().c_str(),
+                                                                      packet.GetString().size(),
+                                                                      response,
+                                                                      false) == GDBRemoteCommunication::PacketResult::Success)
                             {
-                                register_offset = running_byte_offset;
+                                const char *current_src = (const char *)m_reg_data.PeekData(register_offset, reg_byte_size);
+                                if (current_src)
+                                    write_reg = memcmp (current_src, restore_src, reg_byte_size) != 0;
                             }
 
-                            // Only write down the registers that need to be written
-                            // if we are going to be doing registers individually.
-                            bool write_reg = true;
-                            const uint32_t reg_byte_size = reg_info->byte_size;
-    
-                            const char *restore_src = (const char *)restore_data.PeekData(register_offset, reg_byte_size);
-                            if (restore_src)
+                            if (write_reg)
                             {
                                 StreamString packet;
                                 packet.Printf ("P%x=", reg);
@@ -784,37 +835,13 @@ GDBRemoteRegisterContext::WriteAllRegisterValues (const lldb::DataBufferSP &data
                                                                           response,
                                                                           false) == GDBRemoteCommunication::PacketResult::Success)
                                 {
-                                    const char *current_src = (const char *)m_reg_data.PeekData(register_offset, reg_byte_size);
-                                    if (current_src)
-                                        write_reg = memcmp (current_src, restore_src, reg_byte_size) != 0;
-                                }
-    
-                                if (write_reg)
-                                {
-                                    StreamString packet;
-                                    packet.Printf ("P%x=", reg);
-                                    packet.PutBytesAsRawHex8 (restore_src,
-                                                              reg_byte_size,
-                                                              lldb::endian::InlHostByteOrder(),
-                                                              lldb::endian::InlHostByteOrder());
-    
-                                    if (thread_suffix_supported)
-                                        packet.Printf (";thread:%4.4" PRIx64 ";", m_thread.GetProtocolID());
-    
-                                    SetRegisterIsValid(reg, false);
-                                    if (gdb_comm.SendPacketAndWaitForResponse(packet.GetString().c_str(),
-                                                                              packet.GetString().size(),
-                                                                              response,
-                                                                              false) == GDBRemoteCommunication::PacketResult::Success)
-                                    {
-                                        if (response.IsOKResponse())
-                                            ++num_restored;
-                                    }
+                                    if (response.IsOKResponse())
+                                        ++num_restored;
                                 }
                             }
                         }
-                        return num_restored > 0;
                     }
+                    return num_restored > 0;
                 }
             }
             else
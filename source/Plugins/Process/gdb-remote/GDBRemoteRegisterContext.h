@@ -118,6 +118,9 @@ protected:
 
     bool
     PrivateSetRegisterValue (uint32_t reg, StringExtractor &response);
+
+    bool
+    PrivateSetAllRegisterValues (StringExtractor &response);
     
     void
     SetAllRegisterValid (bool b);
@@ -1702,6 +1702,7 @@ ProcessGDBRemote::ClearThreadIDList ()
 {
     Mutex::Locker locker(m_thread_list_real.GetMutex());
     m_thread_ids.clear();
+    m_thread_infos.clear();
 }
 
 bool
@@ -1717,6 +1718,73 @@ ProcessGDBRemote::UpdateThreadIDList ()
     return true;
 }
 
+bool
+ProcessGDBRemote::UpdateThreadInfos ()
+{
+    // Get the thread IDs, stop reasons and expedited registers of all threads
+    // with one packet instead of a qfThreadInfo/qsThreadInfo sequence followed
+    // by a qThreadStopInfo and a few register reads per thread.
+    StringExtractorGDBRemote response;
+    if (!m_gdb_comm.GetThreadsInfo (response))
+        return false;
+
+    // The packet has already had the 0x7d xor quoting stripped out at the
+    // GDBRemoteCommunication packet receive level.
+    StructuredData::ObjectSP threads_sp (StructuredData::ParseJSON (response.GetStringRef()));
+    StructuredData::Array *threads = threads_sp ? threads_sp->GetAsArray() : NULL;
+    if (threads == NULL)
+        return false;
+
+    Mutex::Locker locker(m_thread_list_real.GetMutex());
+    m_thread_ids.clear();
+    m_thread_infos.clear();
+    const size_t num_threads = threads->GetSize();
+    for (size_t i = 0; i < num_threads; ++i)
+    {
+        StructuredData::ObjectSP thread_info_sp (threads->GetItemAtIndex(i));
+        StructuredData::Dictionary *thread_dict = thread_info_sp ? thread_info_sp->GetAsDictionary() : NULL;
+        lldb::tid_t tid = LLDB_INVALID_THREAD_ID;
+        if (thread_dict && thread_dict->GetValueForKeyAsInteger ("tid", tid) && tid != LLDB_INVALID_THREAD_ID)
+        {
+            m_thread_ids.push_back (tid);
+            m_thread_infos[tid] = thread_info_sp;
+        }
+    }
+
+    Log *log (ProcessGDBRemoteLog::GetLogIfAllCategoriesSet (GDBR_LOG_THREAD));
+    if (log)
+        log->Printf ("ProcessGDBRemote::%s got stop info for %" PRIu64 " threads", __FUNCTION__, (uint64_t)m_thread_ids.size());
+    return true;
+}
+
+bool
+ProcessGDBRemote::CalculateThreadStopInfo (ThreadGDBRemote *thread)
+{
+    const lldb::tid_t tid = thread->GetProtocolID();
+
+    // See if we got this thread's stop info with the "jThreadsInfo" packet.
+    // Each entry is only used once, if the stop info needs to be calculated
+    // again we ask the stub so we don't reapply stale register values.
+    StructuredData::ObjectSP thread_info_sp;
+    {
+        Mutex::Locker locker(m_thread_list_real.GetMutex());
+        ThreadInfoMap::iterator pos = m_thread_infos.find (tid);
+        if (pos != m_thread_infos.end())
+        {
+            thread_info_sp = pos->second;
+            m_thread_infos.erase (pos);
+        }
+    }
+    if (thread_info_sp)
+        return SetThreadStopInfo (thread_info_sp->GetAsDictionary()) == eStateStopped;
+
+    // Fall back to using the qThreadStopInfo packet
+    StringExtractorGDBRemote stop_packet;
+    if (m_gdb_comm.GetThreadStopInfo(tid, stop_packet))
+        return SetThreadStopInfo (stop_packet) == eStateStopped;
+    return false;
+}
+
 bool
 ProcessGDBRemote::UpdateThreadList (ThreadList &old_thread_list, ThreadList &new_thread_list)
 {
@@ -1780,6 +1848,277 @@ ProcessGDBRemote::UpdateThreadList (ThreadList &old_thread_list, ThreadList &new
 }
 
 
+ThreadSP
+ProcessGDBRemote::SetThreadStopInfo (lldb::tid_t tid,
+                                     ExpeditedRegisterMap &expedited_register_map,
+                                     uint8_t signo,
+                                     const std::string &thread_name,
+                                     const std::string &reason,
+                                     const std::string &description,
+                                     uint32_t exc_type,
+                                     const std::vector<addr_t> &exc_data,
+                                     addr_t thread_dispatch_qaddr)
+{
+    ThreadSP thread_sp;
+    if (tid == LLDB_INVALID_THREAD_ID)
+        return thread_sp;
+
+    {
+        // m_thread_list_real does have its own mutex, but we need to
+        // hold onto the mutex between the call to m_thread_list_real.FindThreadByID(...)
+        // and the m_thread_list_real.AddThread(...) so it doesn't change on us
+        Mutex::Locker locker (m_thread_list_real.GetMutex ());
+        thread_sp = m_thread_list_real.FindThreadByProtocolID(tid, false);
+
+        if (!thread_sp)
+        {
+            // Create the thread if we need to
+            thread_sp.reset (new ThreadGDBRemote (*this, tid));
+            Log *log (ProcessGDBRemoteLog::GetLogIfAllCategoriesSet (GDBR_LOG_THREAD));
+            if (log && log->GetMask().Test(GDBR_LOG_VERBOSE))
+                log->Printf ("ProcessGDBRemote::%s Adding new thread: %p for thread ID: 0x%" PRIx64 ".\n",
+                             __FUNCTION__,
+                             static_cast<void*>(thread_sp.get()),
+                             thread_sp->GetID());
+
+            m_thread_list_real.AddThread(thread_sp);
+        }
+    }
+
+    ThreadGDBRemote *gdb_thread = static_cast<ThreadGDBRemote *> (thread_sp.get());
+
+    // Supply the expedited register values to our thread so it won't have
+    // to go and read them.
+    for (ExpeditedRegisterMap::iterator pos = expedited_register_map.begin(), end = expedited_register_map.end(); pos != end; ++pos)
+    {
+        StringExtractor reg_value_extractor;
+        // Swap the value over into "reg_value_extractor"
+        reg_value_extractor.GetStringRef().swap(pos->second);
+        if (!gdb_thread->PrivateSetRegisterValue (pos->first, reg_value_extractor))
+        {
+            Host::SetCrashDescriptionWithFormat("Setting thread register %u (0x%x) with value '%s' for thread 0x%" PRIx64,
+                                                pos->first,
+                                                pos->first,
+                                                reg_value_extractor.GetStringRef().c_str(),
+                                                tid);
+        }
+    }
+
+    // Clear the stop info just in case we don't set it to anything
+    thread_sp->SetStopInfo (StopInfoSP());
+
+    gdb_thread->SetThreadDispatchQAddr (thread_dispatch_qaddr);
+    gdb_thread->SetName (thread_name.empty() ? NULL : thread_name.c_str());
+    if (exc_type != 0)
+    {
+        const size_t exc_data_size = exc_data.size();
+
+        thread_sp->SetStopInfo (StopInfoMachException::CreateStopReasonWithMachException (*thread_sp,
+                                                                                          exc_type,
+                                                                                          exc_data_size,
+                                                                                          exc_data_size >= 1 ? exc_data[0] : 0,
+                                                                                          exc_data_size >= 2 ? exc_data[1] : 0,
+                                                                                          exc_data_size >= 3 ? exc_data[2] : 0));
+    }
+    else
+    {
+        bool handled = false;
+        bool did_exec = false;
+        if (!reason.empty())
+        {
+            if (reason.compare("trace") == 0)
+            {
+                thread_sp->SetStopInfo (StopInfo::CreateStopReasonToTrace (*thread_sp));
+                handled = true;
+            }
+            else if (reason.compare("breakpoint") == 0)
+            {
+                addr_t pc = thread_sp->GetRegisterContext()->GetPC();
+                lldb::BreakpointSiteSP bp_site_sp = thread_sp->GetProcess()->GetBreakpointSiteList().FindByAddress(pc);
+                if (bp_site_sp)
+                {
+                    // If the breakpoint is for this thread, then we'll report the hit, but if it is for another thread,
+                    // we can just report no reason.  We don't need to worry about stepping over the breakpoint here, that
+                    // will be taken care of when the thread resumes and notices that there's a breakpoint under the pc.
+                    handled = true;
+                    if (bp_site_sp->ValidForThisThread (thread_sp.get()))
+                    {
+                        thread_sp->SetStopInfo (StopInfo::CreateStopReasonWithBreakpointSiteID (*thread_sp, bp_site_sp->GetID()));
+                    }
+                    else
+                    {
+                        StopInfoSP invalid_stop_info_sp;
+                        thread_sp->SetStopInfo (invalid_stop_info_sp);
+                    }
+                }
+            }
+            else if (reason.compare("trap") == 0)
+            {
+                // Let the trap just use the standard signal stop reason below...
+            }
+            else if (reason.compare("watchpoint") == 0)
+            {
+                StringExtractor desc_extractor(description.c_str());
+                addr_t wp_addr = desc_extractor.GetU64(LLDB_INVALID_ADDRESS);
+                uint32_t wp_index = desc_extractor.GetU32(LLDB_INVALID_INDEX32);
+                watch_id_t watch_id = LLDB_INVALID_WATCH_ID;
+                if (wp_addr != LLDB_INVALID_ADDRESS)
+                {
+                    WatchpointSP wp_sp = GetTarget().GetWatchpointList().FindByAddress(wp_addr);
+                    if (wp_sp)
+                    {
+                        wp_sp->SetHardwareIndex(wp_index);
+                        watch_id = wp_sp->GetID();
+                    }
+                }
+                if (watch_id == LLDB_INVALID_WATCH_ID)
+                {
+                    Log *log (ProcessGDBRemoteLog::GetLogIfAllCategoriesSet (GDBR_LOG_WATCHPOINTS));
+                    if (log) log->Printf ("failed to find watchpoint");
+                }
+                thread_sp->SetStopInfo (StopInfo::CreateStopReasonWithWatchpointID (*thread_sp, watch_id));
+                handled = true;
+            }
+            else if (reason.compare("exception") == 0)
+            {
+                thread_sp->SetStopInfo (StopInfo::CreateStopReasonWithException(*thread_sp, description.c_str()));
+                handled = true;
+            }
+            else if (reason.compare("exec") == 0)
+            {
+                did_exec = true;
+                thread_sp->SetStopInfo (StopInfo::CreateStopReasonWithExec(*thread_sp));
+                handled = true;
+            }
+        }
+
+        if (!handled && signo && did_exec == false)
+        {
+            if (signo == SIGTRAP)
+            {
+                // Currently we are going to assume SIGTRAP means we are either
+                // hitting a breakpoint or hardware single stepping. 
+                handled = true;
+                addr_t pc = thread_sp->GetRegisterContext()->GetPC() + m_breakpoint_pc_offset;
+                lldb::BreakpointSiteSP bp_site_sp = thread_sp->GetProcess()->GetBreakpointSiteList().FindByAddress(pc);
+
+                if (bp_site_sp)
+                {
+                    // If the breakpoint is for this thread, then we'll report the hit, but if it is for another thread,
+                    // we can just report no reason.  We don't need to worry about stepping over the breakpoint here, that
+                    // will be taken care of when the thread resumes and notices that there's a breakpoint under the pc.
+                    if (bp_site_sp->ValidForThisThread (thread_sp.get()))
+                    {
+                        if(m_breakpoint_pc_offset != 0)
+                            thread_sp->GetRegisterContext()->SetPC(pc);
+                        thread_sp->SetStopInfo (StopInfo::CreateStopReasonWithBreakpointSiteID (*thread_sp, bp_site_sp->GetID()));
+                    }
+                    else
+                    {
+                        StopInfoSP invalid_stop_info_sp;
+                        thread_sp->SetStopInfo (invalid_stop_info_sp);
+                    }
+                }
+                else
+                {
+                    // If we were stepping then assume the stop was the result of the trace.  If we were
+                    // not stepping then report the SIGTRAP.
+                    // FIXME: We are still missing the case where we single step over a trap instruction.
+                    if (thread_sp->GetTemporaryResumeState() == eStateStepping)
+                        thread_sp->SetStopInfo (StopInfo::CreateStopReasonToTrace (*thread_sp));
+                    else
+                        thread_sp->SetStopInfo (StopInfo::CreateStopReasonWithSignal(*thread_sp, signo));
+                }
+            }
+            if (!handled)
+                thread_sp->SetStopInfo (StopInfo::CreateStopReasonWithSignal (*thread_sp, signo));
+        }
+
+        if (!description.empty())
+        {
+            lldb::StopInfoSP stop_info_sp (thread_sp->GetStopInfo ());
+            if (stop_info_sp)
+            {
+                const char *stop_info_desc = stop_info_sp->GetDescription();
+                if (!stop_info_desc || !stop_info_desc[0])
+                    stop_info_sp->SetDescription (description.c_str());
+            }
+            else
+            {
+                thread_sp->SetStopInfo (StopInfo::CreateStopReasonWithException (*thread_sp, description.c_str()));
+            }
+        }
+    }
+    return thread_sp;
+}
+
+lldb::StateType
+ProcessGDBRemote::SetThreadStopInfo (StructuredData::Dictionary *thread_dict)
+{
+    // A thread dictionary from the "jThreadsInfo" packet. It has the same
+    // information a stop reply packet would have, only the registers are
+    // keyed by their decimal register number and everything else is
+    // already decoded.
+    lldb::tid_t tid = LLDB_INVALID_THREAD_ID;
+    if (!thread_dict || !thread_dict->GetValueForKeyAsInteger ("tid", tid) || tid == LLDB_INVALID_THREAD_ID)
+        return eStateInvalid;
+
+    uint32_t signo = 0;
+    std::string thread_name;
+    std::string reason;
+    std::string description;
+    uint32_t exc_type = 0;
+    std::vector<addr_t> exc_data;
+    addr_t thread_dispatch_qaddr = LLDB_INVALID_ADDRESS;
+    ExpeditedRegisterMap expedited_register_map;
+
+    thread_dict->GetValueForKeyAsInteger ("signal", signo);
+    thread_dict->GetValueForKeyAsString ("name", thread_name);
+    thread_dict->GetValueForKeyAsString ("reason", reason);
+    thread_dict->GetValueForKeyAsString ("description", description);
+    thread_dict->GetValueForKeyAsInteger ("metype", exc_type);
+    thread_dict->GetValueForKeyAsInteger ("qaddr", thread_dispatch_qaddr);
+
+    StructuredData::Array *medata_array = nullptr;
+    if (thread_dict->GetValueForKeyAsArray ("medata", medata_array) && medata_array)
+    {
+        for (size_t i = 0; i < medata_array->GetSize(); ++i)
+        {
+            addr_t medata = 0;
+            if (medata_array->GetItemAtIndexAsInteger (i, medata))
+                exc_data.push_back (medata);
+        }
+    }
+
+    StructuredData::Dictionary *registers_dict = nullptr;
+    if (thread_dict->GetValueForKeyAsDictionary ("registers", registers_dict) && registers_dict)
+    {
+        StructuredData::ObjectSP keys_sp (registers_dict->GetKeys());
+        StructuredData::Array *keys = keys_sp->GetAsArray();
+        for (size_t i = 0; i < keys->GetSize(); ++i)
+        {
+            std::string key;
+            std::string value;
+            if (!keys->GetItemAtIndexAsString (i, key) || !registers_dict->GetValueForKeyAsString (key, value))
+                continue;
+            const uint32_t reg = StringConvert::ToUInt32 (key.c_str(), UINT32_MAX, 10);
+            if (reg != UINT32_MAX)
+                expedited_register_map[reg] = value;
+        }
+    }
+
+    SetThreadStopInfo (tid,
+                       expedited_register_map,
+                       signo,
+                       thread_name,
+                       reason,
+                       description,
+                       exc_type,
+                       exc_data,
+                       thread_dispatch_qaddr);
+    return eStateStopped;
+}
+
 StateType
 ProcessGDBRemote::SetThreadStopInfo (StringExtractor& stop_packet)
 {
@@ -1818,8 +2157,8 @@ ProcessGDBRemote::SetThreadStopInfo (StringExtractor& stop_packet)
             uint32_t exc_type = 0;
             std::vector<addr_t> exc_data;
             addr_t thread_dispatch_qaddr = LLDB_INVALID_ADDRESS;
-            ThreadSP thread_sp;
-            ThreadGDBRemote *gdb_thread = NULL;
+            lldb::tid_t tid = LLDB_INVALID_THREAD_ID;
+            ExpeditedRegisterMap expedited_register_map;
 
             while (stop_packet.GetNameColonValue(name, value))
             {
@@ -1836,28 +2175,7 @@ ProcessGDBRemote::SetThreadStopInfo (StringExtractor& stop_packet)
                 else if (name.compare("thread") == 0)
                 {
                     // thread in big endian hex
-                    lldb::tid_t tid = StringConvert::ToUInt64 (value.c_str(), LLDB_INVALID_THREAD_ID, 16);
-                    // m_thread_list_real does have its own mutex, but we need to
-                    // hold onto the mutex between the call to m_thread_list_real.FindThreadByID(...)
-                    // and the m_thread_list_real.AddThread(...) so it doesn't change on us
-                    Mutex::Locker locker (m_thread_list_real.GetMutex ());
-                    thread_sp = m_thread_list_real.FindThreadByProtocolID(tid, false);
-
-                    if (!thread_sp)
-                    {
-                        // Create the thread if we need to
-                        thread_sp.reset (new ThreadGDBRemote (*this, tid));
-                        Log *log (ProcessGDBRemoteLog::GetLogIfAllCategoriesSet (GDBR_LOG_THREAD));
-                        if (log && log->GetMask().Test(GDBR_LOG_VERBOSE))
-                            log->Printf ("ProcessGDBRemote::%s Adding new thread: %p for thread ID: 0x%" PRIx64 ".\n",
-                                         __FUNCTION__,
-                                         static_cast<void*>(thread_sp.get()),
-                                         thread_sp->GetID());
-
-                        m_thread_list_real.AddThread(thread_sp);
-                    }
-                    gdb_thread = static_cast<ThreadGDBRemote *> (thread_sp.get());
-
+                    tid = StringConvert::ToUInt64 (value.c_str(), LLDB_INVALID_THREAD_ID, 16);
                 }
                 else if (name.compare("threads") == 0)
                 {
@@ -1867,19 +2185,19 @@ ProcessGDBRemote::SetThreadStopInfo (StringExtractor& stop_packet)
                     // process that includes the thread for this stop reply
                     // packet
                     size_t comma_pos;
-                    lldb::tid_t tid;
+                    lldb::tid_t thread_id;
                     while ((comma_pos = value.find(',')) != std::string::npos)
                     {
                         value[comma_pos] = '\0';
                         // thread in big endian hex
-                        tid = StringConvert::ToUInt64 (value.c_str(), LLDB_INVALID_THREAD_ID, 16);
-                        if (tid != LLDB_INVALID_THREAD_ID)
-                            m_thread_ids.push_back (tid);
+                        thread_id = StringConvert::ToUInt64 (value.c_str(), LLDB_INVALID_THREAD_ID, 16);
+                        if (thread_id != LLDB_INVALID_THREAD_ID)
+                            m_thread_ids.push_back (thread_id);
                         value.erase(0, comma_pos + 1);
                     }
-                    tid = StringConvert::ToUInt64 (value.c_str(), LLDB_INVALID_THREAD_ID, 16);
-                    if (tid != LLDB_INVALID_THREAD_ID)
-                        m_thread_ids.push_back (tid);
+                    thread_id = StringConvert::ToUInt64 (value.c_str(), LLDB_INVALID_THREAD_ID, 16);
+                    if (thread_id != LLDB_INVALID_THREAD_ID)
+                        m_thread_ids.push_back (thread_id);
                 }
                 else if (name.compare("hexname") == 0)
                 {
@@ -1916,192 +2234,32 @@ ProcessGDBRemote::SetThreadStopInfo (StringExtractor& stop_packet)
                     // We have a register number that contains an expedited
                     // register value. Lets supply this register to our thread
                     // so it won't have to go and read it.
-                    if (gdb_thread)
-                    {
-                        uint32_t reg = StringConvert::ToUInt32 (name.c_str(), UINT32_MAX, 16);
-
-                        if (reg != UINT32_MAX)
-                        {
-                            StringExtractor reg_value_extractor;
-                            // Swap "value" over into "reg_value_extractor"
-                            reg_value_extractor.GetStringRef().swap(value);
-                            if (!gdb_thread->PrivateSetRegisterValue (reg, reg_value_extractor))
-                            {
-                                Host::SetCrashDescriptionWithFormat("Setting thread register '%s' (decoded to %u (0x%x)) with value '%s' for stop packet: '%s'", 
-                                                                    name.c_str(), 
-                                                                    reg, 
-                                                                    reg, 
-                                                                    reg_value_extractor.GetStringRef().c_str(), 
-                                                                    stop_packet.GetStringRef().c_str());
-                            }
-                        }
-                    }
+                    uint32_t reg = StringConvert::ToUInt32 (name.c_str(), UINT32_MAX, 16);
+                    if (reg != UINT32_MAX)
+                        expedited_register_map[reg] = value;
                 }
             }
 
-            // If the response is old style 'S' packet which does not provide us with thread information
-            // then update the thread list and choose the first one.
-            if (!thread_sp)
+            if (tid == LLDB_INVALID_THREAD_ID)
             {
+                // If the response is old style 'S' packet which does not provide us with thread information
+                // then update the thread list and choose the first one.
                 UpdateThreadIDList ();
 
                 if (!m_thread_ids.empty ())
-                {
-                    Mutex::Locker locker (m_thread_list_real.GetMutex ());
-                    thread_sp = m_thread_list_real.FindThreadByProtocolID (m_thread_ids.front (), false);
-                    if (thread_sp)
-                        gdb_thread = static_cast<ThreadGDBRemote *> (thread_sp.get ());
-                }
+                    tid = m_thread_ids.front ();
             }
 
-            if (thread_sp)
-            {
-                // Clear the stop info just in case we don't set it to anything
-                thread_sp->SetStopInfo (StopInfoSP());
+            SetThreadStopInfo (tid,
+                               expedited_register_map,
+                               signo,
+                               thread_name,
+                               reason,
+                               description,
+                               exc_type,
+                               exc_data,
+                               thread_dispatch_qaddr);
 
-                gdb_thread->SetThreadDispatchQAddr (thread_dispatch_qaddr);
-                gdb_thread->SetName (thread_name.empty() ? NULL : thread_name.c_str());
-                if (exc_type != 0)
-                {
-                    const size_t exc_data_size = exc_data.size();
-
-                    thread_sp->SetStopInfo (StopInfoMachException::CreateStopReasonWithMachException (*thread_sp,
-                                                                                                      exc_type,
-                                                                                                      exc_data_size,
-                                                                                                      exc_data_size >= 1 ? exc_data[0] : 0,
-                                                                                                      exc_data_size >= 2 ? exc_data[1] : 0,
-                                                                                                      exc_data_size >= 3 ? exc_data[2] : 0));
-                }
-                else
-                {
-                    bool handled = false;
-                    bool did_exec = false;
-                    if (!reason.empty())
-                    {
-                        if (reason.compare("trace") == 0)
-                        {
-                            thread_sp->SetStopInfo (StopInfo::CreateStopReasonToTrace (*thread_sp));
-                            handled = true;
-                        }
-                        else if (reason.compare("breakpoint") == 0)
-                        {
-                            addr_t pc = thread_sp->GetRegisterContext()->GetPC();
-                            lldb::BreakpointSiteSP bp_site_sp = thread_sp->GetProcess()->GetBreakpointSiteList().FindByAddress(pc);
-                            if (bp_site_sp)
-                            {
-                                // If the breakpoint is for this thread, then we'll report the hit, but if it is for another thread,
-                                // we can just report no reason.  We don't need to worry about stepping over the breakpoint here, that
-                                // will be taken care of when the thread resumes and notices that there's a breakpoint under the pc.
-                                handled = true;
-                                if (bp_site_sp->ValidForThisThread (thread_sp.get()))
-                                {
-                                    thread_sp->SetStopInfo (StopInfo::CreateStopReasonWithBreakpointSiteID (*thread_sp, bp_site_sp->GetID()));
-                                }
-                                else
-                                {
-                                    StopInfoSP invalid_stop_info_sp;
-                                    thread_sp->SetStopInfo (invalid_stop_info_sp);
-                                }
-                            }
-                        }
-                        else if (reason.compare("trap") == 0)
-                        {
-                            // Let the trap just use the standard signal stop reason below...
-                        }
-                        else if (reason.compare("watchpoint") == 0)
-                        {
-                            StringExtractor desc_extractor(description.c_str());
-                            addr_t wp_addr = desc_extractor.GetU64(LLDB_INVALID_ADDRESS);
-                            uint32_t wp_index = desc_extractor.GetU32(LLDB_INVALID_INDEX32);
-                            watch_id_t watch_id = LLDB_INVALID_WATCH_ID;
-                            if (wp_addr != LLDB_INVALID_ADDRESS)
-                            {
-                                WatchpointSP wp_sp = GetTarget().GetWatchpointList().FindByAddress(wp_addr);
-                                if (wp_sp)
-                                {
-                                    wp_sp->SetHardwareIndex(wp_index);
-                                    watch_id = wp_sp->GetID();
-                                }
-                            }
-                            if (watch_id == LLDB_INVALID_WATCH_ID)
-                            {
-                                Log *log (ProcessGDBRemoteLog::GetLogIfAllCategoriesSet (GDBR_LOG_WATCHPOINTS));
-                                if (log) log->Printf ("failed to find watchpoint");
-                            }
-                            thread_sp->SetStopInfo (StopInfo::CreateStopReasonWithWatchpointID (*thread_sp, watch_id));
-                            handled = true;
-                        }
-                        else if (reason.compare("exception") == 0)
-                        {
-                            thread_sp->SetStopInfo (StopInfo::CreateStopReasonWithException(*thread_sp, description.c_str()));
-                            handled = true;
-                        }
-                        else if (reason.compare("exec") == 0)
-                        {
-                            did_exec = true;
-                            thread_sp->SetStopInfo (StopInfo::CreateStopReasonWithExec(*thread_sp));
-                            handled = true;
-                        }
-                    }
-
-                    if (!handled && signo && did_exec == false)
-                    {
-                        if (signo == SIGTRAP)
-                        {
-                            // Currently we are going to assume SIGTRAP means we are either
-                            // hitting a breakpoint or hardware single stepping. 
-                            handled = true;
-                            addr_t pc = thread_sp->GetRegisterContext()->GetPC() + m_breakpoint_pc_offset;
-                            lldb::BreakpointSiteSP bp_site_sp = thread_sp->GetProcess()->GetBreakpointSiteList().FindByAddress(pc);
-
-                            if (bp_site_sp)
-                            {
-                                // If the breakpoint is for this thread, then we'll report the hit, but if it is for another thread,
-                                // we can just report no reason.  We don't need to worry about stepping over the breakpoint here, that
-                                // will be taken care of when the thread resumes and notices that there's a breakpoint under the pc.
-                                if (bp_site_sp->ValidForThisThread (thread_sp.get()))
-                                {
-                                    if(m_breakpoint_pc_offset != 0)
-                                        thread_sp->GetRegisterContext()->SetPC(pc);
-                                    thread_sp->SetStopInfo (StopInfo::CreateStopReasonWithBreakpointSiteID (*thread_sp, bp_site_sp->GetID()));
-                                }
-                                else
-                                {
-                                    StopInfoSP invalid_stop_info_sp;
-                                    thread_sp->SetStopInfo (invalid_stop_info_sp);
-                                }
-                            }
-                            else
-                            {
-                                // If we were stepping then assume the stop was the result of the trace.  If we were
-                                // not stepping then report the SIGTRAP.
-                                // FIXME: We are still missing the case where we single step over a trap instruction.
-                                if (thread_sp->GetTemporaryResumeState() == eStateStepping)
-                                    thread_sp->SetStopInfo (StopInfo::CreateStopReasonToTrace (*thread_sp));
-                                else
-                                    thread_sp->SetStopInfo (StopInfo::CreateStopReasonWithSignal(*thread_sp, signo));
-                            }
-                        }
-                        if (!handled)
-                            thread_sp->SetStopInfo (StopInfo::CreateStopReasonWithSignal (*thread_sp, signo));
-                    }
-
-                    if (!description.empty())
-                    {
-                        lldb::StopInfoSP stop_info_sp (thread_sp->GetStopInfo ());
-                        if (stop_info_sp)
-                        {
-                            const char *stop_info_desc = stop_info_sp->GetDescription();
-                            if (!stop_info_desc || !stop_info_desc[0])
-                                stop_info_sp->SetDescription (description.c_str());
-                        }
-                        else
-                        {
-                            thread_sp->SetStopInfo (StopInfo::CreateStopReasonWithException (*thread_sp, description.c_str()));
-                        }
-                    }
-                }
-            }
             return eStateStopped;
         }
         break;
@@ -2122,12 +2280,14 @@ ProcessGDBRemote::RefreshStateAfterStop ()
 {
     Mutex::Locker locker(m_thread_list_real.GetMutex());
     m_thread_ids.clear();
+    m_thread_infos.clear();
     // Set the thread stop info. It might have a "threads" key whose value is
     // a list of all thread IDs in the current process, so m_thread_ids might
     // get set.
     SetThreadStopInfo (m_last_stop_packet);
-    // Check to see if SetThreadStopInfo() filled in m_thread_ids?
-    if (m_thread_ids.empty())
+    // Fetch the stop info of all other threads in one go if the stub lets us,
+    // this also gives us the thread list.
+    if (!UpdateThreadInfos() && m_thread_ids.empty())
     {
         // No, we need to fetch the thread list manually
         UpdateThreadIDList();
@@ -2471,7 +2631,10 @@ ProcessGDBRemote::DoReadMemory (addr_t addr, void *buf, size_t size, Error &erro
     StringExtractorGDBRemote response;
     if (m_gdb_comm.SendPacketAndWaitForResponse(packet, packet_len, response, true) == GDBRemoteCommunication::PacketResult::Success)
     {
-        if (response.IsNormalResponse())
+        // Binary memory that happens to look like "OK" or "Exx" is still memory
+        // if it is exactly the size we asked for.
+        const bool full_binary_read = binary_memory_read && response.GetStringRef().size() == size;
+        if (full_binary_read || response.IsNormalResponse())
         {
             error.Clear();
             if (binary_memory_read)
@@ -3512,7 +3675,7 @@ ProcessGDBRemote::GetExtendedInfoForThread (lldb::tid_t tid)
 void
 ProcessGDBRemote::GetMaxMemorySize()
 {
-    const uint64_t reasonable_largeish_default = 128 * 1024;
+    const uint64_t reasonable_largeish_default = 512 * 1024;
     const uint64_t conservative_default = 512;
 
     if (m_max_memory_size == 0)
@@ -14,6 +14,7 @@
 
 // C++ Includes
 #include <list>
+#include <map>
 #include <vector>
 
 // Other libraries and framework includes
@@ -343,6 +344,8 @@ protected:
     typedef std::vector< std::pair<lldb::tid_t,int> > tid_sig_collection;
     typedef std::map<lldb::addr_t, lldb::addr_t> MMapMap;
     tid_collection m_thread_ids; // Thread IDs for all threads. This list gets updated after stopping
+    typedef std::map<lldb::tid_t, StructuredData::ObjectSP> ThreadInfoMap;
+    ThreadInfoMap m_thread_infos; // Unused "jThreadsInfo" thread dictionaries for the current stop
     tid_collection m_continue_c_tids;                  // 'c' for continue
     tid_sig_collection m_continue_C_tids; // 'C' for continue with signal
     tid_collection m_continue_s_tids;                  // 's' for step
@@ -373,9 +376,31 @@ protected:
                                int signo,
                                int exit_status);
 
+    typedef std::map<uint32_t, std::string> ExpeditedRegisterMap;
+
+    lldb::ThreadSP
+    SetThreadStopInfo (lldb::tid_t tid,
+                       ExpeditedRegisterMap &expedited_register_map,
+                       uint8_t signo,
+                       const std::string &thread_name,
+                       const std::string &reason,
+                       const std::string &description,
+                       uint32_t exc_type,
+                       const std::vector<lldb::addr_t> &exc_data,
+                       lldb::addr_t thread_dispatch_qaddr);
+
+    lldb::StateType
+    SetThreadStopInfo (StructuredData::Dictionary *thread_dict);
+
     lldb::StateType
     SetThreadStopInfo (StringExtractor& stop_packet);
 
+    bool
+    UpdateThreadInfos ();
+
+    bool
+    CalculateThreadStopInfo (ThreadGDBRemote *thread);
+
     void
     HandleStopReplySequence ();
 
@@ -28,6 +28,7 @@
 #include "NameToDIE.h"
 #include "SymbolFileDWARF.h"
 #include "SymbolFileDWARFDebugMap.h"
+#include "SymbolFileDWARFDwo.h"
 
 using namespace lldb;
 using namespace lldb_private;
@@ -41,6 +42,7 @@ DWARFCompileUnit::DWARFCompileUnit(SymbolFileDWARF* dwarf2Data) :
     m_abbrevs       (NULL),
     m_user_data     (NULL),
     m_die_array     (),
+    m_num_dies      (0),
     m_func_aranges_ap (),
     m_base_addr     (0),
     m_offset        (DW_INVALID_OFFSET),
@@ -52,7 +54,17 @@ DWARFCompileUnit::DWARFCompileUnit(SymbolFileDWARF* dwarf2Data) :
     m_producer_version_minor (0),
     m_producer_version_update (0),
     m_language_type (eLanguageTypeUnknown),
-    m_is_dwarf64    (false)
+    m_is_dwarf64    (false),
+    m_addr_base     (0),
+    m_ranges_base   (0),
+    m_is_split_skeleton (eLazyBoolCalculate),
+    m_dwo_symbol_file_ap (),
+    m_dwo_symbol_file_mutex (Mutex::eMutexTypeRecursive),
+    m_dwo_symbol_file_loaded (false)
+{
+}
+
+DWARFCompileUnit::~DWARFCompileUnit()
 {
 }
 
@@ -66,11 +78,15 @@ DWARFCompileUnit::Clear()
     m_addr_size     = DWARFCompileUnit::GetDefaultAddressSize();
     m_base_addr     = 0;
     m_die_array.clear();
+    m_num_dies      = 0;
     m_func_aranges_ap.reset();
     m_user_data     = NULL;
     m_producer      = eProducerInvalid;
     m_language_type = eLanguageTypeUnknown;
     m_is_dwarf64    = false;
+    m_addr_base     = 0;
+    m_ranges_base   = 0;
+    m_is_split_skeleton = eLazyBoolCalculate;
 }
 
 bool
@@ -188,14 +204,24 @@ DWARFCompileUnit::ExtractDIEsIfNeeded (bool cu_die_only)
         const bool null_die = die.IsNULL();
         if (depth == 0)
         {
+            // The address base must be known before any DW_FORM_GNU_addr_index
+            // values are extracted
+            m_addr_base = die.GetAttributeValueAsUnsigned(m_dwarf2Data, this, DW_AT_GNU_addr_base, m_addr_base);
             uint64_t base_addr = die.GetAttributeValueAsUnsigned(m_dwarf2Data, this, DW_AT_low_pc, LLDB_INVALID_ADDRESS);
             if (base_addr == LLDB_INVALID_ADDRESS)
-                base_addr = die.GetAttributeValueAsUnsigned(m_dwarf2Data, this, DW_AT_entry_pc, 0);
-            SetBaseAddress (base_addr);
+                base_addr = die.GetAttributeValueAsUnsigned(m_dwarf2Data, this, DW_AT_entry_pc, LLDB_INVALID_ADDRESS);
+            // A .dwo compile unit has no address attributes and keeps the
+            // base address it got from its skeleton compile unit
+            if (base_addr != LLDB_INVALID_ADDRESS)
+                SetBaseAddress (base_addr);
             if (initial_die_array_size == 0)
                 AddDIE (die);
             if (cu_die_only)
                 return 1;
+            // Reserve room for all the DIEs up front so the array doesn't
+            // grow by doubling. A compile unit that was extracted before
+            // and then cleared gets exactly what it needs.
+            m_die_array.reserve (m_num_dies > 0 ? m_num_dies : m_dwarf2Data->EstimateNumDIEs (GetDebugInfoSize()));
         }
         else
         {
@@ -261,12 +287,13 @@ DWARFCompileUnit::ExtractDIEsIfNeeded (bool cu_die_only)
                                                                    offset);
     }
 
-    // Since std::vector objects will double their size, we really need to
-    // make a new array with the perfect size so we don't end up wasting
-    // space. So here we copy and swap to make sure we don't have any extra
-    // memory taken up.
-    
-    if (m_die_array.size () < m_die_array.capacity())
+    m_num_dies = m_die_array.size();
+    m_dwarf2Data->AddExtractedDIEs (GetDebugInfoSize(), m_die_array.size());
+
+    // The array was reserved from an estimate, so only copy and swap into
+    // an array of the perfect size when the estimate was well off. Copying
+    // briefly needs memory for both arrays.
+    if (m_die_array.capacity() - m_die_array.size() > m_die_array.size() / 8)
     {
         DWARFDebugInfoEntry::collection exact_size_die_array (m_die_array.begin(), m_die_array.end());
         exact_size_die_array.swap (m_die_array);
@@ -387,8 +414,11 @@ DWARFCompileUnit::BuildAddressRangeTable (SymbolFileDWARF* dwarf2Data,
     const dw_offset_t cu_offset = GetOffset();
     if (die)
     {
+        // A skeleton compile unit has no DIEs to fall back on, so use its
+        // low and high PC before we need to open the .dwo file.
+        const bool check_hi_lo_pc = IsSplitSkeleton();
         DWARFDebugRanges::RangeList ranges;
-        const size_t num_ranges = die->GetAttributeAddressRanges(dwarf2Data, this, ranges, false);
+        const size_t num_ranges = die->GetAttributeAddressRanges(dwarf2Data, this, ranges, check_hi_lo_pc);
         if (num_ranges > 0)
         {
             // This compile unit has DW_AT_ranges, assume this is correct if it
@@ -406,6 +436,28 @@ DWARFCompileUnit::BuildAddressRangeTable (SymbolFileDWARF* dwarf2Data,
     }
     // We don't have a DW_AT_ranges attribute, so we need to parse the DWARF
     
+    SymbolFileDWARFDwo *dwo_symbol_file = GetDwoSymbolFile();
+    if (dwo_symbol_file)
+    {
+        // The function DIEs are in the .dwo compile unit, but the ranges
+        // must be attributed to the skeleton compile unit.
+        DWARFCompileUnit *dwo_cu = dwo_symbol_file->GetCompileUnit();
+        const DWARFDebugInfoEntry *dwo_die = dwo_cu ? dwo_cu->DIE() : NULL;
+        if (dwo_die)
+        {
+            DWARFDebugAranges dwo_aranges;
+            dwo_die->BuildAddressRangeTable(dwo_symbol_file, dwo_cu, &dwo_aranges);
+            const size_t num_ranges = dwo_aranges.GetNumRanges();
+            for (size_t i=0; i<num_ranges; ++i)
+            {
+                const DWARFDebugAranges::Range *range = dwo_aranges.RangeAtIndex(i);
+                debug_aranges->AppendRange(cu_offset, range->GetRangeBase(), range->GetRangeEnd());
+            }
+            if (num_ranges > 0)
+                return;
+        }
+    }
+
     // If the DIEs weren't parsed, then we don't want all dies for all compile units
     // to stay loaded when they weren't needed. So we can end up parsing the DWARF
     // and then throwing them all away to keep memory usage down.
@@ -479,6 +531,75 @@ DWARFCompileUnit::BuildAddressRangeTable (SymbolFileDWARF* dwarf2Data,
 }
 
 
+void
+DWARFCompileUnit::SetAddrBase (dw_addr_t addr_base, dw_offset_t ranges_base, dw_addr_t base_addr)
+{
+    m_addr_base = addr_base;
+    m_ranges_base = ranges_base;
+    SetBaseAddress (base_addr);
+}
+
+dw_addr_t
+DWARFCompileUnit::ReadAddressFromDebugAddrSection (uint64_t index) const
+{
+    const DWARFDataExtractor &debug_addr_data = m_dwarf2Data->get_debug_addr_data();
+    lldb::offset_t offset = m_addr_base + index * m_addr_size;
+    if (!debug_addr_data.ValidOffsetForDataOfSize(offset, m_addr_size))
+        return LLDB_INVALID_ADDRESS;
+    return debug_addr_data.GetMaxU64(&offset, m_addr_size);
+}
+
+dw_offset_t
+DWARFCompileUnit::ReadStringOffsetFromDebugStrOffsetsSection (uint64_t index) const
+{
+    const DWARFDataExtractor &debug_str_offsets_data = m_dwarf2Data->get_debug_str_offsets_data();
+    const uint32_t offset_size = m_is_dwarf64 ? 8 : 4;
+    lldb::offset_t offset = index * offset_size;
+    if (!debug_str_offsets_data.ValidOffsetForDataOfSize(offset, offset_size))
+        return DW_INVALID_OFFSET;
+    return debug_str_offsets_data.GetMaxU64(&offset, offset_size);
+}
+
+bool
+DWARFCompileUnit::IsSplitSkeleton ()
+{
+    if (m_is_split_skeleton == eLazyBoolCalculate)
+    {
+        m_is_split_skeleton = eLazyBoolNo;
+        // Clang module references also have a DW_AT_GNU_dwo_name, but they
+        // have no line table or address table of their own.
+        const DWARFDebugInfoEntry *cu_die = GetCompileUnitDIEOnly();
+        if (cu_die &&
+            cu_die->GetAttributeValueAsString(m_dwarf2Data, this, DW_AT_GNU_dwo_name, NULL) &&
+            (cu_die->GetAttributeValueAsUnsigned(m_dwarf2Data, this, DW_AT_stmt_list, DW_INVALID_OFFSET) != DW_INVALID_OFFSET ||
+             cu_die->GetAttributeValueAsUnsigned(m_dwarf2Data, this, DW_AT_GNU_addr_base, DW_INVALID_OFFSET) != DW_INVALID_OFFSET))
+            m_is_split_skeleton = eLazyBoolYes;
+    }
+    return m_is_split_skeleton == eLazyBoolYes;
+}
+
+uint64_t
+DWARFCompileUnit::GetDWOId ()
+{
+    const DWARFDebugInfoEntry *cu_die = GetCompileUnitDIEOnly();
+    if (cu_die)
+        return cu_die->GetAttributeValueAsUnsigned(m_dwarf2Data, this, DW_AT_GNU_dwo_id, 0);
+    return 0;
+}
+
+SymbolFileDWARFDwo *
+DWARFCompileUnit::GetDwoSymbolFile ()
+{
+    Mutex::Locker locker (m_dwo_symbol_file_mutex);
+    if (!m_dwo_symbol_file_loaded)
+    {
+        m_dwo_symbol_file_loaded = true;
+        if (IsSplitSkeleton())
+            m_dwo_symbol_file_ap = m_dwarf2Data->LoadDwoSymbolFile (*this, *GetCompileUnitDIEOnly());
+    }
+    return m_dwo_symbol_file_ap.get();
+}
+
 const DWARFDebugAranges &
 DWARFCompileUnit::GetFunctionAranges ()
 {
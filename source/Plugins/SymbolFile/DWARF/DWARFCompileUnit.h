@@ -11,10 +11,12 @@
 #define SymbolFileDWARF_DWARFCompileUnit_h_
 
 #include "lldb/lldb-enumerations.h"
+#include "lldb/Host/Mutex.h"
 #include "DWARFDebugInfoEntry.h"
 #include "SymbolFileDWARF.h"
 
 class NameToDIE;
+class SymbolFileDWARFDwo;
 
 class DWARFCompileUnit
 {
@@ -29,6 +31,7 @@ public:
     };
 
     DWARFCompileUnit(SymbolFileDWARF* dwarf2Data);
+    ~DWARFCompileUnit();
 
     bool        Extract(const lldb_private::DWARFDataExtractor &debug_info, lldb::offset_t *offset_ptr);
     size_t      ExtractDIEsIfNeeded (bool cu_die_only);
@@ -63,6 +66,47 @@ public:
         m_base_addr = base_addr;
     }
 
+    //------------------------------------------------------------------
+    // Split DWARF
+    //
+    // A skeleton compile unit has a DW_AT_GNU_dwo_name that names the
+    // .dwo file (or .dwp package entry) with the rest of its DIEs. The
+    // .dwo compile unit indexes into the skeleton's .debug_addr table
+    // and its DW_AT_ranges are relative to the skeleton's ranges base.
+    //------------------------------------------------------------------
+    dw_addr_t
+    GetAddrBase() const
+    {
+        return m_addr_base;
+    }
+
+    dw_offset_t
+    GetRangesBase() const
+    {
+        return m_ranges_base;
+    }
+
+    void
+    SetAddrBase (dw_addr_t addr_base, dw_offset_t ranges_base, dw_addr_t base_addr);
+
+    dw_addr_t
+    ReadAddressFromDebugAddrSection (uint64_t index) const;
+
+    dw_offset_t
+    ReadStringOffsetFromDebugStrOffsetsSection (uint64_t index) const;
+
+    bool
+    IsSplitSkeleton ();
+
+    uint64_t
+    GetDWOId ();
+
+    // Opens the .dwo symbol file for a skeleton compile unit the first
+    // time it is needed. Returns NULL if this isn't a skeleton compile
+    // unit or if the .dwo file can't be found.
+    SymbolFileDWARFDwo *
+    GetDwoSymbolFile ();
+
     const DWARFDebugInfoEntry*
     GetCompileUnitDIEOnly()
     {
@@ -84,17 +128,6 @@ public:
     void
     AddDIE (DWARFDebugInfoEntry& die)
     {
-        // The average bytes per DIE entry has been seen to be
-        // around 14-20 so lets pre-reserve half of that since
-        // we are now stripping the NULL tags. 
-
-        // Only reserve the memory if we are adding children of
-        // the main compile unit DIE. The compile unit DIE is always
-        // the first entry, so if our size is 1, then we are adding
-        // the first compile unit child DIE and should reserve
-        // the memory.
-        if (m_die_array.empty())
-            m_die_array.reserve(GetDebugInfoSize() / 24);
         m_die_array.push_back(die);
     }
 
@@ -104,6 +137,20 @@ public:
         return m_die_array.size() > 1;
     }
 
+    size_t
+    GetNumDIEsParsed () const
+    {
+        return m_die_array.size();
+    }
+
+    // The number of bytes the extracted DIEs take up, including any
+    // unused capacity in the DIE array
+    size_t
+    GetDIEMemoryUsage () const
+    {
+        return m_die_array.capacity() * sizeof(DWARFDebugInfoEntry);
+    }
+
     DWARFDebugInfoEntry*
     GetDIEAtIndexUnchecked (uint32_t idx)
     {
@@ -198,6 +245,7 @@ protected:
     const DWARFAbbreviationDeclarationSet *m_abbrevs;
     void *              m_user_data;
     DWARFDebugInfoEntry::collection m_die_array;    // The compile unit debug information entry item
+    uint32_t            m_num_dies;     // How many DIEs the last full extraction found, zero if it hasn't happened
     std::unique_ptr<DWARFDebugAranges> m_func_aranges_ap;   // A table similar to the .debug_aranges table, but this one points to the exact DW_TAG_subprogram DIEs
     dw_addr_t           m_base_addr;
     dw_offset_t         m_offset;
@@ -210,6 +258,12 @@ protected:
     uint32_t            m_producer_version_update;
     lldb::LanguageType  m_language_type;
     bool                m_is_dwarf64;
+    dw_addr_t           m_addr_base;    // Value of DW_AT_GNU_addr_base
+    dw_offset_t         m_ranges_base;  // Value of the skeleton DW_AT_GNU_ranges_base for .dwo compile units
+    lldb_private::LazyBool m_is_split_skeleton;
+    std::unique_ptr<SymbolFileDWARFDwo> m_dwo_symbol_file_ap;
+    lldb_private::Mutex m_dwo_symbol_file_mutex;
+    bool                m_dwo_symbol_file_loaded;
     
     void
     ParseProducerInfo ();
@@ -197,6 +197,30 @@ DWARFDebugInfo::GetCompileUnitAtIndex(uint32_t idx)
     return cu;
 }
 
+//----------------------------------------------------------------------
+// GetDIEMemoryUsage
+//
+// Add up the memory used by the DIEs of all compile units, and count the
+// compile units that have more than their compile unit DIE extracted.
+//----------------------------------------------------------------------
+size_t
+DWARFDebugInfo::GetDIEMemoryUsage(size_t &num_dies, size_t &num_extracted_cus)
+{
+    size_t num_bytes = 0;
+    num_dies = 0;
+    num_extracted_cus = 0;
+    const size_t num_cus = GetNumCompileUnits();
+    for (size_t idx = 0; idx < num_cus; ++idx)
+    {
+        const DWARFCompileUnit* cu = m_compile_units[idx].get();
+        num_bytes += cu->GetDIEMemoryUsage();
+        num_dies += cu->GetNumDIEsParsed();
+        if (cu->HasDIEsParsed())
+            ++num_extracted_cus;
+    }
+    return num_bytes;
+}
+
 bool
 DWARFDebugInfo::ContainsCompileUnit (const DWARFCompileUnit *cu) const
 {
@@ -29,6 +29,7 @@
 #include "DWARFLocationDescription.h"
 #include "DWARFLocationList.h"
 #include "DWARFDebugRanges.h"
+#include "SymbolFileDWARFDwo.h"
 
 using namespace lldb_private;
 using namespace std;
@@ -158,7 +159,7 @@ DWARFDebugInfoEntry::FastExtract
         {
             form = abbrevDecl->GetFormByIndexUnchecked(i);
 
-            const uint8_t fixed_skip_size = fixed_form_sizes [form];
+            const uint8_t fixed_skip_size = DWARFFormValue::GetFixedFormSize (fixed_form_sizes, form);
             if (fixed_skip_size)
                 offset += fixed_skip_size;
             else
@@ -229,6 +230,8 @@ DWARFDebugInfoEntry::FastExtract
                     case DW_FORM_sdata       :
                     case DW_FORM_udata       :
                     case DW_FORM_ref_udata   :
+                    case DW_FORM_GNU_addr_index:
+                    case DW_FORM_GNU_str_index:
                         debug_info_data.Skip_LEB128 (&offset);
                         break;
 
@@ -392,6 +395,8 @@ DWARFDebugInfoEntry::Extract
                             case DW_FORM_sdata       :
                             case DW_FORM_udata       :
                             case DW_FORM_ref_udata   :
+                            case DW_FORM_GNU_addr_index:
+                            case DW_FORM_GNU_str_index:
                                 debug_info_data.Skip_LEB128(&offset);
                                 break;
 
@@ -797,7 +802,7 @@ DWARFDebugInfoEntry::GetDIENamesAndRanges
 
                 case DW_AT_high_pc:
                     hi_pc = form_value.Unsigned();
-                    if (form_value.Form() != DW_FORM_addr)
+                    if (form_value.Form() != DW_FORM_addr && form_value.Form() != DW_FORM_GNU_addr_index)
                     {
                         if (lo_pc == LLDB_INVALID_ADDRESS)
                             do_offset = hi_pc != LLDB_INVALID_ADDRESS;
@@ -809,7 +814,7 @@ DWARFDebugInfoEntry::GetDIENamesAndRanges
                 case DW_AT_ranges:
                     {
                         const DWARFDebugRanges* debug_ranges = dwarf2Data->DebugRanges();
-                        debug_ranges->FindRanges(form_value.Unsigned(), ranges);
+                        debug_ranges->FindRanges(cu->GetRangesBase() + form_value.Unsigned(), ranges);
                         // All DW_AT_ranges are relative to the base address of the
                         // compile unit. We add the compile unit base address to make
                         // sure all the addresses are properly fixed up.
@@ -1277,7 +1282,7 @@ DWARFDebugInfoEntry::GetAttributes
             }
             else
             {
-                const uint8_t fixed_skip_size = fixed_form_sizes [form];
+                const uint8_t fixed_skip_size = DWARFFormValue::GetFixedFormSize (fixed_form_sizes, form);
                 if (fixed_skip_size)
                     offset += fixed_skip_size;
                 else
@@ -1293,6 +1298,34 @@ DWARFDebugInfoEntry::GetAttributes
 
 }
 
+//----------------------------------------------------------------------
+// Attributes that only describe a skeleton compile unit. All other
+// attributes of a split compile unit are in its .dwo compile unit DIE.
+//----------------------------------------------------------------------
+static bool
+IsSkeletonAttribute (const dw_attr_t attr)
+{
+    switch (attr)
+    {
+    case DW_AT_low_pc:
+    case DW_AT_high_pc:
+    case DW_AT_entry_pc:
+    case DW_AT_ranges:
+    case DW_AT_stmt_list:
+    case DW_AT_comp_dir:
+    case DW_AT_GNU_dwo_name:
+    case DW_AT_GNU_dwo_id:
+    case DW_AT_GNU_addr_base:
+    case DW_AT_GNU_ranges_base:
+    case DW_AT_GNU_pubnames:
+    case DW_AT_GNU_pubtypes:
+        return true;
+    default:
+        break;
+    }
+    return false;
+}
+
 //----------------------------------------------------------------------
 // GetAttributeValue
 //
@@ -1336,6 +1369,29 @@ DWARFDebugInfoEntry::GetAttributeValue
                 return attr_offset;
             }
         }
+        else if (m_tag == DW_TAG_compile_unit && cu && !IsSkeletonAttribute(attr))
+        {
+            SymbolFileDWARFDwo *dwo_symbol_file = const_cast<DWARFCompileUnit*>(cu)->GetDwoSymbolFile();
+            DWARFCompileUnit *dwo_cu = dwo_symbol_file ? dwo_symbol_file->GetCompileUnit() : NULL;
+            const DWARFDebugInfoEntry *dwo_cu_die = dwo_cu ? dwo_cu->GetCompileUnitDIEOnly() : NULL;
+            if (dwo_cu_die)
+            {
+                const dw_offset_t attr_offset = dwo_cu_die->GetAttributeValue(dwo_symbol_file, dwo_cu, attr, form_value, end_attr_offset_ptr);
+                if (attr_offset)
+                {
+                    // Callers look strings up in their own .debug_str, so
+                    // hand back the string from the .dwo file directly.
+                    if (!form_value.IsInlinedCStr() &&
+                        (form_value.Form() == DW_FORM_strp || form_value.Form() == DW_FORM_GNU_str_index))
+                    {
+                        const char *cstr = form_value.AsCString(&dwo_symbol_file->get_debug_str_data());
+                        if (cstr)
+                            form_value.SetInlinedCStr(cstr);
+                    }
+                    return attr_offset;
+                }
+            }
+        }
     }
 
     return 0;
@@ -1446,7 +1502,7 @@ DWARFDebugInfoEntry::GetAttributeHighPC
     if (GetAttributeValue(dwarf2Data, cu, DW_AT_high_pc, form_value))
     {
         dw_addr_t hi_pc = form_value.Unsigned();
-        if (form_value.Form() != DW_FORM_addr)
+        if (form_value.Form() != DW_FORM_addr && form_value.Form() != DW_FORM_GNU_addr_index)
             hi_pc += lo_pc; // DWARF4 can specify the hi_pc as an <offset-from-lowpc>
         return hi_pc; 
     }
@@ -1499,7 +1555,7 @@ DWARFDebugInfoEntry::GetAttributeAddressRanges(SymbolFileDWARF* dwarf2Data,
         {
             DWARFDebugRanges* debug_ranges = dwarf2Data->DebugRanges();
             
-            debug_ranges->FindRanges(debug_ranges_offset, ranges);
+            debug_ranges->FindRanges(cu->GetRangesBase() + debug_ranges_offset, ranges);
             ranges.Slide (cu->GetBaseAddress());
         }
     }
@@ -2227,7 +2283,7 @@ DWARFDebugInfoEntry::LookupAddress
                 {
                     DWARFDebugRanges::RangeList ranges;
                     DWARFDebugRanges* debug_ranges = dwarf2Data->DebugRanges();
-                    debug_ranges->FindRanges(debug_ranges_offset, ranges);
+                    debug_ranges->FindRanges(cu->GetRangesBase() + debug_ranges_offset, ranges);
                     // All DW_AT_ranges are relative to the base address of the
                     // compile unit. We add the compile unit base address to make
                     // sure all the addresses are properly fixed up.
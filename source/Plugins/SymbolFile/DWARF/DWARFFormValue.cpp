@@ -223,6 +223,18 @@ DWARFFormValue::ExtractValue(const DWARFDataExtractor& data, lldb::offset_t* off
                                     m_value.value.uval = data.GetMaxU64(offset_ptr, DWARFCompileUnit::IsDWARF64(m_cu) ? 8 : 4);  break;
         case DW_FORM_flag_present:  m_value.value.uval = 1;                                             break;
         case DW_FORM_ref_sig8:      m_value.value.uval = data.GetU64(offset_ptr);                       break;
+        case DW_FORM_GNU_addr_index:
+                                    // Resolve the .debug_addr index right away so the value
+                                    // can be used like a DW_FORM_addr value
+                                    assert(m_cu);
+                                    m_value.value.uval = m_cu->ReadAddressFromDebugAddrSection (data.GetULEB128(offset_ptr));
+                                    break;
+        case DW_FORM_GNU_str_index:
+                                    // Resolve the .debug_str_offsets index to a .debug_str
+                                    // offset so the value can be used like a DW_FORM_strp value
+                                    assert(m_cu);
+                                    m_value.value.uval = m_cu->ReadStringOffsetFromDebugStrOffsetsSection (data.GetULEB128(offset_ptr));
+                                    break;
         default:
             return false;
             break;
@@ -322,6 +334,8 @@ DWARFFormValue::SkipValue(dw_form_t form, const DWARFDataExtractor& debug_info_d
     case DW_FORM_sdata:
     case DW_FORM_udata:
     case DW_FORM_ref_udata:
+    case DW_FORM_GNU_addr_index:
+    case DW_FORM_GNU_str_index:
         debug_info_data.Skip_LEB128(offset_ptr);
         return true;
 
@@ -351,6 +365,7 @@ DWARFFormValue::Dump(Stream &s, const DWARFDataExtractor* debug_str_data) const
 
     switch (m_form)
     {
+    case DW_FORM_GNU_addr_index:
     case DW_FORM_addr:      s.Address(uvalue, sizeof (uint64_t)); break;
     case DW_FORM_flag:
     case DW_FORM_data1:     s.PutHex8(uvalue);     break;
@@ -394,6 +409,7 @@ DWARFFormValue::Dump(Stream &s, const DWARFDataExtractor* debug_str_data) const
 
     case DW_FORM_sdata:     s.PutSLEB128(uvalue); break;
     case DW_FORM_udata:     s.PutULEB128(uvalue); break;
+    case DW_FORM_GNU_str_index:
     case DW_FORM_strp:
         if (debug_str_data)
         {
@@ -558,6 +574,7 @@ DWARFFormValue::Compare (const DWARFFormValue& a_value, const DWARFFormValue& b_
     case DW_FORM_sec_offset:
     case DW_FORM_flag_present:
     case DW_FORM_ref_sig8:
+    case DW_FORM_GNU_addr_index:
         {
             uint64_t a = a_value.Unsigned();
             uint64_t b = b_value.Unsigned();
@@ -581,6 +598,7 @@ DWARFFormValue::Compare (const DWARFFormValue& a_value, const DWARFFormValue& b_
 
     case DW_FORM_string:
     case DW_FORM_strp:
+    case DW_FORM_GNU_str_index:
         {
             const char *a_string = a_value.AsCString(debug_str_data_ptr);
             const char *b_string = b_value.AsCString(debug_str_data_ptr);
@@ -56,6 +56,7 @@ public:
     bool                ExtractValue(const lldb_private::DWARFDataExtractor& data,
                                      lldb::offset_t* offset_ptr);
     bool                IsInlinedCStr() const { return (m_value.data != NULL) && m_value.data == (const uint8_t*)m_value.value.cstr; }
+    void                SetInlinedCStr(const char *cstr) { m_value.value.cstr = cstr; m_value.data = (const uint8_t*)cstr; }
     const uint8_t*      BlockData() const;
     uint64_t            Reference() const;
     uint64_t            Reference (dw_offset_t offset) const;
@@ -70,6 +71,9 @@ public:
     static bool         IsBlockForm(const dw_form_t form);
     static bool         IsDataForm(const dw_form_t form);
     static const uint8_t * GetFixedFormSizesForAddressSize (uint8_t addr_size, bool is_dwarf64);
+    // The fixed form size tables only cover the DWARF 4 forms, the GNU
+    // extension forms have no fixed size.
+    static uint8_t      GetFixedFormSize (const uint8_t *fixed_form_sizes, dw_form_t form) { return form <= DW_FORM_ref_sig8 ? fixed_form_sizes[form] : 0; }
     static int          Compare (const DWARFFormValue& a, const DWARFFormValue& b, const lldb_private::DWARFDataExtractor* debug_str_data_ptr);
 protected:
     const DWARFCompileUnit* m_cu; // Compile unit for this form
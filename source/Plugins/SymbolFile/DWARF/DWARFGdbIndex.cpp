@@ -0,0 +1,301 @@
+//===-- DWARFGdbIndex.cpp ---------------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "DWARFGdbIndex.h"
+
+#include <ctype.h>
+
+#include <algorithm>
+
+#include "lldb/Core/ConstString.h"
+#include "lldb/Core/Mangled.h"
+#include "lldb/Core/Timer.h"
+
+using namespace lldb;
+using namespace lldb_private;
+
+// The header is six 32 bit values: the version followed by the offsets
+// of the CU list, the type unit list, the address area, the symbol table
+// and the constant pool.
+static const uint32_t k_header_size = 6 * sizeof(uint32_t);
+
+// Each CU vector entry has the CU index in the low bits and the symbol
+// attributes in the high bits.
+static const uint32_t k_cu_index_mask = 0x00ffffff;
+static const uint32_t k_symbol_kind_shift = 28;
+static const uint32_t k_symbol_kind_mask = 7;
+
+DWARFGdbIndex::DWARFGdbIndex () :
+    m_data (),
+    m_version (0),
+    m_cu_list_offset (0),
+    m_num_cus (0),
+    m_symbol_table_offset (0),
+    m_symbol_table_size (0),
+    m_constant_pool_offset (0),
+    m_base_names (),
+    m_base_names_built (false)
+{
+}
+
+bool
+DWARFGdbIndex::Extract (const DataExtractor &gdb_index_data)
+{
+    m_data = gdb_index_data;
+    m_symbol_table_size = 0;
+    m_base_names.clear();
+    m_base_names_built = false;
+
+    // The section is always little endian, no matter what the target is
+    m_data.SetByteOrder (eByteOrderLittle);
+    if (m_data.GetByteSize() < k_header_size)
+        return false;
+
+    lldb::offset_t offset = 0;
+    m_version = m_data.GetU32 (&offset);
+    // Versions before 5 hash names case sensitively and are obsolete,
+    // version 8 only changed how gdb treats the contents.
+    if (m_version < 5 || m_version > 8)
+        return false;
+
+    m_cu_list_offset = m_data.GetU32 (&offset);
+    const uint32_t types_cu_list_offset = m_data.GetU32 (&offset);
+    m_data.GetU32 (&offset); // Address area offset
+    m_symbol_table_offset = m_data.GetU32 (&offset);
+    m_constant_pool_offset = m_data.GetU32 (&offset);
+
+    if (m_cu_list_offset < k_header_size ||
+        types_cu_list_offset < m_cu_list_offset ||
+        m_symbol_table_offset < types_cu_list_offset ||
+        m_constant_pool_offset < m_symbol_table_offset ||
+        m_constant_pool_offset > m_data.GetByteSize())
+        return false;
+
+    // Each CU list entry is a 64 bit offset and a 64 bit length
+    m_num_cus = (types_cu_list_offset - m_cu_list_offset) / 16;
+
+    // Each symbol table slot is a 32 bit name offset and a 32 bit CU
+    // vector offset, both relative to the constant pool.
+    const uint32_t symbol_table_size = (m_constant_pool_offset - m_symbol_table_offset) / 8;
+    if (symbol_table_size == 0 || (symbol_table_size & (symbol_table_size - 1)) != 0)
+        return false;
+    m_symbol_table_size = symbol_table_size;
+    return true;
+}
+
+uint32_t
+DWARFGdbIndex::HashName (llvm::StringRef name)
+{
+    // This is gdb's mapped_index_string_hash() for version 5 and later
+    uint32_t hash = 0;
+    for (const char ch : name)
+        hash = hash * 67 + tolower ((unsigned char)ch) - 113;
+    return hash;
+}
+
+llvm::StringRef
+DWARFGdbIndex::GetBaseName (llvm::StringRef name)
+{
+    // Find the last "::" that isn't inside template arguments or a
+    // parameter list
+    size_t base_start = 0;
+    int depth = 0;
+    for (size_t i = 0; i < name.size(); ++i)
+    {
+        switch (name[i])
+        {
+            case '<':
+            case '(':
+                ++depth;
+                break;
+            case '>':
+            case ')':
+                if (depth > 0)
+                    --depth;
+                break;
+            case ':':
+                if (depth == 0 && i + 1 < name.size() && name[i + 1] == ':')
+                {
+                    base_start = i + 2;
+                    ++i;
+                }
+                break;
+            default:
+                break;
+        }
+    }
+    return name.substr (base_start);
+}
+
+llvm::StringRef
+DWARFGdbIndex::StripParameters (llvm::StringRef name)
+{
+    // Demangled names end with the parameter list and optional method
+    // qualifiers, the index only has the names up to the parameters.
+    llvm::StringRef stripped (name.rtrim());
+    while (true)
+    {
+        if (stripped.endswith (" const"))
+            stripped = stripped.drop_back (6).rtrim();
+        else if (stripped.endswith (" volatile"))
+            stripped = stripped.drop_back (9).rtrim();
+        else
+            break;
+    }
+
+    if (!stripped.endswith (")"))
+        return name;
+
+    int depth = 0;
+    for (size_t i = stripped.size(); i > 0; --i)
+    {
+        const char ch = stripped[i - 1];
+        if (ch == ')')
+            ++depth;
+        else if (ch == '(' && --depth == 0)
+        {
+            // Names like "(anonymous namespace)" have no parameter list
+            if (i == 1)
+                return name;
+            return stripped.substr (0, i - 1).rtrim();
+        }
+    }
+    return name;
+}
+
+const char *
+DWARFGdbIndex::GetString (uint32_t offset) const
+{
+    lldb::offset_t string_offset = m_constant_pool_offset + (lldb::offset_t)offset;
+    return m_data.GetCStr (&string_offset);
+}
+
+void
+DWARFGdbIndex::AppendCompileUnits (uint32_t cu_vector_offset,
+                                   uint32_t kind_mask,
+                                   std::vector<dw_offset_t> &cu_offsets) const
+{
+    lldb::offset_t offset = m_constant_pool_offset + (lldb::offset_t)cu_vector_offset;
+    if (!m_data.ValidOffsetForDataOfSize (offset, sizeof(uint32_t)))
+        return;
+    const uint32_t num_entries = m_data.GetU32 (&offset);
+    for (uint32_t i = 0; i < num_entries && m_data.ValidOffsetForDataOfSize (offset, sizeof(uint32_t)); ++i)
+    {
+        const uint32_t entry = m_data.GetU32 (&offset);
+        const uint32_t kind = (entry >> k_symbol_kind_shift) & k_symbol_kind_mask;
+        if (kind != eSymbolKindNone && (kind_mask & SymbolKindMask ((SymbolKind)kind)) == 0)
+            continue;
+
+        // Indexes past the CU list refer to type units which we don't use
+        const uint32_t cu_idx = entry & k_cu_index_mask;
+        if (cu_idx >= m_num_cus)
+            continue;
+
+        lldb::offset_t cu_list_entry_offset = m_cu_list_offset + (lldb::offset_t)cu_idx * 16;
+        if (m_data.ValidOffsetForDataOfSize (cu_list_entry_offset, sizeof(uint64_t)))
+            cu_offsets.push_back ((dw_offset_t)m_data.GetU64 (&cu_list_entry_offset));
+    }
+}
+
+bool
+DWARFGdbIndex::FindSymbol (llvm::StringRef name, uint32_t &cu_vector_offset) const
+{
+    const uint32_t hash = HashName (name);
+    const uint32_t slot_mask = m_symbol_table_size - 1;
+    const uint32_t step = ((hash * 17) & slot_mask) | 1;
+    uint32_t slot = hash & slot_mask;
+    for (uint32_t probe = 0; probe < m_symbol_table_size; ++probe)
+    {
+        lldb::offset_t offset = m_symbol_table_offset + (lldb::offset_t)slot * 8;
+        const uint32_t name_offset = m_data.GetU32 (&offset);
+        const uint32_t vector_offset = m_data.GetU32 (&offset);
+        if (name_offset == 0 && vector_offset == 0)
+            return false;
+
+        // The hash ignores case so keep probing on a mismatch
+        const char *symbol_name = GetString (name_offset);
+        if (symbol_name && name == symbol_name)
+        {
+            cu_vector_offset = vector_offset;
+            return true;
+        }
+        slot = (slot + step) & slot_mask;
+    }
+    return false;
+}
+
+void
+DWARFGdbIndex::BuildBaseNameTable ()
+{
+    if (m_base_names_built)
+        return;
+    m_base_names_built = true;
+
+    Timer scoped_timer (__PRETTY_FUNCTION__, "%s", __PRETTY_FUNCTION__);
+
+    // The index is keyed by qualified names while the DWARF is mostly
+    // looked up by base names, so remember the base name of every
+    // qualified symbol. The strings live in the section data.
+    for (uint32_t slot = 0; slot < m_symbol_table_size; ++slot)
+    {
+        lldb::offset_t offset = m_symbol_table_offset + (lldb::offset_t)slot * 8;
+        const uint32_t name_offset = m_data.GetU32 (&offset);
+        const uint32_t vector_offset = m_data.GetU32 (&offset);
+        if (name_offset == 0 && vector_offset == 0)
+            continue;
+
+        const char *symbol_name = GetString (name_offset);
+        if (symbol_name == NULL)
+            continue;
+        llvm::StringRef name (symbol_name);
+        llvm::StringRef base_name (GetBaseName (name));
+        if (base_name.size() != name.size() && !base_name.empty())
+            m_base_names.push_back (BaseNameEntry (base_name, vector_offset));
+    }
+    std::sort (m_base_names.begin(), m_base_names.end());
+}
+
+bool
+DWARFGdbIndex::FindCompileUnitOffsets (const char *name,
+                                       uint32_t kind_mask,
+                                       std::vector<dw_offset_t> &cu_offsets)
+{
+    if (!IsValid() || name == NULL || name[0] == '\0')
+        return false;
+
+    // The index only contains demangled names
+    ConstString demangled;
+    llvm::StringRef lookup_name (name);
+    if (lookup_name.startswith ("_Z"))
+    {
+        Mangled mangled (ConstString (name), true);
+        demangled = mangled.GetDemangledName();
+        if (!demangled)
+            return false;
+        lookup_name = demangled.GetStringRef();
+    }
+    lookup_name = StripParameters (lookup_name);
+
+    const size_t original_size = cu_offsets.size();
+    uint32_t cu_vector_offset = 0;
+    if (FindSymbol (lookup_name, cu_vector_offset))
+        AppendCompileUnits (cu_vector_offset, kind_mask, cu_offsets);
+
+    BuildBaseNameTable ();
+    llvm::StringRef base_name (GetBaseName (lookup_name));
+    BaseNameTable::const_iterator pos = std::lower_bound (m_base_names.begin(),
+                                                          m_base_names.end(),
+                                                          BaseNameEntry (base_name, 0));
+    for (; pos != m_base_names.end() && pos->first == base_name; ++pos)
+        AppendCompileUnits (pos->second, kind_mask, cu_offsets);
+
+    std::sort (cu_offsets.begin() + original_size, cu_offsets.end());
+    cu_offsets.erase (std::unique (cu_offsets.begin() + original_size, cu_offsets.end()), cu_offsets.end());
+    return true;
+}
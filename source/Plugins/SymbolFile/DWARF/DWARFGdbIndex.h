@@ -0,0 +1,131 @@
+//===-- DWARFGdbIndex.h -----------------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef SymbolFileDWARF_DWARFGdbIndex_h_
+#define SymbolFileDWARF_DWARFGdbIndex_h_
+
+#include <utility>
+#include <vector>
+
+#include "llvm/ADT/StringRef.h"
+
+#include "lldb/lldb-private.h"
+#include "lldb/Core/DataExtractor.h"
+#include "lldb/Core/dwarf.h"
+
+//----------------------------------------------------------------------
+// DWARFGdbIndex
+//
+// Reads the ".gdb_index" section that linkers and gdb-add-index emit
+// (versions 5 through 8). The section maps every global name in the
+// DWARF to the compile units that define it, which lets us index just
+// the compile units that can contain a name instead of all of them.
+//----------------------------------------------------------------------
+class DWARFGdbIndex
+{
+public:
+    // The symbol kinds recorded in the CU vector attributes. Indexes
+    // older than version 7 don't record kinds, so their entries are
+    // always of kind eSymbolKindNone which matches any kind mask.
+    enum SymbolKind
+    {
+        eSymbolKindNone     = 0,
+        eSymbolKindType     = 1,
+        eSymbolKindVariable = 2,
+        eSymbolKindFunction = 3,
+        eSymbolKindOther    = 4
+    };
+
+    static uint32_t
+    SymbolKindMask (SymbolKind kind)
+    {
+        return 1u << kind;
+    }
+
+    DWARFGdbIndex ();
+
+    bool
+    Extract (const lldb_private::DataExtractor &gdb_index_data);
+
+    bool
+    IsValid () const
+    {
+        return m_symbol_table_size > 0;
+    }
+
+    uint32_t
+    GetVersion () const
+    {
+        return m_version;
+    }
+
+    //------------------------------------------------------------------
+    /// Find the compile units that can contain DIEs for a name.
+    ///
+    /// @param[in] name
+    ///     A name as it is looked up in the DWARF name indexes: a base
+    ///     name, a qualified name, a demangled name with its parameter
+    ///     list, or a mangled C++ name.
+    ///
+    /// @param[in] kind_mask
+    ///     A mask of SymbolKindMask() values the entries must match.
+    ///
+    /// @param[out] cu_offsets
+    ///     The .debug_info offsets of the matching compile units, sorted
+    ///     and unique.
+    ///
+    /// @return
+    ///     True if the index could answer the lookup. False if the name
+    ///     is in a form the index can't look up, in which case every
+    ///     compile unit must be searched.
+    //------------------------------------------------------------------
+    bool
+    FindCompileUnitOffsets (const char *name,
+                            uint32_t kind_mask,
+                            std::vector<dw_offset_t> &cu_offsets);
+
+protected:
+    static uint32_t
+    HashName (llvm::StringRef name);
+
+    static llvm::StringRef
+    GetBaseName (llvm::StringRef name);
+
+    static llvm::StringRef
+    StripParameters (llvm::StringRef name);
+
+    const char *
+    GetString (uint32_t offset) const;
+
+    void
+    AppendCompileUnits (uint32_t cu_vector_offset,
+                        uint32_t kind_mask,
+                        std::vector<dw_offset_t> &cu_offsets) const;
+
+    bool
+    FindSymbol (llvm::StringRef name, uint32_t &cu_vector_offset) const;
+
+    void
+    BuildBaseNameTable ();
+
+    typedef std::pair<llvm::StringRef, uint32_t> BaseNameEntry; // Base name and CU vector offset
+    typedef std::vector<BaseNameEntry> BaseNameTable;
+
+    lldb_private::DataExtractor m_data;
+    uint32_t m_version;
+    uint32_t m_cu_list_offset;
+    uint32_t m_num_cus;
+    uint32_t m_symbol_table_offset;
+    uint32_t m_symbol_table_size;   // Number of slots, always a power of two
+    uint32_t m_constant_pool_offset;
+    BaseNameTable m_base_names;     // Built the first time we look up a name
+    bool m_base_names_built;
+};
+
+#endif  // SymbolFileDWARF_DWARFGdbIndex_h_
@@ -38,6 +38,9 @@ public:
     void
     Insert (const lldb_private::ConstString& name, uint32_t die_offset);
 
+    void
+    Append (const NameToDIE& other);
+
     void
     Finalize();
 
@@ -57,6 +60,18 @@ public:
     void
     ForEach (std::function <bool(const char *name, uint32_t die_offset)> const &callback) const;
 
+    lldb_private::UniqueCStringMap<uint32_t> &
+    GetMap ()
+    {
+        return m_map;
+    }
+
+    const lldb_private::UniqueCStringMap<uint32_t> &
+    GetMap () const
+    {
+        return m_map;
+    }
+
 protected:
     lldb_private::UniqueCStringMap<uint32_t> m_map;
 
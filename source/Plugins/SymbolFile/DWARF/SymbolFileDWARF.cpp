@@ -37,12 +37,16 @@
 #include "lldb/Core/StreamFile.h"
 #include "lldb/Core/StreamString.h"
 #include "lldb/Core/Timer.h"
+#include "lldb/Core/UserSettingsController.h"
 #include "lldb/Core/Value.h"
 
 #include "lldb/Expression/ClangModulesDeclVendor.h"
 
 #include "lldb/Host/Host.h"
 
+#include "lldb/Interpreter/OptionValueProperties.h"
+#include "lldb/Interpreter/Property.h"
+
 #include "lldb/Symbol/Block.h"
 #include "lldb/Symbol/ClangExternalASTSourceCallbacks.h"
 #include "lldb/Symbol/CompileUnit.h"
@@ -53,6 +57,11 @@
 
 #include "lldb/Target/ObjCLanguageRuntime.h"
 #include "lldb/Target/CPPLanguageRuntime.h"
+#include "lldb/Target/Target.h"
+
+#include "lldb/Utility/TaskPool.h"
+
+#include "Utility/IndexCache.h"
 
 #include "DWARFCompileUnit.h"
 #include "DWARFDebugAbbrev.h"
@@ -65,9 +74,12 @@
 #include "DWARFDeclContext.h"
 #include "DWARFDIECollection.h"
 #include "DWARFFormValue.h"
+#include "DWARFGdbIndex.h"
 #include "DWARFLocationList.h"
 #include "LogChannelDWARF.h"
 #include "SymbolFileDWARFDebugMap.h"
+#include "SymbolFileDWARFDwo.h"
+#include "SymbolFileDWARFDwp.h"
 
 #include <map>
 
@@ -88,6 +100,67 @@
 using namespace lldb;
 using namespace lldb_private;
 
+namespace {
+
+    PropertyDefinition
+    g_properties[] =
+    {
+        { "index-thread-count" , OptionValue::eTypeUInt64 , true , 0, NULL, NULL, "The number of threads used to index DWARF compile units when no accelerator tables are available. Zero uses one thread per CPU, one indexes serially on the calling thread." },
+        { "keep-indexed-dies"  , OptionValue::eTypeBoolean, true , false, NULL, NULL, "Keep the DIEs that indexing extracts in memory instead of freeing them and extracting them again when they are needed. Uses more memory, which \"image dump symfile\" reports." },
+        {  NULL            , OptionValue::eTypeInvalid, false, 0, NULL, NULL, NULL  }
+    };
+
+    enum
+    {
+        ePropertyIndexThreadCount,
+        ePropertyKeepIndexedDIEs
+    };
+
+    class PluginProperties : public Properties
+    {
+    public:
+
+        static ConstString
+        GetSettingName ()
+        {
+            return SymbolFileDWARF::GetPluginNameStatic();
+        }
+
+        PluginProperties() :
+            Properties ()
+        {
+            m_collection_sp.reset (new OptionValueProperties(GetSettingName()));
+            m_collection_sp->Initialize(g_properties);
+        }
+
+        uint32_t
+        GetIndexThreadCount() const
+        {
+            const uint32_t idx = ePropertyIndexThreadCount;
+            return m_collection_sp->GetPropertyAtIndexAsUInt64(NULL, idx, g_properties[idx].default_uint_value);
+        }
+
+        bool
+        GetKeepIndexedDIEs() const
+        {
+            const uint32_t idx = ePropertyKeepIndexedDIEs;
+            return m_collection_sp->GetPropertyAtIndexAsBoolean(NULL, idx, g_properties[idx].default_uint_value != 0);
+        }
+    };
+
+    typedef std::shared_ptr<PluginProperties> SymbolFileDWARFPropertiesSP;
+
+    static const SymbolFileDWARFPropertiesSP &
+    GetGlobalPluginProperties()
+    {
+        static SymbolFileDWARFPropertiesSP g_settings_sp;
+        if (!g_settings_sp)
+            g_settings_sp.reset (new PluginProperties ());
+        return g_settings_sp;
+    }
+
+} // anonymous namespace end
+
 //static inline bool
 //child_requires_parent_class_union_or_struct_to_be_completed (dw_tag_t tag)
 //{
@@ -232,7 +305,21 @@ SymbolFileDWARF::Initialize()
     LogChannelDWARF::Initialize();
     PluginManager::RegisterPlugin (GetPluginNameStatic(),
                                    GetPluginDescriptionStatic(),
-                                   CreateInstance);
+                                   CreateInstance,
+                                   DebuggerInitialize);
+}
+
+void
+SymbolFileDWARF::DebuggerInitialize (Debugger &debugger)
+{
+    if (!PluginManager::GetSettingForSymbolFilePlugin(debugger, PluginProperties::GetSettingName()))
+    {
+        const bool is_global_setting = true;
+        PluginManager::CreateSettingForSymbolFilePlugin (debugger,
+                                                         GetGlobalPluginProperties()->GetValueProperties(),
+                                                         ConstString ("Properties for the dwarf symbol-file plug-in."),
+                                                         is_global_setting);
+    }
 }
 
 void
@@ -350,6 +437,10 @@ SymbolFileDWARF::GetTypes (SymbolContextScope *sc_scope,
 
     if (comp_unit)
     {
+        SymbolFileDWARFDwo *dwo_symbol_file = GetDwoSymbolFile (comp_unit);
+        if (dwo_symbol_file)
+            return dwo_symbol_file->GetTypes (sc_scope, type_mask, type_list);
+
         dwarf_cu = GetDWARFCompileUnit(comp_unit);
         if (dwarf_cu == 0)
             return 0;
@@ -492,6 +583,7 @@ SymbolFileDWARF::SymbolFileDWARF(ObjectFile* objfile) :
     m_clang_tu_decl (NULL),
     m_flags(),
     m_data_debug_abbrev (),
+    m_data_debug_addr (),
     m_data_debug_aranges (),
     m_data_debug_frame (),
     m_data_debug_info (),
@@ -499,6 +591,7 @@ SymbolFileDWARF::SymbolFileDWARF(ObjectFile* objfile) :
     m_data_debug_loc (),
     m_data_debug_ranges (),
     m_data_debug_str (),
+    m_data_debug_str_offsets (),
     m_data_apple_names (),
     m_data_apple_types (),
     m_data_apple_namespaces (),
@@ -509,6 +602,7 @@ SymbolFileDWARF::SymbolFileDWARF(ObjectFile* objfile) :
     m_apple_types_ap (),
     m_apple_namespaces_ap (),
     m_apple_objc_ap (),
+    m_gdb_index_ap (),
     m_function_basename_index(),
     m_function_fullname_index(),
     m_function_method_index(),
@@ -517,11 +611,19 @@ SymbolFileDWARF::SymbolFileDWARF(ObjectFile* objfile) :
     m_global_index(),
     m_type_index(),
     m_namespace_index(),
+    m_gdb_indexed_cus(),
+    m_dwp_symfile_ap (),
+    m_dwo_mutex (Mutex::eMutexTypeRecursive),
+    m_loaded_dwo_symfiles (),
+    m_has_split_compile_units (eLazyBoolCalculate),
+    m_loaded_dwp_symfile (false),
     m_indexed (false),
     m_is_external_ast_source (false),
     m_using_apple_tables (false),
     m_fetched_external_modules (false),
     m_supports_DW_AT_APPLE_objc_complete_type (eLazyBoolCalculate),
+    m_extracted_die_bytes (0),
+    m_extracted_die_count (0),
     m_ranges(),
     m_unique_ast_type_map ()
 {
@@ -627,6 +729,23 @@ SymbolFileDWARF::InitializeObject()
         else
             m_apple_objc_ap.reset();
     }
+
+    // Without the apple tables, use the .gdb_index section to avoid
+    // indexing every compile unit when looking up names.
+    if (!m_using_apple_tables && module_sp)
+    {
+        const SectionList *section_list = module_sp->GetSectionList();
+        SectionSP section_sp;
+        if (section_list)
+            section_sp = section_list->FindSectionByName (ConstString(".gdb_index"));
+        DataExtractor gdb_index_data;
+        if (section_sp && m_obj_file->ReadSectionData (section_sp.get(), gdb_index_data) > 0)
+        {
+            m_gdb_index_ap.reset (new DWARFGdbIndex());
+            if (!m_gdb_index_ap->Extract (gdb_index_data))
+                m_gdb_index_ap.reset();
+        }
+    }
 }
 
 bool
@@ -741,28 +860,102 @@ SymbolFileDWARF::GetCachedSectionData (uint32_t got_flag, SectionType sect_type,
 {
     if (m_flags.IsClear (got_flag))
     {
-        ModuleSP module_sp (m_obj_file->GetModule());
         m_flags.Set (got_flag);
-        const SectionList *section_list = module_sp->GetSectionList();
-        if (section_list)
+        LoadSectionData (sect_type, data);
+    }
+    return data;
+}
+
+const SectionList *
+SymbolFileDWARF::GetDWARFSectionList ()
+{
+    ModuleSP module_sp (m_obj_file->GetModule());
+    if (module_sp)
+        return module_sp->GetSectionList();
+    return NULL;
+}
+
+void
+SymbolFileDWARF::LoadSectionData (SectionType sect_type, DWARFDataExtractor &data)
+{
+    const SectionList *section_list = GetDWARFSectionList();
+    if (section_list)
+    {
+        SectionSP section_sp (section_list->FindSectionByType(sect_type, true));
+        if (section_sp)
         {
-            SectionSP section_sp (section_list->FindSectionByType(sect_type, true));
-            if (section_sp)
+            // See if we memory mapped the DWARF segment?
+            if (m_dwarf_data.GetByteSize())
             {
-                // See if we memory mapped the DWARF segment?
-                if (m_dwarf_data.GetByteSize())
-                {
-                    data.SetData(m_dwarf_data, section_sp->GetOffset (), section_sp->GetFileSize());
-                }
-                else
-                {
-                    if (m_obj_file->ReadSectionData (section_sp.get(), data) == 0)
-                        data.Clear();
-                }
+                data.SetData(m_dwarf_data, section_sp->GetOffset (), section_sp->GetFileSize());
+            }
+            else
+            {
+                if (m_obj_file->ReadSectionData (section_sp.get(), data) == 0)
+                    data.Clear();
             }
         }
     }
-    return data;
+}
+
+void
+SymbolFileDWARF::PrefetchCompressedSectionData ()
+{
+    // Compressed sections get inflated the first time they are read.
+    // Parsing the DWARF needs these sections right away, so inflate them
+    // on separate threads instead of one after another.
+    struct SectionToPrefetch
+    {
+        uint32_t got_flag;
+        SectionType sect_type;
+        DWARFDataExtractor *data;
+    };
+    const SectionToPrefetch g_sections[] =
+    {
+        { flagsGotDebugInfoData,    eSectionTypeDWARFDebugInfo,     &m_data_debug_info      },
+        { flagsGotDebugAbbrevData,  eSectionTypeDWARFDebugAbbrev,   &m_data_debug_abbrev    },
+        { flagsGotDebugStrData,     eSectionTypeDWARFDebugStr,      &m_data_debug_str       },
+        { flagsGotDebugLineData,    eSectionTypeDWARFDebugLine,     &m_data_debug_line      },
+        { flagsGotDebugArangesData, eSectionTypeDWARFDebugAranges,  &m_data_debug_aranges   },
+        { flagsGotDebugRangesData,  eSectionTypeDWARFDebugRanges,   &m_data_debug_ranges    }
+    };
+
+    // The mach-o DWARF segment is memory mapped and never compressed
+    if (m_dwarf_data.GetByteSize())
+        return;
+
+    const SectionList *section_list = GetDWARFSectionList();
+    if (section_list == NULL)
+        return;
+
+    std::vector<const SectionToPrefetch *> prefetch_sections;
+    for (const SectionToPrefetch &section : g_sections)
+    {
+        if (m_flags.IsSet (section.got_flag))
+            continue;
+        SectionSP section_sp (section_list->FindSectionByType (section.sect_type, true));
+        if (section_sp && m_obj_file->SectionIsCompressed (section_sp.get()))
+            prefetch_sections.push_back (&section);
+    }
+
+    const uint32_t num_sections = prefetch_sections.size();
+    if (num_sections < 2)
+        return;
+
+    // The object file caches what it inflates, but don't count on it and
+    // hand the contents over to the section data ourselves.
+    std::vector<DWARFDataExtractor> section_data (num_sections);
+    TaskPool::MapOverInt (0, num_sections, 0,
+                          [this, &prefetch_sections, &section_data](uint32_t idx, uint32_t /*worker_idx*/)
+                          {
+                              LoadSectionData (prefetch_sections[idx]->sect_type, section_data[idx]);
+                          });
+
+    for (uint32_t idx = 0; idx < num_sections; ++idx)
+    {
+        m_flags.Set (prefetch_sections[idx]->got_flag);
+        *prefetch_sections[idx]->data = section_data[idx];
+    }
 }
 
 const DWARFDataExtractor&
@@ -771,6 +964,12 @@ SymbolFileDWARF::get_debug_abbrev_data()
     return GetCachedSectionData (flagsGotDebugAbbrevData, eSectionTypeDWARFDebugAbbrev, m_data_debug_abbrev);
 }
 
+const DWARFDataExtractor&
+SymbolFileDWARF::get_debug_addr_data()
+{
+    return GetCachedSectionData (flagsGotDebugAddrData, eSectionTypeDWARFDebugAddr, m_data_debug_addr);
+}
+
 const DWARFDataExtractor&
 SymbolFileDWARF::get_debug_aranges_data()
 {
@@ -813,6 +1012,12 @@ SymbolFileDWARF::get_debug_str_data()
     return GetCachedSectionData (flagsGotDebugStrData, eSectionTypeDWARFDebugStr, m_data_debug_str);
 }
 
+const DWARFDataExtractor&
+SymbolFileDWARF::get_debug_str_offsets_data()
+{
+    return GetCachedSectionData (flagsGotDebugStrOffsetsData, eSectionTypeDWARFDebugStrOffsets, m_data_debug_str_offsets);
+}
+
 const DWARFDataExtractor&
 SymbolFileDWARF::get_apple_names_data()
 {
@@ -868,6 +1073,7 @@ SymbolFileDWARF::DebugInfo()
     {
         Timer scoped_timer(__PRETTY_FUNCTION__, "%s this = %p",
                            __PRETTY_FUNCTION__, static_cast<void*>(this));
+        PrefetchCompressedSectionData();
         if (get_debug_info_data().GetByteSize() > 0)
         {
             m_info.reset(new DWARFDebugInfo());
@@ -944,6 +1150,241 @@ SymbolFileDWARF::DebugRanges() const
     return m_ranges.get();
 }
 
+std::string
+SymbolFileDWARF::GetIndexCacheKind ()
+{
+    return "dwarf";
+}
+
+SymbolFileDWARFDwp *
+SymbolFileDWARF::GetDwpSymbolFile ()
+{
+    Mutex::Locker locker (m_dwo_mutex);
+    if (!m_loaded_dwp_symfile)
+    {
+        m_loaded_dwp_symfile = true;
+        // The dwp tool names the package after the executable
+        FileSpec dwp_file_spec (m_obj_file->GetFileSpec());
+        if (dwp_file_spec)
+        {
+            dwp_file_spec.SetFile ((dwp_file_spec.GetPath() + ".dwp").c_str(), false);
+            if (dwp_file_spec.Exists())
+                m_dwp_symfile_ap = SymbolFileDWARFDwp::Create (m_obj_file->GetModule(), dwp_file_spec);
+        }
+    }
+    return m_dwp_symfile_ap.get();
+}
+
+std::unique_ptr<SymbolFileDWARFDwo>
+SymbolFileDWARF::LoadDwoSymbolFile (DWARFCompileUnit &dwarf_cu, const DWARFDebugInfoEntry &cu_die)
+{
+    // The .o files of a debug map never have split compile units
+    if (GetDebugMapSymfile () || GetBaseSymbolFile ())
+        return nullptr;
+
+    Timer scoped_timer (__PRETTY_FUNCTION__, "%s", __PRETTY_FUNCTION__);
+    std::unique_ptr<SymbolFileDWARFDwo> dwo_symfile;
+
+    SymbolFileDWARFDwp *dwp_symfile = GetDwpSymbolFile ();
+    if (dwp_symfile)
+        dwo_symfile = dwp_symfile->GetSymbolFileForDwoId (&dwarf_cu, dwarf_cu.GetDWOId());
+
+    const char *dwo_name = cu_die.GetAttributeValueAsString (this, &dwarf_cu, DW_AT_GNU_dwo_name, NULL);
+    if (!dwo_symfile && dwo_name)
+    {
+        FileSpec dwo_file;
+        if (dwo_name[0] == '/')
+            dwo_file.SetFile (dwo_name, false);
+        else
+        {
+            // DWARF2/3 suggests the form hostname:pathname for compilation directory.
+            // Remove the host part if present.
+            const char *comp_dir = removeHostnameFromPathname (cu_die.GetAttributeValueAsString (this, &dwarf_cu, DW_AT_comp_dir, NULL));
+            if (comp_dir && comp_dir[0])
+            {
+                dwo_file.SetFile (comp_dir, false);
+                dwo_file.AppendPathComponent (dwo_name);
+            }
+        }
+
+        // Binaries that were moved after they were built usually have
+        // their .dwo files right next to them
+        if (!dwo_file.Exists())
+        {
+            dwo_file = m_obj_file->GetFileSpec().CopyByRemovingLastPathComponent();
+            dwo_file.AppendPathComponent (FileSpec (dwo_name, false).GetFilename().GetCString());
+        }
+
+        if (dwo_file.Exists())
+        {
+            DataBufferSP dwo_file_data_sp;
+            lldb::offset_t dwo_file_data_offset = 0;
+            ObjectFileSP dwo_obj_file = ObjectFile::FindPlugin (m_obj_file->GetModule(),
+                                                                &dwo_file,
+                                                                0,
+                                                                dwo_file.GetByteSize(),
+                                                                dwo_file_data_sp,
+                                                                dwo_file_data_offset);
+            if (dwo_obj_file)
+                dwo_symfile.reset (new SymbolFileDWARFDwo (dwo_obj_file, &dwarf_cu));
+        }
+    }
+
+    // Make sure the .dwo file matches the skeleton and wasn't rebuilt
+    if (dwo_symfile)
+    {
+        DWARFCompileUnit *dwo_cu = dwo_symfile->GetCompileUnit();
+        if (dwo_cu == NULL)
+            dwo_symfile.reset();
+        else
+        {
+            const uint64_t dwo_id = dwarf_cu.GetDWOId();
+            const uint64_t dwo_cu_id = dwo_cu->GetDWOId();
+            if (dwo_id != 0 && dwo_cu_id != 0 && dwo_id != dwo_cu_id)
+                dwo_symfile.reset();
+        }
+    }
+
+    if (!dwo_symfile)
+    {
+        GetObjectFile()->GetModule()->ReportWarning ("unable to locate split DWARF file '%s' for the compile unit at 0x%8.8x, debug info for it will be missing",
+                                                     dwo_name ? dwo_name : "<unknown>",
+                                                     dwarf_cu.GetOffset());
+        return nullptr;
+    }
+
+    Mutex::Locker locker (m_dwo_mutex);
+    m_loaded_dwo_symfiles.push_back (dwo_symfile.get());
+    return dwo_symfile;
+}
+
+SymbolFileDWARFDwo *
+SymbolFileDWARF::GetDwoSymbolFile (CompileUnit *comp_unit)
+{
+    if (comp_unit == NULL || !HasSplitCompileUnits ())
+        return NULL;
+    DWARFCompileUnit *dwarf_cu = GetDWARFCompileUnit (comp_unit);
+    if (dwarf_cu)
+        return dwarf_cu->GetDwoSymbolFile();
+    return NULL;
+}
+
+SymbolFileDWARF *
+SymbolFileDWARF::GetDwoSymbolFileForUserID (lldb::user_id_t uid)
+{
+    // A .dwo symbol file makes user IDs with the index of its skeleton
+    // compile unit plus one in the high 32 bits, see SymbolFileDWARFDwo.
+    const uint32_t cu_idx_plus_one = (uint32_t)(uid >> 32);
+    if (cu_idx_plus_one == 0 || GetID() != 0 || !HasSplitCompileUnits ())
+        return NULL;
+    DWARFDebugInfo *info = DebugInfo();
+    DWARFCompileUnit *dwarf_cu = info ? info->GetCompileUnitAtIndex (cu_idx_plus_one - 1) : NULL;
+    if (dwarf_cu)
+        return dwarf_cu->GetDwoSymbolFile();
+    return NULL;
+}
+
+bool
+SymbolFileDWARF::HasSplitCompileUnits ()
+{
+    if (m_has_split_compile_units == eLazyBoolCalculate)
+    {
+        m_has_split_compile_units = eLazyBoolNo;
+        DWARFDebugInfo *info = DebugInfo();
+        if (info && !GetDebugMapSymfile () && !GetBaseSymbolFile ())
+        {
+            const uint32_t num_cus = info->GetNumCompileUnits();
+            for (uint32_t cu_idx = 0; cu_idx < num_cus; ++cu_idx)
+            {
+                DWARFCompileUnit *dwarf_cu = info->GetCompileUnitAtIndex (cu_idx);
+                if (dwarf_cu && dwarf_cu->IsSplitSkeleton())
+                {
+                    m_has_split_compile_units = eLazyBoolYes;
+                    break;
+                }
+            }
+        }
+    }
+    return m_has_split_compile_units == eLazyBoolYes;
+}
+
+void
+SymbolFileDWARF::ForEachLoadedDwoSymbolFile (std::function<bool (SymbolFileDWARFDwo *)> closure)
+{
+    // The closure can open more .dwo files, so don't hold the lock
+    std::vector<SymbolFileDWARFDwo *> dwo_symfiles;
+    {
+        Mutex::Locker locker (m_dwo_mutex);
+        dwo_symfiles = m_loaded_dwo_symfiles;
+    }
+    for (SymbolFileDWARFDwo *dwo_symfile : dwo_symfiles)
+    {
+        if (!closure (dwo_symfile))
+            break;
+    }
+}
+
+void
+SymbolFileDWARF::ForEachDwoSymbolFile (std::function<bool (SymbolFileDWARFDwo *)> closure)
+{
+    if (!HasSplitCompileUnits ())
+        return;
+    DWARFDebugInfo *info = DebugInfo();
+    const uint32_t num_cus = info->GetNumCompileUnits();
+    for (uint32_t cu_idx = 0; cu_idx < num_cus; ++cu_idx)
+    {
+        DWARFCompileUnit *dwarf_cu = info->GetCompileUnitAtIndex (cu_idx);
+        SymbolFileDWARFDwo *dwo_symfile = dwarf_cu ? dwarf_cu->GetDwoSymbolFile() : NULL;
+        if (dwo_symfile && !closure (dwo_symfile))
+            break;
+    }
+}
+
+void
+SymbolFileDWARF::ForEachDwoSymbolFileForName (const ConstString &name,
+                                              uint32_t gdb_index_kind_mask,
+                                              std::function<bool (SymbolFileDWARFDwo *)> closure)
+{
+    if (!HasSplitCompileUnits ())
+        return;
+
+    // The .gdb_index lists the skeleton compile units, so only the .dwo
+    // files that define the name need to be opened.
+    std::vector<dw_offset_t> cu_offsets;
+    if (m_gdb_index_ap.get() == NULL ||
+        !m_gdb_index_ap->FindCompileUnitOffsets (name.GetCString(), gdb_index_kind_mask, cu_offsets))
+    {
+        ForEachDwoSymbolFile (closure);
+        return;
+    }
+
+    DWARFDebugInfo *info = DebugInfo();
+    for (dw_offset_t cu_offset : cu_offsets)
+    {
+        DWARFCompileUnit *dwarf_cu = info->GetCompileUnit (cu_offset).get();
+        SymbolFileDWARFDwo *dwo_symfile = dwarf_cu ? dwarf_cu->GetDwoSymbolFile() : NULL;
+        if (dwo_symfile && !closure (dwo_symfile))
+            break;
+    }
+}
+
+TypeSP
+SymbolFileDWARF::FindDefinitionTypeInDwoSymbolFiles (SymbolFileDWARF *skip_dwarf_dwo,
+                                                     const DWARFDeclContext &die_decl_ctx)
+{
+    TypeSP type_sp;
+    if (die_decl_ctx.GetSize() == 0)
+        return type_sp;
+    ForEachDwoSymbolFileForName (die_decl_ctx.GetQualifiedNameAsConstString(),
+                                 DWARFGdbIndex::SymbolKindMask (DWARFGdbIndex::eSymbolKindType),
+                                 [&](SymbolFileDWARFDwo *dwo_symfile) -> bool {
+        if (dwo_symfile != skip_dwarf_dwo)
+            type_sp = dwo_symfile->FindDefinitionTypeForDWARFDeclContext (die_decl_ctx);
+        return !type_sp;
+    });
+    return type_sp;
+}
+
 lldb::CompUnitSP
 SymbolFileDWARF::ParseCompileUnit (DWARFCompileUnit* dwarf_cu, uint32_t cu_idx)
 {
@@ -1219,6 +1660,9 @@ size_t
 SymbolFileDWARF::ParseCompileUnitFunctions(const SymbolContext &sc)
 {
     assert (sc.comp_unit);
+    SymbolFileDWARFDwo *dwo_symbol_file = GetDwoSymbolFile (sc.comp_unit);
+    if (dwo_symbol_file)
+        return dwo_symbol_file->ParseCompileUnitFunctions (sc);
     size_t functions_added = 0;
     DWARFCompileUnit* dwarf_cu = GetDWARFCompileUnit(sc.comp_unit);
     if (dwarf_cu)
@@ -2387,6 +2831,10 @@ SymbolFileDWARF::ParseChildMembers
 clang::DeclContext*
 SymbolFileDWARF::GetClangDeclContextContainingTypeUID (lldb::user_id_t type_uid)
 {
+    SymbolFileDWARF *dwo_symbol_file = GetDwoSymbolFileForUserID (type_uid);
+    if (dwo_symbol_file)
+        return dwo_symbol_file->GetClangDeclContextContainingTypeUID (type_uid);
+
     DWARFDebugInfo* debug_info = DebugInfo();
     if (debug_info && UserIDMatches(type_uid))
     {
@@ -2401,6 +2849,10 @@ SymbolFileDWARF::GetClangDeclContextContainingTypeUID (lldb::user_id_t type_uid)
 clang::DeclContext*
 SymbolFileDWARF::GetClangDeclContextForTypeUID (const lldb_private::SymbolContext &sc, lldb::user_id_t type_uid)
 {
+    SymbolFileDWARF *dwo_symbol_file = GetDwoSymbolFileForUserID (type_uid);
+    if (dwo_symbol_file)
+        return dwo_symbol_file->GetClangDeclContextForTypeUID (sc, type_uid);
+
     if (UserIDMatches(type_uid))
         return GetClangDeclContextForDIEOffset (sc, type_uid);
     return NULL;
@@ -2409,6 +2861,10 @@ SymbolFileDWARF::GetClangDeclContextForTypeUID (const lldb_private::SymbolContex
 Type*
 SymbolFileDWARF::ResolveTypeUID (lldb::user_id_t type_uid)
 {
+    SymbolFileDWARF *dwo_symbol_file = GetDwoSymbolFileForUserID (type_uid);
+    if (dwo_symbol_file)
+        return dwo_symbol_file->ResolveTypeUID (type_uid);
+
     if (UserIDMatches(type_uid))
     {
         DWARFDebugInfo* debug_info = DebugInfo();
@@ -2502,8 +2958,19 @@ SymbolFileDWARF::ResolveClangOpaqueTypeDefinition (ClangASTType &clang_type)
     const DWARFDebugInfoEntry* die = m_forward_decl_clang_type_to_die.lookup (clang_type_no_qualifiers.GetOpaqueQualType());
     if (die == NULL)
     {
-        // We have already resolved this type...
-        return true;
+        // The AST callbacks always come to the main symbol file, see if
+        // the type was made by a .dwo symbol file.
+        bool resolved = true;
+        ForEachLoadedDwoSymbolFile ([&clang_type, &resolved](SymbolFileDWARFDwo *dwo_symbol_file) -> bool {
+            if (dwo_symbol_file->HasForwardDeclForClangType (clang_type))
+            {
+                resolved = dwo_symbol_file->ResolveClangOpaqueTypeDefinition (clang_type);
+                return false;
+            }
+            return true;
+        });
+        // Otherwise we have already resolved this type...
+        return resolved;
     }
     // Once we start resolving this type, remove it from the forward declaration
     // map in case anyone child members or other types require this type to get resolved.
@@ -2892,8 +3359,10 @@ SymbolFileDWARF::UpdateExternalModuleListIfNeeded()
     {
         DWARFCompileUnit* dwarf_cu = debug_info->GetCompileUnitAtIndex(cu_idx);
         
+        // Split DWARF skeleton compile units also have no children and a
+        // DW_AT_GNU_dwo_name, but they aren't clang modules.
         const DWARFDebugInfoEntry *die = dwarf_cu->GetCompileUnitDIEOnly();
-        if (die && die->HasChildren() == false)
+        if (die && die->HasChildren() == false && !dwarf_cu->IsSplitSkeleton())
         {
             const uint64_t name_strp = die->GetAttributeValueAsUnsigned(this, dwarf_cu, DW_AT_name, UINT64_MAX);
             const uint64_t dwo_path_strp = die->GetAttributeValueAsUnsigned(this, dwarf_cu, DW_AT_GNU_dwo_name, UINT64_MAX);
@@ -2983,6 +3452,27 @@ SymbolFileDWARF::GetGlobalAranges()
 }
 
 
+//----------------------------------------------------------------------
+// The DIEs of a split compile unit are in its .dwo file. Returns the
+// symbol file that has the DIEs and updates "dwarf_cu" to the compile
+// unit they are in.
+//----------------------------------------------------------------------
+static SymbolFileDWARF *
+GetSymbolFileWithDIEs (SymbolFileDWARF *dwarf, DWARFCompileUnit *&dwarf_cu)
+{
+    SymbolFileDWARFDwo *dwo_symbol_file = dwarf_cu->GetDwoSymbolFile();
+    if (dwo_symbol_file)
+    {
+        DWARFCompileUnit *dwo_cu = dwo_symbol_file->GetCompileUnit();
+        if (dwo_cu)
+        {
+            dwarf_cu = dwo_cu;
+            return dwo_symbol_file;
+        }
+    }
+    return dwarf;
+}
+
 uint32_t
 SymbolFileDWARF::ResolveSymbolContext (const Address& so_addr, uint32_t resolve_scope, SymbolContext& sc)
 {
@@ -3040,22 +3530,24 @@ SymbolFileDWARF::ResolveSymbolContext (const Address& so_addr, uint32_t resolve_
                         bool force_check_line_table = false;
                         if (resolve_scope & (eSymbolContextFunction | eSymbolContextBlock))
                         {
+                            DWARFCompileUnit *die_cu = dwarf_cu;
+                            SymbolFileDWARF *die_dwarf = GetSymbolFileWithDIEs (this, die_cu);
                             DWARFDebugInfoEntry *function_die = NULL;
                             DWARFDebugInfoEntry *block_die = NULL;
                             if (resolve_scope & eSymbolContextBlock)
                             {
-                                dwarf_cu->LookupAddress(file_vm_addr, &function_die, &block_die);
+                                die_cu->LookupAddress(file_vm_addr, &function_die, &block_die);
                             }
                             else
                             {
-                                dwarf_cu->LookupAddress(file_vm_addr, &function_die, NULL);
+                                die_cu->LookupAddress(file_vm_addr, &function_die, NULL);
                             }
 
                             if (function_die != NULL)
                             {
-                                sc.function = sc.comp_unit->FindFunctionByUID (MakeUserID(function_die->GetOffset())).get();
+                                sc.function = sc.comp_unit->FindFunctionByUID (die_dwarf->MakeUserID(function_die->GetOffset())).get();
                                 if (sc.function == NULL)
-                                    sc.function = ParseCompileUnitFunction(sc, dwarf_cu, function_die);
+                                    sc.function = die_dwarf->ParseCompileUnitFunction(sc, die_cu, function_die);
                             }
                             else
                             {
@@ -3077,9 +3569,9 @@ SymbolFileDWARF::ResolveSymbolContext (const Address& so_addr, uint32_t resolve_
                                     Block& block = sc.function->GetBlock (true);
 
                                     if (block_die != NULL)
-                                        sc.block = block.FindBlockByID (MakeUserID(block_die->GetOffset()));
+                                        sc.block = block.FindBlockByID (die_dwarf->MakeUserID(block_die->GetOffset()));
                                     else
-                                        sc.block = block.FindBlockByID (MakeUserID(function_die->GetOffset()));
+                                        sc.block = block.FindBlockByID (die_dwarf->MakeUserID(function_die->GetOffset()));
                                     if (sc.block)
                                         resolved |= eSymbolContextBlock;
                                 }
@@ -3194,15 +3686,17 @@ SymbolFileDWARF::ResolveSymbolContext(const FileSpec& file_spec, uint32_t line,
                                             const lldb::addr_t file_vm_addr = sc.line_entry.range.GetBaseAddress().GetFileAddress();
                                             if (file_vm_addr != LLDB_INVALID_ADDRESS)
                                             {
+                                                DWARFCompileUnit *die_cu = dwarf_cu;
+                                                SymbolFileDWARF *die_dwarf = GetSymbolFileWithDIEs (this, die_cu);
                                                 DWARFDebugInfoEntry *function_die = NULL;
                                                 DWARFDebugInfoEntry *block_die = NULL;
-                                                dwarf_cu->LookupAddress(file_vm_addr, &function_die, resolve_scope & eSymbolContextBlock ? &block_die : NULL);
+                                                die_cu->LookupAddress(file_vm_addr, &function_die, resolve_scope & eSymbolContextBlock ? &block_die : NULL);
 
                                                 if (function_die != NULL)
                                                 {
-                                                    sc.function = sc.comp_unit->FindFunctionByUID (MakeUserID(function_die->GetOffset())).get();
+                                                    sc.function = sc.comp_unit->FindFunctionByUID (die_dwarf->MakeUserID(function_die->GetOffset())).get();
                                                     if (sc.function == NULL)
-                                                        sc.function = ParseCompileUnitFunction(sc, dwarf_cu, function_die);
+                                                        sc.function = die_dwarf->ParseCompileUnitFunction(sc, die_cu, function_die);
                                                 }
 
                                                 if (sc.function != NULL)
@@ -3210,9 +3704,9 @@ SymbolFileDWARF::ResolveSymbolContext(const FileSpec& file_spec, uint32_t line,
                                                     Block& block = sc.function->GetBlock (true);
 
                                                     if (block_die != NULL)
-                                                        sc.block = block.FindBlockByID (MakeUserID(block_die->GetOffset()));
+                                                        sc.block = block.FindBlockByID (die_dwarf->MakeUserID(block_die->GetOffset()));
                                                     else if (function_die != NULL)
-                                                        sc.block = block.FindBlockByID (MakeUserID(function_die->GetOffset()));
+                                                        sc.block = block.FindBlockByID (die_dwarf->MakeUserID(function_die->GetOffset()));
                                                 }
                                             }
                                         }
@@ -3256,33 +3750,79 @@ SymbolFileDWARF::Index ()
                         "SymbolFileDWARF::Index (%s)",
                         GetObjectFile()->GetFileSpec().GetFilename().AsCString("<Unknown>"));
 
+    // Throw away what IndexCompileUnits() indexed so we don't end up
+    // with duplicate entries.
+    if (!m_gdb_indexed_cus.empty())
+    {
+        m_function_basename_index.GetMap().Clear();
+        m_function_fullname_index.GetMap().Clear();
+        m_function_method_index.GetMap().Clear();
+        m_function_selector_index.GetMap().Clear();
+        m_objc_class_selectors_index.GetMap().Clear();
+        m_global_index.GetMap().Clear();
+        m_type_index.GetMap().Clear();
+        m_namespace_index.GetMap().Clear();
+        m_gdb_indexed_cus.clear();
+    }
+
     DWARFDebugInfo* debug_info = DebugInfo();
     if (debug_info)
     {
-        uint32_t cu_idx = 0;
-        const uint32_t num_compile_units = GetNumCompileUnits();
-        for (cu_idx = 0; cu_idx < num_compile_units; ++cu_idx)
+        // Reuse the indexes from a previous debug session if we can. A .dwo
+        // file has no UUID of its own, so the entries are keyed by the
+        // module's UUID and told apart by their kind.
+        ModuleSP module_sp (m_obj_file->GetModule());
+        IndexCache index_cache (Target::GetDefaultIndexCachePath(),
+                                module_sp ? module_sp->GetUUID() : UUID(),
+                                m_obj_file->GetFileSpec(),
+                                GetIndexCacheKind().c_str(),
+                                get_debug_info_data().GetByteSize());
+        std::vector<IndexCache::NameToIndexMap *> cached_maps;
+        cached_maps.push_back (&m_function_basename_index.GetMap());
+        cached_maps.push_back (&m_function_fullname_index.GetMap());
+        cached_maps.push_back (&m_function_method_index.GetMap());
+        cached_maps.push_back (&m_function_selector_index.GetMap());
+        cached_maps.push_back (&m_objc_class_selectors_index.GetMap());
+        cached_maps.push_back (&m_global_index.GetMap());
+        cached_maps.push_back (&m_type_index.GetMap());
+        cached_maps.push_back (&m_namespace_index.GetMap());
+        const bool loaded_from_cache = index_cache.IsValid() && index_cache.Load (cached_maps);
+
+        if (!loaded_from_cache)
         {
-            DWARFCompileUnit* dwarf_cu = debug_info->GetCompileUnitAtIndex(cu_idx);
-
-            bool clear_dies = dwarf_cu->ExtractDIEsIfNeeded (false) > 1;
-
-            dwarf_cu->Index (cu_idx,
-                             m_function_basename_index,
-                             m_function_fullname_index,
-                             m_function_method_index,
-                             m_function_selector_index,
-                             m_objc_class_selectors_index,
-                             m_global_index, 
-                             m_type_index,
-                             m_namespace_index);
-            
-            // Keep memory down by clearing DIEs if this generate function
-            // caused them to be parsed
-            if (clear_dies)
-                dwarf_cu->ClearDIEs (true);
+            const uint32_t num_compile_units = GetNumCompileUnits();
+            const uint32_t num_threads = TaskPool::GetNumWorkers (num_compile_units,
+                                                                  GetGlobalPluginProperties()->GetIndexThreadCount());
+            if (num_threads > 1)
+            {
+                IndexParallel (debug_info, num_compile_units, num_threads);
+            }
+            else
+            {
+                for (uint32_t cu_idx = 0; cu_idx < num_compile_units; ++cu_idx)
+                {
+                    DWARFCompileUnit* dwarf_cu = debug_info->GetCompileUnitAtIndex(cu_idx);
+
+                    bool clear_dies = dwarf_cu->ExtractDIEsIfNeeded (false) > 1 && !KeepDIEsAfterIndexing();
+
+                    dwarf_cu->Index (cu_idx,
+                                     m_function_basename_index,
+                                     m_function_fullname_index,
+                                     m_function_method_index,
+                                     m_function_selector_index,
+                                     m_objc_class_selectors_index,
+                                     m_global_index,
+                                     m_type_index,
+                                     m_namespace_index);
+
+                    // Keep memory down by clearing DIEs if this generate function
+                    // caused them to be parsed
+                    if (clear_dies)
+                        dwarf_cu->ClearDIEs (true);
+                }
+            }
         }
-        
+
         m_function_basename_index.Finalize();
         m_function_fullname_index.Finalize();
         m_function_method_index.Finalize();
@@ -3292,6 +3832,9 @@ SymbolFileDWARF::Index ()
         m_type_index.Finalize();
         m_namespace_index.Finalize();
 
+        if (index_cache.IsValid() && !loaded_from_cache)
+            index_cache.Save (std::vector<const IndexCache::NameToIndexMap *> (cached_maps.begin(), cached_maps.end()));
+
 #if defined (ENABLE_DEBUG_PRINTF)
         StreamFile s(stdout, false);
         s.Printf ("DWARF index for '%s':",
@@ -3308,6 +3851,205 @@ SymbolFileDWARF::Index ()
     }
 }
 
+void
+SymbolFileDWARF::IndexParallel (DWARFDebugInfo* debug_info,
+                                uint32_t num_compile_units,
+                                uint32_t num_threads)
+{
+    Timer scoped_timer ("SymbolFileDWARF::IndexParallel",
+                        "SymbolFileDWARF::IndexParallel (%s, %u threads)",
+                        GetObjectFile()->GetFileSpec().GetFilename().AsCString("<Unknown>"),
+                        num_threads);
+
+    // The section data accessors lazily cache their contents and are not
+    // thread safe, so make sure everything the workers read is loaded up
+    // front.
+    get_debug_info_data();
+    get_debug_str_data();
+
+    // Extract the DIEs for all compile units before indexing any of them.
+    // Indexing a DIE can follow DW_AT_specification into another compile
+    // unit, and that must never race with the other unit being extracted
+    // or cleared.
+    std::vector<uint8_t> clear_cu_dies (num_compile_units, false);
+    const bool keep_dies = KeepDIEsAfterIndexing();
+    {
+        Timer extract_timer ("SymbolFileDWARF::IndexParallel - extract DIEs",
+                             "SymbolFileDWARF::IndexParallel - extract DIEs for %u compile units",
+                             num_compile_units);
+        TaskPool::MapOverInt (0, num_compile_units, num_threads,
+                              [debug_info, keep_dies, &clear_cu_dies](uint32_t cu_idx, uint32_t /*worker_idx*/)
+                              {
+                                  DWARFCompileUnit* dwarf_cu = debug_info->GetCompileUnitAtIndex(cu_idx);
+                                  if (dwarf_cu && dwarf_cu->ExtractDIEsIfNeeded (false) > 1 && !keep_dies)
+                                      clear_cu_dies[cu_idx] = true;
+                              });
+    }
+
+    // Each worker indexes into its own set of maps so no locking is needed
+    // while indexing. The shards are merged once all workers are done.
+    struct IndexShard
+    {
+        NameToDIE function_basename_index;
+        NameToDIE function_fullname_index;
+        NameToDIE function_method_index;
+        NameToDIE function_selector_index;
+        NameToDIE objc_class_selectors_index;
+        NameToDIE global_index;
+        NameToDIE type_index;
+        NameToDIE namespace_index;
+    };
+    std::vector<IndexShard> shards (num_threads);
+    {
+        Timer index_timer ("SymbolFileDWARF::IndexParallel - index",
+                           "SymbolFileDWARF::IndexParallel - index %u compile units",
+                           num_compile_units);
+        TaskPool::MapOverInt (0, num_compile_units, num_threads,
+                              [debug_info, &shards](uint32_t cu_idx, uint32_t worker_idx)
+                              {
+                                  DWARFCompileUnit* dwarf_cu = debug_info->GetCompileUnitAtIndex(cu_idx);
+                                  if (dwarf_cu)
+                                  {
+                                      IndexShard &shard = shards[worker_idx];
+                                      dwarf_cu->Index (cu_idx,
+                                                       shard.function_basename_index,
+                                                       shard.function_fullname_index,
+                                                       shard.function_method_index,
+                                                       shard.function_selector_index,
+                                                       shard.objc_class_selectors_index,
+                                                       shard.global_index,
+                                                       shard.type_index,
+                                                       shard.namespace_index);
+                                  }
+                              });
+    }
+
+    {
+        Timer merge_timer ("SymbolFileDWARF::IndexParallel - merge",
+                           "SymbolFileDWARF::IndexParallel - merge %u shards",
+                           num_threads);
+        for (const IndexShard &shard : shards)
+        {
+            m_function_basename_index.Append (shard.function_basename_index);
+            m_function_fullname_index.Append (shard.function_fullname_index);
+            m_function_method_index.Append (shard.function_method_index);
+            m_function_selector_index.Append (shard.function_selector_index);
+            m_objc_class_selectors_index.Append (shard.objc_class_selectors_index);
+            m_global_index.Append (shard.global_index);
+            m_type_index.Append (shard.type_index);
+            m_namespace_index.Append (shard.namespace_index);
+        }
+    }
+
+    // Keep memory down by clearing the DIEs we caused to be parsed
+    for (uint32_t cu_idx = 0; cu_idx < num_compile_units; ++cu_idx)
+    {
+        if (clear_cu_dies[cu_idx])
+            debug_info->GetCompileUnitAtIndex(cu_idx)->ClearDIEs (true);
+    }
+}
+
+void
+SymbolFileDWARF::IndexNameIfNeeded (const ConstString &name, uint32_t gdb_index_kind_mask)
+{
+    if (m_indexed)
+        return;
+
+    DWARFDebugInfo* debug_info = DebugInfo();
+    std::vector<dw_offset_t> cu_offsets;
+    if (debug_info == NULL ||
+        m_gdb_index_ap.get() == NULL ||
+        !m_gdb_index_ap->FindCompileUnitOffsets (name.GetCString(), gdb_index_kind_mask, cu_offsets))
+    {
+        Index ();
+        return;
+    }
+
+    std::vector<uint32_t> cu_indexes;
+    for (dw_offset_t cu_offset : cu_offsets)
+    {
+        uint32_t cu_idx = UINT32_MAX;
+        if (!debug_info->GetCompileUnit (cu_offset, &cu_idx))
+        {
+            // The index doesn't match the DWARF, don't trust it anymore
+            GetObjectFile()->GetModule()->ReportWarning (".gdb_index refers to a compile unit at 0x%8.8x that doesn't exist, ignoring the index",
+                                                         cu_offset);
+            m_gdb_index_ap.reset();
+            Index ();
+            return;
+        }
+        cu_indexes.push_back (cu_idx);
+    }
+    IndexCompileUnits (cu_indexes);
+}
+
+void
+SymbolFileDWARF::IndexCompileUnitIfNeeded (DWARFCompileUnit *dwarf_cu)
+{
+    if (m_indexed)
+        return;
+
+    uint32_t cu_idx = UINT32_MAX;
+    DWARFDebugInfo* debug_info = DebugInfo();
+    if (m_gdb_index_ap.get() == NULL ||
+        debug_info == NULL ||
+        !debug_info->GetCompileUnit (dwarf_cu->GetOffset(), &cu_idx))
+    {
+        Index ();
+        return;
+    }
+    IndexCompileUnits (std::vector<uint32_t> (1, cu_idx));
+}
+
+void
+SymbolFileDWARF::IndexCompileUnits (const std::vector<uint32_t> &cu_indexes)
+{
+    DWARFDebugInfo* debug_info = DebugInfo();
+    if (debug_info == NULL)
+        return;
+
+    if (m_gdb_indexed_cus.empty())
+        m_gdb_indexed_cus.resize (GetNumCompileUnits(), false);
+
+    bool indexed_any = false;
+    for (uint32_t cu_idx : cu_indexes)
+    {
+        if (cu_idx >= m_gdb_indexed_cus.size() || m_gdb_indexed_cus[cu_idx])
+            continue;
+        m_gdb_indexed_cus[cu_idx] = true;
+
+        DWARFCompileUnit* dwarf_cu = debug_info->GetCompileUnitAtIndex(cu_idx);
+        if (dwarf_cu == NULL)
+            continue;
+
+        // Unlike Index() we keep the DIEs around since the lookup that
+        // caused the compile unit to be indexed is about to use them.
+        dwarf_cu->ExtractDIEsIfNeeded (false);
+        dwarf_cu->Index (cu_idx,
+                         m_function_basename_index,
+                         m_function_fullname_index,
+                         m_function_method_index,
+                         m_function_selector_index,
+                         m_objc_class_selectors_index,
+                         m_global_index,
+                         m_type_index,
+                         m_namespace_index);
+        indexed_any = true;
+    }
+
+    if (indexed_any)
+    {
+        m_function_basename_index.Finalize();
+        m_function_fullname_index.Finalize();
+        m_function_method_index.Finalize();
+        m_function_selector_index.Finalize();
+        m_objc_class_selectors_index.Finalize();
+        m_global_index.Finalize();
+        m_type_index.Finalize();
+        m_namespace_index.Finalize();
+    }
+}
+
 bool
 SymbolFileDWARF::NamespaceDeclMatchesThisSymbolFile (const ClangNamespaceDecl *namespace_decl)
 {
@@ -3430,8 +4172,7 @@ SymbolFileDWARF::FindGlobalVariables (const ConstString &name, const lldb_privat
     else
     {
         // Index the DWARF if we haven't already
-        if (!m_indexed)
-            Index ();
+        IndexNameIfNeeded (name, DWARFGdbIndex::SymbolKindMask (DWARFGdbIndex::eSymbolKindVariable));
 
         m_global_index.Find (name, die_offsets);
     }
@@ -3489,6 +4230,16 @@ SymbolFileDWARF::FindGlobalVariables (const ConstString &name, const lldb_privat
         }
     }
 
+    ForEachDwoSymbolFileForName (name,
+                                 DWARFGdbIndex::SymbolKindMask (DWARFGdbIndex::eSymbolKindVariable),
+                                 [&](SymbolFileDWARFDwo *dwo_symbol_file) -> bool {
+        const uint32_t num_found = variables.GetSize() - original_size;
+        if (num_found >= max_matches)
+            return false;
+        dwo_symbol_file->FindGlobalVariables (name, namespace_decl, true, max_matches - num_found, variables);
+        return true;
+    });
+
     // Return the number of variable that were appended to the list
     const uint32_t num_matches = variables.GetSize() - original_size;
     if (log && num_matches > 0)
@@ -3583,6 +4334,14 @@ SymbolFileDWARF::FindGlobalVariables(const RegularExpression& regex, bool append
         }
     }
 
+    ForEachDwoSymbolFile ([&](SymbolFileDWARFDwo *dwo_symbol_file) -> bool {
+        const uint32_t num_found = variables.GetSize() - original_size;
+        if (num_found >= max_matches)
+            return false;
+        dwo_symbol_file->FindGlobalVariables (regex, true, max_matches - num_found, variables);
+        return true;
+    });
+
     // Return the number of variable that were appended to the list
     return variables.GetSize() - original_size;
 }
@@ -4032,9 +4791,12 @@ SymbolFileDWARF::FindFunctions (const ConstString &name,
     else
     {
 
-        // Index the DWARF if we haven't already
-        if (!m_indexed)
+        // Index the DWARF if we haven't already. Objective C selectors
+        // aren't in the .gdb_index so we need everything indexed for them.
+        if (name_type_mask & eFunctionNameTypeSelector)
             Index ();
+        else
+            IndexNameIfNeeded (name, DWARFGdbIndex::SymbolKindMask (DWARFGdbIndex::eSymbolKindFunction));
 
         if (name_type_mask & eFunctionNameTypeFull)
         {
@@ -4134,6 +4896,13 @@ SymbolFileDWARF::FindFunctions (const ConstString &name,
         
     }
 
+    ForEachDwoSymbolFileForName (name,
+                                 DWARFGdbIndex::SymbolKindMask (DWARFGdbIndex::eSymbolKindFunction),
+                                 [&](SymbolFileDWARFDwo *dwo_symbol_file) -> bool {
+        dwo_symbol_file->FindFunctions (name, namespace_decl, name_type_mask, include_inlines, true, sc_list);
+        return true;
+    });
+
     // Return the number of variable that were appended to the list
     const uint32_t num_matches = sc_list.GetSize() - original_size;
     
@@ -4192,6 +4961,11 @@ SymbolFileDWARF::FindFunctions(const RegularExpression& regex, bool include_inli
         FindFunctions (regex, m_function_fullname_index, include_inlines, sc_list);
     }
 
+    ForEachDwoSymbolFile ([&](SymbolFileDWARFDwo *dwo_symbol_file) -> bool {
+        dwo_symbol_file->FindFunctions (regex, include_inlines, true, sc_list);
+        return true;
+    });
+
     // Return the number of variable that were appended to the list
     return sc_list.GetSize() - original_size;
 }
@@ -4245,17 +5019,16 @@ SymbolFileDWARF::FindTypes (const SymbolContext& sc,
     }
     else
     {
-        if (!m_indexed)
-            Index ();
+        IndexNameIfNeeded (name, DWARFGdbIndex::SymbolKindMask (DWARFGdbIndex::eSymbolKindType));
 
         m_type_index.Find (name, die_offsets);
     }
 
+    const uint32_t initial_types_size = types.GetSize();
     const size_t num_die_matches = die_offsets.size();
 
     if (num_die_matches)
     {
-        const uint32_t initial_types_size = types.GetSize();
         DWARFCompileUnit* dwarf_cu = NULL;
         const DWARFDebugInfoEntry* die = NULL;
         DWARFDebugInfo* debug_info = DebugInfo();
@@ -4274,7 +5047,7 @@ SymbolFileDWARF::FindTypes (const SymbolContext& sc,
                 {
                     // We found a type pointer, now find the shared pointer form our type list
                     types.InsertUnique (matching_type->shared_from_this());
-                    if (types.GetSize() >= max_matches)
+                    if (types.GetSize() - initial_types_size >= max_matches)
                         break;
                 }
             }
@@ -4288,31 +5061,41 @@ SymbolFileDWARF::FindTypes (const SymbolContext& sc,
             }            
 
         }
-        const uint32_t num_matches = types.GetSize() - initial_types_size;
-        if (log && num_matches)
+    }
+
+    ForEachDwoSymbolFileForName (name,
+                                 DWARFGdbIndex::SymbolKindMask (DWARFGdbIndex::eSymbolKindType),
+                                 [&](SymbolFileDWARFDwo *dwo_symbol_file) -> bool {
+        const uint32_t num_found = types.GetSize() - initial_types_size;
+        if (num_found >= max_matches)
+            return false;
+        dwo_symbol_file->FindTypes (sc, name, namespace_decl, true, max_matches - num_found, types);
+        return true;
+    });
+
+    const uint32_t num_matches = types.GetSize() - initial_types_size;
+    if (log && num_matches)
+    {
+        if (namespace_decl)
         {
-            if (namespace_decl)
-            {
-                GetObjectFile()->GetModule()->LogMessage (log,
-                                                          "SymbolFileDWARF::FindTypes (sc, name=\"%s\", clang::NamespaceDecl(%p) \"%s\", append=%u, max_matches=%u, type_list) => %u", 
-                                                          name.GetCString(),
-                                                          static_cast<void*>(namespace_decl->GetNamespaceDecl()),
-                                                          namespace_decl->GetQualifiedName().c_str(),
-                                                          append, max_matches,
-                                                          num_matches);
-            }
-            else
-            {
-                GetObjectFile()->GetModule()->LogMessage (log,
-                                                          "SymbolFileDWARF::FindTypes (sc, name=\"%s\", clang::NamespaceDecl(NULL), append=%u, max_matches=%u, type_list) => %u",
-                                                          name.GetCString(), 
-                                                          append, max_matches,
-                                                          num_matches);
-            }
+            GetObjectFile()->GetModule()->LogMessage (log,
+                                                      "SymbolFileDWARF::FindTypes (sc, name=\"%s\", clang::NamespaceDecl(%p) \"%s\", append=%u, max_matches=%u, type_list) => %u", 
+                                                      name.GetCString(),
+                                                      static_cast<void*>(namespace_decl->GetNamespaceDecl()),
+                                                      namespace_decl->GetQualifiedName().c_str(),
+                                                      append, max_matches,
+                                                      num_matches);
+        }
+        else
+        {
+            GetObjectFile()->GetModule()->LogMessage (log,
+                                                      "SymbolFileDWARF::FindTypes (sc, name=\"%s\", clang::NamespaceDecl(NULL), append=%u, max_matches=%u, type_list) => %u",
+                                                      name.GetCString(), 
+                                                      append, max_matches,
+                                                      num_matches);
         }
-        return num_matches;
     }
-    return 0;
+    return num_matches;
 }
 
 
@@ -4351,8 +5134,8 @@ SymbolFileDWARF::FindNamespace (const SymbolContext& sc,
         }
         else
         {
-            if (!m_indexed)
-                Index ();
+            IndexNameIfNeeded (name, DWARFGdbIndex::SymbolKindMask (DWARFGdbIndex::eSymbolKindType) |
+                                     DWARFGdbIndex::SymbolKindMask (DWARFGdbIndex::eSymbolKindOther));
 
             m_namespace_index.Find (name, die_offsets);
         }
@@ -4393,6 +5176,18 @@ SymbolFileDWARF::FindNamespace (const SymbolContext& sc,
             }
         }
     }
+
+    if (!namespace_decl.GetNamespaceDecl())
+    {
+        ForEachDwoSymbolFileForName (name,
+                                     DWARFGdbIndex::SymbolKindMask (DWARFGdbIndex::eSymbolKindType) |
+                                     DWARFGdbIndex::SymbolKindMask (DWARFGdbIndex::eSymbolKindOther),
+                                     [&](SymbolFileDWARFDwo *dwo_symbol_file) -> bool {
+            namespace_decl = dwo_symbol_file->FindNamespace (sc, name, parent_namespace_decl);
+            return !namespace_decl.GetNamespaceDecl();
+        });
+    }
+
     if (log && namespace_decl.GetNamespaceDecl())
     {
         GetObjectFile()->GetModule()->LogMessage (log,
@@ -5332,8 +6127,7 @@ SymbolFileDWARF::FindDefinitionTypeForDWARFDeclContext (const DWARFDeclContext &
             }
             else
             {
-                if (!m_indexed)
-                    Index ();
+                IndexNameIfNeeded (type_name, DWARFGdbIndex::SymbolKindMask (DWARFGdbIndex::eSymbolKindType));
                 
                 m_type_index.Find (type_name, die_offsets);
             }
@@ -6230,6 +7024,13 @@ SymbolFileDWARF::ParseType (const SymbolContext& sc, DWARFCompileUnit* dwarf_cu,
                             type_sp = m_debug_map_symfile->FindDefinitionTypeForDWARFDeclContext (die_decl_ctx);
                         }
 
+                        if (!type_sp && GetBaseSymbolFile ())
+                        {
+                            // The definition is usually in the .dwo file of
+                            // another compile unit
+                            type_sp = GetBaseSymbolFile ()->FindDefinitionTypeInDwoSymbolFiles (this, die_decl_ctx);
+                        }
+
                         if (type_sp)
                         {
                             if (log)
@@ -7229,6 +8030,9 @@ size_t
 SymbolFileDWARF::ParseFunctionBlocks (const SymbolContext &sc)
 {
     assert(sc.comp_unit && sc.function);
+    SymbolFileDWARFDwo *dwo_symbol_file = GetDwoSymbolFile (sc.comp_unit);
+    if (dwo_symbol_file)
+        return dwo_symbol_file->ParseFunctionBlocks (sc);
     size_t functions_added = 0;
     DWARFCompileUnit* dwarf_cu = GetDWARFCompileUnit(sc.comp_unit);
     if (dwarf_cu)
@@ -7250,6 +8054,9 @@ SymbolFileDWARF::ParseTypes (const SymbolContext &sc)
 {
     // At least a compile unit must be valid
     assert(sc.comp_unit);
+    SymbolFileDWARFDwo *dwo_symbol_file = GetDwoSymbolFile (sc.comp_unit);
+    if (dwo_symbol_file)
+        return dwo_symbol_file->ParseTypes (sc);
     size_t types_added = 0;
     DWARFCompileUnit* dwarf_cu = GetDWARFCompileUnit(sc.comp_unit);
     if (dwarf_cu)
@@ -7281,6 +8088,10 @@ SymbolFileDWARF::ParseVariablesForContext (const SymbolContext& sc)
 {
     if (sc.comp_unit != NULL)
     {
+        SymbolFileDWARFDwo *dwo_symbol_file = GetDwoSymbolFile (sc.comp_unit);
+        if (dwo_symbol_file)
+            return dwo_symbol_file->ParseVariablesForContext (sc);
+
         DWARFDebugInfo* info = DebugInfo();
         if (info == NULL)
             return 0;
@@ -7306,7 +8117,7 @@ SymbolFileDWARF::ParseVariablesForContext (const SymbolContext& sc)
         }
         else if (sc.comp_unit)
         {
-            DWARFCompileUnit* dwarf_cu = info->GetCompileUnit(sc.comp_unit->GetID()).get();
+            DWARFCompileUnit* dwarf_cu = GetDWARFCompileUnit(sc.comp_unit);
 
             if (dwarf_cu == NULL)
                 return 0;
@@ -7339,8 +8150,7 @@ SymbolFileDWARF::ParseVariablesForContext (const SymbolContext& sc)
                 {
                     // Index if we already haven't to make sure the compile units
                     // get indexed and make their global DIE index list
-                    if (!m_indexed)
-                        Index ();
+                    IndexCompileUnitIfNeeded (dwarf_cu);
 
                     m_global_index.FindAllEntriesForCompileUnit (dwarf_cu->GetOffset(), 
                                                                  dwarf_cu->GetNextCompileUnitOffset(), 
@@ -7382,6 +8192,46 @@ SymbolFileDWARF::ParseVariablesForContext (const SymbolContext& sc)
 }
 
 
+//----------------------------------------------------------------------
+// The locations of globals in .dwo files use DW_OP_GNU_addr_index to
+// refer to their address in the skeleton's .debug_addr section. Rewrite
+// such a location to start with a DW_OP_addr, which is what the rest of
+// LLDB looks for when it links and slides global variables.
+//----------------------------------------------------------------------
+static bool
+CopyAddrIndexOpcodeData (DWARFExpression &location,
+                         const DWARFCompileUnit *dwarf_cu,
+                         const DWARFDataExtractor &data,
+                         lldb::offset_t block_offset,
+                         lldb::offset_t block_length)
+{
+    if (block_length == 0 || !data.ValidOffsetForDataOfSize (block_offset, block_length))
+        return false;
+    lldb::offset_t offset = block_offset;
+    const uint8_t op = data.GetU8 (&offset);
+    if (op != DW_OP_GNU_addr_index && op != DW_OP_GNU_const_index)
+        return false;
+    const dw_addr_t addr = dwarf_cu->ReadAddressFromDebugAddrSection (data.GetULEB128 (&offset));
+    if (addr == LLDB_INVALID_ADDRESS)
+        return false;
+
+    const uint32_t addr_size = dwarf_cu->GetAddressByteSize();
+    const ByteOrder byte_order = data.GetByteOrder();
+    StreamString strm (Stream::eBinary, addr_size, byte_order);
+    if (op == DW_OP_GNU_addr_index)
+        strm.PutHex8 (DW_OP_addr);
+    else if (addr_size == 8)
+        strm.PutHex8 (DW_OP_const8u);
+    else
+        strm.PutHex8 (DW_OP_const4u);
+    strm.PutMaxHex64 (addr, addr_size, byte_order);
+    const lldb::offset_t block_end = block_offset + block_length;
+    if (offset < block_end)
+        strm.Write (data.PeekData (offset, block_end - offset), block_end - offset);
+    location.CopyOpcodeData (strm.GetData(), strm.GetSize(), byte_order, addr_size);
+    return true;
+}
+
 VariableSP
 SymbolFileDWARF::ParseVariableDIE
 (
@@ -7502,7 +8352,8 @@ SymbolFileDWARF::ParseVariableDIE
 
                                 uint32_t block_offset = form_value.BlockData() - debug_info_data.GetDataStart();
                                 uint32_t block_length = form_value.Unsigned();
-                                location.CopyOpcodeData(module, get_debug_info_data(), block_offset, block_length);
+                                if (!CopyAddrIndexOpcodeData (location, attributes.CompileUnitAtIndex(i), debug_info_data, block_offset, block_length))
+                                    location.CopyOpcodeData(module, get_debug_info_data(), block_offset, block_length);
                             }
                             else
                             {
@@ -7970,6 +8821,66 @@ SymbolFileDWARF::CompleteObjCInterfaceDecl (void *baton, clang::ObjCInterfaceDec
         symbol_file_dwarf->ResolveClangOpaqueTypeDefinition (clang_type);
 }
 
+size_t
+SymbolFileDWARF::EstimateNumDIEs (size_t debug_info_size) const
+{
+    // Until a compile unit has been extracted assume 16 bytes per DIE,
+    // which is on the small side for C++, so we rarely need to grow
+    uint64_t die_bytes = m_extracted_die_bytes;
+    uint64_t die_count = m_extracted_die_count;
+    if (die_count == 0)
+    {
+        die_bytes = 16;
+        die_count = 1;
+    }
+    return (size_t)(debug_info_size * die_count / die_bytes) + 1;
+}
+
+void
+SymbolFileDWARF::AddExtractedDIEs (size_t debug_info_size, size_t num_dies)
+{
+    if (num_dies == 0)
+        return;
+    m_extracted_die_bytes += debug_info_size;
+    m_extracted_die_count += num_dies;
+}
+
+bool
+SymbolFileDWARF::KeepDIEsAfterIndexing ()
+{
+    return GetGlobalPluginProperties()->GetKeepIndexedDIEs();
+}
+
+void
+SymbolFileDWARF::Dump (lldb_private::Stream &s)
+{
+    DWARFDebugInfo* debug_info = DebugInfo();
+    if (debug_info == NULL)
+        return;
+
+    size_t num_dies = 0;
+    size_t num_extracted_cus = 0;
+    size_t num_bytes = debug_info->GetDIEMemoryUsage (num_dies, num_extracted_cus);
+    ForEachLoadedDwoSymbolFile ([&num_dies, &num_bytes](SymbolFileDWARFDwo *dwo_symbol_file) -> bool {
+        DWARFDebugInfo* dwo_debug_info = dwo_symbol_file->DebugInfo();
+        if (dwo_debug_info)
+        {
+            size_t dwo_num_dies = 0;
+            size_t dwo_num_extracted_cus = 0;
+            num_bytes += dwo_debug_info->GetDIEMemoryUsage (dwo_num_dies, dwo_num_extracted_cus);
+            num_dies += dwo_num_dies;
+        }
+        return true;
+    });
+
+    s.Indent();
+    s.Printf ("DWARF DIEs: %" PRIu64 " DIEs using %" PRIu64 " bytes, %" PRIu64 " of %" PRIu64 " compile units extracted\n",
+              (uint64_t)num_dies,
+              (uint64_t)num_bytes,
+              (uint64_t)num_extracted_cus,
+              (uint64_t)debug_info->GetNumCompileUnits());
+}
+
 void
 SymbolFileDWARF::DumpIndexes ()
 {
@@ -7996,7 +8907,13 @@ SymbolFileDWARF::SearchDeclContext (const clang::DeclContext *decl_context,
     DeclContextToDIEMap::iterator iter = m_decl_ctx_to_die.find(decl_context);
     
     if (iter == m_decl_ctx_to_die.end())
+    {
+        ForEachLoadedDwoSymbolFile ([decl_context, name, results](SymbolFileDWARFDwo *dwo_symbol_file) -> bool {
+            dwo_symbol_file->SearchDeclContext (decl_context, name, results);
+            return true;
+        });
         return;
+    }
     
     for (DIEPointerSet::iterator pos = iter->second.begin(), end = iter->second.end(); pos != end; ++pos)
     {
@@ -8019,8 +8936,7 @@ SymbolFileDWARF::SearchDeclContext (const clang::DeclContext *decl_context,
         }
         else
         {
-            if (!m_indexed)
-                Index ();
+            IndexNameIfNeeded (ConstString(name), DWARFGdbIndex::SymbolKindMask (DWARFGdbIndex::eSymbolKindType));
             
             m_type_index.Find (ConstString(name), die_offsets);
         }
@@ -8114,6 +9030,12 @@ SymbolFileDWARF::LayoutRecordType(const clang::RecordDecl *record_decl, uint64_t
         bit_size = 0;
         alignment = 0;
         field_offsets.clear();
+        ForEachLoadedDwoSymbolFile ([&](SymbolFileDWARFDwo *dwo_symbol_file) -> bool {
+            success = dwo_symbol_file->LayoutRecordType (record_decl, bit_size, alignment, field_offsets, base_offsets, vbase_offsets);
+            return !success;
+        });
+        if (success)
+            return true;
     }
     
     if (log)
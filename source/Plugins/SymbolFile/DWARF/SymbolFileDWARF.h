@@ -12,6 +12,8 @@
 
 // C Includes
 // C++ Includes
+#include <atomic>
+#include <functional>
 #include <list>
 #include <map>
 #include <set>
@@ -31,6 +33,7 @@
 #include "lldb/Core/Flags.h"
 #include "lldb/Core/RangeMap.h"
 #include "lldb/Core/UniqueCStringMap.h"
+#include "lldb/Host/Mutex.h"
 #include "lldb/Symbol/ClangASTContext.h"
 #include "lldb/Symbol/SymbolFile.h"
 #include "lldb/Symbol/SymbolContext.h"
@@ -58,13 +61,17 @@ class DWARFDebugPubnames;
 class DWARFDebugRanges;
 class DWARFDeclContext;
 class DWARFDIECollection;
+class DWARFGdbIndex;
 class DWARFFormValue;
 class SymbolFileDWARFDebugMap;
+class SymbolFileDWARFDwo;
+class SymbolFileDWARFDwp;
 
 class SymbolFileDWARF : public lldb_private::SymbolFile, public lldb_private::UserID
 {
 public:
     friend class SymbolFileDWARFDebugMap;
+    friend class SymbolFileDWARFDwo;
     friend class DebugMapModule;
     friend class DWARFCompileUnit;
     //------------------------------------------------------------------
@@ -76,6 +83,9 @@ public:
     static void
     Terminate();
 
+    static void
+    DebuggerInitialize (lldb_private::Debugger &debugger);
+
     static lldb_private::ConstString
     GetPluginNameStatic();
 
@@ -92,6 +102,7 @@ public:
 
     virtual uint32_t        CalculateAbilities ();
     virtual void            InitializeObject();
+    virtual void            Dump (lldb_private::Stream &s);
 
     //------------------------------------------------------------------
     // Compile Unit function calls
@@ -195,6 +206,7 @@ public:
     //virtual CompUnitSP    GetCompUnitAtIndex(size_t cu_idx) = 0;
 
     const lldb_private::DWARFDataExtractor&     get_debug_abbrev_data ();
+    virtual const lldb_private::DWARFDataExtractor& get_debug_addr_data ();
     const lldb_private::DWARFDataExtractor&     get_debug_aranges_data ();
     const lldb_private::DWARFDataExtractor&     get_debug_frame_data ();
     const lldb_private::DWARFDataExtractor&     get_debug_info_data ();
@@ -202,6 +214,7 @@ public:
     const lldb_private::DWARFDataExtractor&     get_debug_loc_data ();
     const lldb_private::DWARFDataExtractor&     get_debug_ranges_data ();
     const lldb_private::DWARFDataExtractor&     get_debug_str_data ();
+    const lldb_private::DWARFDataExtractor&     get_debug_str_offsets_data ();
     const lldb_private::DWARFDataExtractor&     get_apple_names_data ();
     const lldb_private::DWARFDataExtractor&     get_apple_types_data ();
     const lldb_private::DWARFDataExtractor&     get_apple_namespaces_data ();
@@ -214,14 +227,32 @@ public:
     DWARFDebugInfo*         DebugInfo();
     const DWARFDebugInfo*   DebugInfo() const;
 
-    DWARFDebugRanges*       DebugRanges();
-    const DWARFDebugRanges* DebugRanges() const;
+    virtual DWARFDebugRanges*       DebugRanges();
+    virtual const DWARFDebugRanges* DebugRanges() const;
 
     const lldb_private::DWARFDataExtractor&
     GetCachedSectionData (uint32_t got_flag, 
                           lldb::SectionType sect_type, 
                           lldb_private::DWARFDataExtractor &data);
 
+    void
+    PrefetchCompressedSectionData ();
+
+    //------------------------------------------------------------------
+    /// Open the .dwo symbol file of a split DWARF skeleton compile unit.
+    ///
+    /// The DIEs are looked for in the .dwp package next to the module
+    /// first, then in the file named by DW_AT_GNU_dwo_name relative to
+    /// the compilation directory and finally next to the module.
+    //------------------------------------------------------------------
+    std::unique_ptr<SymbolFileDWARFDwo>
+    LoadDwoSymbolFile (DWARFCompileUnit &dwarf_cu, const DWARFDebugInfoEntry &cu_die);
+
+    // Returns the .dwo symbol file that has the DIEs for a compile unit
+    // of this symbol file, or NULL if the compile unit isn't split.
+    SymbolFileDWARFDwo *
+    GetDwoSymbolFile (lldb_private::CompileUnit *comp_unit);
+
     static bool
     SupportedVersion(uint16_t version);
 
@@ -290,8 +321,61 @@ protected:
         flagsGotAppleNamesData      = (1 << 11),
         flagsGotAppleTypesData      = (1 << 12),
         flagsGotAppleNamespacesData = (1 << 13),
-        flagsGotAppleObjCData       = (1 << 14)
+        flagsGotAppleObjCData       = (1 << 14),
+        flagsGotDebugAddrData       = (1 << 15),
+        flagsGotDebugStrOffsetsData = (1 << 16)
     };
+
+    // The sections the DWARF is read from. A .dwo file must not merge
+    // its sections into the module.
+    virtual const lldb_private::SectionList *
+    GetDWARFSectionList ();
+
+    virtual void
+    LoadSectionData (lldb::SectionType sect_type, lldb_private::DWARFDataExtractor& data);
+
+    // The kind of the index cache file for this symbol file
+    virtual std::string
+    GetIndexCacheKind ();
+
+    // Looks up the symbol file for a user ID made by a .dwo symbol file
+    SymbolFileDWARF *
+    GetDwoSymbolFileForUserID (lldb::user_id_t uid);
+
+    bool
+    HasSplitCompileUnits ();
+
+    // Calls "closure" for each .dwo symbol file that was opened so far
+    // until it returns false.
+    void
+    ForEachLoadedDwoSymbolFile (std::function<bool (SymbolFileDWARFDwo *)> closure);
+
+    // Calls "closure" for each .dwo symbol file that can have DIEs for
+    // "name", opening them as needed. With a .gdb_index only the .dwo
+    // files of the compile units that define "name" are opened.
+    void
+    ForEachDwoSymbolFileForName (const lldb_private::ConstString &name,
+                                 uint32_t gdb_index_kind_mask,
+                                 std::function<bool (SymbolFileDWARFDwo *)> closure);
+
+    void
+    ForEachDwoSymbolFile (std::function<bool (SymbolFileDWARFDwo *)> closure);
+
+    // Looks for the definition of a type that a .dwo symbol file only
+    // has a declaration for in the other .dwo symbol files.
+    lldb::TypeSP
+    FindDefinitionTypeInDwoSymbolFiles (SymbolFileDWARF *skip_dwarf_dwo,
+                                        const DWARFDeclContext &die_decl_ctx);
+
+    // Returns the symbol file a .dwo symbol file belongs to, or NULL
+    virtual SymbolFileDWARF *
+    GetBaseSymbolFile ()
+    {
+        return NULL;
+    }
+
+    SymbolFileDWARFDwp *
+    GetDwpSymbolFile ();
     
     bool                    NamespaceDeclMatchesThisSymbolFile (const lldb_private::ClangNamespaceDecl *namespace_decl);
 
@@ -301,9 +385,9 @@ protected:
 
     DISALLOW_COPY_AND_ASSIGN (SymbolFileDWARF);
     lldb::CompUnitSP        ParseCompileUnit (DWARFCompileUnit* dwarf_cu, uint32_t cu_idx);
-    DWARFCompileUnit*       GetDWARFCompileUnit(lldb_private::CompileUnit *comp_unit);
+    virtual DWARFCompileUnit*       GetDWARFCompileUnit(lldb_private::CompileUnit *comp_unit);
     DWARFCompileUnit*       GetNextUnparsedDWARFCompileUnit(DWARFCompileUnit* prev_cu);
-    lldb_private::CompileUnit*      GetCompUnitForDWARFCompUnit(DWARFCompileUnit* dwarf_cu, uint32_t cu_idx = UINT32_MAX);
+    virtual lldb_private::CompileUnit*      GetCompUnitForDWARFCompUnit(DWARFCompileUnit* dwarf_cu, uint32_t cu_idx = UINT32_MAX);
     bool                    GetFunction (DWARFCompileUnit* dwarf_cu, const DWARFDebugInfoEntry* func_die, lldb_private::SymbolContext& sc);
     lldb_private::Function *        ParseCompileUnitFunction (const lldb_private::SymbolContext& sc, DWARFCompileUnit* dwarf_cu, const DWARFDebugInfoEntry *die);
     size_t                  ParseFunctionBlocks (const lldb_private::SymbolContext& sc,
@@ -444,9 +528,33 @@ protected:
     uint32_t                FindTypes(std::vector<dw_offset_t> die_offsets, uint32_t max_matches, lldb_private::TypeList& types);
 
     void                    Index();
+
+    void                    IndexParallel (DWARFDebugInfo* debug_info,
+                                           uint32_t num_compile_units,
+                                           uint32_t num_threads);
+
+    // Make sure the name indexes contain all DIEs for "name". With a
+    // .gdb_index only the compile units that define the name get
+    // indexed, otherwise this does a full Index().
+    void                    IndexNameIfNeeded (const lldb_private::ConstString &name,
+                                               uint32_t gdb_index_kind_mask);
+
+    void                    IndexCompileUnitIfNeeded (DWARFCompileUnit *dwarf_cu);
+
+    void                    IndexCompileUnits (const std::vector<uint32_t> &cu_indexes);
     
     void                    DumpIndexes();
 
+    // Guess how many DIEs, not counting NULL DIEs, a compile unit with
+    // "debug_info_size" bytes of .debug_info holds, from the compile units
+    // extracted so far.
+    size_t                  EstimateNumDIEs (size_t debug_info_size) const;
+
+    void                    AddExtractedDIEs (size_t debug_info_size, size_t num_dies);
+
+    // True if indexing should leave the DIEs it extracts in memory
+    static bool             KeepDIEsAfterIndexing ();
+
     void                    SetDebugMapModule (const lldb::ModuleSP &module_sp)
                             {
                                 m_debug_map_module_wp = module_sp;
@@ -469,7 +577,7 @@ protected:
     clang::NamespaceDecl *
     ResolveNamespaceDIE (DWARFCompileUnit *curr_cu, const DWARFDebugInfoEntry *die);
     
-    UniqueDWARFASTTypeMap &
+    virtual UniqueDWARFASTTypeMap &
     GetUniqueDWARFASTTypeMap ();
 
     void                    LinkDeclContextToDIE (clang::DeclContext *decl_ctx,
@@ -578,6 +686,7 @@ protected:
     lldb_private::Flags                   m_flags;
     lldb_private::DWARFDataExtractor      m_dwarf_data; 
     lldb_private::DWARFDataExtractor      m_data_debug_abbrev;
+    lldb_private::DWARFDataExtractor      m_data_debug_addr;
     lldb_private::DWARFDataExtractor      m_data_debug_aranges;
     lldb_private::DWARFDataExtractor      m_data_debug_frame;
     lldb_private::DWARFDataExtractor      m_data_debug_info;
@@ -585,6 +694,7 @@ protected:
     lldb_private::DWARFDataExtractor      m_data_debug_loc;
     lldb_private::DWARFDataExtractor      m_data_debug_ranges;
     lldb_private::DWARFDataExtractor      m_data_debug_str;
+    lldb_private::DWARFDataExtractor      m_data_debug_str_offsets;
     lldb_private::DWARFDataExtractor      m_data_apple_names;
     lldb_private::DWARFDataExtractor      m_data_apple_types;
     lldb_private::DWARFDataExtractor      m_data_apple_namespaces;
@@ -599,6 +709,7 @@ protected:
     std::unique_ptr<DWARFMappedHash::MemoryTable> m_apple_types_ap;
     std::unique_ptr<DWARFMappedHash::MemoryTable> m_apple_namespaces_ap;
     std::unique_ptr<DWARFMappedHash::MemoryTable> m_apple_objc_ap;
+    std::unique_ptr<DWARFGdbIndex>      m_gdb_index_ap;
     std::unique_ptr<GlobalVariableMap>  m_global_aranges_ap;
     ExternalTypeModuleMap               m_external_type_modules;
     NameToDIE                           m_function_basename_index;  // All concrete functions
@@ -609,11 +720,19 @@ protected:
     NameToDIE                           m_global_index;             // Global and static variables
     NameToDIE                           m_type_index;               // All type DIE offsets
     NameToDIE                           m_namespace_index;          // All type DIE offsets
+    std::vector<bool>                   m_gdb_indexed_cus;          // Compile units indexed through the .gdb_index
+    std::unique_ptr<SymbolFileDWARFDwp> m_dwp_symfile_ap;
+    lldb_private::Mutex                 m_dwo_mutex;                // Protects the .dwp and the loaded .dwo list
+    std::vector<SymbolFileDWARFDwo *>   m_loaded_dwo_symfiles;      // Owned by their skeleton compile units
+    lldb_private::LazyBool              m_has_split_compile_units;
+    bool                                m_loaded_dwp_symfile;       // Protected by m_dwo_mutex
     bool                                m_indexed:1,
                                         m_is_external_ast_source:1,
                                         m_using_apple_tables:1,
                                         m_fetched_external_modules:1;
     lldb_private::LazyBool              m_supports_DW_AT_APPLE_objc_complete_type;
+    std::atomic<uint64_t>               m_extracted_die_bytes;      // Bytes of .debug_info in all DIE extractions so far
+    std::atomic<uint64_t>               m_extracted_die_count;      // DIEs found in all DIE extractions so far
 
     std::unique_ptr<DWARFDebugRanges>     m_ranges;
     UniqueDWARFASTTypeMap m_unique_ast_type_map;
@@ -0,0 +1,145 @@
+//===-- SymbolFileDWARFDwo.cpp ----------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "SymbolFileDWARFDwo.h"
+
+#include "lldb/Core/Section.h"
+#include "lldb/Core/StreamString.h"
+#include "lldb/Symbol/ObjectFile.h"
+
+#include "DWARFCompileUnit.h"
+#include "DWARFDebugInfo.h"
+
+using namespace lldb;
+using namespace lldb_private;
+
+SymbolFileDWARFDwo::SymbolFileDWARFDwo (ObjectFileSP objfile, DWARFCompileUnit *dwarf_cu) :
+    SymbolFileDWARF (objfile.get()),
+    m_obj_file_sp (objfile),
+    m_base_dwarf_cu (dwarf_cu),
+    m_initialized_cu (false)
+{
+    // The DIE offsets of all .dwo files overlap, so make user IDs that
+    // tell the main symbol file which skeleton compile unit they are for.
+    uint32_t cu_idx = UINT32_MAX;
+    DWARFDebugInfo *base_debug_info = dwarf_cu->GetSymbolFileDWARF()->DebugInfo();
+    if (base_debug_info)
+        base_debug_info->GetCompileUnit (dwarf_cu->GetOffset(), &cu_idx);
+    if (cu_idx != UINT32_MAX)
+        SetID (((lldb::user_id_t)cu_idx + 1) << 32);
+}
+
+SymbolFileDWARFDwo::~SymbolFileDWARFDwo ()
+{
+}
+
+DWARFCompileUnit *
+SymbolFileDWARFDwo::GetCompileUnit ()
+{
+    DWARFDebugInfo *debug_info = DebugInfo();
+    if (debug_info == NULL || debug_info->GetNumCompileUnits() != 1)
+        return NULL;
+
+    DWARFCompileUnit *dwarf_cu = debug_info->GetCompileUnitAtIndex (0);
+    if (dwarf_cu && !m_initialized_cu)
+    {
+        m_initialized_cu = true;
+        // The .dwo compile unit has no address attributes of its own. It
+        // must know where its skeleton's entries in .debug_addr and
+        // .debug_ranges start before any of its DIEs are extracted.
+        SymbolFileDWARF *base_symfile = GetBaseSymbolFile();
+        const DWARFDebugInfoEntry *base_cu_die = m_base_dwarf_cu->GetCompileUnitDIEOnly();
+        dw_offset_t ranges_base = 0;
+        if (base_cu_die)
+            ranges_base = base_cu_die->GetAttributeValueAsUnsigned (base_symfile, m_base_dwarf_cu, DW_AT_GNU_ranges_base, 0);
+        dwarf_cu->SetAddrBase (m_base_dwarf_cu->GetAddrBase(), ranges_base, m_base_dwarf_cu->GetBaseAddress());
+    }
+    return dwarf_cu;
+}
+
+SymbolFileDWARF *
+SymbolFileDWARFDwo::GetBaseSymbolFile ()
+{
+    return m_base_dwarf_cu->GetSymbolFileDWARF();
+}
+
+const DWARFDataExtractor&
+SymbolFileDWARFDwo::get_debug_addr_data ()
+{
+    // The address table is in the main file, indexed from the skeleton's
+    // DW_AT_GNU_addr_base.
+    return GetBaseSymbolFile()->get_debug_addr_data();
+}
+
+DWARFDebugRanges*
+SymbolFileDWARFDwo::DebugRanges ()
+{
+    return GetBaseSymbolFile()->DebugRanges();
+}
+
+const DWARFDebugRanges*
+SymbolFileDWARFDwo::DebugRanges () const
+{
+    return m_base_dwarf_cu->GetSymbolFileDWARF()->DebugRanges();
+}
+
+TypeList *
+SymbolFileDWARFDwo::GetTypeList ()
+{
+    return GetBaseSymbolFile()->GetTypeList();
+}
+
+ClangASTContext &
+SymbolFileDWARFDwo::GetClangASTContext ()
+{
+    // Share the main symbol file's AST and its external AST source so
+    // types from all .dwo files can be completed through it.
+    return GetBaseSymbolFile()->GetClangASTContext();
+}
+
+const SectionList *
+SymbolFileDWARFDwo::GetDWARFSectionList ()
+{
+    // Don't merge the .dwo sections into the sections of the module
+    return m_obj_file->GetSectionList (false);
+}
+
+std::string
+SymbolFileDWARFDwo::GetIndexCacheKind ()
+{
+    StreamString strm;
+    strm.Printf ("dwo-%16.16" PRIx64, m_base_dwarf_cu->GetDWOId());
+    return strm.GetString();
+}
+
+DWARFCompileUnit *
+SymbolFileDWARFDwo::GetDWARFCompileUnit (CompileUnit *comp_unit)
+{
+    // The skeleton compile unit and the .dwo compile unit share the
+    // same lldb_private::CompileUnit
+    DWARFCompileUnit *dwarf_cu = GetCompileUnit();
+    if (dwarf_cu && dwarf_cu->GetUserData() == NULL)
+        dwarf_cu->SetUserData (comp_unit);
+    return dwarf_cu;
+}
+
+CompileUnit *
+SymbolFileDWARFDwo::GetCompUnitForDWARFCompUnit (DWARFCompileUnit *dwarf_cu, uint32_t cu_idx)
+{
+    CompileUnit *comp_unit = GetBaseSymbolFile()->GetCompUnitForDWARFCompUnit (m_base_dwarf_cu, UINT32_MAX);
+    if (comp_unit && dwarf_cu && dwarf_cu->GetUserData() == NULL)
+        dwarf_cu->SetUserData (comp_unit);
+    return comp_unit;
+}
+
+UniqueDWARFASTTypeMap &
+SymbolFileDWARFDwo::GetUniqueDWARFASTTypeMap ()
+{
+    return GetBaseSymbolFile()->GetUniqueDWARFASTTypeMap();
+}
@@ -0,0 +1,79 @@
+//===-- SymbolFileDWARFDwo.h ------------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef SymbolFileDWARF_SymbolFileDWARFDwo_h_
+#define SymbolFileDWARF_SymbolFileDWARFDwo_h_
+
+// C Includes
+// C++ Includes
+// Other libraries and framework includes
+// Project includes
+#include "SymbolFileDWARF.h"
+
+//----------------------------------------------------------------------
+// SymbolFileDWARFDwo
+//
+// The DIEs of a split DWARF compile unit, read from its .dwo file or
+// from its entry in a .dwp package. The skeleton compile unit in the
+// main symbol file owns this symbol file and everything it parses
+// (compile unit, types, AST) goes into the main symbol file's module.
+//----------------------------------------------------------------------
+class SymbolFileDWARFDwo : public SymbolFileDWARF
+{
+public:
+    SymbolFileDWARFDwo (lldb::ObjectFileSP objfile, DWARFCompileUnit *dwarf_cu);
+
+    virtual
+    ~SymbolFileDWARFDwo ();
+
+    // The compile unit in the .dwo file, NULL if it doesn't have exactly
+    // one compile unit.
+    DWARFCompileUnit *
+    GetCompileUnit ();
+
+    virtual SymbolFileDWARF *
+    GetBaseSymbolFile ();
+
+    virtual const lldb_private::DWARFDataExtractor&
+    get_debug_addr_data ();
+
+    virtual DWARFDebugRanges*
+    DebugRanges ();
+
+    virtual const DWARFDebugRanges*
+    DebugRanges () const;
+
+    virtual lldb_private::TypeList *
+    GetTypeList ();
+
+    virtual lldb_private::ClangASTContext &
+    GetClangASTContext ();
+
+protected:
+    virtual const lldb_private::SectionList *
+    GetDWARFSectionList ();
+
+    virtual std::string
+    GetIndexCacheKind ();
+
+    virtual DWARFCompileUnit*
+    GetDWARFCompileUnit (lldb_private::CompileUnit *comp_unit);
+
+    virtual lldb_private::CompileUnit*
+    GetCompUnitForDWARFCompUnit (DWARFCompileUnit* dwarf_cu, uint32_t cu_idx = UINT32_MAX);
+
+    virtual UniqueDWARFASTTypeMap &
+    GetUniqueDWARFASTTypeMap ();
+
+    lldb::ObjectFileSP m_obj_file_sp;   // Keeps the .dwo (or .dwp) object file alive
+    DWARFCompileUnit *m_base_dwarf_cu;
+    bool m_initialized_cu;
+};
+
+#endif  // SymbolFileDWARF_SymbolFileDWARFDwo_h_
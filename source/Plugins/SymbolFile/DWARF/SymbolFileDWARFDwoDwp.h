@@ -0,0 +1,40 @@
+//===-- SymbolFileDWARFDwoDwp.h ---------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef SymbolFileDWARF_SymbolFileDWARFDwoDwp_h_
+#define SymbolFileDWARF_SymbolFileDWARFDwoDwp_h_
+
+// Project includes
+#include "SymbolFileDWARFDwo.h"
+#include "SymbolFileDWARFDwp.h"
+
+//----------------------------------------------------------------------
+// SymbolFileDWARFDwoDwp
+//
+// The DIEs of a split compile unit that are in a .dwp package. The
+// DWARF sections are the compile unit's contributions to the package's
+// sections.
+//----------------------------------------------------------------------
+class SymbolFileDWARFDwoDwp : public SymbolFileDWARFDwo
+{
+public:
+    SymbolFileDWARFDwoDwp (SymbolFileDWARFDwp *dwp_symfile,
+                           lldb::ObjectFileSP objfile,
+                           DWARFCompileUnit *dwarf_cu,
+                           uint64_t dwo_id);
+
+protected:
+    virtual void
+    LoadSectionData (lldb::SectionType sect_type, lldb_private::DWARFDataExtractor& data);
+
+    SymbolFileDWARFDwp *m_dwp_symfile;
+    uint64_t m_dwo_id;
+};
+
+#endif  // SymbolFileDWARF_SymbolFileDWARFDwoDwp_h_
@@ -0,0 +1,219 @@
+//===-- SymbolFileDWARFDwp.cpp ----------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "SymbolFileDWARFDwp.h"
+
+#include "lldb/Core/Module.h"
+#include "lldb/Core/Section.h"
+#include "lldb/Symbol/ObjectFile.h"
+
+#include "SymbolFileDWARFDwoDwp.h"
+
+using namespace lldb;
+using namespace lldb_private;
+
+// The section identifiers used in the columns of .debug_cu_index
+enum DwpSectionKind
+{
+    eDwpSectionInfo         = 1,
+    eDwpSectionTypes        = 2,
+    eDwpSectionAbbrev       = 3,
+    eDwpSectionLine         = 4,
+    eDwpSectionLoc          = 5,
+    eDwpSectionStrOffsets   = 6,
+    eDwpSectionMacInfo      = 7,
+    eDwpSectionMacro        = 8
+};
+
+// The header is the version, the number of columns, the number of units
+// and the number of hash table slots, all 32 bit values.
+static const uint32_t k_cu_index_header_size = 4 * sizeof(uint32_t);
+
+static SectionType
+GetSectionTypeForDwpSectionKind (uint32_t kind)
+{
+    switch (kind)
+    {
+    case eDwpSectionInfo:       return eSectionTypeDWARFDebugInfo;
+    case eDwpSectionAbbrev:     return eSectionTypeDWARFDebugAbbrev;
+    case eDwpSectionLine:       return eSectionTypeDWARFDebugLine;
+    case eDwpSectionLoc:        return eSectionTypeDWARFDebugLoc;
+    case eDwpSectionStrOffsets: return eSectionTypeDWARFDebugStrOffsets;
+    case eDwpSectionMacInfo:    return eSectionTypeDWARFDebugMacInfo;
+    default:
+        break;
+    }
+    return eSectionTypeInvalid;
+}
+
+std::unique_ptr<SymbolFileDWARFDwp>
+SymbolFileDWARFDwp::Create (ModuleSP module_sp, const FileSpec &file_spec)
+{
+    DataBufferSP dwp_file_data_sp;
+    lldb::offset_t dwp_file_data_offset = 0;
+    ObjectFileSP dwp_obj_file = ObjectFile::FindPlugin (module_sp,
+                                                        &file_spec,
+                                                        0,
+                                                        file_spec.GetByteSize(),
+                                                        dwp_file_data_sp,
+                                                        dwp_file_data_offset);
+    if (!dwp_obj_file)
+        return nullptr;
+
+    std::unique_ptr<SymbolFileDWARFDwp> dwp_symfile (new SymbolFileDWARFDwp (dwp_obj_file));
+    if (!dwp_symfile->ExtractCUIndex ())
+    {
+        module_sp->ReportWarning ("ignoring '%s', it has no valid .debug_cu_index section",
+                                  file_spec.GetPath().c_str());
+        return nullptr;
+    }
+    return dwp_symfile;
+}
+
+SymbolFileDWARFDwp::SymbolFileDWARFDwp (ObjectFileSP obj_file) :
+    m_obj_file (obj_file),
+    m_cu_index_data (),
+    m_num_columns (0),
+    m_num_units (0),
+    m_num_slots (0),
+    m_sections_mutex (Mutex::eMutexTypeNormal),
+    m_sections ()
+{
+}
+
+SymbolFileDWARFDwp::~SymbolFileDWARFDwp ()
+{
+}
+
+bool
+SymbolFileDWARFDwp::ExtractCUIndex ()
+{
+    const SectionList *section_list = m_obj_file->GetSectionList (false);
+    if (section_list == NULL)
+        return false;
+    SectionSP section_sp (section_list->FindSectionByName (ConstString (".debug_cu_index")));
+    if (!section_sp || m_obj_file->ReadSectionData (section_sp.get(), m_cu_index_data) == 0)
+        return false;
+
+    if (!m_cu_index_data.ValidOffsetForDataOfSize (0, k_cu_index_header_size))
+        return false;
+    lldb::offset_t offset = 0;
+    const uint32_t version = m_cu_index_data.GetU32 (&offset);
+    // Version 1 packages were only ever made by an experimental tool
+    if (version != 2)
+        return false;
+    m_num_columns = m_cu_index_data.GetU32 (&offset);
+    m_num_units = m_cu_index_data.GetU32 (&offset);
+    m_num_slots = m_cu_index_data.GetU32 (&offset);
+    if (m_num_slots == 0 || (m_num_slots & (m_num_slots - 1)) != 0)
+        return false;
+
+    // The hash table, the parallel row table, the section identifiers and
+    // the offset and size tables must all fit in the section
+    const uint64_t table_size = (uint64_t)m_num_slots * (sizeof(uint64_t) + sizeof(uint32_t)) +
+                                (uint64_t)m_num_columns * sizeof(uint32_t) * (1 + 2 * (uint64_t)m_num_units);
+    return m_cu_index_data.ValidOffsetForDataOfSize (k_cu_index_header_size, table_size);
+}
+
+uint32_t
+SymbolFileDWARFDwp::FindRow (uint64_t dwo_id) const
+{
+    const lldb::offset_t hash_table_offset = k_cu_index_header_size;
+    const lldb::offset_t row_table_offset = hash_table_offset + (lldb::offset_t)m_num_slots * sizeof(uint64_t);
+    const uint64_t slot_mask = m_num_slots - 1;
+    const uint64_t step = ((dwo_id >> 32) & slot_mask) | 1;
+    uint64_t slot = dwo_id & slot_mask;
+    for (uint32_t probe = 0; probe < m_num_slots; ++probe)
+    {
+        lldb::offset_t offset = row_table_offset + slot * sizeof(uint32_t);
+        const uint32_t row = m_cu_index_data.GetU32 (&offset);
+        // Unused slots have a zero row
+        if (row == 0)
+            return 0;
+        offset = hash_table_offset + slot * sizeof(uint64_t);
+        if (m_cu_index_data.GetU64 (&offset) == dwo_id)
+            return row <= m_num_units ? row : 0;
+        slot = (slot + step) & slot_mask;
+    }
+    return 0;
+}
+
+uint32_t
+SymbolFileDWARFDwp::FindColumn (SectionType sect_type) const
+{
+    lldb::offset_t offset = k_cu_index_header_size + (lldb::offset_t)m_num_slots * (sizeof(uint64_t) + sizeof(uint32_t));
+    for (uint32_t column = 0; column < m_num_columns; ++column)
+    {
+        if (GetSectionTypeForDwpSectionKind (m_cu_index_data.GetU32 (&offset)) == sect_type)
+            return column;
+    }
+    return UINT32_MAX;
+}
+
+bool
+SymbolFileDWARFDwp::LoadRawSectionData (SectionType sect_type, DWARFDataExtractor &data)
+{
+    Mutex::Locker locker (m_sections_mutex);
+    std::map<SectionType, DWARFDataExtractor>::iterator pos = m_sections.find (sect_type);
+    if (pos == m_sections.end())
+    {
+        DWARFDataExtractor &section_data = m_sections[sect_type];
+        const SectionList *section_list = m_obj_file->GetSectionList (false);
+        SectionSP section_sp;
+        if (section_list)
+            section_sp = section_list->FindSectionByType (sect_type, true);
+        if (!section_sp || m_obj_file->ReadSectionData (section_sp.get(), section_data) == 0)
+            section_data.Clear();
+        pos = m_sections.find (sect_type);
+    }
+    data = pos->second;
+    return data.GetByteSize() > 0;
+}
+
+bool
+SymbolFileDWARFDwp::LoadSectionData (uint64_t dwo_id, SectionType sect_type, DWARFDataExtractor &data)
+{
+    DWARFDataExtractor section_data;
+    if (!LoadRawSectionData (sect_type, section_data))
+        return false;
+
+    const uint32_t column = FindColumn (sect_type);
+    if (column == UINT32_MAX)
+    {
+        // Sections like .debug_str are shared by all units
+        data = section_data;
+        return true;
+    }
+
+    const uint32_t row = FindRow (dwo_id);
+    if (row == 0)
+        return false;
+
+    const lldb::offset_t row_size = (lldb::offset_t)m_num_columns * sizeof(uint32_t);
+    const lldb::offset_t offsets_table_offset = k_cu_index_header_size +
+                                                (lldb::offset_t)m_num_slots * (sizeof(uint64_t) + sizeof(uint32_t)) +
+                                                row_size;
+    const lldb::offset_t sizes_table_offset = offsets_table_offset + m_num_units * row_size;
+    lldb::offset_t offset = offsets_table_offset + (row - 1) * row_size + column * sizeof(uint32_t);
+    const uint32_t contribution_offset = m_cu_index_data.GetU32 (&offset);
+    offset = sizes_table_offset + (row - 1) * row_size + column * sizeof(uint32_t);
+    const uint32_t contribution_size = m_cu_index_data.GetU32 (&offset);
+    if (!section_data.ValidOffsetForDataOfSize (contribution_offset, contribution_size))
+        return false;
+    data.SetData (section_data, contribution_offset, contribution_size);
+    return true;
+}
+
+std::unique_ptr<SymbolFileDWARFDwo>
+SymbolFileDWARFDwp::GetSymbolFileForDwoId (DWARFCompileUnit *dwarf_cu, uint64_t dwo_id)
+{
+    if (dwo_id == 0 || FindRow (dwo_id) == 0)
+        return nullptr;
+    return std::unique_ptr<SymbolFileDWARFDwo> (new SymbolFileDWARFDwoDwp (this, m_obj_file, dwarf_cu, dwo_id));
+}
@@ -0,0 +1,80 @@
+//===-- SymbolFileDWARFDwp.h ------------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef SymbolFileDWARF_SymbolFileDWARFDwp_h_
+#define SymbolFileDWARF_SymbolFileDWARFDwp_h_
+
+// C Includes
+// C++ Includes
+#include <map>
+#include <memory>
+
+// Other libraries and framework includes
+#include "lldb/lldb-private.h"
+#include "lldb/Core/DataExtractor.h"
+#include "lldb/Host/Mutex.h"
+
+// Project includes
+#include "DWARFDataExtractor.h"
+
+class DWARFCompileUnit;
+class SymbolFileDWARFDwo;
+
+//----------------------------------------------------------------------
+// SymbolFileDWARFDwp
+//
+// A .dwp package that the dwp tool made from the .dwo files of a
+// program. Its .debug_cu_index section (version 2) maps the DWO ID of
+// each compile unit to its contributions to the package's sections.
+//----------------------------------------------------------------------
+class SymbolFileDWARFDwp
+{
+public:
+    static std::unique_ptr<SymbolFileDWARFDwp>
+    Create (lldb::ModuleSP module_sp, const lldb_private::FileSpec &file_spec);
+
+    ~SymbolFileDWARFDwp ();
+
+    // Returns a symbol file for the compile unit with "dwo_id", or NULL
+    // if the package doesn't have it.
+    std::unique_ptr<SymbolFileDWARFDwo>
+    GetSymbolFileForDwoId (DWARFCompileUnit *dwarf_cu, uint64_t dwo_id);
+
+    // Fills in "data" with the contribution of the compile unit with
+    // "dwo_id" to a section, or the whole section if units don't have
+    // separate contributions to it (like .debug_str).
+    bool
+    LoadSectionData (uint64_t dwo_id, lldb::SectionType sect_type, lldb_private::DWARFDataExtractor &data);
+
+private:
+    SymbolFileDWARFDwp (lldb::ObjectFileSP obj_file);
+
+    bool
+    ExtractCUIndex ();
+
+    // Returns the 1 based row of "dwo_id" in the index, zero if not found
+    uint32_t
+    FindRow (uint64_t dwo_id) const;
+
+    uint32_t
+    FindColumn (lldb::SectionType sect_type) const;
+
+    bool
+    LoadRawSectionData (lldb::SectionType sect_type, lldb_private::DWARFDataExtractor &data);
+
+    lldb::ObjectFileSP m_obj_file;
+    lldb_private::DataExtractor m_cu_index_data;
+    uint32_t m_num_columns;
+    uint32_t m_num_units;
+    uint32_t m_num_slots;
+    lldb_private::Mutex m_sections_mutex;
+    std::map<lldb::SectionType, lldb_private::DWARFDataExtractor> m_sections;   // Whole sections, read on first use
+};
+
+#endif  // SymbolFileDWARF_SymbolFileDWARFDwp_h_
@@ -142,12 +142,14 @@ SymbolVendorELF::CreateInstance (const lldb::ModuleSP &module_sp, lldb_private::
 
                     static const SectionType g_sections[] =
                     {
+                        eSectionTypeDWARFDebugAddr,
                         eSectionTypeDWARFDebugAranges,
                         eSectionTypeDWARFDebugInfo,
                         eSectionTypeDWARFDebugAbbrev,
                         eSectionTypeDWARFDebugFrame,
                         eSectionTypeDWARFDebugLine,
                         eSectionTypeDWARFDebugStr,
+                        eSectionTypeDWARFDebugStrOffsets,
                         eSectionTypeDWARFDebugLoc,
                         eSectionTypeDWARFDebugMacInfo,
                         eSectionTypeDWARFDebugPubNames,
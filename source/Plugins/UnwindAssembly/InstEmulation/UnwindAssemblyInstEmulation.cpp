@@ -269,9 +269,6 @@ UnwindAssemblyInstEmulation::GetNonCallSiteUnwindPlanFromAssembly (AddressRange&
                     }
                 }
             }
-            // FIXME: The DisassemblerLLVMC has a reference cycle and won't go away if it has any active instructions.
-            // I'll fix that but for now, just clear the list and it will go away nicely.
-            disasm_sp->GetInstructionList().Clear();
         }
         
         if (log && log->GetVerbose ())
@@ -354,6 +354,7 @@ ObjectFile::GetAddressClass (addr_t file_addr)
                         return eAddressClassData;
                     case eSectionTypeDebug:
                     case eSectionTypeDWARFDebugAbbrev:
+                    case eSectionTypeDWARFDebugAddr:
                     case eSectionTypeDWARFDebugAranges:
                     case eSectionTypeDWARFDebugFrame:
                     case eSectionTypeDWARFDebugInfo:
@@ -364,6 +365,7 @@ ObjectFile::GetAddressClass (addr_t file_addr)
                     case eSectionTypeDWARFDebugPubTypes:
                     case eSectionTypeDWARFDebugRanges:
                     case eSectionTypeDWARFDebugStr:
+                    case eSectionTypeDWARFDebugStrOffsets:
                     case eSectionTypeDWARFAppleNames:
                     case eSectionTypeDWARFAppleTypes:
                     case eSectionTypeDWARFAppleNamespaces:
@@ -560,6 +562,15 @@ ObjectFile::MemoryMapSectionData (const Section *section, DataExtractor& section
     }
 }
 
+bool
+ObjectFile::SectionIsCompressed (const Section *section) const
+{
+    // If some other objectfile owns this section, pass this to them.
+    if (section->GetObjectFile() != this)
+        return section->GetObjectFile()->SectionIsCompressed (section);
+    return false;
+}
+
 
 bool
 ObjectFile::SplitArchivePathWithObject (const char *path_with_object, FileSpec &archive_file, ConstString &archive_object, bool must_exist)
@@ -600,7 +611,7 @@ ObjectFile::ClearSymtab ()
 }
 
 SectionList *
-ObjectFile::GetSectionList()
+ObjectFile::GetSectionList(bool update_module_section_list)
 {
     if (m_sections_ap.get() == nullptr)
     {
@@ -608,7 +619,13 @@ ObjectFile::GetSectionList()
         if (module_sp)
         {
             lldb_private::Mutex::Locker locker(module_sp->GetMutex());
-            CreateSections(*module_sp->GetUnifiedSectionList());
+            if (update_module_section_list)
+                CreateSections(*module_sp->GetUnifiedSectionList());
+            else
+            {
+                SectionList unified_section_list;
+                CreateSections(unified_section_list);
+            }
         }
     }
     return m_sections_ap.get();
@@ -418,6 +418,8 @@ SymbolVendor::Dump(Stream *s)
         }
         s->EOL();
         s->IndentMore();
+        if (m_sym_file_ap.get())
+            m_sym_file_ap->Dump(*s);
         m_type_list.Dump(s, show_context);
 
         CompileUnitConstIter cu_pos, cu_end;
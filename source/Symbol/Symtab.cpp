@@ -19,6 +19,9 @@
 #include "lldb/Symbol/Symtab.h"
 #include "lldb/Target/CPPLanguageRuntime.h"
 #include "lldb/Target/ObjCLanguageRuntime.h"
+#include "lldb/Target/Target.h"
+
+#include "Utility/IndexCache.h"
 
 using namespace lldb;
 using namespace lldb_private;
@@ -265,6 +268,11 @@ Symtab::InitNameIndexes()
     {
         m_name_indexes_computed = true;
         Timer scoped_timer (__PRETTY_FUNCTION__, "%s", __PRETTY_FUNCTION__);
+
+        // Reuse the indexes from a previous debug session if we can
+        if (LoadNameIndexesFromCache())
+            return;
+
         // Create the name index vector to be able to quickly search by name
         const size_t num_symbols = m_symbols.size();
 #if 1
@@ -439,6 +447,8 @@ Symtab::InitNameIndexes()
         m_basename_to_index.SizeToFit();
         m_method_to_index.Sort();
         m_method_to_index.SizeToFit();
+
+        SaveNameIndexesToCache();
     
 //        static StreamFile a ("/tmp/a.txt");
 //
@@ -463,6 +473,60 @@ Symtab::InitNameIndexes()
     }
 }
 
+bool
+Symtab::LoadNameIndexesFromCache ()
+{
+    // Protected function, no need to lock mutex...
+    UUID uuid;
+    m_objfile->GetUUID (&uuid);
+    IndexCache index_cache (Target::GetDefaultIndexCachePath(),
+                            uuid,
+                            m_objfile->GetFileSpec(),
+                            "symtab",
+                            m_symbols.size());
+    if (!index_cache.IsValid())
+        return false;
+
+    std::vector<NameToIndexMap *> maps;
+    maps.push_back (&m_name_to_index);
+    maps.push_back (&m_selector_to_index);
+    maps.push_back (&m_basename_to_index);
+    maps.push_back (&m_method_to_index);
+    if (!index_cache.Load (maps))
+        return false;
+
+    // The cache stores entries in the order of the previous session's
+    // string pool addresses, so they need to be sorted again.
+    for (NameToIndexMap *map : maps)
+    {
+        map->Sort();
+        map->SizeToFit();
+    }
+    return true;
+}
+
+void
+Symtab::SaveNameIndexesToCache () const
+{
+    // Protected function, no need to lock mutex...
+    UUID uuid;
+    m_objfile->GetUUID (&uuid);
+    IndexCache index_cache (Target::GetDefaultIndexCachePath(),
+                            uuid,
+                            m_objfile->GetFileSpec(),
+                            "symtab",
+                            m_symbols.size());
+    if (!index_cache.IsValid())
+        return;
+
+    std::vector<const NameToIndexMap *> maps;
+    maps.push_back (&m_name_to_index);
+    maps.push_back (&m_selector_to_index);
+    maps.push_back (&m_basename_to_index);
+    maps.push_back (&m_method_to_index);
+    index_cache.Save (maps);
+}
+
 void
 Symtab::AppendSymbolNamesToMap (const IndexCollection &indexes,
                                 bool add_demangled,
@@ -1068,6 +1132,30 @@ Symtab::FindSymbolContainingFileAddress (addr_t file_addr)
     return nullptr;
 }
 
+//----------------------------------------------------------------------
+// Look up the symbols for file addresses that are sorted in increasing
+// order, taking the lock once and making a single pass over the address
+// index.
+//----------------------------------------------------------------------
+void
+Symtab::FindSymbolsContainingFileAddresses (const addr_t *file_addrs, size_t num_addrs, Symbol **symbols)
+{
+    Mutex::Locker locker (m_mutex);
+
+    if (!m_file_addr_to_index_computed)
+        InitAddressIndexes();
+
+    size_t start_idx = 0;
+    for (size_t i = 0; i < num_addrs; ++i)
+    {
+        const uint32_t entry_idx = m_file_addr_to_index.FindEntryIndexThatContainsSorted(file_addrs[i], start_idx);
+        if (entry_idx == UINT32_MAX)
+            symbols[i] = nullptr;
+        else
+            symbols[i] = SymbolAtIndex(m_file_addr_to_index.GetEntryRef(entry_idx).data);
+    }
+}
+
 void
 Symtab::SymbolIndicesToSymbolContextList (std::vector<uint32_t> &symbol_indexes, SymbolContextList &sc_list)
 {
@@ -11,25 +11,60 @@
 // C Includes
 #include <inttypes.h>
 // C++ Includes
+#include <algorithm>
 // Other libraries and framework includes
 // Project includes
 #include "lldb/Core/DataBufferHeap.h"
+#include "lldb/Core/Section.h"
 #include "lldb/Core/State.h"
 #include "lldb/Core/Log.h"
+#include "lldb/Core/StreamString.h"
 #include "lldb/Target/Process.h"
+#include "lldb/Target/SectionLoadList.h"
+#include "lldb/Target/Target.h"
 
 using namespace lldb;
 using namespace lldb_private;
 
+// The most lines a single read-ahead brings in once consecutive lines
+// keep missing.
+static const uint32_t g_max_read_ahead_lines = 16;
+
+static uint32_t
+CalculateMaxLines (const Process &process, uint32_t cache_line_byte_size)
+{
+    if (cache_line_byte_size == 0)
+        return 1;
+    const uint64_t max_lines = process.GetMemoryCacheMaxSize() / cache_line_byte_size;
+    if (max_lines == 0)
+        return 1;
+    return max_lines > UINT32_MAX ? UINT32_MAX : (uint32_t)max_lines;
+}
+
 //----------------------------------------------------------------------
 // MemoryCache constructor
 //----------------------------------------------------------------------
 MemoryCache::MemoryCache(Process &process) :
     m_process (process),
     m_cache_line_byte_size (process.GetMemoryCacheLineSize()),
+    m_max_lines (CalculateMaxLines (process, m_cache_line_byte_size)),
     m_mutex (Mutex::eMutexTypeRecursive),
     m_cache (),
-    m_invalid_ranges ()
+    m_lines (),
+    m_slab (),
+    m_free_lines (),
+    m_read_buffer (),
+    m_lru_head (UINT32_MAX),
+    m_lru_tail (UINT32_MAX),
+    m_last_miss_addr (LLDB_INVALID_ADDRESS),
+    m_read_ahead_lines (1),
+    m_invalid_ranges (),
+    m_hits (0),
+    m_misses (0),
+    m_read_ahead_count (0),
+    m_evictions (0),
+    m_prefetch_count (0),
+    m_flush_id (0)
 {
 }
 
@@ -44,10 +79,68 @@ void
 MemoryCache::Clear(bool clear_invalid_ranges)
 {
     Mutex::Locker locker (m_mutex);
+    ++m_flush_id;
     m_cache.clear();
+    m_lines.clear();
+    m_slab.clear();
+    m_free_lines.clear();
+    m_lru_head = UINT32_MAX;
+    m_lru_tail = UINT32_MAX;
+    m_last_miss_addr = LLDB_INVALID_ADDRESS;
+    m_read_ahead_lines = 1;
     if (clear_invalid_ranges)
         m_invalid_ranges.Clear();
     m_cache_line_byte_size = m_process.GetMemoryCacheLineSize();
+    m_max_lines = CalculateMaxLines (m_process, m_cache_line_byte_size);
+}
+
+void
+MemoryCache::ClearMutableLines ()
+{
+    Mutex::Locker locker (m_mutex);
+
+    Log *log (GetLogIfAllCategoriesSet (LIBLLDB_LOG_PROCESS));
+    if (log)
+    {
+        StreamString strm;
+        DumpStatistics (strm);
+        log->Printf ("MemoryCache::%s %s", __FUNCTION__, strm.GetData());
+    }
+
+    // Start over if the cache settings changed.
+    if (m_cache_line_byte_size != m_process.GetMemoryCacheLineSize() ||
+        m_max_lines != CalculateMaxLines (m_process, m_cache_line_byte_size))
+    {
+        Clear();
+        return;
+    }
+
+    ++m_flush_id;
+    m_last_miss_addr = LLDB_INVALID_ADDRESS;
+    m_read_ahead_lines = 1;
+
+    // Keep a read-only line only while the section it came from is still
+    // loaded at the same address.
+    const SectionLoadList &section_load_list = m_process.GetTarget().GetSectionLoadList();
+    LineMap::iterator pos = m_cache.begin();
+    while (pos != m_cache.end())
+    {
+        const CacheLine &line = m_lines[pos->second];
+        bool keep = false;
+        if (line.immutable)
+        {
+            SectionSP section_sp (line.section_wp.lock());
+            Address so_addr;
+            keep = section_sp &&
+                   section_load_list.ResolveLoadAddress (line.addr, so_addr) &&
+                   so_addr.GetSection() == section_sp;
+        }
+
+        if (keep)
+            ++pos;
+        else
+            RemoveLine (pos++);
+    }
 }
 
 void
@@ -57,6 +150,7 @@ MemoryCache::Flush (addr_t addr, size_t size)
         return;
 
     Mutex::Locker locker (m_mutex);
+    ++m_flush_id;
     if (m_cache.empty())
         return;
 
@@ -64,23 +158,13 @@ MemoryCache::Flush (addr_t addr, size_t size)
     const addr_t end_addr = (addr + size - 1);
     const addr_t first_cache_line_addr = addr - (addr % cache_line_byte_size);
     const addr_t last_cache_line_addr = end_addr - (end_addr % cache_line_byte_size);
+
     // Watch for overflow where size will cause us to go off the end of the
     // 64 bit address space
-    uint32_t num_cache_lines;
-    if (last_cache_line_addr >= first_cache_line_addr)
-        num_cache_lines = ((last_cache_line_addr - first_cache_line_addr)/cache_line_byte_size) + 1;
-    else
-        num_cache_lines = (UINT64_MAX - first_cache_line_addr + 1)/cache_line_byte_size;
-
-    uint32_t cache_idx = 0;
-    for (addr_t curr_addr = first_cache_line_addr;
-         cache_idx < num_cache_lines;
-         curr_addr += cache_line_byte_size, ++cache_idx)
-    {
-        BlockMap::iterator pos = m_cache.find (curr_addr);
-        if (pos != m_cache.end())
-            m_cache.erase(pos);
-    }
+    LineMap::iterator pos = m_cache.lower_bound (first_cache_line_addr);
+    LineMap::iterator end = last_cache_line_addr >= first_cache_line_addr ? m_cache.upper_bound (last_cache_line_addr) : m_cache.end();
+    while (pos != end)
+        RemoveLine (pos++);
 }
 
 void
@@ -112,7 +196,273 @@ MemoryCache::RemoveInvalidRange (lldb::addr_t base_addr, lldb::addr_t byte_size)
     return false;
 }
 
+void
+MemoryCache::DumpStatistics (Stream &strm)
+{
+    Mutex::Locker locker (m_mutex);
+    strm.Printf ("hits = %" PRIu64 ", misses = %" PRIu64 ", read-ahead lines = %" PRIu64 ", prefetched lines = %" PRIu64 ", evictions = %" PRIu64 ", lines = %" PRIu64 "/%u (%u bytes each)",
+                 m_hits,
+                 m_misses,
+                 m_read_ahead_count,
+                 m_prefetch_count,
+                 m_evictions,
+                 (uint64_t)m_cache.size(),
+                 m_max_lines,
+                 m_cache_line_byte_size);
+}
+
+void
+MemoryCache::UnlinkLine (uint32_t line_idx)
+{
+    CacheLine &line = m_lines[line_idx];
+    if (line.prev != UINT32_MAX)
+        m_lines[line.prev].next = line.next;
+    else
+        m_lru_head = line.next;
+    if (line.next != UINT32_MAX)
+        m_lines[line.next].prev = line.prev;
+    else
+        m_lru_tail = line.prev;
+    line.prev = UINT32_MAX;
+    line.next = UINT32_MAX;
+}
+
+void
+MemoryCache::LinkLineAtFront (uint32_t line_idx)
+{
+    CacheLine &line = m_lines[line_idx];
+    line.prev = UINT32_MAX;
+    line.next = m_lru_head;
+    if (m_lru_head != UINT32_MAX)
+        m_lines[m_lru_head].prev = line_idx;
+    m_lru_head = line_idx;
+    if (m_lru_tail == UINT32_MAX)
+        m_lru_tail = line_idx;
+}
+
+void
+MemoryCache::RemoveLine (LineMap::iterator pos)
+{
+    const uint32_t line_idx = pos->second;
+    UnlinkLine (line_idx);
+    m_lines[line_idx].section_wp.reset();
+    m_free_lines.push_back (line_idx);
+    m_cache.erase (pos);
+}
+
+uint32_t
+MemoryCache::AllocateLine ()
+{
+    if (!m_free_lines.empty())
+    {
+        const uint32_t line_idx = m_free_lines.back();
+        m_free_lines.pop_back();
+        return line_idx;
+    }
+
+    if (m_lines.size() < m_max_lines)
+    {
+        // Grow the slab, lines are addressed by index so it may move.
+        const uint32_t line_idx = m_lines.size();
+        m_lines.push_back (CacheLine());
+        m_slab.resize ((size_t)(line_idx + 1) * m_cache_line_byte_size);
+        return line_idx;
+    }
+
+    // The cache is full, recycle the least recently used line.
+    const uint32_t line_idx = m_lru_tail;
+    assert (line_idx != UINT32_MAX);
+    UnlinkLine (line_idx);
+    m_cache.erase (m_lines[line_idx].addr);
+    m_lines[line_idx].section_wp.reset();
+    ++m_evictions;
+    return line_idx;
+}
+
+uint32_t
+MemoryCache::FindLine (addr_t line_addr)
+{
+    LineMap::const_iterator pos = m_cache.find (line_addr);
+    if (pos == m_cache.end())
+        return UINT32_MAX;
 
+    ++m_hits;
+    const uint32_t line_idx = pos->second;
+    if (line_idx != m_lru_head)
+    {
+        UnlinkLine (line_idx);
+        LinkLineAtFront (line_idx);
+    }
+    return line_idx;
+}
+
+bool
+MemoryCache::IsImmutable (addr_t line_addr, SectionSP &section_sp) const
+{
+    Address so_addr;
+    if (!m_process.GetTarget().GetSectionLoadList().ResolveLoadAddress (line_addr, so_addr))
+        return false;
+
+    section_sp = so_addr.GetSection();
+    if (!section_sp || so_addr.GetOffset() + m_cache_line_byte_size > section_sp->GetByteSize())
+        return false;
+
+    switch (section_sp->GetType())
+    {
+        case eSectionTypeCode:
+        case eSectionTypeDataCString:
+        case eSectionTypeEHFrame:
+        case eSectionTypeCompactUnwind:
+            return true;
+        default:
+            break;
+    }
+
+    // ELF read-only data doesn't get a section type of its own.
+    static ConstString g_rodata_section_name (".rodata");
+    static ConstString g_rodata1_section_name (".rodata1");
+    const ConstString &section_name = section_sp->GetName();
+    return section_name == g_rodata_section_name || section_name == g_rodata1_section_name;
+}
+
+uint32_t
+MemoryCache::FillLines (addr_t line_addr, Error &error)
+{
+    const uint32_t cache_line_byte_size = m_cache_line_byte_size;
+    ++m_misses;
+
+    // Misses on consecutive lines double the read-ahead window, anything
+    // else starts it over at a single line.
+    if (m_last_miss_addr != LLDB_INVALID_ADDRESS && line_addr == m_last_miss_addr + cache_line_byte_size)
+        m_read_ahead_lines = std::min<uint32_t> (m_read_ahead_lines * 2, g_max_read_ahead_lines);
+    else
+        m_read_ahead_lines = 1;
+
+    // Don't let a read-ahead evict the line it is being done for, and stop
+    // at lines we already have or know can't be read.
+    const uint32_t max_lines = std::min<uint32_t> (m_read_ahead_lines, std::max<uint32_t> (m_max_lines / 2, 1));
+    uint32_t num_lines = 1;
+    for (; num_lines < max_lines; ++num_lines)
+    {
+        const addr_t next_line_addr = line_addr + (addr_t)num_lines * cache_line_byte_size;
+        if (next_line_addr < line_addr ||
+            m_cache.find (next_line_addr) != m_cache.end() ||
+            m_invalid_ranges.FindEntryThatContains (next_line_addr))
+            break;
+    }
+
+    const size_t bytes_to_read = (size_t)num_lines * cache_line_byte_size;
+    m_read_buffer.resize (bytes_to_read);
+    size_t bytes_read = m_process.ReadMemoryFromInferior (line_addr, m_read_buffer.data(), bytes_to_read, error);
+    if (bytes_read == 0 && num_lines > 1)
+    {
+        // Many stubs fail a whole read that runs into an unmapped page
+        // rather than returning what they could read, so a read-ahead past
+        // the end of a mapping can't tell us the line we want is bad. Go
+        // back to reading just that line.
+        m_read_ahead_lines = 1;
+        num_lines = 1;
+        error.Clear();
+        bytes_read = m_process.ReadMemoryFromInferior (line_addr, m_read_buffer.data(), cache_line_byte_size, error);
+    }
+    if (bytes_read == 0)
+        return UINT32_MAX;
+
+    // A read-ahead that comes up short after the line that was asked for
+    // is not an error for the caller.
+    if (num_lines > 1 && bytes_read >= cache_line_byte_size)
+        error.Clear();
+
+    uint32_t first_line_idx = UINT32_MAX;
+    for (size_t offset = 0; offset < bytes_read; offset += cache_line_byte_size)
+    {
+        const addr_t curr_addr = line_addr + offset;
+        const uint32_t line_idx = AllocateLine ();
+        CacheLine &line = m_lines[line_idx];
+        line.addr = curr_addr;
+        line.byte_size = std::min<size_t> (cache_line_byte_size, bytes_read - offset);
+        SectionSP section_sp;
+        line.immutable = IsImmutable (curr_addr, section_sp);
+        line.section_wp = section_sp;
+        ::memcpy (GetLineBytes (line_idx), m_read_buffer.data() + offset, line.byte_size);
+        m_cache[curr_addr] = line_idx;
+        LinkLineAtFront (line_idx);
+
+        if (first_line_idx == UINT32_MAX)
+            first_line_idx = line_idx;
+        else
+            ++m_read_ahead_count;
+        m_last_miss_addr = curr_addr;
+    }
+    return first_line_idx;
+}
+
+size_t
+MemoryCache::Prefetch (addr_t addr, size_t size)
+{
+    if (size == 0)
+        return 0;
+
+    uint32_t cache_line_byte_size;
+    uint32_t flush_id;
+    addr_t first_line_addr;
+    size_t num_lines = 0;
+    {
+        Mutex::Locker locker (m_mutex);
+        cache_line_byte_size = m_cache_line_byte_size;
+        flush_id = m_flush_id;
+        first_line_addr = addr - (addr % cache_line_byte_size);
+        const size_t max_lines = std::max<uint32_t> (m_max_lines / 4, 1);
+        const addr_t end_addr = addr + size;
+
+        // Skip the lines we already have at the start, and stop at ones we
+        // know can't be read
+        while (first_line_addr < end_addr && m_cache.find (first_line_addr) != m_cache.end())
+            first_line_addr += cache_line_byte_size;
+        while (num_lines < max_lines)
+        {
+            const addr_t line_addr = first_line_addr + (addr_t)num_lines * cache_line_byte_size;
+            if (line_addr >= end_addr || line_addr < first_line_addr || m_invalid_ranges.FindEntryThatContains (line_addr))
+                break;
+            ++num_lines;
+        }
+    }
+    if (num_lines == 0)
+        return 0;
+
+    std::vector<uint8_t> buffer ((size_t)num_lines * cache_line_byte_size);
+    Error error;
+    const size_t bytes_read = m_process.ReadMemoryFromInferior (first_line_addr, buffer.data(), buffer.size(), error);
+    if (bytes_read == 0)
+        return 0;
+
+    Mutex::Locker locker (m_mutex);
+    // Memory may have been written, or the cache cleared, while we were
+    // reading
+    if (flush_id != m_flush_id || cache_line_byte_size != m_cache_line_byte_size)
+        return 0;
+
+    size_t bytes_added = 0;
+    for (size_t offset = 0; offset < bytes_read; offset += cache_line_byte_size)
+    {
+        const addr_t curr_addr = first_line_addr + offset;
+        if (m_cache.find (curr_addr) != m_cache.end())
+            continue;
+        const uint32_t line_idx = AllocateLine ();
+        CacheLine &line = m_lines[line_idx];
+        line.addr = curr_addr;
+        line.byte_size = std::min<size_t> (cache_line_byte_size, bytes_read - offset);
+        SectionSP section_sp;
+        line.immutable = IsImmutable (curr_addr, section_sp);
+        line.section_wp = section_sp;
+        ::memcpy (GetLineBytes (line_idx), buffer.data() + offset, line.byte_size);
+        m_cache[curr_addr] = line_idx;
+        LinkLineAtFront (line_idx);
+        ++m_prefetch_count;
+        bytes_added += line.byte_size;
+    }
+    return bytes_added;
+}
 
 size_t
 MemoryCache::Read (addr_t addr,  
@@ -136,11 +486,11 @@ MemoryCache::Read (addr_t addr,
 
     if (dst && bytes_left > 0)
     {
+        Mutex::Locker locker (m_mutex);
         const uint32_t cache_line_byte_size = m_cache_line_byte_size;
         uint8_t *dst_buf = (uint8_t *)dst;
         addr_t curr_addr = addr - (addr % cache_line_byte_size);
         addr_t cache_offset = addr - curr_addr;
-        Mutex::Locker locker (m_mutex);
         
         while (bytes_left > 0)
         {
@@ -150,68 +500,34 @@ MemoryCache::Read (addr_t addr,
                 return dst_len - bytes_left;
             }
 
-            BlockMap::const_iterator pos = m_cache.find (curr_addr);
-            BlockMap::const_iterator end = m_cache.end ();
-            
-            if (pos != end)
+            uint32_t line_idx = FindLine (curr_addr);
+            if (line_idx == UINT32_MAX)
             {
-                size_t curr_read_size = cache_line_byte_size - cache_offset;
-                if (curr_read_size > bytes_left)
-                    curr_read_size = bytes_left;
-                
-                memcpy (dst_buf + dst_len - bytes_left, pos->second->GetBytes() + cache_offset, curr_read_size);
-                
-                bytes_left -= curr_read_size;
-                curr_addr += curr_read_size + cache_offset;
-                cache_offset = 0;
-                
-                if (bytes_left > 0)
-                {
-                    // Get sequential cache page hits
-                    for (++pos; (pos != end) && (bytes_left > 0); ++pos)
-                    {
-                        assert ((curr_addr % cache_line_byte_size) == 0);
-                        
-                        if (pos->first != curr_addr)
-                            break;
-                        
-                        curr_read_size = pos->second->GetByteSize();
-                        if (curr_read_size > bytes_left)
-                            curr_read_size = bytes_left;
-                        
-                        memcpy (dst_buf + dst_len - bytes_left, pos->second->GetBytes(), curr_read_size);
-                        
-                        bytes_left -= curr_read_size;
-                        curr_addr += curr_read_size;
-                        
-                        // We have a cache page that succeeded to read some bytes
-                        // but not an entire page. If this happens, we must cap
-                        // off how much data we are able to read...
-                        if (pos->second->GetByteSize() != cache_line_byte_size)
-                            return dst_len - bytes_left;
-                    }
-                }
-            }
-            
-            // We need to read from the process
-            
-            if (bytes_left > 0)
-            {
-                assert ((curr_addr % cache_line_byte_size) == 0);
-                std::unique_ptr<DataBufferHeap> data_buffer_heap_ap(new DataBufferHeap (cache_line_byte_size, 0));
-                size_t process_bytes_read = m_process.ReadMemoryFromInferior (curr_addr, 
-                                                                              data_buffer_heap_ap->GetBytes(), 
-                                                                              data_buffer_heap_ap->GetByteSize(), 
-                                                                              error);
-                if (process_bytes_read == 0)
+                // We need to read from the process
+                line_idx = FillLines (curr_addr, error);
+                if (line_idx == UINT32_MAX)
                     return dst_len - bytes_left;
-                
-                if (process_bytes_read != cache_line_byte_size)
-                    data_buffer_heap_ap->SetByteSize (process_bytes_read);
-                m_cache[curr_addr] = DataBufferSP (data_buffer_heap_ap.release());
-                // We have read data and put it into the cache, continue through the
-                // loop again to get the data out of the cache...
             }
+
+            const CacheLine &line = m_lines[line_idx];
+            if (line.byte_size <= cache_offset)
+                return dst_len - bytes_left;
+
+            size_t curr_read_size = line.byte_size - cache_offset;
+            if (curr_read_size > bytes_left)
+                curr_read_size = bytes_left;
+
+            memcpy (dst_buf + dst_len - bytes_left, GetLineBytes (line_idx) + cache_offset, curr_read_size);
+            bytes_left -= curr_read_size;
+
+            // We have a cache line that succeeded to read some bytes but not
+            // an entire line. If this happens, we must cap off how much data
+            // we are able to read...
+            if (bytes_left > 0 && line.byte_size != cache_line_byte_size)
+                return dst_len - bytes_left;
+
+            curr_addr += cache_line_byte_size;
+            cache_offset = 0;
         }
     }
     
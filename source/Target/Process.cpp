@@ -117,6 +117,9 @@ g_properties[] =
     { "stop-on-sharedlibrary-events" , OptionValue::eTypeBoolean, true, false, NULL, NULL, "If true, stop when a shared library is loaded or unloaded." },
     { "detach-keeps-stopped" , OptionValue::eTypeBoolean, true, false, NULL, NULL, "If true, detach will attempt to keep the process stopped." },
     { "memory-cache-line-size" , OptionValue::eTypeUInt64, false, 512, NULL, NULL, "The memory cache line size" },
+    { "memory-cache-max-size" , OptionValue::eTypeUInt64, false, 4 * 1024 * 1024, NULL, NULL, "The maximum number of bytes the memory cache holds before it starts evicting the least recently used cache lines." },
+    { "unwind-thread-count" , OptionValue::eTypeUInt64, false, 0, NULL, NULL, "The number of threads used to unwind the stacks of all threads at once, as \"thread backtrace all\" does. Zero uses one thread per CPU, one unwinds the threads one after another." },
+    { "stack-prefetch-size" , OptionValue::eTypeUInt64, false, 4096, NULL, NULL, "The number of bytes above a thread's stack pointer that are read in one go before all threads are unwound. Zero disables the prefetch." },
     {  NULL                  , OptionValue::eTypeInvalid, false, 0, NULL, NULL, NULL  }
 };
 
@@ -128,7 +131,10 @@ enum {
     ePropertyPythonOSPluginPath,
     ePropertyStopOnSharedLibraryEvents,
     ePropertyDetachKeepsStopped,
-    ePropertyMemCacheLineSize
+    ePropertyMemCacheLineSize,
+    ePropertyMemCacheMaxSize,
+    ePropertyUnwindThreadCount,
+    ePropertyStackPrefetchSize
 };
 
 ProcessProperties::ProcessProperties (lldb_private::Process *process) :
@@ -178,6 +184,27 @@ ProcessProperties::GetMemoryCacheLineSize() const
     return m_collection_sp->GetPropertyAtIndexAsUInt64 (NULL, idx, g_properties[idx].default_uint_value);
 }
 
+uint64_t
+ProcessProperties::GetMemoryCacheMaxSize() const
+{
+    const uint32_t idx = ePropertyMemCacheMaxSize;
+    return m_collection_sp->GetPropertyAtIndexAsUInt64 (NULL, idx, g_properties[idx].default_uint_value);
+}
+
+uint64_t
+ProcessProperties::GetUnwindThreadCount() const
+{
+    const uint32_t idx = ePropertyUnwindThreadCount;
+    return m_collection_sp->GetPropertyAtIndexAsUInt64 (NULL, idx, g_properties[idx].default_uint_value);
+}
+
+uint64_t
+ProcessProperties::GetStackPrefetchSize() const
+{
+    const uint32_t idx = ePropertyStackPrefetchSize;
+    return m_collection_sp->GetPropertyAtIndexAsUInt64 (NULL, idx, g_properties[idx].default_uint_value);
+}
+
 Args
 ProcessProperties::GetExtraStartupCommands () const
 {
@@ -1812,7 +1839,7 @@ Process::SetPrivateState (StateType new_state)
             m_thread_list.DidStop();
 
             m_mod_id.BumpStopID();
-            m_memory_cache.Clear();
+            m_memory_cache.ClearMutableLines();
             if (log)
                 log->Printf("Process::SetPrivateState (%s) stop_id = %u", StateAsCString(new_state), m_mod_id.GetStopID());
         }
@@ -2396,6 +2423,9 @@ Process::EnableSoftwareBreakpoint (BreakpointSite *bp_site)
         // Save the original opcode by reading it
         if (DoReadMemory(bp_addr, bp_site->GetSavedOpcodeBytes(), bp_opcode_size, error) == bp_opcode_size)
         {
+            // Cached code can outlive a stop, so don't let it show the old bytes.
+            m_memory_cache.Flush (bp_addr, bp_opcode_size);
+
             // Write a software breakpoint in place of the original opcode
             if (DoWriteMemory(bp_addr, bp_opcode_bytes, bp_opcode_size, error) == bp_opcode_size)
             {
@@ -2467,6 +2497,7 @@ Process::DisableSoftwareBreakpoint (BreakpointSite *bp_site)
                     break_op_found = true;
                     // We found a valid breakpoint opcode at this address, now restore
                     // the saved opcode.
+                    m_memory_cache.Flush (bp_addr, break_op_size);
                     if (DoWriteMemory (bp_addr, bp_site->GetSavedOpcodeBytes(), break_op_size, error) == break_op_size)
                     {
                         verify = true;
@@ -2573,6 +2604,14 @@ Process::ReadMemory (addr_t addr, void *buf, size_t size, Error &error)
         return ReadMemoryFromInferior (addr, buf, size, error);
     }
 }
+
+size_t
+Process::PrefetchMemory (addr_t addr, size_t size)
+{
+    if (GetDisableMemoryCache())
+        return 0;
+    return m_memory_cache.Prefetch (addr, size);
+}
     
 size_t
 Process::ReadCStringFromMemory (addr_t addr, std::string &out_str, Error &error)
@@ -274,6 +274,42 @@ SectionLoadList::ResolveLoadAddress (addr_t load_addr, Address &so_addr) const
     return false;
 }
 
+size_t
+SectionLoadList::ResolveLoadAddresses (const addr_t *load_addrs, size_t num_addrs, Address *so_addrs) const
+{
+    size_t num_resolved = 0;
+    Mutex::Locker locker(m_mutex);
+    addr_to_sect_collection::const_iterator pos = m_addr_to_sect.end();
+    for (size_t i = 0; i < num_addrs; ++i)
+    {
+        const addr_t load_addr = load_addrs[i];
+        // Sorted addresses tend to come in runs within the same section, so
+        // only look the section up again once we have moved past it
+        if (pos == m_addr_to_sect.end() ||
+            load_addr < pos->first ||
+            load_addr - pos->first >= pos->second->GetByteSize())
+        {
+            pos = m_addr_to_sect.upper_bound (load_addr);
+            if (pos == m_addr_to_sect.begin())
+                pos = m_addr_to_sect.end();
+            else
+                --pos;
+        }
+
+        if (pos != m_addr_to_sect.end() &&
+            load_addr - pos->first < pos->second->GetByteSize() &&
+            pos->second->ResolveContainedAddress (load_addr - pos->first, so_addrs[i]))
+        {
+            ++num_resolved;
+        }
+        else
+        {
+            so_addrs[i].Clear();
+        }
+    }
+    return num_resolved;
+}
+
 void
 SectionLoadList::Dump (Stream &s, Target *target)
 {
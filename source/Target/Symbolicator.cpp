@@ -0,0 +1,274 @@
+//===-- Symbolicator.cpp ----------------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "lldb/Target/Symbolicator.h"
+
+// C Includes
+// C++ Includes
+#include <algorithm>
+
+// Other libraries and framework includes
+// Project includes
+#include "lldb/Core/Log.h"
+#include "lldb/Core/Module.h"
+#include "lldb/Core/Section.h"
+#include "lldb/Symbol/CompileUnit.h"
+#include "lldb/Symbol/LineTable.h"
+#include "lldb/Symbol/ObjectFile.h"
+#include "lldb/Symbol/Symbol.h"
+#include "lldb/Symbol/SymbolContext.h"
+#include "lldb/Symbol/SymbolVendor.h"
+#include "lldb/Symbol/Symtab.h"
+#include "lldb/Target/SectionLoadList.h"
+#include "lldb/Target/Target.h"
+#include "lldb/Utility/TaskPool.h"
+
+using namespace lldb;
+using namespace lldb_private;
+
+namespace
+{
+    // An address that resolved to a module, with its position in the
+    // batch once the batch is sorted by load address
+    struct ModuleAddress
+    {
+        Module *module;
+        addr_t file_addr;
+        uint32_t sorted_idx;
+
+        bool
+        operator < (const ModuleAddress &rhs) const
+        {
+            if (module != rhs.module)
+                return module < rhs.module;
+            if (file_addr != rhs.file_addr)
+                return file_addr < rhs.file_addr;
+            return sorted_idx < rhs.sorted_idx;
+        }
+    };
+}
+
+Symbolicator::Symbolicator () :
+    m_entries (),
+    m_modules ()
+{
+}
+
+Symbolicator::~Symbolicator ()
+{
+}
+
+void
+Symbolicator::Clear ()
+{
+    m_entries.clear();
+    m_modules.clear();
+}
+
+ModuleSP
+Symbolicator::GetModuleForEntry (const Entry &entry) const
+{
+    if (entry.module_idx < m_modules.size())
+        return m_modules[entry.module_idx];
+    return ModuleSP();
+}
+
+//----------------------------------------------------------------------
+// Resolve the symbols and line entries for the addresses in one module,
+// which are sorted by file address.
+//----------------------------------------------------------------------
+static void
+SymbolicateModuleAddresses (Module &module,
+                            const ModuleAddress *addrs,
+                            size_t num_addrs,
+                            const std::vector<Address> &so_addrs,
+                            const std::vector<uint32_t> &sorted_to_entry,
+                            std::vector<Symbolicator::Entry> &entries)
+{
+    Mutex::Locker locker (module.GetMutex());
+
+    SymbolVendor *sym_vendor = module.GetSymbolVendor();
+    if (sym_vendor == NULL)
+        return;
+
+    std::vector<Symbol *> symbols (num_addrs, NULL);
+    bool symtab_is_stripped = false;
+    Symtab *symtab = sym_vendor->GetSymtab();
+    if (symtab)
+    {
+        std::vector<addr_t> file_addrs (num_addrs);
+        for (size_t i = 0; i < num_addrs; ++i)
+            file_addrs[i] = addrs[i].file_addr;
+        symtab->FindSymbolsContainingFileAddresses (file_addrs.data(), num_addrs, symbols.data());
+
+        ObjectFile *symtab_objfile = symtab->GetObjectFile();
+        symtab_is_stripped = symtab_objfile && symtab_objfile->IsStripped();
+    }
+
+    LineTable *line_table = NULL;
+    LineEntry line_entry;
+    for (size_t i = 0; i < num_addrs; ++i)
+    {
+        const addr_t file_addr = addrs[i].file_addr;
+        const Address &so_addr = so_addrs[addrs[i].sorted_idx];
+        Symbolicator::Entry &entry = entries[sorted_to_entry[addrs[i].sorted_idx]];
+
+        Symbol *symbol = symbols[i];
+        if (symbol && symbol->IsSynthetic() && symtab_is_stripped)
+        {
+            // The symbol file may have a better symbol than the stripped
+            // symbol table, which the module knows how to find
+            SymbolContext sc;
+            module.ResolveSymbolContextForAddress (so_addr, eSymbolContextSymbol, sc);
+            if (sc.symbol)
+                symbol = sc.symbol;
+        }
+        if (symbol)
+        {
+            entry.symbol_name = symbol->GetName();
+            entry.symbol_offset = file_addr - symbol->GetAddress().GetFileAddress();
+        }
+
+        // Most addresses are in the same line entry, or at least the same
+        // compile unit, as the one before them. Since the addresses are
+        // sorted, a miss in the previous line table means it's somewhere
+        // else, and only then do we ask the symbol file.
+        if (!line_entry.range.ContainsFileAddress (file_addr))
+        {
+            if (line_table == NULL || !line_table->FindLineEntryByAddress (so_addr, line_entry))
+            {
+                SymbolContext sc;
+                const uint32_t resolved = module.ResolveSymbolContextForAddress (so_addr,
+                                                                                 eSymbolContextCompUnit | eSymbolContextLineEntry,
+                                                                                 sc);
+                if (resolved & eSymbolContextLineEntry)
+                {
+                    line_entry = sc.line_entry;
+                    line_table = sc.comp_unit ? sc.comp_unit->GetLineTable() : NULL;
+                }
+                else
+                {
+                    line_entry.Clear();
+                    line_table = NULL;
+                }
+            }
+        }
+        if (line_entry.IsValid())
+        {
+            entry.file = line_entry.file;
+            entry.line = line_entry.line;
+            entry.column = line_entry.column;
+        }
+    }
+}
+
+void
+Symbolicator::Symbolicate (Target &target,
+                           const addr_t *load_addrs,
+                           size_t num_addrs,
+                           uint32_t num_threads)
+{
+    Clear();
+    if (num_addrs == 0)
+        return;
+
+    m_entries.resize (num_addrs);
+    for (size_t i = 0; i < num_addrs; ++i)
+    {
+        Entry &entry = m_entries[i];
+        entry.load_addr = load_addrs[i];
+        entry.file_addr = LLDB_INVALID_ADDRESS;
+        entry.symbol_offset = 0;
+        entry.module_idx = UINT32_MAX;
+        entry.line = 0;
+        entry.column = 0;
+    }
+
+    // Sort by load address so that each section is found once for all of
+    // the addresses in it
+    std::vector<uint32_t> sorted_to_entry (num_addrs);
+    for (size_t i = 0; i < num_addrs; ++i)
+        sorted_to_entry[i] = i;
+    std::sort (sorted_to_entry.begin(), sorted_to_entry.end(),
+               [load_addrs](uint32_t lhs, uint32_t rhs) { return load_addrs[lhs] < load_addrs[rhs]; });
+
+    std::vector<addr_t> sorted_load_addrs (num_addrs);
+    for (size_t i = 0; i < num_addrs; ++i)
+        sorted_load_addrs[i] = load_addrs[sorted_to_entry[i]];
+
+    std::vector<Address> so_addrs (num_addrs);
+    SectionLoadList &section_load_list = target.GetSectionLoadList();
+    if (section_load_list.IsEmpty())
+    {
+        // Nothing has been loaded, so the load addresses are file addresses
+        const ModuleList &images = target.GetImages();
+        for (size_t i = 0; i < num_addrs; ++i)
+            images.ResolveFileAddress (sorted_load_addrs[i], so_addrs[i]);
+    }
+    else
+    {
+        section_load_list.ResolveLoadAddresses (sorted_load_addrs.data(), num_addrs, so_addrs.data());
+    }
+
+    std::vector<ModuleAddress> module_addrs;
+    module_addrs.reserve (num_addrs);
+    Section *prev_section = NULL;
+    Module *prev_module = NULL;
+    for (size_t i = 0; i < num_addrs; ++i)
+    {
+        SectionSP section_sp (so_addrs[i].GetSection());
+        if (!section_sp)
+            continue;
+        // Neighbouring addresses are mostly in the same section
+        if (section_sp.get() != prev_section)
+        {
+            prev_section = section_sp.get();
+            prev_module = section_sp->GetModule().get();
+        }
+        if (prev_module == NULL)
+            continue;
+        ModuleAddress module_addr = { prev_module, so_addrs[i].GetFileAddress(), (uint32_t)i };
+        module_addrs.push_back (module_addr);
+        m_entries[sorted_to_entry[i]].file_addr = module_addr.file_addr;
+    }
+    std::sort (module_addrs.begin(), module_addrs.end());
+
+    // Each run of addresses in the same module is resolved by one worker
+    std::vector<size_t> module_starts;
+    for (size_t i = 0; i < module_addrs.size(); ++i)
+    {
+        if (i == 0 || module_addrs[i].module != module_addrs[i - 1].module)
+        {
+            module_starts.push_back (i);
+            m_modules.push_back (module_addrs[i].module->shared_from_this());
+        }
+        m_entries[sorted_to_entry[module_addrs[i].sorted_idx]].module_idx = m_modules.size() - 1;
+    }
+    module_starts.push_back (module_addrs.size());
+
+    const uint32_t num_modules = m_modules.size();
+    num_threads = TaskPool::GetNumWorkers (num_modules, num_threads);
+
+    Log *log(lldb_private::GetLogIfAllCategoriesSet (LIBLLDB_LOG_SYMBOLS));
+    if (log)
+        log->Printf ("Symbolicator::%s resolving %" PRIu64 " addresses in %u modules on %u workers",
+                     __FUNCTION__, (uint64_t)num_addrs, num_modules, num_threads);
+
+    TaskPool::MapOverInt (0, num_modules, num_threads,
+                          [this, &module_addrs, &module_starts, &so_addrs, &sorted_to_entry](uint32_t idx, uint32_t /*worker_idx*/)
+                          {
+                              const size_t start = module_starts[idx];
+                              SymbolicateModuleAddresses (*m_modules[idx],
+                                                          &module_addrs[start],
+                                                          module_starts[idx + 1] - start,
+                                                          so_addrs,
+                                                          sorted_to_entry,
+                                                          m_entries);
+                          });
+}
@@ -22,6 +22,7 @@
 #include "lldb/Breakpoint/BreakpointResolverName.h"
 #include "lldb/Breakpoint/Watchpoint.h"
 #include "lldb/Core/Debugger.h"
+#include "lldb/Core/Disassembler.h"
 #include "lldb/Core/Event.h"
 #include "lldb/Core/Log.h"
 #include "lldb/Core/Module.h"
@@ -36,6 +37,7 @@
 #include "lldb/Expression/ClangASTSource.h"
 #include "lldb/Expression/ClangPersistentVariables.h"
 #include "lldb/Expression/ClangUserExpression.h"
+#include "lldb/Expression/ClangUserExpressionCache.h"
 #include "lldb/Expression/ClangModulesDeclVendor.h"
 #include "lldb/Host/FileSpec.h"
 #include "lldb/Host/Host.h"
@@ -88,6 +90,8 @@ Target::Target(Debugger &debugger, const ArchSpec &target_arch, const lldb::Plat
     m_scratch_ast_source_ap (),
     m_ast_importer_ap (),
     m_persistent_variables (new ClangPersistentVariables),
+    m_user_expression_cache_ap (new ClangUserExpressionCache),
+    m_modules_generation (0),
     m_source_manager_ap(),
     m_stop_hooks (),
     m_stop_hook_next_id (0),
@@ -196,6 +200,9 @@ Target::DeleteCurrentProcess ()
         CleanupProcess ();
 
         m_process_sp.reset();
+
+        // Drop the expressions that were compiled for that process
+        m_user_expression_cache_ap->Clear();
     }
 }
 
@@ -231,6 +238,7 @@ Target::Destroy()
     m_search_filter_sp.reset();
     m_image_search_paths.Clear(notify);
     m_persistent_variables->Clear();
+    m_user_expression_cache_ap->Clear();
     m_stop_hooks.clear();
     m_stop_hook_next_id = 0;
     m_suppress_stop_hooks = false;
@@ -1277,7 +1285,10 @@ Target::ModuleUpdated (const ModuleList& module_list, const ModuleSP &old_module
 {
     // A module is replacing an already added module
     if (m_valid)
+    {
+        m_modules_generation++;
         m_breakpoint_list.UpdateBreakpointsWhenModuleIsReplaced(old_module_sp, new_module_sp);
+    }
 }
 
 void
@@ -1285,6 +1296,7 @@ Target::ModulesDidLoad (ModuleList &module_list)
 {
     if (m_valid && module_list.GetSize())
     {
+        m_modules_generation++;
         m_breakpoint_list.UpdateBreakpoints (module_list, true, false);
         if (m_process_sp)
         {
@@ -1299,6 +1311,7 @@ Target::SymbolsDidLoad (ModuleList &module_list)
 {
     if (m_valid && module_list.GetSize())
     {
+        m_modules_generation++;
         if (m_process_sp)
         {
             LanguageRuntime* runtime = m_process_sp->GetLanguageRuntime(lldb::eLanguageTypeObjC);
@@ -1319,7 +1332,11 @@ Target::ModulesDidUnload (ModuleList &module_list, bool delete_locations)
 {
     if (m_valid && module_list.GetSize())
     {
+        m_modules_generation++;
         UnloadModuleSections (module_list);
+        const size_t num_modules = module_list.GetSize();
+        for (size_t i = 0; i < num_modules; ++i)
+            Disassembler::RemoveCachedInstructions (module_list.GetModulePointerAtIndex(i));
         m_breakpoint_list.UpdateBreakpoints (module_list, false, delete_locations);
         BroadcastEvent (eBroadcastBitModulesUnloaded, new TargetEventData (this->shared_from_this(), module_list));
     }
@@ -1933,6 +1950,15 @@ Target::GetDefaultDebugFileSearchPaths ()
     return FileSpecList();
 }
 
+FileSpec
+Target::GetDefaultIndexCachePath ()
+{
+    TargetPropertiesSP properties_sp(Target::GetGlobalProperties());
+    if (properties_sp)
+        return properties_sp->GetIndexCachePath();
+    return FileSpec();
+}
+
 FileSpecList
 Target::GetDefaultClangModuleSearchPaths ()
 {
@@ -2048,6 +2074,12 @@ Target::GetPersistentVariables()
     return *m_persistent_variables;
 }
 
+ClangUserExpressionCache &
+Target::GetUserExpressionCache ()
+{
+    return *m_user_expression_cache_ap;
+}
+
 lldb::addr_t
 Target::GetCallableLoadAddress (lldb::addr_t load_addr, AddressClass addr_class) const
 {
@@ -2947,11 +2979,13 @@ g_properties[] =
       "Each element of the array is checked in order and the first one that results in a match wins." },
     { "exec-search-paths"                  , OptionValue::eTypeFileSpecList, false, 0                       , NULL, NULL, "Executable search paths to use when locating executable files whose paths don't match the local file system." },
     { "debug-file-search-paths"            , OptionValue::eTypeFileSpecList, false, 0                       , NULL, NULL, "List of directories to be searched when locating debug symbol files." },
+    { "index-cache-path"                   , OptionValue::eTypeFileSpec  , true , 0                         , NULL, NULL, "The directory in which symbol table and debug info name indexes are cached between debug sessions. The cache is disabled when this is empty." },
     { "clang-module-search-paths"          , OptionValue::eTypeFileSpecList, false, 0                       , NULL, NULL, "List of directories to be searched when locating modules for Clang." },
     { "auto-import-clang-modules"          , OptionValue::eTypeBoolean   , false, false                     , NULL, NULL, "Automatically load Clang modules referred to by the program." },
     { "max-children-count"                 , OptionValue::eTypeSInt64    , false, 256                       , NULL, NULL, "Maximum number of children to expand in any level of depth." },
     { "max-string-summary-length"          , OptionValue::eTypeSInt64    , false, 1024                      , NULL, NULL, "Maximum number of characters to show when using %s in summary strings." },
     { "max-memory-read-size"               , OptionValue::eTypeSInt64    , false, 1024                      , NULL, NULL, "Maximum number of bytes that 'memory read' will fetch before --force must be specified." },
+    { "expression-cache-size"              , OptionValue::eTypeSInt64    , false, 64                        , NULL, NULL, "Maximum number of parsed expressions to keep so that evaluating the same expression again in the same block doesn't reparse it. Set to zero to parse every expression." },
     { "breakpoints-use-platform-avoid-list", OptionValue::eTypeBoolean   , false, true                      , NULL, NULL, "Consult the platform module avoid list when setting non-module specific breakpoints." },
     { "arg0"                               , OptionValue::eTypeString    , false, 0                         , NULL, NULL, "The first argument passed to the program in the argument array which can be different from the executable itself." },
     { "run-args"                           , OptionValue::eTypeArgs      , false, 0                         , NULL, NULL, "A list containing all the arguments to be passed to the executable when it is run. Note that this does NOT include the argv[0] which is in target.arg0." },
@@ -3001,11 +3035,13 @@ enum
     ePropertySourceMap,
     ePropertyExecutableSearchPaths,
     ePropertyDebugFileSearchPaths,
+    ePropertyIndexCachePath,
     ePropertyClangModuleSearchPaths,
     ePropertyAutoImportClangModules,
     ePropertyMaxChildrenCount,
     ePropertyMaxSummaryLength,
     ePropertyMaxMemReadSize,
+    ePropertyExpressionCacheSize,
     ePropertyBreakpointUseAvoidList,
     ePropertyArg0,
     ePropertyRunArgs,
@@ -3363,6 +3399,13 @@ TargetProperties::GetDebugFileSearchPaths ()
     return option_value->GetCurrentValue();
 }
 
+FileSpec
+TargetProperties::GetIndexCachePath () const
+{
+    const uint32_t idx = ePropertyIndexCachePath;
+    return m_collection_sp->GetPropertyAtIndexAsFileSpec (NULL, idx);
+}
+
 FileSpecList &
 TargetProperties::GetClangModuleSearchPaths ()
 {
@@ -3407,6 +3450,13 @@ TargetProperties::GetMaximumMemReadSize () const
     return m_collection_sp->GetPropertyAtIndexAsSInt64 (NULL, idx, g_properties[idx].default_uint_value);
 }
 
+uint32_t
+TargetProperties::GetExpressionCacheSize () const
+{
+    const uint32_t idx = ePropertyExpressionCacheSize;
+    return m_collection_sp->GetPropertyAtIndexAsSInt64 (NULL, idx, g_properties[idx].default_uint_value);
+}
+
 FileSpec
 TargetProperties::GetStandardInputPath () const
 {
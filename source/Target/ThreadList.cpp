@@ -18,6 +18,7 @@
 #include "lldb/Target/ThreadPlan.h"
 #include "lldb/Target/Process.h"
 #include "lldb/Utility/ConvertEnum.h"
+#include "lldb/Utility/TaskPool.h"
 
 using namespace lldb;
 using namespace lldb_private;
@@ -495,6 +496,60 @@ ThreadList::DiscardThreadPlans ()
 
 }
 
+void
+ThreadList::PrefetchStackFrames (uint32_t num_frames)
+{
+    if (num_frames == 0 || !StateIsStoppedState (m_process->GetState(), true))
+        return;
+
+    // Don't hold the thread list mutex while unwinding, the workers would
+    // deadlock on it as soon as anything they call looks at the list.
+    std::vector<ThreadSP> threads;
+    {
+        Mutex::Locker locker(GetMutex());
+        m_process->UpdateThreadListIfNeeded();
+        threads = m_threads;
+    }
+    if (threads.size() < 2)
+        return;
+
+    // Threads from an OS plug-in are backed by the script interpreter,
+    // which we don't want to enter from several threads at once.
+    uint32_t num_threads = m_process->GetUnwindThreadCount();
+    if (m_process->GetOperatingSystem())
+        num_threads = 1;
+    num_threads = TaskPool::GetNumWorkers (threads.size(), num_threads);
+
+    Log *log(lldb_private::GetLogIfAllCategoriesSet (LIBLLDB_LOG_THREAD));
+    if (log)
+        log->Printf ("ThreadList::%s unwinding %" PRIu64 " threads on %u workers",
+                     __FUNCTION__, (uint64_t)threads.size(), num_threads);
+
+    // Prefetch each thread's stack just before it is unwound. Doing all
+    // the prefetches up front would have later threads evict the stacks
+    // of earlier ones from the memory cache when there are many threads.
+    const size_t stack_prefetch_size = m_process->GetStackPrefetchSize();
+    TaskPool::MapOverInt (0, threads.size(), num_threads,
+                          [&threads, num_frames, stack_prefetch_size](uint32_t idx, uint32_t /*worker_idx*/)
+                          {
+                              Thread *thread = threads[idx].get();
+                              if (stack_prefetch_size > 0)
+                              {
+                                  RegisterContextSP reg_ctx_sp (thread->GetRegisterContext());
+                                  if (reg_ctx_sp)
+                                  {
+                                      const addr_t sp = reg_ctx_sp->GetSP (LLDB_INVALID_ADDRESS);
+                                      if (sp != LLDB_INVALID_ADDRESS)
+                                          thread->GetProcess()->PrefetchMemory (sp, stack_prefetch_size);
+                                  }
+                              }
+                              if (num_frames == UINT32_MAX)
+                                  thread->GetStackFrameCount();
+                              else
+                                  thread->GetStackFrameAtIndex (num_frames - 1);
+                          });
+}
+
 bool
 ThreadList::WillResume ()
 {
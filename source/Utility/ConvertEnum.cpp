@@ -63,6 +63,8 @@ lldb_private::GetSectionTypeAsCString(lldb::SectionType sect_type)
             return "objc-cfstrings";
         case eSectionTypeDWARFDebugAbbrev:
             return "dwarf-abbrev";
+        case eSectionTypeDWARFDebugAddr:
+            return "dwarf-addr";
         case eSectionTypeDWARFDebugAranges:
             return "dwarf-aranges";
         case eSectionTypeDWARFDebugFrame:
@@ -83,6 +85,8 @@ lldb_private::GetSectionTypeAsCString(lldb::SectionType sect_type)
             return "dwarf-ranges";
         case eSectionTypeDWARFDebugStr:
             return "dwarf-str";
+        case eSectionTypeDWARFDebugStrOffsets:
+            return "dwarf-str-offsets";
         case eSectionTypeELFSymbolTable:
             return "elf-symbol-table";
         case eSectionTypeELFDynamicSymbols:
@@ -0,0 +1,332 @@
+//===-- HexCoding.cpp -------------------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "lldb/Utility/HexCoding.h"
+
+// C Includes
+#include <string.h>
+
+// C++ Includes
+#include <algorithm>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__SSE2__)
+#define LLDB_HEX_CODING_SSE2
+#include <emmintrin.h>
+#endif
+
+// AVX2 kernels are built with the target attribute so the rest of the file
+// doesn't need -mavx2, and are only used when the CPU has AVX2.
+#if defined(LLDB_HEX_CODING_SSE2) && !defined(_MSC_VER)
+#if defined(__clang__)
+#if defined(__has_attribute) && defined(__has_builtin)
+#if __has_attribute(target) && __has_builtin(__builtin_cpu_supports)
+#define LLDB_HEX_CODING_AVX2
+#endif
+#endif
+#elif defined(__GNUC__) && (__GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 9))
+#define LLDB_HEX_CODING_AVX2
+#endif
+#endif
+
+#if defined(LLDB_HEX_CODING_AVX2)
+#include <immintrin.h>
+#define LLDB_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+
+using namespace lldb_private;
+
+namespace
+{
+    typedef void (*HexEncodeFunc) (const uint8_t *src, size_t src_len, char *dst);
+    typedef size_t (*HexDecodeFunc) (const char *src, size_t num_bytes, uint8_t *dst);
+    typedef uint64_t (*SumFunc) (const uint8_t *src, size_t src_len);
+
+    struct HexCodingKernels
+    {
+        HexEncodeFunc encode;
+        HexDecodeFunc decode;
+        SumFunc sum;
+    };
+}
+
+static const char g_hex_digits[] = "0123456789abcdef";
+
+// The value of each hex digit, 0xff for characters that aren't hex digits
+static const uint8_t g_hex_values[256] =
+{
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff
+};
+
+//----------------------------------------------------------------------
+// Scalar versions, also used for what is left after the vector loops
+//----------------------------------------------------------------------
+static void
+HexEncodeScalar (const uint8_t *src, size_t src_len, char *dst)
+{
+    for (size_t i = 0; i < src_len; ++i)
+    {
+        dst[2 * i] = g_hex_digits[src[i] >> 4];
+        dst[2 * i + 1] = g_hex_digits[src[i] & 0xf];
+    }
+}
+
+static size_t
+HexDecodeScalar (const char *src, size_t num_bytes, uint8_t *dst)
+{
+    for (size_t i = 0; i < num_bytes; ++i)
+    {
+        const uint8_t hi_nibble = g_hex_values[(uint8_t)src[2 * i]];
+        const uint8_t lo_nibble = g_hex_values[(uint8_t)src[2 * i + 1]];
+        if ((hi_nibble | lo_nibble) & 0xf0)
+            return i;
+        dst[i] = (hi_nibble << 4) | lo_nibble;
+    }
+    return num_bytes;
+}
+
+static uint64_t
+SumScalar (const uint8_t *src, size_t src_len)
+{
+    uint64_t sum = 0;
+    for (size_t i = 0; i < src_len; ++i)
+        sum += src[i];
+    return sum;
+}
+
+#if defined(LLDB_HEX_CODING_SSE2)
+//----------------------------------------------------------------------
+// SSE2 versions, which every x86_64 CPU has
+//----------------------------------------------------------------------
+
+// Turns 16 nibble values into their hex digits
+static inline __m128i
+NibblesToHexSSE2 (__m128i nibbles)
+{
+    // '0' + nibble, plus the distance from '9' + 1 to 'a' for nibbles over 9
+    const __m128i letters = _mm_and_si128 (_mm_cmpgt_epi8 (nibbles, _mm_set1_epi8 (9)), _mm_set1_epi8 ('a' - '9' - 1));
+    return _mm_add_epi8 (_mm_add_epi8 (nibbles, _mm_set1_epi8 ('0')), letters);
+}
+
+static void
+HexEncodeSSE2 (const uint8_t *src, size_t src_len, char *dst)
+{
+    const __m128i low_mask = _mm_set1_epi8 (0x0f);
+    size_t i = 0;
+    for (; i + 16 <= src_len; i += 16)
+    {
+        const __m128i bytes = _mm_loadu_si128 ((const __m128i *)(src + i));
+        const __m128i hi = NibblesToHexSSE2 (_mm_and_si128 (_mm_srli_epi16 (bytes, 4), low_mask));
+        const __m128i lo = NibblesToHexSSE2 (_mm_and_si128 (bytes, low_mask));
+        // The high nibble's digit comes first
+        _mm_storeu_si128 ((__m128i *)(dst + 2 * i), _mm_unpacklo_epi8 (hi, lo));
+        _mm_storeu_si128 ((__m128i *)(dst + 2 * i + 16), _mm_unpackhi_epi8 (hi, lo));
+    }
+    HexEncodeScalar (src + i, src_len - i, dst + 2 * i);
+}
+
+// Turns 16 hex digits into their values, returns false if any of them
+// isn't a hex digit. Characters over 0x7f are negative as signed bytes so
+// they fail both range checks.
+static inline bool
+HexToNibblesSSE2 (__m128i chars, __m128i &nibbles)
+{
+    const __m128i is_digit = _mm_and_si128 (_mm_cmpgt_epi8 (chars, _mm_set1_epi8 ('0' - 1)),
+                                            _mm_cmplt_epi8 (chars, _mm_set1_epi8 ('9' + 1)));
+    const __m128i lower = _mm_or_si128 (chars, _mm_set1_epi8 (0x20));
+    const __m128i is_letter = _mm_and_si128 (_mm_cmpgt_epi8 (lower, _mm_set1_epi8 ('a' - 1)),
+                                             _mm_cmplt_epi8 (lower, _mm_set1_epi8 ('f' + 1)));
+    if (_mm_movemask_epi8 (_mm_or_si128 (is_digit, is_letter)) != 0xffff)
+        return false;
+    nibbles = _mm_or_si128 (_mm_and_si128 (is_digit, _mm_sub_epi8 (chars, _mm_set1_epi8 ('0'))),
+                            _mm_and_si128 (is_letter, _mm_sub_epi8 (lower, _mm_set1_epi8 ('a' - 10))));
+    return true;
+}
+
+// Combines each pair of nibbles into a byte in the low half of a 16-bit lane
+static inline __m128i
+CombineNibblesSSE2 (__m128i nibbles)
+{
+    return _mm_or_si128 (_mm_slli_epi16 (_mm_and_si128 (nibbles, _mm_set1_epi16 (0x00ff)), 4),
+                         _mm_srli_epi16 (nibbles, 8));
+}
+
+static size_t
+HexDecodeSSE2 (const char *src, size_t num_bytes, uint8_t *dst)
+{
+    size_t i = 0;
+    for (; i + 16 <= num_bytes; i += 16)
+    {
+        __m128i first, second;
+        if (!HexToNibblesSSE2 (_mm_loadu_si128 ((const __m128i *)(src + 2 * i)), first) ||
+            !HexToNibblesSSE2 (_mm_loadu_si128 ((const __m128i *)(src + 2 * i + 16)), second))
+            break; // Let the scalar loop find where exactly decoding stops
+        _mm_storeu_si128 ((__m128i *)(dst + i), _mm_packus_epi16 (CombineNibblesSSE2 (first), CombineNibblesSSE2 (second)));
+    }
+    return i + HexDecodeScalar (src + 2 * i, num_bytes - i, dst + i);
+}
+
+static uint64_t
+SumSSE2 (const uint8_t *src, size_t src_len)
+{
+    const __m128i zero = _mm_setzero_si128 ();
+    __m128i sums = zero;
+    size_t i = 0;
+    for (; i + 16 <= src_len; i += 16)
+        sums = _mm_add_epi64 (sums, _mm_sad_epu8 (_mm_loadu_si128 ((const __m128i *)(src + i)), zero));
+    uint64_t lanes[2];
+    _mm_storeu_si128 ((__m128i *)lanes, sums);
+    return lanes[0] + lanes[1] + SumScalar (src + i, src_len - i);
+}
+#endif // LLDB_HEX_CODING_SSE2
+
+#if defined(LLDB_HEX_CODING_AVX2)
+//----------------------------------------------------------------------
+// AVX2 versions, which do twice as much per instruction. The unpack and
+// pack instructions work within each 128-bit lane, so the lanes are
+// shuffled back into order around them.
+//----------------------------------------------------------------------
+LLDB_TARGET_AVX2 static inline __m256i
+NibblesToHexAVX2 (__m256i nibbles)
+{
+    const __m256i letters = _mm256_and_si256 (_mm256_cmpgt_epi8 (nibbles, _mm256_set1_epi8 (9)), _mm256_set1_epi8 ('a' - '9' - 1));
+    return _mm256_add_epi8 (_mm256_add_epi8 (nibbles, _mm256_set1_epi8 ('0')), letters);
+}
+
+LLDB_TARGET_AVX2 static void
+HexEncodeAVX2 (const uint8_t *src, size_t src_len, char *dst)
+{
+    const __m256i low_mask = _mm256_set1_epi8 (0x0f);
+    size_t i = 0;
+    for (; i + 32 <= src_len; i += 32)
+    {
+        const __m256i bytes = _mm256_loadu_si256 ((const __m256i *)(src + i));
+        const __m256i hi = NibblesToHexAVX2 (_mm256_and_si256 (_mm256_srli_epi16 (bytes, 4), low_mask));
+        const __m256i lo = NibblesToHexAVX2 (_mm256_and_si256 (bytes, low_mask));
+        const __m256i first = _mm256_unpacklo_epi8 (hi, lo);    // Bytes 0-7 and 16-23
+        const __m256i second = _mm256_unpackhi_epi8 (hi, lo);   // Bytes 8-15 and 24-31
+        _mm256_storeu_si256 ((__m256i *)(dst + 2 * i), _mm256_permute2x128_si256 (first, second, 0x20));
+        _mm256_storeu_si256 ((__m256i *)(dst + 2 * i + 32), _mm256_permute2x128_si256 (first, second, 0x31));
+    }
+    HexEncodeSSE2 (src + i, src_len - i, dst + 2 * i);
+}
+
+LLDB_TARGET_AVX2 static inline bool
+HexToNibblesAVX2 (__m256i chars, __m256i &nibbles)
+{
+    const __m256i is_digit = _mm256_and_si256 (_mm256_cmpgt_epi8 (chars, _mm256_set1_epi8 ('0' - 1)),
+                                               _mm256_cmpgt_epi8 (_mm256_set1_epi8 ('9' + 1), chars));
+    const __m256i lower = _mm256_or_si256 (chars, _mm256_set1_epi8 (0x20));
+    const __m256i is_letter = _mm256_and_si256 (_mm256_cmpgt_epi8 (lower, _mm256_set1_epi8 ('a' - 1)),
+                                                _mm256_cmpgt_epi8 (_mm256_set1_epi8 ('f' + 1), lower));
+    if (_mm256_movemask_epi8 (_mm256_or_si256 (is_digit, is_letter)) != -1)
+        return false;
+    nibbles = _mm256_or_si256 (_mm256_and_si256 (is_digit, _mm256_sub_epi8 (chars, _mm256_set1_epi8 ('0'))),
+                               _mm256_and_si256 (is_letter, _mm256_sub_epi8 (lower, _mm256_set1_epi8 ('a' - 10))));
+    return true;
+}
+
+LLDB_TARGET_AVX2 static inline __m256i
+CombineNibblesAVX2 (__m256i nibbles)
+{
+    return _mm256_or_si256 (_mm256_slli_epi16 (_mm256_and_si256 (nibbles, _mm256_set1_epi16 (0x00ff)), 4),
+                            _mm256_srli_epi16 (nibbles, 8));
+}
+
+LLDB_TARGET_AVX2 static size_t
+HexDecodeAVX2 (const char *src, size_t num_bytes, uint8_t *dst)
+{
+    size_t i = 0;
+    for (; i + 32 <= num_bytes; i += 32)
+    {
+        __m256i first, second;
+        if (!HexToNibblesAVX2 (_mm256_loadu_si256 ((const __m256i *)(src + 2 * i)), first) ||
+            !HexToNibblesAVX2 (_mm256_loadu_si256 ((const __m256i *)(src + 2 * i + 32)), second))
+            break;
+        // The pack interleaves the lanes of its operands, put them back in order
+        const __m256i packed = _mm256_packus_epi16 (CombineNibblesAVX2 (first), CombineNibblesAVX2 (second));
+        _mm256_storeu_si256 ((__m256i *)(dst + i), _mm256_permute4x64_epi64 (packed, 0xd8));
+    }
+    return i + HexDecodeSSE2 (src + 2 * i, num_bytes - i, dst + i);
+}
+
+LLDB_TARGET_AVX2 static uint64_t
+SumAVX2 (const uint8_t *src, size_t src_len)
+{
+    const __m256i zero = _mm256_setzero_si256 ();
+    __m256i sums = zero;
+    size_t i = 0;
+    for (; i + 32 <= src_len; i += 32)
+        sums = _mm256_add_epi64 (sums, _mm256_sad_epu8 (_mm256_loadu_si256 ((const __m256i *)(src + i)), zero));
+    uint64_t lanes[4];
+    _mm256_storeu_si256 ((__m256i *)lanes, sums);
+    return lanes[0] + lanes[1] + lanes[2] + lanes[3] + SumSSE2 (src + i, src_len - i);
+}
+#endif // LLDB_HEX_CODING_AVX2
+
+static HexCodingKernels
+SelectKernels ()
+{
+    HexCodingKernels kernels = { HexEncodeScalar, HexDecodeScalar, SumScalar };
+#if defined(LLDB_HEX_CODING_SSE2)
+    kernels.encode = HexEncodeSSE2;
+    kernels.decode = HexDecodeSSE2;
+    kernels.sum = SumSSE2;
+#endif
+#if defined(LLDB_HEX_CODING_AVX2)
+    __builtin_cpu_init ();
+    if (__builtin_cpu_supports ("avx2"))
+    {
+        kernels.encode = HexEncodeAVX2;
+        kernels.decode = HexDecodeAVX2;
+        kernels.sum = SumAVX2;
+    }
+#endif
+    return kernels;
+}
+
+static const HexCodingKernels &
+GetKernels ()
+{
+    static const HexCodingKernels g_kernels = SelectKernels ();
+    return g_kernels;
+}
+
+size_t
+lldb_private::HexEncode (const void *src, size_t src_len, char *dst)
+{
+    GetKernels ().encode ((const uint8_t *)src, src_len, dst);
+    return 2 * src_len;
+}
+
+size_t
+lldb_private::HexDecode (const char *src, size_t src_len, void *dst, size_t dst_len)
+{
+    return GetKernels ().decode (src, std::min (src_len / 2, dst_len), (uint8_t *)dst);
+}
+
+uint8_t
+lldb_private::Checksum8 (const void *src, size_t src_len)
+{
+    return (uint8_t)GetKernels ().sum ((const uint8_t *)src, src_len);
+}
@@ -0,0 +1,238 @@
+//===-- IndexCache.cpp ------------------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "IndexCache.h"
+
+#include "lldb/Core/ConstString.h"
+#include "lldb/Core/DataBufferMemoryMap.h"
+#include "lldb/Core/DataExtractor.h"
+#include "lldb/Core/Log.h"
+#include "lldb/Core/StreamString.h"
+#include "lldb/Host/Endian.h"
+#include "lldb/Host/File.h"
+#include "lldb/Host/Host.h"
+#include "lldb/Host/HostInfo.h"
+#include "llvm/Support/FileSystem.h"
+
+#include <unordered_map>
+
+using namespace lldb;
+using namespace lldb_private;
+
+namespace {
+
+const uint32_t kIndexCacheMagic = 0x5844494c; // 'LIDX'
+const uint32_t kIndexCacheVersion = 2;
+
+// magic, version, mod time, file size, UUID string size, followed by the
+// UUID string and then the signature, number of maps and string table size
+const lldb::offset_t kHeaderSize = 4 + 4 + 8 + 8 + 4;
+
+}  // namespace
+
+IndexCache::IndexCache (const FileSpec &cache_dir,
+                        const UUID &uuid,
+                        const FileSpec &file,
+                        const char *kind,
+                        uint64_t signature) :
+    m_cache_file (),
+    m_uuid (),
+    m_mod_time (0),
+    m_file_size (0),
+    m_signature (signature)
+{
+    if (!cache_dir || !uuid.IsValid() || !file || !file.Exists())
+        return;
+
+    m_uuid = uuid.GetAsString();
+    m_mod_time = file.GetModificationTime().GetAsSecondsSinceJan1_1970();
+    m_file_size = file.GetByteSize();
+
+    std::string filename (file.GetFilename().AsCString(""));
+    filename += '.';
+    filename += kind;
+    filename += "-index";
+
+    m_cache_file = cache_dir;
+    m_cache_file.AppendPathComponent (m_uuid.c_str());
+    m_cache_file.AppendPathComponent (filename.c_str());
+}
+
+bool
+IndexCache::Load (const std::vector<NameToIndexMap *> &maps) const
+{
+    if (!IsValid() || !m_cache_file.Exists())
+        return false;
+
+    Log *log (lldb_private::GetLogIfAllCategoriesSet (LIBLLDB_LOG_SYMBOLS));
+
+    DataBufferMemoryMap buffer;
+    if (buffer.MemoryMapFromFileSpec (&m_cache_file) < kHeaderSize)
+        return false;
+
+    DataExtractor data (buffer.GetBytes(),
+                        buffer.GetByteSize(),
+                        endian::InlHostByteOrder(),
+                        HostInfo::GetArchitecture().GetAddressByteSize());
+    lldb::offset_t offset = 0;
+    bool matches = data.GetU32 (&offset) == kIndexCacheMagic &&
+                   data.GetU32 (&offset) == kIndexCacheVersion &&
+                   data.GetU64 (&offset) == m_mod_time &&
+                   data.GetU64 (&offset) == m_file_size;
+    if (matches)
+    {
+        const uint32_t uuid_size = data.GetU32 (&offset);
+        const char *uuid_cstr = (const char *)data.GetData (&offset, uuid_size);
+        matches = uuid_cstr != NULL &&
+                  m_uuid.compare (0, std::string::npos, uuid_cstr, uuid_size) == 0 &&
+                  data.GetU64 (&offset) == m_signature &&
+                  data.GetU32 (&offset) == maps.size();
+    }
+    if (!matches)
+    {
+        if (log)
+            log->Printf ("IndexCache::Load ('%s') ignoring stale cache entry", m_cache_file.GetPath().c_str());
+        return false;
+    }
+
+    const uint32_t strtab_size = data.GetU32 (&offset);
+    // GetData() returns NULL for empty data, which is fine when there are
+    // no names at all
+    const char *strtab = strtab_size > 0 ? (const char *)data.GetData (&offset, strtab_size) : "";
+    if (strtab == NULL || (strtab_size > 0 && strtab[strtab_size - 1] != '\0'))
+        return false;
+
+    // Validate the entire file before touching any of the maps so that a
+    // truncated or corrupt entry doesn't leave them half filled.
+    const lldb::offset_t maps_offset = offset;
+    for (size_t map_idx = 0; map_idx < maps.size(); ++map_idx)
+    {
+        if (!data.ValidOffsetForDataOfSize (offset, 4))
+            return false;
+        const uint32_t count = data.GetU32 (&offset);
+        if (!data.ValidOffsetForDataOfSize (offset, (lldb::offset_t)count * 8))
+            return false;
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            if (data.GetU32 (&offset) >= strtab_size)
+                return false;
+            offset += 4;
+        }
+    }
+    if (offset != data.GetByteSize())
+        return false;
+
+    offset = maps_offset;
+    for (NameToIndexMap *map : maps)
+    {
+        const uint32_t count = data.GetU32 (&offset);
+        map->Clear();
+        map->Reserve (count);
+        const char *prev_cstr = NULL;
+        uint32_t prev_strx = UINT32_MAX;
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            const uint32_t strx = data.GetU32 (&offset);
+            const uint32_t value = data.GetU32 (&offset);
+            // Entries for the same name are usually adjacent, so avoid
+            // hashing the same string into the string pool again.
+            if (strx != prev_strx)
+            {
+                prev_cstr = ConstString (strtab + strx).GetCString();
+                prev_strx = strx;
+            }
+            map->Append (prev_cstr, value);
+        }
+    }
+
+    if (log)
+        log->Printf ("IndexCache::Load ('%s') loaded %" PRIu64 " maps", m_cache_file.GetPath().c_str(), (uint64_t)maps.size());
+    return true;
+}
+
+bool
+IndexCache::Save (const std::vector<const NameToIndexMap *> &maps) const
+{
+    if (!IsValid())
+        return false;
+
+    Log *log (lldb_private::GetLogIfAllCategoriesSet (LIBLLDB_LOG_SYMBOLS));
+
+    // Build the string table. All strings come from the ConstString pool
+    // so they can be uniqued by pointer.
+    std::unordered_map<const char *, uint32_t> strtab_offsets;
+    StreamString strtab (Stream::eBinary, 4, endian::InlHostByteOrder());
+    for (const NameToIndexMap *map : maps)
+    {
+        const size_t count = map->GetSize();
+        for (size_t i = 0; i < count; ++i)
+        {
+            const char *cstr = map->GetCStringAtIndexUnchecked (i);
+            if (strtab_offsets.find (cstr) == strtab_offsets.end())
+            {
+                strtab_offsets[cstr] = strtab.GetSize();
+                strtab.PutCString (cstr ? cstr : "");
+                strtab.PutChar ('\0');
+            }
+        }
+    }
+
+    StreamString strm (Stream::eBinary, 4, endian::InlHostByteOrder());
+    strm.PutHex32 (kIndexCacheMagic);
+    strm.PutHex32 (kIndexCacheVersion);
+    strm.PutHex64 (m_mod_time);
+    strm.PutHex64 (m_file_size);
+    strm.PutHex32 (m_uuid.size());
+    strm.Write (m_uuid.data(), m_uuid.size());
+    strm.PutHex64 (m_signature);
+    strm.PutHex32 (maps.size());
+    strm.PutHex32 (strtab.GetSize());
+    strm.Write (strtab.GetData(), strtab.GetSize());
+    for (const NameToIndexMap *map : maps)
+    {
+        const size_t count = map->GetSize();
+        strm.PutHex32 (count);
+        for (size_t i = 0; i < count; ++i)
+        {
+            strm.PutHex32 (strtab_offsets[map->GetCStringAtIndexUnchecked (i)]);
+            strm.PutHex32 (map->GetValueAtIndexUnchecked (i));
+        }
+    }
+
+    // Write to a temporary file and rename it into place so concurrent
+    // sessions never see a partially written entry.
+    const std::string cache_path (m_cache_file.GetPath());
+    if (llvm::sys::fs::create_directories (m_cache_file.GetDirectory().GetCString()))
+        return false;
+
+    StreamString tmp_path;
+    tmp_path.Printf ("%s.%" PRIu64 ".tmp", cache_path.c_str(), Host::GetCurrentProcessID());
+    {
+        File file (tmp_path.GetData(), File::eOpenOptionWrite | File::eOpenOptionCanCreate | File::eOpenOptionTruncate);
+        if (!file.IsValid())
+            return false;
+        size_t num_bytes = strm.GetSize();
+        if (file.Write (strm.GetData(), num_bytes).Fail() || num_bytes != strm.GetSize())
+        {
+            file.Close();
+            llvm::sys::fs::remove (tmp_path.GetData());
+            return false;
+        }
+    }
+
+    if (llvm::sys::fs::rename (tmp_path.GetData(), cache_path))
+    {
+        llvm::sys::fs::remove (tmp_path.GetData());
+        return false;
+    }
+
+    if (log)
+        log->Printf ("IndexCache::Save ('%s') wrote %" PRIu64 " bytes", cache_path.c_str(), (uint64_t)strm.GetSize());
+    return true;
+}
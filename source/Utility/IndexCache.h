@@ -0,0 +1,117 @@
+//===-- IndexCache.h --------------------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef utility_IndexCache_h_
+#define utility_IndexCache_h_
+
+#include "lldb/lldb-types.h"
+#include "lldb/lldb-forward.h"
+
+#include "lldb/Core/UniqueCStringMap.h"
+#include "lldb/Core/UUID.h"
+#include "lldb/Host/FileSpec.h"
+
+#include <string>
+#include <vector>
+
+namespace lldb_private {
+
+//----------------------------------------------------------------------
+/// @class IndexCache IndexCache.h "Utility/IndexCache.h"
+/// @brief Persists name indexes for a module between debug sessions.
+///
+/// Name indexes (UniqueCStringMap<uint32_t> objects mapping names to
+/// symbol indexes or DIE offsets) are expensive to compute from symbol
+/// tables and debug info, but only depend on the contents of the file
+/// they were built from. This class stores them in a cache directory:
+///
+///  /${CACHE_ROOT}/${UUID}/${FILENAME}.${KIND}-index
+///
+/// Each cache file starts with a header that records the UUID, the
+/// modification time and the size of the indexed file, and a caller
+/// supplied signature (such as a symbol count). An entry whose header
+/// doesn't match is ignored and later overwritten.
+///
+/// The rest of the file is a single string table followed by a flat
+/// array of (string table offset, value) pairs for each map, so it can
+/// be memory mapped and turned back into maps without any parsing.
+//----------------------------------------------------------------------
+class IndexCache
+{
+public:
+    typedef UniqueCStringMap<uint32_t> NameToIndexMap;
+
+    //------------------------------------------------------------------
+    /// @param[in] cache_dir
+    ///     The root of the cache. If it is not valid, caching is
+    ///     disabled and Load() and Save() do nothing.
+    ///
+    /// @param[in] uuid
+    ///     The UUID of the object file the indexes are built from, which
+    ///     keys the cache entry. If it isn't valid, caching is disabled.
+    ///
+    /// @param[in] file
+    ///     The file the indexes are built from. Its modification time
+    ///     and size are used to validate the cache entry.
+    ///
+    /// @param[in] kind
+    ///     A short name for the kind of index, e.g. "symtab".
+    ///
+    /// @param[in] signature
+    ///     An extra value that must match for an entry to be used.
+    //------------------------------------------------------------------
+    IndexCache (const FileSpec &cache_dir,
+                const UUID &uuid,
+                const FileSpec &file,
+                const char *kind,
+                uint64_t signature);
+
+    bool
+    IsValid () const
+    {
+        return (bool)m_cache_file;
+    }
+
+    const FileSpec &
+    GetCacheFile () const
+    {
+        return m_cache_file;
+    }
+
+    //------------------------------------------------------------------
+    /// Fill in \a maps from the cache entry.
+    ///
+    /// The maps are cleared and filled with unsorted entries; callers
+    /// must sort them as they would after building them by hand.
+    ///
+    /// @return
+    ///     True if a valid entry with the same number of maps was
+    ///     found, false otherwise (in which case \a maps are left
+    ///     untouched).
+    //------------------------------------------------------------------
+    bool
+    Load (const std::vector<NameToIndexMap *> &maps) const;
+
+    //------------------------------------------------------------------
+    /// Write \a maps to the cache entry, replacing any previous one.
+    //------------------------------------------------------------------
+    bool
+    Save (const std::vector<const NameToIndexMap *> &maps) const;
+
+private:
+    FileSpec m_cache_file;
+    std::string m_uuid;
+    uint64_t m_mod_time;
+    uint64_t m_file_size;
+    uint64_t m_signature;
+};
+
+} // namespace lldb_private
+
+#endif  // utility_IndexCache_h_
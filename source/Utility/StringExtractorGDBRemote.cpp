@@ -136,6 +136,10 @@ StringExtractorGDBRemote::GetServerPacketType () const
             if (PACKET_STARTS_WITH ("qfThreadInfo"))            return eServerPacketType_qfThreadInfo;
             break;
 
+        case 'B':
+            if (PACKET_STARTS_WITH ("qBreakpointHitCount:"))    return eServerPacketType_qBreakpointHitCount;
+            break;
+
         case 'C':
             if (packet_size == 2)                               return eServerPacketType_qC;
             break;
@@ -211,6 +215,10 @@ StringExtractorGDBRemote::GetServerPacketType () const
             break;
         }
         break;
+    case 'j':
+        if (PACKET_MATCHES ("jThreadsInfo"))                    return eServerPacketType_jThreadsInfo;
+        break;
+
     case 'v':
             if (PACKET_STARTS_WITH("vFile:"))
             {
@@ -261,7 +269,8 @@ StringExtractorGDBRemote::GetServerPacketType () const
         break;
 
       case 'g':
-        if (packet_size == 1) return eServerPacketType_g;
+        // A thread suffix ("g;thread:XXXX;") may follow.
+        if (packet_size == 1 || packet_cstr[1] == ';') return eServerPacketType_g;
         break;
 
       case 'G':
@@ -299,6 +308,9 @@ StringExtractorGDBRemote::GetServerPacketType () const
       case 'T':
         return eServerPacketType_T;
 
+      case 'x':
+        return eServerPacketType_x;
+
       case 'z':
         if (packet_cstr[1] >= '0' && packet_cstr[1] <= '4')
           return eServerPacketType_z;
@@ -0,0 +1,63 @@
+//===-- TaskPool.cpp --------------------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "lldb/Utility/TaskPool.h"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using namespace lldb_private;
+
+uint32_t
+TaskPool::GetDefaultThreadCount ()
+{
+    const uint32_t num_cpus = std::thread::hardware_concurrency();
+    return num_cpus > 0 ? num_cpus : 1;
+}
+
+uint32_t
+TaskPool::GetNumWorkers (uint32_t num_items, uint32_t num_threads)
+{
+    if (num_threads == 0)
+        num_threads = GetDefaultThreadCount();
+    if (num_threads > num_items)
+        num_threads = num_items;
+    return num_threads > 0 ? num_threads : 1;
+}
+
+void
+TaskPool::MapOverInt (uint32_t begin,
+                      uint32_t end,
+                      uint32_t num_threads,
+                      const std::function<void(uint32_t idx, uint32_t worker_idx)> &func)
+{
+    if (begin >= end)
+        return;
+
+    const uint32_t num_workers = GetNumWorkers (end - begin, num_threads);
+    std::atomic<uint32_t> next_idx (begin);
+
+    auto worker = [&next_idx, end, &func](uint32_t worker_idx)
+    {
+        for (uint32_t idx = next_idx++; idx < end; idx = next_idx++)
+            func (idx, worker_idx);
+    };
+
+    // Worker zero is the calling thread
+    std::vector<std::thread> threads;
+    threads.reserve (num_workers - 1);
+    for (uint32_t worker_idx = 1; worker_idx < num_workers; ++worker_idx)
+        threads.push_back (std::thread (worker, worker_idx));
+
+    worker (0);
+
+    for (auto &thread : threads)
+        thread.join();
+}
@@ -0,0 +1,61 @@
+"""Test the throughput of conditional breakpoint hits."""
+
+import os, sys
+import unittest2
+import lldb
+from lldbbench import *
+import lldbutil
+
+class BreakpointConditionSpeedBench(BenchBase):
+
+    mydir = TestBase.compute_mydir(__file__)
+
+    def setUp(self):
+        BenchBase.setUp(self)
+        self.source = 'main.c'
+        self.count = lldb.bmIterationCount
+        if self.count <= 0:
+            self.count = 5
+        # The number of times main.c calls accumulate().
+        self.num_hits = 2000
+
+    @benchmarks_test
+    def test_breakpoint_condition_speed(self):
+        """Benchmark hitting a breakpoint whose condition is almost always false."""
+        self.buildDefault()
+        self.run_breakpoint_condition_bench(self.count)
+
+    def run_breakpoint_condition_bench(self, count):
+        exe = os.path.join(os.getcwd(), "a.out")
+        target = self.dbg.CreateTarget(exe)
+        self.assertTrue(target, VALID_TARGET)
+
+        # The condition only reads a local and a global, so it can be
+        # evaluated without running anything in the inferior.
+        cond_bkpt = target.BreakpointCreateBySourceRegex("// Set breakpoint here.", lldb.SBFileSpec(self.source))
+        self.assertTrue(cond_bkpt.GetNumLocations() > 0, VALID_BREAKPOINT)
+        cond_bkpt.SetCondition("value < 0 && g_sum >= 0")
+        final_bkpt = target.BreakpointCreateBySourceRegex("// Set final breakpoint here.", lldb.SBFileSpec(self.source))
+        self.assertTrue(final_bkpt.GetNumLocations() > 0, VALID_BREAKPOINT)
+
+        sw = Stopwatch()
+        for i in range(count):
+            with sw:
+                process = target.LaunchSimple(None, None, self.get_process_working_directory())
+                self.assertTrue(process, PROCESS_IS_VALID)
+                thread = lldbutil.get_one_thread_stopped_at_breakpoint(process, final_bkpt)
+                self.assertTrue(thread, "stopped at the final breakpoint")
+            if i == 0:
+                # Evaluating the condition mustn't use up the $N result names.
+                self.expect("expression -- 1", substrs = ['$0 = 1'])
+            process.Kill()
+
+        print
+        print "lldb conditional breakpoint (%d hits) benchmark:" % self.num_hits, sw
+        print "lldb conditional breakpoint hits per second: %.1f" % (self.num_hits / sw.avg())
+
+if __name__ == '__main__':
+    import atexit
+    lldb.SBDebugger.Initialize()
+    atexit.register(lambda: lldb.SBDebugger.Terminate())
+    unittest2.main()
@@ -0,0 +1,21 @@
+#include <stdio.h>
+
+#define NUM_ITERATIONS 2000
+
+int g_sum = 0;
+
+static void
+accumulate (int value)
+{
+    g_sum += value; // Set breakpoint here.
+}
+
+int main()
+{
+    int i;
+    for (i = 0; i < NUM_ITERATIONS; i++)
+        accumulate(i);
+
+    printf("sum = %d\n", g_sum); // Set final breakpoint here.
+    return 0;
+}
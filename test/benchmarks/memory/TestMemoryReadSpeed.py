@@ -0,0 +1,106 @@
+"""Test lldb's inferior memory read throughput."""
+
+import os, sys
+import unittest2
+import lldb
+from lldbbench import *
+import lldbutil
+
+class MemoryReadSpeedBench(BenchBase):
+
+    mydir = TestBase.compute_mydir(__file__)
+
+    def setUp(self):
+        BenchBase.setUp(self)
+        self.source = 'main.cpp'
+        self.count = lldb.bmIterationCount
+        if self.count <= 0:
+            self.count = 10
+
+    @benchmarks_test
+    def test_memory_read_speed(self):
+        """Benchmark reading a large inferior buffer in bulk and a word at a time."""
+        self.buildDefault()
+        self.run_memory_read_bench(self.count)
+
+    @benchmarks_test
+    @skipUnlessPlatform(['linux'])
+    def test_memory_read_speed_per_method(self):
+        """Benchmark bulk reads through each of the Linux memory read methods."""
+        self.buildDefault()
+        # lldb-server reads LLDB_SERVER_MEMORY_READ_METHOD when it starts, and
+        # each launch starts a new one.
+        results = []
+        old_method = os.environ.get("LLDB_SERVER_MEMORY_READ_METHOD")
+        try:
+            for method in ["process_vm_readv", "proc_mem", "ptrace"]:
+                os.environ["LLDB_SERVER_MEMORY_READ_METHOD"] = method
+                process, addr, size = self.launch_to_buffer()
+                results.append((method, self.time_bulk_reads(process, addr, size, self.count)))
+                process.Kill()
+        finally:
+            if old_method is None:
+                del os.environ["LLDB_SERVER_MEMORY_READ_METHOD"]
+            else:
+                os.environ["LLDB_SERVER_MEMORY_READ_METHOD"] = old_method
+
+        print
+        for method, bulk_sw in results:
+            print "lldb bulk memory read with %s: %f seconds per %d byte read" % (method, bulk_sw.avg(), size)
+
+    def launch_to_buffer(self):
+        exe = os.path.join(os.getcwd(), "a.out")
+        target = self.dbg.CreateTarget(exe)
+        self.assertTrue(target, VALID_TARGET)
+
+        lldbutil.run_break_set_by_source_regexp(self, "// Set breakpoint here.")
+        process = target.LaunchSimple(None, None, self.get_process_working_directory())
+        self.assertTrue(process, PROCESS_IS_VALID)
+        self.assertTrue(process.GetState() == lldb.eStateStopped, STOPPED_DUE_TO_BREAKPOINT)
+
+        buffer = target.FindFirstGlobalVariable("g_buffer")
+        self.assertTrue(buffer.IsValid(), "g_buffer found")
+        return (process, buffer.GetLoadAddress(), buffer.GetByteSize())
+
+    def time_bulk_reads(self, process, addr, size, count):
+        # The reads are done directly on the process to bypass the memory cache.
+        chunk_size = 64 * 1024
+        bulk_sw = Stopwatch()
+        for i in range(count):
+            with bulk_sw:
+                for offset in range(0, size, chunk_size):
+                    error = lldb.SBError()
+                    process.ReadMemory(addr + offset, chunk_size, error)
+                    self.assertTrue(error.Success(), "bulk read succeeded")
+        return bulk_sw
+
+    def run_memory_read_bench(self, count):
+        process, addr, size = self.launch_to_buffer()
+        word_size = process.GetAddressByteSize()
+        chunk_size = 64 * 1024
+
+        # Large reads are serviced by process_vm_readv or /proc/<pid>/mem.
+        bulk_sw = self.time_bulk_reads(process, addr, size, count)
+
+        # Word sized reads show the per request overhead the word at a time
+        # ptrace path used to pay for every word of a large read.
+        word_sw = Stopwatch()
+        word_count = chunk_size / word_size
+        for i in range(count):
+            with word_sw:
+                for offset in range(0, chunk_size, word_size):
+                    error = lldb.SBError()
+                    process.ReadMemory(addr + offset, word_size, error)
+                    self.assertTrue(error.Success(), "word read succeeded")
+
+        print
+        print "lldb bulk memory read (%d bytes) benchmark:" % size, bulk_sw
+        print "lldb word memory read (%d words) benchmark:" % word_count, word_sw
+
+        process.Kill()
+
+if __name__ == '__main__':
+    import atexit
+    lldb.SBDebugger.Initialize()
+    atexit.register(lambda: lldb.SBDebugger.Terminate())
+    unittest2.main()
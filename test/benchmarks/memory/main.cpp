@@ -0,0 +1,15 @@
+#include <stdio.h>
+#include <string.h>
+
+#define BUFFER_SIZE (4 * 1024 * 1024)
+
+static unsigned char g_buffer[BUFFER_SIZE];
+
+int main()
+{
+    for (int i = 0; i < BUFFER_SIZE; i++)
+        g_buffer[i] = (unsigned char)i;
+
+    printf("buffer at %p\n", g_buffer); // Set breakpoint here.
+    return 0;
+}
@@ -0,0 +1,138 @@
+"""
+Test that lldb reuses parsed expressions only where they still mean the same thing.
+"""
+
+import os, time
+import unittest2
+import lldb
+from lldbtest import *
+
+class ExpressionCacheTestCase(TestBase):
+
+    mydir = TestBase.compute_mydir(__file__)
+    log_file = "lldb-expression-cache-log.txt"
+
+    @classmethod
+    def classCleanup(cls):
+        """Cleanup the test byproducts."""
+        cls.RemoveTempFile(cls.log_file)
+
+    def setUp(self):
+        # Call super's setUp().
+        TestBase.setUp(self)
+        self.buildDefault()
+
+        self.runCmd("file a.out", CURRENT_EXECUTABLE_SET)
+
+        self.runCmd("breakpoint set --source-pattern-regexp 'Set breakpoint here'")
+
+        self.runCmd("run", RUN_SUCCEEDED)
+
+    def parses_and_reuses(self, commands):
+        """Runs the commands and returns how many times each expression was
+           parsed and how many times it was reused, from the expression log."""
+        log_file = os.path.join(os.getcwd(), self.log_file)
+        self.runCmd("log enable -f '%s' lldb expr" % (log_file))
+        outputs = []
+        for command in commands:
+            self.runCmd(command)
+            outputs.append(self.res.GetOutput())
+        self.runCmd("log disable lldb expr")
+
+        parses = {}
+        reuses = {}
+        with open(log_file) as f:
+            for line in f:
+                for prefix, counts in (("Parsing expression ", parses),
+                                       ("Reusing parsed expression ", reuses)):
+                    start = line.find("[ClangUserExpression::Evaluate] " + prefix)
+                    if start == -1:
+                        continue
+                    start = line.index(prefix, start) + len(prefix)
+                    expr = line[start:line.rindex(" ==")]
+                    counts[expr] = counts.get(expr, 0) + 1
+        return (outputs, parses, reuses)
+
+    def test_repeated_expression_is_reused(self):
+        """Test that a repeated expression is parsed once but still gets a new result variable."""
+        outputs, parses, reuses = self.parses_and_reuses(["expression shadow + 40",
+                                                          "expression shadow + 40"])
+        self.assertTrue(outputs[0].startswith("(int) $0 = 42"), outputs[0])
+        self.assertTrue(outputs[1].startswith("(int) $1 = 42"), outputs[1])
+        self.assertEqual(parses.get("shadow + 40", 0), 1)
+        self.assertEqual(reuses.get("shadow + 40", 0), 1)
+
+        # Both result variables keep their own values
+        self.expect("expression $0 + $1",
+            startstr = "(int) $2 = 84")
+
+    def test_other_block_is_parsed_again(self):
+        """Test that an expression is parsed again in a frame with a different block."""
+        outputs, parses, reuses = self.parses_and_reuses(["expression shadow",
+                                                          "frame select 1",
+                                                          "expression shadow",
+                                                          "frame select 0",
+                                                          "expression shadow"])
+        self.assertTrue(outputs[0].startswith("(int) $0 = 2"), outputs[0])
+        self.assertTrue(outputs[2].startswith("(int) $1 = 1"), outputs[2])
+        self.assertTrue(outputs[4].startswith("(int) $2 = 2"), outputs[4])
+
+        # Back in the first block the first parse is still good
+        self.assertEqual(parses.get("shadow", 0), 2)
+        self.assertEqual(reuses.get("shadow", 0), 1)
+
+    def test_declarations_are_not_reused(self):
+        """Test that an expression declaring a persistent variable is parsed each time it is run."""
+        outputs, parses, reuses = self.parses_and_reuses(["expression int $x = 1",
+                                                          "expression $x = 5",
+                                                          "expression $x",
+                                                          "expression int $x = 1",
+                                                          "expression $x"])
+        self.assertEqual(parses.get("int $x = 1", 0), 2)
+        self.assertEqual(reuses.get("int $x = 1", 0), 0)
+
+        # The second declaration was parsed and run like the first one
+        # rather than replayed, and there is still one $x
+        self.assertTrue(outputs[2].startswith("(int) $1 = 5"), outputs[2])
+        self.assertTrue(outputs[4].startswith("(int) $2 = 1"), outputs[4])
+        self.expect("expression $x + 1",
+            startstr = "(int) $3 = 2")
+
+    def test_cache_size_zero_disables_cache(self):
+        """Test that setting target.expression-cache-size to 0 turns the cache off."""
+        self.runCmd("settings set target.expression-cache-size 0")
+        self.addTearDownHook(lambda: self.runCmd("settings clear target.expression-cache-size"))
+
+        outputs, parses, reuses = self.parses_and_reuses(["expression shadow",
+                                                          "expression shadow",
+                                                          "expression shadow"])
+        self.assertEqual(parses.get("shadow", 0), 3)
+        self.assertEqual(reuses.get("shadow", 0), 0)
+        self.assertTrue(outputs[2].startswith("(int) $2 = 2"), outputs[2])
+
+    def test_new_declaration_invalidates_cache(self):
+        """Test that declaring a new persistent variable makes earlier parses stale."""
+        outputs, parses, reuses = self.parses_and_reuses(["expression shadow",
+                                                          "expression int $y = 3",
+                                                          "expression shadow",
+                                                          "expression shadow"])
+        self.assertEqual(parses.get("shadow", 0), 2)
+        self.assertEqual(reuses.get("shadow", 0), 1)
+
+    def test_module_load_invalidates_cache(self):
+        """Test that adding a module to the target makes earlier parses stale."""
+        obj = os.path.join(os.getcwd(), "main.o")
+        self.assertTrue(os.path.isfile(obj), "main.o was built")
+
+        outputs, parses, reuses = self.parses_and_reuses(["expression shadow",
+                                                          "target modules add '%s'" % (obj),
+                                                          "expression shadow",
+                                                          "expression shadow"])
+        self.assertEqual(parses.get("shadow", 0), 2)
+        self.assertEqual(reuses.get("shadow", 0), 1)
+
+if __name__ == '__main__':
+    import atexit
+    lldb.SBDebugger.Initialize()
+    atexit.register(lambda: lldb.SBDebugger.Terminate())
+    unittest2.main()
@@ -0,0 +1,20 @@
+//===-- main.c --------------------------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+int inner (void)
+{
+    int shadow = 2;
+    return shadow; // Set breakpoint here
+}
+
+int main (int argc, char const *argv[])
+{
+    int shadow = 1;
+    return inner () + shadow;
+}
@@ -0,0 +1,18 @@
+#include <memory>
+
+struct point
+{
+    int x;
+    int y;
+};
+
+int main()
+{
+    std::shared_ptr<int> nsp;
+    std::shared_ptr<int> isp(new int(123));
+    std::shared_ptr<point> psp(new point{1, 2});
+    std::shared_ptr<point> psp2(psp);
+    std::weak_ptr<point> pwp(psp);
+
+    return 0; // Set break point at this line.
+}
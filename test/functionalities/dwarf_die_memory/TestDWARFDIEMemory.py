@@ -0,0 +1,54 @@
+"""
+Test that "image dump symfile" reports the memory used by DWARF DIEs, and
+that indexing can keep all the DIEs it extracts.
+"""
+
+import os, re, time
+import unittest2
+import lldb
+from lldbtest import *
+import lldbutil
+
+class DWARFDIEMemoryTestCase(TestBase):
+
+    mydir = TestBase.compute_mydir(__file__)
+
+    @skipUnlessPlatform(['linux', 'freebsd'])
+    @dwarf_test
+    def test_with_dwarf(self):
+        """Test the DWARF DIE memory statistic with and without keeping indexed DIEs."""
+        self.buildDwarf()
+        self.die_memory()
+
+    def tearDown(self):
+        self.runCmd("settings clear plugin.symbol-file.dwarf.keep-indexed-dies", check=False)
+        TestBase.tearDown(self)
+
+    def extracted_compile_units(self):
+        self.runCmd("image dump symfile a.out")
+        output = self.res.GetOutput()
+        match = re.search(r"DWARF DIEs: (\d+) DIEs using (\d+) bytes, (\d+) of (\d+) compile units extracted", output)
+        self.assertTrue(match, "DIE statistic not found in:\n" + output)
+        return (int(match.group(3)), int(match.group(4)))
+
+    def die_memory(self):
+        exe = os.path.join(os.getcwd(), "a.out")
+
+        # Modules are shared between targets, so the setting must be in
+        # place before the module is first indexed.
+        self.runCmd("settings set plugin.symbol-file.dwarf.keep-indexed-dies true")
+        target = self.dbg.CreateTarget(exe)
+        self.assertTrue(target, VALID_TARGET)
+
+        # Looking up a name indexes every compile unit, and all of them
+        # should stay resident afterwards.
+        lldbutil.run_break_set_by_symbol (self, "other_function", num_expected_locations=1)
+        (extracted, total) = self.extracted_compile_units()
+        self.assertEquals(total, 2)
+        self.assertEquals(extracted, total)
+
+if __name__ == '__main__':
+    import atexit
+    lldb.SBDebugger.Initialize()
+    atexit.register(lambda: lldb.SBDebugger.Terminate())
+    unittest2.main()
@@ -0,0 +1,7 @@
+int other_function (int value);
+
+int
+main (int argc, char const *argv[])
+{
+    return other_function (argc);
+}
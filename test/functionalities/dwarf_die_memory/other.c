@@ -0,0 +1,12 @@
+struct point
+{
+    int x;
+    int y;
+};
+
+int
+other_function (int value)
+{
+    struct point p = { value, value * 2 };
+    return p.x + p.y;
+}
@@ -0,0 +1,92 @@
+"""
+Test that memory read through the process memory cache stays coherent
+across stops.
+"""
+
+import os
+import struct
+import unittest2
+import lldb
+from lldbtest import *
+import lldbutil
+
+class MemoryCacheTestCase(TestBase):
+
+    mydir = TestBase.compute_mydir(__file__)
+
+    @skipUnlessDarwin
+    @dsym_test
+    @python_api_test
+    def test_memory_cache_with_dsym(self):
+        """Test that cached memory is refreshed or kept correctly when the process stops again."""
+        self.buildDsym()
+        self.memory_cache_coherency()
+
+    @dwarf_test
+    @python_api_test
+    def test_memory_cache_with_dwarf(self):
+        """Test that cached memory is refreshed or kept correctly when the process stops again."""
+        self.buildDwarf()
+        self.memory_cache_coherency()
+
+    def setUp(self):
+        # Call super's setUp().
+        TestBase.setUp(self)
+        # Find the line numbers to break inside main().
+        self.line1 = line_number('main.cpp', '// Set first break point at this line.')
+        self.line2 = line_number('main.cpp', '// Set second break point at this line.')
+
+    def read_ints(self, process, addr, count):
+        error = lldb.SBError()
+        data = process.ReadMemory(addr, 4 * count, error)
+        self.assertTrue(error.Success(), "reading memory at 0x%x failed" % addr)
+        return list(struct.unpack("<%di" % count, data))
+
+    def read_bytes(self, process, addr, count):
+        error = lldb.SBError()
+        data = process.ReadMemory(addr, count, error)
+        self.assertTrue(error.Success(), "reading memory at 0x%x failed" % addr)
+        return data
+
+    def memory_cache_coherency(self):
+        exe = os.path.join(os.getcwd(), "a.out")
+        target = self.dbg.CreateTarget(exe)
+        self.assertTrue(target, VALID_TARGET)
+
+        bp1 = target.BreakpointCreateByLocation("main.cpp", self.line1)
+        bp2 = target.BreakpointCreateByLocation("main.cpp", self.line2)
+        self.assertTrue(bp1.GetNumLocations() == 1 and bp2.GetNumLocations() == 1, VALID_BREAKPOINT)
+
+        process = target.LaunchSimple(None, None, self.get_process_working_directory())
+        self.assertTrue(process, PROCESS_IS_VALID)
+        threads = lldbutil.get_threads_stopped_at_breakpoint(process, bp1)
+        self.assertTrue(len(threads) == 1)
+
+        data_addr = target.FindFirstGlobalVariable("g_data").GetLoadAddress()
+        const_addr = target.FindFirstGlobalVariable("g_const_data").GetLoadAddress()
+        bp1_addr = bp1.GetLocationAtIndex(0).GetLoadAddress()
+        self.assertTrue(data_addr != lldb.LLDB_INVALID_ADDRESS and const_addr != lldb.LLDB_INVALID_ADDRESS)
+
+        self.assertEqual(self.read_ints(process, data_addr, 4), [1, 2, 3, 4])
+        self.assertEqual(self.read_ints(process, const_addr, 4), [10, 20, 30, 40])
+        # Code under an enabled breakpoint reads back with the original opcode.
+        code_bytes = self.read_bytes(process, bp1_addr, 16)
+
+        process.Continue()
+        threads = lldbutil.get_threads_stopped_at_breakpoint(process, bp2)
+        self.assertTrue(len(threads) == 1)
+
+        # Memory the inferior wrote while running must not come from the cache.
+        self.assertEqual(self.read_ints(process, data_addr, 4), [10, 21, 32, 43])
+        self.assertEqual(self.read_ints(process, const_addr, 4), [10, 20, 30, 40])
+
+        # Removing the breakpoint trap must not leave stale bytes behind.
+        self.assertEqual(self.read_bytes(process, bp1_addr, 16), code_bytes)
+        target.BreakpointDelete(bp1.GetID())
+        self.assertEqual(self.read_bytes(process, bp1_addr, 16), code_bytes)
+
+if __name__ == '__main__':
+    import atexit
+    lldb.SBDebugger.Initialize()
+    atexit.register(lambda: lldb.SBDebugger.Terminate())
+    unittest2.main()
@@ -0,0 +1,21 @@
+//===-- main.cpp ------------------------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#include <stdio.h>
+
+const int g_const_data[4] = { 10, 20, 30, 40 };
+int g_data[4] = { 1, 2, 3, 4 };
+
+int main (int argc, char const *argv[])
+{
+    printf("g_data[0]=%d\n", g_data[0]); // Set first break point at this line.
+    for (int i = 0; i < 4; ++i)
+        g_data[i] = g_const_data[i] + i;
+    printf("g_data[0]=%d\n", g_data[0]); // Set second break point at this line.
+    return 0;
+}
@@ -0,0 +1,106 @@
+"""
+Test the 'target symbolicate' command.
+"""
+
+import os, time
+import unittest2
+import lldb
+from lldbtest import *
+
+class TargetSymbolicateTestCase(TestBase):
+
+    mydir = TestBase.compute_mydir(__file__)
+
+    def setUp(self):
+        # Call super's setUp().
+        TestBase.setUp(self)
+        # Find the line number to symbolicate.
+        self.line = line_number('main.c', '// Symbolicate this line')
+
+    @skipUnlessDarwin
+    @dsym_test
+    def test_symbolicate_with_dsym(self):
+        """Test that 'target symbolicate' resolves a file of addresses."""
+        self.buildDsym()
+        self.symbolicate()
+
+    @dwarf_test
+    def test_symbolicate_with_dwarf(self):
+        """Test that 'target symbolicate' resolves a file of addresses."""
+        self.buildDwarf()
+        self.symbolicate()
+
+    def test_invalid_address(self):
+        """Test that 'target symbolicate' reports the line of an address it can't parse."""
+        self.buildDefault()
+        self.create_target()
+
+        address_file = self.write_address_file("invalid", ["0x1000", "", "main", "4096"])
+        self.expect("target symbolicate '%s'" % (address_file), error=True,
+            substrs = ["invalid address on line 3 of"])
+
+        address_file = self.write_address_file("trailing", ["0x1000 0x2000"])
+        self.expect("target symbolicate '%s'" % (address_file), error=True,
+            substrs = ["invalid address on line 1 of"])
+
+    def test_argument_count(self):
+        """Test that 'target symbolicate' takes exactly one file."""
+        self.buildDefault()
+        self.create_target()
+
+        address_file = self.write_address_file("args", ["0x1000"])
+        self.expect("target symbolicate", error=True,
+            substrs = ["'target symbolicate' takes exactly one address file argument."])
+        self.expect("target symbolicate '%s' '%s'" % (address_file, address_file), error=True,
+            substrs = ["'target symbolicate' takes exactly one address file argument."])
+
+    def create_target(self):
+        exe = os.path.join(os.getcwd(), "a.out")
+        target = self.dbg.CreateTarget(exe)
+        self.assertTrue(target, VALID_TARGET)
+        return target
+
+    def write_address_file(self, name, lines):
+        """Writes the lines to a file in the build directory and returns its path."""
+        address_file = os.path.join(os.getcwd(), "addresses-%s.txt" % (name))
+        with open(address_file, "w") as f:
+            f.write("\n".join(lines) + "\n")
+        self.addTearDownHook(lambda: os.remove(address_file))
+        return address_file
+
+    def symbolicate(self):
+        target = self.create_target()
+
+        # Without a process the addresses are looked up as file addresses.
+        breakpoint = target.BreakpointCreateByLocation('main.c', self.line)
+        self.assertTrue(breakpoint.GetNumLocations() == 1, VALID_BREAKPOINT)
+        address = breakpoint.GetLocationAtIndex(0).GetAddress()
+        file_addr = address.GetFileAddress()
+        symbol = address.GetSymbol()
+        self.assertTrue(symbol.IsValid(), "The breakpoint address has a symbol")
+        offset = file_addr - symbol.GetStartAddress().GetFileAddress()
+
+        # Hex and decimal addresses, surrounding white space and blank lines,
+        # and an address outside any module. Address 1 would be in the
+        # __PAGEZERO segment of a Mach-O executable.
+        unmapped_addr = 0xfffffffffffff000
+        address_file = self.write_address_file("valid", ["0x%x" % (file_addr),
+                                                         "",
+                                                         "  %d\t" % (file_addr),
+                                                         "",
+                                                         "%d" % (unmapped_addr)])
+        self.runCmd("target symbolicate '%s'" % (address_file))
+        lines = self.res.GetOutput().splitlines()
+        self.assertEqual(len(lines), 3, "One line for each address")
+
+        addr_width = target.GetAddressByteSize() * 2
+        expected = "0x%0*x a.out`%s + %d at main.c:%d" % (addr_width, file_addr, symbol.GetName(), offset, self.line)
+        self.assertTrue(lines[0].startswith(expected), "'%s' starts with '%s'" % (lines[0], expected))
+        self.assertTrue(lines[1].startswith(expected), "'%s' starts with '%s'" % (lines[1], expected))
+        self.assertEqual(lines[2].rstrip(), "0x%0*x" % (addr_width, unmapped_addr))
+
+if __name__ == '__main__':
+    import atexit
+    lldb.SBDebugger.Initialize()
+    atexit.register(lambda: lldb.SBDebugger.Terminate())
+    unittest2.main()
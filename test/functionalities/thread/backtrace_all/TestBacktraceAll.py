@@ -0,0 +1,70 @@
+"""
+Test that "thread backtrace all" unwinds many threads concurrently.
+"""
+
+import os, time
+import unittest2
+import lldb
+from lldbtest import *
+import lldbutil
+
+class BacktraceAllTestCase(TestBase):
+
+    mydir = TestBase.compute_mydir(__file__)
+
+    @skipUnlessDarwin
+    @dsym_test
+    def test_with_dsym(self):
+        """Test backtraces of all threads unwound on several workers."""
+        self.buildDsym(dictionary=self.getBuildFlags())
+        self.backtrace_all_test()
+
+    @dwarf_test
+    def test_with_dwarf(self):
+        """Test backtraces of all threads unwound on several workers."""
+        self.buildDwarf(dictionary=self.getBuildFlags())
+        self.backtrace_all_test()
+
+    def setUp(self):
+        # Call super's setUp().
+        TestBase.setUp(self)
+        # Find the line number for our breakpoint.
+        self.breakpoint = line_number('main.cpp', '// Set breakpoint here')
+
+    def tearDown(self):
+        self.runCmd("settings clear target.process.unwind-thread-count", check=False)
+        TestBase.tearDown(self)
+
+    def backtrace_all(self):
+        self.runCmd("thread backtrace all")
+        return self.res.GetOutput()
+
+    def backtrace_all_test(self):
+        exe = os.path.join(os.getcwd(), "a.out")
+        self.runCmd("file " + exe, CURRENT_EXECUTABLE_SET)
+
+        lldbutil.run_break_set_by_file_and_line (self, "main.cpp", self.breakpoint, num_expected_locations=1)
+        self.runCmd("run", RUN_SUCCEEDED)
+        self.expect("thread list", STOPPED_DUE_TO_BREAKPOINT,
+            substrs = ['stopped',
+                       'stop reason = breakpoint'])
+
+        process = self.dbg.GetSelectedTarget().GetProcess()
+        self.assertTrue(process.GetNumThreads() >= 17, "Not all threads were started")
+
+        # Unwind all threads on several workers.
+        self.runCmd("settings set target.process.unwind-thread-count 4")
+        output = self.backtrace_all()
+
+        # Every thread that was started should show its whole call chain.
+        self.assertTrue(output.count("thread_func") >= 16, "Missing thread_func frames in:\n" + output)
+        for thread in process:
+            names = [frame.GetFunctionName() for frame in thread]
+            if any(name is not None and name.startswith("thread_func") for name in names):
+                self.assertTrue(names[0] is not None and names[0].startswith("wait_here"), "Unexpected top frame: " + str(names))
+
+if __name__ == '__main__':
+    import atexit
+    lldb.SBDebugger.Initialize()
+    atexit.register(lambda: lldb.SBDebugger.Terminate())
+    unittest2.main()
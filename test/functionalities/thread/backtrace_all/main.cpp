@@ -0,0 +1,54 @@
+//===-- main.cpp ------------------------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+// Start a number of threads that each recurse a little before waiting, so
+// that "thread backtrace all" has several threads with distinct stacks to
+// unwind.
+
+#include <pthread.h>
+#include <atomic>
+
+#define NUM_THREADS 16
+
+std::atomic_int g_ready;
+std::atomic_bool g_done;
+
+int
+wait_here (int depth)
+{
+    if (depth > 0)
+        return wait_here (depth - 1) + 1;
+    ++g_ready;
+    while (!g_done)
+        ;
+    return 0;
+}
+
+void *
+thread_func (void *input)
+{
+    wait_here ((int)(long)input);
+    return NULL;
+}
+
+int
+main (int argc, char const *argv[])
+{
+    pthread_t threads[NUM_THREADS];
+    for (long i = 0; i < NUM_THREADS; ++i)
+        pthread_create (&threads[i], NULL, thread_func, (void *)(i % 4));
+
+    while (g_ready < NUM_THREADS)
+        ;
+    g_done = true; // Set breakpoint here
+
+    for (int i = 0; i < NUM_THREADS; ++i)
+        pthread_join (threads[i], NULL);
+    return 0;
+}
@@ -0,0 +1,17 @@
+#include <stdio.h>
+
+struct point
+{
+    int x;
+    int y;
+};
+
+static const char *g_message = "compressed";
+
+int
+main (int argc, char const *argv[])
+{
+    struct point pt = { argc, 2 };
+    printf ("%s %d %d\n", g_message, pt.x, pt.y); // Set break point at this line.
+    return 0;
+}
@@ -0,0 +1,71 @@
+"""
+Test that debug info in split DWARF .dwo and .dwp files is used.
+"""
+
+import os, time
+import unittest2
+import lldb
+from lldbtest import *
+import lldbutil
+
+class SplitDwarfTestCase(TestBase):
+
+    mydir = TestBase.compute_mydir(__file__)
+
+    @skipUnlessPlatform(['linux'])
+    @dwarf_test
+    def test_dwo_with_dwarf(self):
+        """Test functions, line tables, variables and types from a .dwo file."""
+        self.buildDwarf()
+        self.split_dwarf()
+
+    @skipUnlessPlatform(['linux'])
+    @dwarf_test
+    def test_dwp_with_dwarf(self):
+        """Test functions, line tables, variables and types from a .dwp package."""
+        self.buildDwarf()
+        if which("dwp") is None:
+            self.skipTest("the dwp tool is not installed")
+        exe = os.path.join(os.getcwd(), "a.out")
+        system([["dwp", "-e", exe, "-o", exe + ".dwp"]])
+        # Only the package is left to find the DIEs in
+        os.remove(os.path.join(os.getcwd(), "main.dwo"))
+        self.split_dwarf()
+
+    def setUp(self):
+        # Call super's setUp().
+        TestBase.setUp(self)
+        # Find the line number to break inside main().
+        self.source = 'main.c'
+        self.line = line_number(self.source, '// Set break point at this line.')
+
+    def split_dwarf(self):
+        exe = os.path.join(os.getcwd(), "a.out")
+        target = self.dbg.CreateTarget(exe)
+        self.assertTrue(target, VALID_TARGET)
+
+        # The function comes from the .dwo DIEs, the line table from the
+        # skeleton compile unit.
+        lldbutil.run_break_set_by_symbol (self, "main", num_expected_locations=1)
+        lldbutil.run_break_set_by_file_and_line (self, self.source, self.line, num_expected_locations=1, loc_exact=True)
+
+        process = target.LaunchSimple (None, None, self.get_process_working_directory())
+        self.assertTrue(process, PROCESS_IS_VALID)
+
+        self.expect("thread list", STOPPED_DUE_TO_BREAKPOINT,
+            substrs = ['stopped',
+                       'stop reason = breakpoint'])
+
+        process.Continue()
+        self.expect("frame variable pt",
+            substrs = ['(point) pt', 'y = 2'])
+
+        # The address of the global is in .debug_addr of the main file.
+        self.expect("target variable g_split_global",
+            substrs = ['(int) g_split_global = 42'])
+
+if __name__ == '__main__':
+    import atexit
+    lldb.SBDebugger.Initialize()
+    atexit.register(lambda: lldb.SBDebugger.Terminate())
+    unittest2.main()
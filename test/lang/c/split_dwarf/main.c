@@ -0,0 +1,17 @@
+#include <stdio.h>
+
+struct point
+{
+    int x;
+    int y;
+};
+
+int g_split_global = 42;
+
+int
+main (int argc, char const *argv[])
+{
+    struct point pt = { argc, 2 };
+    printf ("%d %d %d\n", g_split_global, pt.x, pt.y); // Set break point at this line.
+    return 0;
+}
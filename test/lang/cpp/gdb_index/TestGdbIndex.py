@@ -0,0 +1,55 @@
+"""
+Test that names are found through the .gdb_index section without indexing
+every compile unit up front.
+"""
+
+import os, time
+import unittest2
+import lldb
+from lldbtest import *
+import lldbutil
+
+class GdbIndexTestCase(TestBase):
+
+    mydir = TestBase.compute_mydir(__file__)
+
+    @skipUnlessPlatform(['linux'])
+    @dwarf_test
+    def test_with_dwarf(self):
+        """Test function, variable, type and namespace lookups with a .gdb_index."""
+        self.buildDwarf()
+        self.gdb_index_lookups()
+
+    def gdb_index_lookups(self):
+        exe = os.path.join(os.getcwd(), "a.out")
+        target = self.dbg.CreateTarget(exe)
+        self.assertTrue(target, VALID_TARGET)
+
+        # Base names, qualified names and methods.
+        lldbutil.run_break_set_by_symbol (self, "other_function", num_expected_locations=1)
+        lldbutil.run_break_set_by_symbol (self, "other_ns::other_function", num_expected_locations=1)
+        lldbutil.run_break_set_by_symbol (self, "other_method", num_expected_locations=1)
+        lldbutil.run_break_set_by_symbol (self, "c_style_function", num_expected_locations=1)
+
+        # Names that aren't in the index shouldn't be found.
+        self.expect("breakpoint set -n not_a_function",
+            substrs = ['no locations (pending)'])
+
+        self.expect("target variable g_other_global",
+            substrs = ['g_other_global = 12'])
+
+        self.expect("image lookup -t OtherType",
+            substrs = ['other_ns::OtherType'])
+
+        # The process should stop in the other compile unit.
+        process = target.LaunchSimple (None, None, self.get_process_working_directory())
+        self.assertTrue(process, PROCESS_IS_VALID)
+        self.expect("thread list", STOPPED_DUE_TO_BREAKPOINT,
+            substrs = ['stopped',
+                       'stop reason = breakpoint'])
+
+if __name__ == '__main__':
+    import atexit
+    lldb.SBDebugger.Initialize()
+    atexit.register(lambda: lldb.SBDebugger.Terminate())
+    unittest2.main()
@@ -0,0 +1,7 @@
+int c_style_function (int x);
+
+int
+main (int argc, char const *argv[])
+{
+    return c_style_function (argc); // Set break point at this line.
+}
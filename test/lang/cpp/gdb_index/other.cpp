@@ -0,0 +1,28 @@
+namespace other_ns
+{
+    struct OtherType
+    {
+        int m_value;
+
+        int
+        other_method (int x)
+        {
+            return m_value + x;
+        }
+    };
+
+    int g_other_global = 12;
+
+    int
+    other_function (int x)
+    {
+        OtherType other_type = { x };
+        return other_type.other_method (g_other_global);
+    }
+}
+
+int
+c_style_function (int x)
+{
+    return other_ns::other_function (x) * 2;
+}
@@ -2,7 +2,7 @@
 Test lldb logging.  This test just makes sure logging doesn't crash, and produces some output.
 """
 
-import os, time, string
+import os, time, string, json
 import unittest2
 import lldb
 from lldbtest import *
@@ -106,6 +106,27 @@ class LogTestCase(TestBase):
         # check that it is still there
         self.assertTrue(string.find(contents, "bacon") == 0)
 
+    # Check that the timer categories can be dumped as JSON
+    @dwarf_test
+    def test_log_timers_json (self):
+        self.buildDwarf ()
+        exe = os.path.join (os.getcwd(), "a.out")
+        self.runCmd ("log timers reset")
+        self.runCmd ("log timers enable")
+        # Creating a target finds plug-ins and parses the executable, which
+        # are all timed
+        self.runCmd ("target create " + exe)
+        self.runCmd ("log timers dump json")
+        output = self.res.GetOutput()
+        self.runCmd ("log timers disable")
+
+        report = json.loads(output)
+        self.assertTrue("categories" in report)
+        self.assertTrue(len(report["categories"]) > 0)
+        for category in report["categories"]:
+            self.assertTrue(category["count"] > 0)
+            self.assertTrue(category["total_nsec"] >= category["self_nsec"])
+
 
 if __name__ == '__main__':
     import atexit
@@ -201,6 +201,25 @@ class TargetAPITestCase(TestBase):
         target = self.create_simple_target('b.out')
         self.read_memory(target)
 
+    @skipUnlessDarwin
+    @python_api_test
+    @dsym_test
+    def test_resolve_load_addresses_with_dsym(self):
+        d = {'EXE': 'a.out'}
+        self.buildDsym(dictionary=d)
+        self.setTearDownCleanup(dictionary=d)
+        target = self.create_simple_target('a.out')
+        self.resolve_load_addresses(target)
+
+    @python_api_test
+    @dwarf_test
+    def test_resolve_load_addresses_with_dwarf(self):
+        d = {'EXE': 'b.out'}
+        self.buildDwarf(dictionary=d)
+        self.setTearDownCleanup(dictionary=d)
+        target = self.create_simple_target('b.out')
+        self.resolve_load_addresses(target)
+
     def setUp(self):
         # Call super's setUp().
         TestBase.setUp(self)
@@ -229,6 +248,40 @@ class TargetAPITestCase(TestBase):
         self.assertTrue(error.Success(), "Make sure memory read succeeded")
         self.assertEquals(len(content), 1)
 
+    def resolve_load_addresses(self, target):
+        """Exercise SBTarget.ResolveLoadAddresses() API."""
+        breakpoint = target.BreakpointCreateByLocation('main.c', self.line1)
+        self.assertTrue(breakpoint, VALID_BREAKPOINT)
+
+        process = target.LaunchSimple (None, None, self.get_process_working_directory())
+        self.assertTrue(process, PROCESS_IS_VALID)
+        thread = lldbutil.get_stopped_thread(process, lldb.eStopReasonBreakpoint)
+        self.assertTrue(thread.IsValid(), "There should be a thread stopped due to breakpoint condition")
+
+        # Out of order, with a repeat and an address that isn't in any
+        # module, to check the results come back in the same order
+        pcs = [frame.GetPC() for frame in thread]
+        addrs = list(reversed(pcs)) + [pcs[0], 0]
+        resolved = target.ResolveLoadAddresses(addrs)
+        self.assertTrue(resolved.IsValid())
+        self.assertEquals(resolved.GetSize(), len(addrs))
+
+        for i in range(len(addrs) - 1):
+            self.assertEquals(resolved.GetLoadAddressAtIndex(i), addrs[i])
+            sc = target.ResolveSymbolContextForAddress(target.ResolveLoadAddress(addrs[i]),
+                                                       lldb.eSymbolContextSymbol | lldb.eSymbolContextLineEntry)
+            self.assertEquals(resolved.GetModuleAtIndex(i), sc.GetModule())
+            self.assertEquals(resolved.GetSymbolNameAtIndex(i), sc.GetSymbol().GetName())
+            self.assertEquals(resolved.GetLineAtIndex(i), sc.GetLineEntry().GetLine())
+
+        # Frame #0 should be on self.line1
+        self.assertEquals(resolved.GetLineAtIndex(len(addrs) - 2), self.line1)
+        self.assertEquals(resolved.GetFileNameAtIndex(len(addrs) - 2), "main.c")
+
+        self.assertEquals(resolved.GetFileAddressAtIndex(len(addrs) - 1), lldb.LLDB_INVALID_ADDRESS)
+        self.assertFalse(resolved.GetModuleAtIndex(len(addrs) - 1).IsValid())
+        self.assertIsNone(resolved.GetSymbolNameAtIndex(len(addrs) - 1))
+
     def create_simple_target(self, fn):
         exe = os.path.join(os.getcwd(), fn)
         target = self.dbg.CreateTarget(exe)
@@ -0,0 +1,145 @@
+import unittest2
+
+import gdbremote_testcase
+import signal
+from lldbtest import *
+
+class TestGdbRemoteConditionalBreakpoints(gdbremote_testcase.GdbRemoteTestCaseBase):
+
+    CONDITIONAL_BREAKPOINTS_FEATURE_NAME = "ConditionalBreakpoints"
+
+    # Agent expression bytecodes for "const8 <value>; end".
+    ALWAYS_FALSE_CONDITION = "220027"
+    ALWAYS_TRUE_CONDITION = "220127"
+
+    BREAKPOINT_KIND = 1
+
+    def start_and_get_function_address(self, inferior_args):
+        procs = self.prep_debug_monitor_and_inferior(inferior_args=inferior_args)
+        self.add_qSupported_packets()
+        self.test_sequence.add_log_lines(
+            [# Start running after initial stop.
+             "read packet: $c#63",
+             # Match output line that prints the memory address of the function call entry point.
+             { "type":"output_match", "regex":r"^code address: 0x([0-9a-fA-F]+)\r\n$", "capture":{ 1:"function_address"} },
+             # Now stop the inferior.
+             "read packet: {}".format(chr(03)),
+             # And wait for the stop notification.
+             {"direction":"send", "regex":r"^\$T([0-9a-fA-F]{2})thread:([0-9a-fA-F]+);", "capture":{1:"stop_signo", 2:"stop_thread_id"} }],
+            True)
+
+        context = self.expect_gdbremote_sequence()
+        self.assertIsNotNone(context)
+
+        features = self.parse_qSupported_response(context)
+        if features.get(self.CONDITIONAL_BREAKPOINTS_FEATURE_NAME) != "+":
+            self.skipTest("conditional breakpoints not supported")
+
+        self.assertIsNotNone(context.get("function_address"))
+        return int(context.get("function_address"), 16)
+
+    def set_conditional_breakpoint(self, address, condition):
+        self.test_sequence.add_log_lines(
+            ["read packet: $Z0,{0:x},{1};X{2:x},{3}#00".format(address, self.BREAKPOINT_KIND, len(condition) / 2, condition),
+             "send packet: $OK#00",
+            ], True)
+
+    def get_hit_counts(self, address):
+        self.reset_test_sequence()
+        self.test_sequence.add_log_lines(
+            ["read packet: $qBreakpointHitCount:{0:x}#00".format(address),
+             {"direction":"send", "regex":r"^\$hits:([0-9a-fA-F]+);skipped:([0-9a-fA-F]+);#[0-9a-fA-F]{2}$", "capture":{1:"hits", 2:"skipped"} },
+            ], True)
+        context = self.expect_gdbremote_sequence()
+        self.assertIsNotNone(context)
+        return (int(context.get("hits"), 16), int(context.get("skipped"), 16))
+
+    def false_condition_does_not_stop(self):
+        function_address = self.start_and_get_function_address(
+            ["get-code-address-hex:hello", "sleep:1", "call-function:hello", "sleep:5"])
+
+        self.reset_test_sequence()
+        self.set_conditional_breakpoint(function_address, self.ALWAYS_FALSE_CONDITION)
+        self.test_sequence.add_log_lines(
+            ["read packet: $c#63",
+             # The call runs to completion without a stop being reported.
+             { "type":"output_match", "regex":r"^hello, world\r\n$" },
+            ], True)
+        # Stop it while it sleeps.
+        self.add_interrupt_packets()
+
+        context = self.expect_gdbremote_sequence()
+        self.assertIsNotNone(context)
+
+        (hits, skipped) = self.get_hit_counts(function_address)
+        self.assertEquals(hits, 1)
+        self.assertEquals(skipped, 1)
+
+    @llgs_test
+    @dwarf_test
+    def test_false_condition_does_not_stop_llgs_dwarf(self):
+        self.init_llgs_test()
+        self.buildDwarf()
+        self.set_inferior_startup_launch()
+        self.false_condition_does_not_stop()
+
+    def true_condition_stops(self):
+        function_address = self.start_and_get_function_address(
+            ["get-code-address-hex:hello", "sleep:1", "call-function:hello"])
+
+        self.reset_test_sequence()
+        self.set_conditional_breakpoint(function_address, self.ALWAYS_TRUE_CONDITION)
+        self.test_sequence.add_log_lines(
+            ["read packet: $c#63",
+             {"direction":"send", "regex":r"^\$T([0-9a-fA-F]{2})thread:([0-9a-fA-F]+);", "capture":{1:"stop_signo", 2:"stop_thread_id"} },
+            ], True)
+
+        context = self.expect_gdbremote_sequence()
+        self.assertIsNotNone(context)
+        self.assertEquals(int(context.get("stop_signo"), 16), signal.SIGTRAP)
+        self.assertEquals(len(context["O_content"]), 0)
+
+        (hits, skipped) = self.get_hit_counts(function_address)
+        self.assertEquals(hits, 1)
+        self.assertEquals(skipped, 0)
+
+    @llgs_test
+    @dwarf_test
+    def test_true_condition_stops_llgs_dwarf(self):
+        self.init_llgs_test()
+        self.buildDwarf()
+        self.set_inferior_startup_launch()
+        self.true_condition_stops()
+
+    def unconditional_hits_counted(self):
+        function_address = self.start_and_get_function_address(
+            ["get-code-address-hex:hello", "sleep:1", "call-function:hello"])
+
+        # Hits are counted whether or not there are conditions to evaluate.
+        self.reset_test_sequence()
+        self.test_sequence.add_log_lines(
+            ["read packet: $Z0,{0:x},{1}#00".format(function_address, self.BREAKPOINT_KIND),
+             "send packet: $OK#00",
+             "read packet: $c#63",
+             {"direction":"send", "regex":r"^\$T([0-9a-fA-F]{2})thread:([0-9a-fA-F]+);", "capture":{1:"stop_signo", 2:"stop_thread_id"} },
+            ], True)
+
+        context = self.expect_gdbremote_sequence()
+        self.assertIsNotNone(context)
+        self.assertEquals(int(context.get("stop_signo"), 16), signal.SIGTRAP)
+
+        (hits, skipped) = self.get_hit_counts(function_address)
+        self.assertEquals(hits, 1)
+        self.assertEquals(skipped, 0)
+
+    @llgs_test
+    @dwarf_test
+    def test_unconditional_hits_counted_llgs_dwarf(self):
+        self.init_llgs_test()
+        self.buildDwarf()
+        self.set_inferior_startup_launch()
+        self.unconditional_hits_counted()
+
+
+if __name__ == '__main__':
+    unittest2.main()
@@ -0,0 +1,85 @@
+import json
+import sys
+import unittest2
+
+import gdbremote_testcase
+from lldbtest import *
+
+class TestGdbRemote_jThreadsInfo(gdbremote_testcase.GdbRemoteTestCaseBase):
+
+    THREAD_COUNT = 5
+
+    def gather_threads_info_via_jThreadsInfo(self, thread_count):
+        # Set up the inferior args.
+        inferior_args=[]
+        for i in range(thread_count - 1):
+            inferior_args.append("thread:new")
+        inferior_args.append("sleep:10")
+        procs = self.prep_debug_monitor_and_inferior(inferior_args=inferior_args)
+
+        self.test_sequence.add_log_lines([
+            "read packet: $c#63"
+            ], True)
+        context = self.expect_gdbremote_sequence()
+        self.assertIsNotNone(context)
+
+        # Give threads time to start up, then break.
+        time.sleep(1)
+        self.reset_test_sequence()
+        self.test_sequence.add_log_lines([
+            "read packet: {}".format(chr(03)),
+            {"direction":"send", "regex":r"^\$T([0-9a-fA-F]+)([^#]+)#[0-9a-fA-F]{2}$", "capture":{1:"stop_result", 2:"key_vals_text"} },
+            ], True)
+        context = self.expect_gdbremote_sequence()
+        self.assertIsNotNone(context)
+
+        # Wait until all threads have started.
+        threads = self.wait_for_thread_count(thread_count, timeout_seconds=3)
+        self.assertIsNotNone(threads)
+        self.assertEquals(len(threads), thread_count)
+
+        # Grab the stop info of all threads with one packet.
+        self.reset_test_sequence()
+        self.test_sequence.add_log_lines([
+            "read packet: $jThreadsInfo#c1",
+            {"direction":"send", "regex":r"^\$(.+)#[0-9a-fA-F]{2}$", "capture":{1:"threads_info"} },
+            ], True)
+        context = self.expect_gdbremote_sequence()
+        self.assertIsNotNone(context)
+
+        # The JSON payload is sent with binary escaping.
+        threads_info_text = context.get("threads_info")
+        self.assertIsNotNone(threads_info_text)
+        threads_info = json.loads(self.decode_gdbremote_binary(threads_info_text))
+        self.assertEquals(len(threads_info), thread_count)
+
+        thread_dicts = {}
+        for thread_info in threads_info:
+            self.assertTrue("tid" in thread_info)
+            self.assertTrue(thread_info["tid"] in threads)
+            thread_dicts[thread_info["tid"]] = thread_info
+        return thread_dicts
+
+    def jThreadsInfo_reports_all_threads(self, thread_count):
+        thread_dicts = self.gather_threads_info_via_jThreadsInfo(thread_count)
+        self.assertEquals(len(thread_dicts), thread_count)
+
+        # Every thread should come with expedited registers.
+        for thread_info in thread_dicts.values():
+            self.assertTrue("registers" in thread_info)
+            self.assertTrue(len(thread_info["registers"]) > 0)
+
+        # Only one thread should should indicate a stop reason.
+        with_stop_reason_count = sum(1 for thread_info in thread_dicts.values() if thread_info.get("signal", 0) != 0)
+        self.assertEqual(with_stop_reason_count, 1)
+
+    @llgs_test
+    @dwarf_test
+    def test_jThreadsInfo_reports_all_threads_llgs_dwarf(self):
+        self.init_llgs_test()
+        self.buildDwarf()
+        self.set_inferior_startup_launch()
+        self.jThreadsInfo_reports_all_threads(self.THREAD_COUNT)
+
+if __name__ == '__main__':
+    unittest2.main()
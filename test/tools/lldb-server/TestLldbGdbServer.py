@@ -884,8 +884,8 @@ class LldbGdbServerTestCase(gdbremote_testcase.GdbRemoteTestCaseBase):
         self.set_inferior_startup_launch()
         self.Hc_then_Csignal_signals_correct_thread(signal.SIGSEGV)
 
-    def m_packet_reads_memory(self):
-        # This is the memory we will write into the inferior and then ensure we can read back with $m.
+    def m_packet_reads_memory(self, binary=False):
+        # This is the memory we will write into the inferior and then ensure we can read back with $m (or $x).
         MEMORY_CONTENTS = "Test contents 0123456789 ABCDEFGHIJKLMNOPQRSTUVWXYZ abcdefghijklmnopqrstuvwxyz"
 
         # Start up the inferior.
@@ -917,7 +917,7 @@ class LldbGdbServerTestCase(gdbremote_testcase.GdbRemoteTestCaseBase):
         # Grab contents from the inferior.
         self.reset_test_sequence()
         self.test_sequence.add_log_lines(
-            ["read packet: $m{0:x},{1:x}#00".format(message_address, len(MEMORY_CONTENTS)),
+            ["read packet: ${0}{1:x},{2:x}#00".format("x" if binary else "m", message_address, len(MEMORY_CONTENTS)),
              {"direction":"send", "regex":r"^\$(.+)#[0-9a-fA-F]{2}$", "capture":{1:"read_contents"} }],
             True)
 
@@ -925,9 +925,13 @@ class LldbGdbServerTestCase(gdbremote_testcase.GdbRemoteTestCaseBase):
         context = self.expect_gdbremote_sequence()
         self.assertIsNotNone(context)
 
-        # Ensure what we read from inferior memory is what we wrote.
+        # Ensure what we read from inferior memory is what we wrote.  The message
+        # has no characters that need escaping in a binary response.
         self.assertIsNotNone(context.get("read_contents"))
-        read_contents = context.get("read_contents").decode("hex")
+        if binary:
+            read_contents = context.get("read_contents")
+        else:
+            read_contents = context.get("read_contents").decode("hex")
         self.assertEquals(read_contents, MEMORY_CONTENTS)
 
     @debugserver_test
@@ -946,6 +950,14 @@ class LldbGdbServerTestCase(gdbremote_testcase.GdbRemoteTestCaseBase):
         self.set_inferior_startup_launch()
         self.m_packet_reads_memory()
 
+    @llgs_test
+    @dwarf_test
+    def test_x_packet_reads_memory_llgs_dwarf(self):
+        self.init_llgs_test()
+        self.buildDwarf()
+        self.set_inferior_startup_launch()
+        self.m_packet_reads_memory(binary=True)
+
     def qMemoryRegionInfo_is_supported(self):
         # Start up the inferior.
         procs = self.prep_debug_monitor_and_inferior()
@@ -1415,6 +1427,63 @@ class LldbGdbServerTestCase(gdbremote_testcase.GdbRemoteTestCaseBase):
         self.set_inferior_startup_launch()
         self.P_writes_all_gpr_registers()
 
+    def g_returns_same_values_as_p(self):
+        procs = self.prep_debug_monitor_and_inferior()
+        self.add_register_info_collection_packets()
+
+        # Read all registers in one shot.
+        self.test_sequence.add_log_lines(
+            ["read packet: $g#00",
+             { "direction":"send", "regex":r"^\$([0-9a-fA-F]+)#", "capture":{1:"g_response"} }],
+            True)
+
+        context = self.expect_gdbremote_sequence()
+        self.assertIsNotNone(context)
+
+        reg_infos = self.parse_register_info_packets(context)
+        self.assertIsNotNone(reg_infos)
+        self.add_lldb_register_index(reg_infos)
+
+        g_response = context.get("g_response")
+        self.assertIsNotNone(g_response)
+
+        # Each register lives at its qRegisterInfo offset in the g response
+        # and must match what p reports for it.
+        checked_count = 0
+        for reg_info in reg_infos:
+            # Skip registers without a register set (x86 DRx) and slices of
+            # other registers.
+            if not "set" in reg_info or "container-regs" in reg_info:
+                continue
+
+            reg_index = reg_info["lldb_register_index"]
+            self.reset_test_sequence()
+            self.test_sequence.add_log_lines(
+                ["read packet: $p{0:x}#00".format(reg_index),
+                 { "direction":"send", "regex":r"^\$([0-9a-fA-F]+)#", "capture":{1:"p_response"} }],
+                True)
+            context = self.expect_gdbremote_sequence()
+            self.assertIsNotNone(context)
+
+            p_response = context.get("p_response")
+            self.assertIsNotNone(p_response)
+
+            start = 2 * int(reg_info["offset"])
+            end = start + 2 * int(reg_info["bitsize"]) / 8
+            self.assertTrue(end <= len(g_response))
+            self.assertEquals(g_response[start:end], p_response)
+            checked_count += 1
+
+        self.assertTrue(checked_count > 0)
+
+    @llgs_test
+    @dwarf_test
+    def test_g_returns_same_values_as_p_llgs_dwarf(self):
+        self.init_llgs_test()
+        self.buildDwarf()
+        self.set_inferior_startup_launch()
+        self.g_returns_same_values_as_p()
+
     def P_and_p_thread_suffix_work(self):
         # Startup the inferior with three threads.
         procs = self.prep_debug_monitor_and_inferior(inferior_args=["thread:new", "thread:new"])
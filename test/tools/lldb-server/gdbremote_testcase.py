@@ -706,6 +706,7 @@ class GdbRemoteTestCaseBase(TestBase):
 
     _KNOWN_QSUPPORTED_STUB_FEATURES = [
         "augmented-libraries-svr4-read",
+        "ConditionalBreakpoints",
         "PacketSize",
         "QStartNoAckMode",
         "QThreadSuffixSupported",
@@ -11,6 +11,7 @@
 
 #include <stdio.h>
 #include <string.h>
+#include <errno.h>
 #include <stdlib.h>
 #include <limits.h>
 #include <fcntl.h>
@@ -132,6 +133,8 @@ static OptionDefinition g_options[] =
         "extensions have been implemented." },
     { LLDB_3_TO_5,       false, "debug"          , 'd', no_argument      , 0,  eArgTypeNone,
         "Tells the debugger to print out extra information for debugging itself." },
+    { LLDB_3_TO_5,       false, "perf-report"    , 'R', required_argument, 0,  eArgTypeFilename,
+        "Tells the debugger to record its internal performance timers and to write them as JSON to <filename> when it exits." },
     { 0,                 false, NULL             , 0  , 0                , 0,  eArgTypeNone,         NULL }
 };
 
@@ -412,6 +415,7 @@ Driver::OptionData::OptionData () :
     m_process_pid(LLDB_INVALID_PROCESS_ID),
     m_use_external_editor(false),
     m_batch(false),
+    m_perf_report_file(),
     m_seen_options()
 {
 }
@@ -446,6 +450,7 @@ Driver::OptionData::Clear ()
     m_wait_for = false;
     m_process_name.erase();
     m_batch = false;
+    m_perf_report_file.clear();
     m_after_crash_commands.clear();
 
     m_process_pid = LLDB_INVALID_PROCESS_ID;
@@ -745,6 +750,10 @@ Driver::ParseArgs (int argc, const char *argv[], FILE *out_fh, bool &exiting)
                         m_option_data.m_source_quietly = true;
                         break;
 
+                    case 'R':
+                        m_option_data.m_perf_report_file = optarg;
+                        break;
+
                     case 'K':
                         m_option_data.AddInitialCommand(optarg, eCommandPlacementAfterCrash, true, true, error);
                         break;
@@ -987,9 +996,15 @@ Driver::MainLoop ()
 
     SBCommandInterpreter sb_interpreter = m_debugger.GetCommandInterpreter();
     
+    // Start recording the internal timers before anything gets loaded so
+    // the performance report covers the whole session.
+    SBCommandReturnObject result;
+    if (!m_option_data.m_perf_report_file.empty())
+        sb_interpreter.HandleCommand ("log timers enable", result);
+
     // Before we handle any options from the command line, we parse the
     // .lldbinit file in the user's home directory.
-    SBCommandReturnObject result;
+    result.Clear();
     sb_interpreter.SourceInitFileInHomeDirectory(result);
     if (GetDebugMode())
     {
@@ -1151,10 +1166,35 @@ Driver::MainLoop ()
     reset_stdin_termios();
     fclose (stdin);
     
+    if (!m_option_data.m_perf_report_file.empty())
+        WritePerfReport ();
+
     SBDebugger::Destroy (m_debugger);
 }
 
 
+void
+Driver::WritePerfReport ()
+{
+    SBCommandReturnObject result;
+    m_debugger.GetCommandInterpreter().HandleCommand ("log timers dump json", result);
+    if (!result.Succeeded())
+    {
+        fprintf (stderr, "error: failed to collect the performance report: %s", result.GetError());
+        return;
+    }
+
+    const char *report_path = m_option_data.m_perf_report_file.c_str();
+    FILE *report_file = ::fopen (report_path, "w");
+    if (report_file == NULL)
+    {
+        fprintf (stderr, "error: unable to open performance report file '%s': %s\n", report_path, strerror (errno));
+        return;
+    }
+    ::fputs (result.GetOutput(), report_file);
+    ::fclose (report_file);
+}
+
 void
 Driver::ResizeWindow (unsigned short col)
 {
@@ -64,6 +64,9 @@ public:
     bool
     GetDebugMode() const;
 
+    void
+    WritePerfReport ();
+
 
     class OptionData
     {
@@ -109,6 +112,7 @@ public:
         lldb::pid_t m_process_pid;
         bool m_use_external_editor;  // FIXME: When we have set/show variables we can remove this from here.
         bool m_batch;
+        std::string m_perf_report_file;
         typedef std::set<char> OptionSet;
         OptionSet m_seen_options;
     };
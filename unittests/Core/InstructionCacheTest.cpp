@@ -0,0 +1,346 @@
+//===-- InstructionCacheTest.cpp --------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "gtest/gtest.h"
+
+#include "lldb/Core/AddressRange.h"
+#include "lldb/Core/ArchSpec.h"
+#include "lldb/Core/DataExtractor.h"
+#include "lldb/Core/Disassembler.h"
+#include "lldb/Core/Module.h"
+#include "lldb/Core/PluginManager.h"
+#include "lldb/Core/Section.h"
+#include "lldb/Core/Timer.h"
+#include "lldb/Symbol/ObjectFile.h"
+#include "lldb/Target/ExecutionContext.h"
+
+using namespace lldb;
+using namespace lldb_private;
+
+namespace
+{
+    //----------------------------------------------------------------------
+    // Every byte is a one byte instruction. Like the instructions of the
+    // real disassemblers, each one holds a reference back to the
+    // disassembler that decoded it.
+    //----------------------------------------------------------------------
+    class TestInstruction : public Instruction
+    {
+    public:
+        TestInstruction (const DisassemblerSP &disasm_sp, const Address &address, uint8_t byte) :
+            Instruction (address, eAddressClassCode),
+            m_disasm_sp (disasm_sp),
+            m_does_branch (eLazyBoolCalculate)
+        {
+            m_opcode.SetOpcode8 (byte, eByteOrderLittle);
+        }
+
+        void
+        CalculateMnemonicOperandsAndComment (const ExecutionContext *exe_ctx) override
+        {
+            m_opcode_name = "test";
+        }
+
+        bool
+        DoesBranch () override
+        {
+            if (m_does_branch == eLazyBoolCalculate)
+                m_does_branch = m_opcode.GetOpcode8() == 0xe9 ? eLazyBoolYes : eLazyBoolNo;
+            return m_does_branch == eLazyBoolYes;
+        }
+
+        size_t
+        Decode (const Disassembler &disassembler, const DataExtractor &data, lldb::offset_t data_offset) override
+        {
+            return 1;
+        }
+
+        bool
+        HasCalculatedStrings () const
+        {
+            return m_calculated_strings;
+        }
+
+        bool
+        HasCalculatedBranch () const
+        {
+            return m_does_branch != eLazyBoolCalculate;
+        }
+
+    private:
+        DisassemblerSP m_disasm_sp;
+        LazyBool m_does_branch;
+    };
+
+    class TestDisassembler : public Disassembler
+    {
+    public:
+        static uint32_t g_num_decodes;
+        static uint32_t g_num_live;
+
+        TestDisassembler (const ArchSpec &arch, const char *flavor) :
+            Disassembler (arch, flavor)
+        {
+            ++g_num_live;
+        }
+
+        ~TestDisassembler () override
+        {
+            --g_num_live;
+        }
+
+        static ConstString
+        GetPluginNameStatic ()
+        {
+            static ConstString g_name ("instruction-cache-test");
+            return g_name;
+        }
+
+        static Disassembler *
+        CreateInstance (const ArchSpec &arch, const char *flavor)
+        {
+            return new TestDisassembler (arch, flavor);
+        }
+
+        size_t
+        DecodeInstructions (const Address &base_addr,
+                            const DataExtractor &data,
+                            lldb::offset_t data_offset,
+                            size_t num_instructions,
+                            bool append,
+                            bool data_from_file) override
+        {
+            ++g_num_decodes;
+            if (!append)
+                m_instruction_list.Clear();
+            DisassemblerSP disasm_sp (shared_from_this());
+            lldb::offset_t offset = data_offset;
+            while (offset < data.GetByteSize() && m_instruction_list.GetSize() < num_instructions)
+            {
+                Address inst_addr (base_addr);
+                inst_addr.Slide (offset - data_offset);
+                const uint8_t byte = data.GetU8 (&offset);
+                InstructionSP inst_sp (new TestInstruction (disasm_sp, inst_addr, byte));
+                m_instruction_list.Append (inst_sp);
+            }
+            return m_instruction_list.GetSize();
+        }
+
+        bool
+        FlavorValidForArchSpec (const ArchSpec &arch, const char *flavor) override
+        {
+            return true;
+        }
+
+        ConstString
+        GetPluginName () override
+        {
+            return GetPluginNameStatic();
+        }
+
+        uint32_t
+        GetPluginVersion () override
+        {
+            return 1;
+        }
+    };
+
+    uint32_t TestDisassembler::g_num_decodes = 0;
+    uint32_t TestDisassembler::g_num_live = 0;
+
+    //----------------------------------------------------------------------
+    // Provides a single code section whose contents are in our memory, the
+    // same way JIT compiled expressions are made into modules.
+    //----------------------------------------------------------------------
+    class TestObjectFileDelegate : public ObjectFileJITDelegate
+    {
+    public:
+        TestObjectFileDelegate (const uint8_t *code, size_t code_size) :
+            m_code (code),
+            m_code_size (code_size)
+        {
+        }
+
+        lldb::ByteOrder
+        GetByteOrder () const override
+        {
+            return eByteOrderLittle;
+        }
+
+        uint32_t
+        GetAddressByteSize () const override
+        {
+            return 8;
+        }
+
+        void
+        PopulateSymtab (ObjectFile *obj_file, Symtab &symtab) override
+        {
+        }
+
+        void
+        PopulateSectionList (ObjectFile *obj_file, SectionList &section_list) override
+        {
+            SectionSP section_sp (new Section (obj_file->GetModule(),
+                                               obj_file,
+                                               1,
+                                               ConstString (".text"),
+                                               eSectionTypeCode,
+                                               0x1000,
+                                               m_code_size,
+                                               (lldb::offset_t)(uintptr_t)m_code, // The host address of the contents
+                                               m_code_size,
+                                               0,
+                                               ePermissionsReadable | ePermissionsExecutable));
+            section_list.AddSection (section_sp);
+        }
+
+        bool
+        GetArchitecture (ArchSpec &arch) override
+        {
+            arch.SetTriple ("x86_64-pc-linux");
+            return true;
+        }
+
+    private:
+        const uint8_t *m_code;
+        size_t m_code_size;
+    };
+
+    class InstructionCacheTest : public ::testing::Test
+    {
+    public:
+        static void
+        SetUpTestCase ()
+        {
+            // Finding plug-ins and loading object files are timed
+            Timer::Initialize ();
+            PluginManager::RegisterPlugin (TestDisassembler::GetPluginNameStatic(),
+                                           "Disassembler for instruction cache tests",
+                                           TestDisassembler::CreateInstance);
+        }
+
+        static void
+        TearDownTestCase ()
+        {
+            PluginManager::UnregisterPlugin (TestDisassembler::CreateInstance);
+        }
+
+    protected:
+        void
+        SetUp ()
+        {
+            static const uint8_t g_code[] = { 0x55, 0x48, 0x89, 0xe5, 0xe9, 0x5d, 0xc3, 0x90 };
+            m_delegate_sp.reset (new TestObjectFileDelegate (g_code, sizeof(g_code)));
+            m_module_sp = Module::CreateJITModule (m_delegate_sp);
+            ASSERT_TRUE (m_module_sp.get() != NULL);
+            SectionList *section_list = m_module_sp->GetSectionList();
+            ASSERT_TRUE (section_list != NULL);
+            SectionSP text_sp (section_list->FindSectionByName (ConstString (".text")));
+            ASSERT_TRUE (text_sp.get() != NULL);
+            m_range = AddressRange (text_sp, 0, sizeof(g_code));
+            m_arch.SetTriple ("x86_64-pc-linux");
+            TestDisassembler::g_num_decodes = 0;
+        }
+
+        void
+        TearDown ()
+        {
+            m_module_sp.reset();
+            m_delegate_sp.reset();
+            ASSERT_EQ (0u, TestDisassembler::g_num_live);
+        }
+
+        DisassemblerSP
+        DisassembleFromFile ()
+        {
+            const bool prefer_file_cache = true;
+            return Disassembler::DisassembleRange (m_arch,
+                                                   TestDisassembler::GetPluginNameStatic().GetCString(),
+                                                   NULL,
+                                                   ExecutionContext(),
+                                                   m_range,
+                                                   prefer_file_cache);
+        }
+
+        ObjectFileJITDelegateSP m_delegate_sp;
+        ModuleSP m_module_sp;
+        AddressRange m_range;
+        ArchSpec m_arch;
+    };
+}
+
+TEST_F (InstructionCacheTest, RepeatedRangeIsCached)
+{
+    DisassemblerSP first_sp (DisassembleFromFile());
+    ASSERT_TRUE (first_sp.get() != NULL);
+    ASSERT_EQ (8u, first_sp->GetInstructionList().GetSize());
+    ASSERT_EQ (1u, TestDisassembler::g_num_decodes);
+
+    DisassemblerSP second_sp (DisassembleFromFile());
+    ASSERT_EQ (first_sp.get(), second_sp.get());
+    ASSERT_EQ (1u, TestDisassembler::g_num_decodes);
+}
+
+TEST_F (InstructionCacheTest, LazyFieldsComputedBeforeSharing)
+{
+    DisassemblerSP disasm_sp (DisassembleFromFile());
+    ASSERT_TRUE (disasm_sp.get() != NULL);
+    InstructionList &inst_list = disasm_sp->GetInstructionList();
+    for (size_t i = 0; i < inst_list.GetSize(); ++i)
+    {
+        TestInstruction *inst = static_cast<TestInstruction *>(inst_list.GetInstructionAtIndex (i).get());
+        ASSERT_TRUE (inst->HasCalculatedStrings()) << "instruction " << i;
+        ASSERT_TRUE (inst->HasCalculatedBranch()) << "instruction " << i;
+    }
+}
+
+TEST_F (InstructionCacheTest, ModuleUnloadDropsEntries)
+{
+    DisassemblerSP old_sp (DisassembleFromFile());
+    ASSERT_TRUE (old_sp.get() != NULL);
+
+    // What the target does when the module is unloaded
+    Disassembler::RemoveCachedInstructions (m_module_sp.get());
+
+    DisassemblerSP new_sp (DisassembleFromFile());
+    ASSERT_TRUE (new_sp.get() != NULL);
+    ASSERT_NE (old_sp.get(), new_sp.get());
+    ASSERT_EQ (2u, TestDisassembler::g_num_decodes);
+
+    // Anyone still using the old list can keep doing so
+    ASSERT_EQ (8u, old_sp->GetInstructionList().GetSize());
+    ASSERT_EQ (2u, TestDisassembler::g_num_live);
+}
+
+TEST_F (InstructionCacheTest, ListClearedWithLastReference)
+{
+    DisassembleFromFile();
+
+    // The cache keeps the list after the caller lets go of it
+    ASSERT_EQ (1u, TestDisassembler::g_num_live);
+    ASSERT_EQ (8u, DisassembleFromFile()->GetInstructionList().GetSize());
+    ASSERT_EQ (1u, TestDisassembler::g_num_decodes);
+
+    // Once the cache and every caller have let go, the list is cleared, which
+    // breaks the references between the instructions and their disassembler
+    DisassemblerSP disasm_sp (DisassembleFromFile());
+    Disassembler::RemoveCachedInstructions (m_module_sp.get());
+    ASSERT_EQ (1u, TestDisassembler::g_num_live);
+    disasm_sp.reset();
+    ASSERT_EQ (0u, TestDisassembler::g_num_live);
+}
+
+TEST_F (InstructionCacheTest, ModuleDestructionDropsEntries)
+{
+    DisassembleFromFile();
+    ASSERT_EQ (1u, TestDisassembler::g_num_live);
+    m_module_sp.reset();
+    ASSERT_EQ (0u, TestDisassembler::g_num_live);
+}
@@ -0,0 +1,158 @@
+//===-- ListenerTest.cpp ----------------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "gtest/gtest.h"
+
+#include "lldb/Core/Broadcaster.h"
+#include "lldb/Core/Event.h"
+#include "lldb/Core/Listener.h"
+
+#include <atomic>
+#include <chrono>
+#include <stdio.h>
+#include <thread>
+
+using namespace lldb;
+using namespace lldb_private;
+
+namespace
+{
+    class ListenerTest: public ::testing::Test
+    {
+    };
+
+    enum
+    {
+        eEventPing  = (1u << 0),
+        eEventOther = (1u << 1)
+    };
+}
+
+TEST_F (ListenerTest, EventTypeFiltering)
+{
+    Broadcaster broadcaster (NULL, "test-broadcaster");
+    Listener listener ("test-listener");
+
+    ASSERT_FALSE (broadcaster.EventTypeHasListeners (eEventPing));
+    ASSERT_EQ ((uint32_t)eEventPing, listener.StartListeningForEvents (&broadcaster, eEventPing));
+    ASSERT_TRUE (broadcaster.EventTypeHasListeners (eEventPing));
+    ASSERT_FALSE (broadcaster.EventTypeHasListeners (eEventOther));
+
+    // Nobody listens for eEventOther so it shouldn't be queued
+    broadcaster.BroadcastEvent (eEventOther, NULL);
+    broadcaster.BroadcastEvent (eEventPing, NULL);
+
+    EventSP event_sp;
+    ASSERT_TRUE (listener.GetNextEvent (event_sp));
+    ASSERT_EQ ((uint32_t)eEventPing, event_sp->GetType ());
+    ASSERT_FALSE (listener.GetNextEvent (event_sp));
+
+    ASSERT_TRUE (listener.StopListeningForEvents (&broadcaster, eEventPing));
+    ASSERT_FALSE (broadcaster.EventTypeHasListeners (eEventPing));
+    broadcaster.BroadcastEvent (eEventPing, NULL);
+    ASSERT_FALSE (listener.GetNextEvent (event_sp));
+}
+
+TEST_F (ListenerTest, HijackingListener)
+{
+    Broadcaster broadcaster (NULL, "test-broadcaster");
+    Listener hijacker ("test-hijacker");
+
+    ASSERT_FALSE (broadcaster.EventTypeHasListeners (eEventPing));
+    broadcaster.HijackBroadcaster (&hijacker, eEventPing);
+    ASSERT_TRUE (broadcaster.EventTypeHasListeners (eEventPing));
+
+    broadcaster.BroadcastEvent (eEventPing, NULL);
+    EventSP event_sp;
+    ASSERT_TRUE (hijacker.GetNextEvent (event_sp));
+
+    broadcaster.RestoreBroadcaster ();
+    ASSERT_FALSE (broadcaster.EventTypeHasListeners (eEventPing));
+}
+
+TEST_F (ListenerTest, EventsKeepTheirOrder)
+{
+    Broadcaster broadcaster (NULL, "test-broadcaster");
+    Listener listener ("test-listener");
+    listener.StartListeningForEvents (&broadcaster, eEventPing | eEventOther);
+
+    for (uint32_t i = 0; i < 100; ++i)
+        broadcaster.BroadcastEvent (i % 2 ? eEventOther : eEventPing, NULL);
+
+    // Take the eEventOther events out of the middle of the queue first
+    EventSP event_sp;
+    for (uint32_t i = 0; i < 50; ++i)
+    {
+        ASSERT_TRUE (listener.GetNextEventForBroadcasterWithType (&broadcaster, eEventOther, event_sp));
+        ASSERT_EQ ((uint32_t)eEventOther, event_sp->GetType ());
+    }
+    for (uint32_t i = 0; i < 50; ++i)
+    {
+        ASSERT_TRUE (listener.GetNextEvent (event_sp));
+        ASSERT_EQ ((uint32_t)eEventPing, event_sp->GetType ());
+    }
+    ASSERT_FALSE (listener.GetNextEvent (event_sp));
+}
+
+// Not a pass/fail test: measures how long it takes an event to get from
+// BroadcastEvent() to a thread blocked in WaitForEvent().
+TEST_F (ListenerTest, BroadcastToReceiveLatency)
+{
+    typedef std::chrono::steady_clock clock;
+    const uint32_t kNumEvents = 2000;
+
+    Broadcaster broadcaster (NULL, "test-broadcaster");
+    Listener listener ("test-listener");
+    listener.StartListeningForEvents (&broadcaster, eEventPing);
+
+    std::atomic<uint32_t> num_received (0);
+    std::atomic<clock::rep> receive_time (0);
+    std::thread receiver ([&listener, &num_received, &receive_time, kNumEvents]()
+    {
+        EventSP event_sp;
+        for (uint32_t i = 0; i < kNumEvents; ++i)
+        {
+            if (!listener.WaitForEvent (NULL, event_sp))
+                break;
+            receive_time = clock::now ().time_since_epoch ().count ();
+            ++num_received;
+        }
+    });
+
+    clock::duration total (0);
+    clock::duration worst (0);
+    for (uint32_t i = 0; i < kNumEvents; ++i)
+    {
+        const clock::time_point send_time = clock::now ();
+        broadcaster.BroadcastEvent (eEventPing, NULL);
+        // Wait for the receiver so every event finds it blocked
+        while (num_received.load () <= i)
+            std::this_thread::yield ();
+        const clock::duration latency = clock::duration (receive_time.load ()) - send_time.time_since_epoch ();
+        total += latency;
+        if (latency > worst)
+            worst = latency;
+    }
+    receiver.join ();
+    ASSERT_EQ (kNumEvents, num_received.load ());
+
+    // Broadcasts of event types nobody listens for
+    const clock::time_point unwanted_start = clock::now ();
+    for (uint32_t i = 0; i < kNumEvents; ++i)
+        broadcaster.BroadcastEvent (eEventOther, NULL);
+    const clock::duration unwanted_total = clock::now () - unwanted_start;
+
+    using std::chrono::nanoseconds;
+    printf ("broadcast to receive latency: mean %lld ns, worst %lld ns over %u events\n",
+            (long long)std::chrono::duration_cast<nanoseconds> (total).count () / kNumEvents,
+            (long long)std::chrono::duration_cast<nanoseconds> (worst).count (),
+            kNumEvents);
+    printf ("broadcast with no listeners: mean %lld ns\n",
+            (long long)std::chrono::duration_cast<nanoseconds> (unwanted_total).count () / kNumEvents);
+}
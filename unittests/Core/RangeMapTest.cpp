@@ -0,0 +1,72 @@
+//===-- RangeMapTest.cpp ----------------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "gtest/gtest.h"
+
+#include "lldb/Core/RangeMap.h"
+
+using namespace lldb_private;
+
+namespace
+{
+    typedef RangeDataVector<uint64_t, uint64_t, uint32_t> RangeDataVectorT;
+
+    class RangeMapTest: public ::testing::Test
+    {
+    };
+
+    // A mix of adjacent ranges, gaps and ranges nested in other ranges,
+    // like the ranges of symbols in a symbol table
+    void
+    MakeRanges (RangeDataVectorT &map)
+    {
+        uint32_t data = 0;
+        for (uint64_t base = 0x1000; base < 0x20000; base += 0x100)
+        {
+            map.Append (RangeDataVectorT::Entry (base, 0x80, data++));
+            if (base % 0x1000 == 0)
+                map.Append (RangeDataVectorT::Entry (base, 0x800, data++));
+            else if (base % 0x300 == 0)
+                map.Append (RangeDataVectorT::Entry (base + 0x80, 0x40, data++));
+        }
+        map.Sort ();
+    }
+}
+
+TEST_F (RangeMapTest, SortedLookupsMatchLookups)
+{
+    RangeDataVectorT map;
+    MakeRanges (map);
+
+    // Every step size from a few bytes to past the end in one lookup, so the
+    // cursor both steps and searches
+    for (uint64_t step = 3; step < 0x40000; step = step * 2 + 1)
+    {
+        size_t start_idx = 0;
+        for (uint64_t addr = 0; addr < 0x21000; addr += step)
+            ASSERT_EQ (map.FindEntryIndexThatContains (addr), map.FindEntryIndexThatContainsSorted (addr, start_idx));
+    }
+}
+
+TEST_F (RangeMapTest, SortedLookupsWithRepeatedAddresses)
+{
+    RangeDataVectorT map;
+    MakeRanges (map);
+
+    size_t start_idx = 0;
+    for (uint64_t addr = 0xff0; addr < 0x3000; addr += 0x10)
+    {
+        for (int i = 0; i < 3; ++i)
+            ASSERT_EQ (map.FindEntryIndexThatContains (addr), map.FindEntryIndexThatContainsSorted (addr, start_idx));
+    }
+
+    RangeDataVectorT empty;
+    start_idx = 0;
+    ASSERT_EQ (UINT32_MAX, empty.FindEntryIndexThatContainsSorted (0x1000, start_idx));
+}
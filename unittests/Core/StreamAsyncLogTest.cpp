@@ -0,0 +1,170 @@
+//===-- StreamAsyncLogTest.cpp ----------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "gtest/gtest.h"
+
+#include "lldb/Core/StreamAsyncLog.h"
+#include "lldb/Core/StreamString.h"
+
+#include <stdio.h>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace lldb;
+using namespace lldb_private;
+
+namespace
+{
+    class StreamAsyncLogTest: public ::testing::Test
+    {
+    };
+
+    std::vector<std::string>
+    SplitLines (const std::string &text)
+    {
+        std::vector<std::string> lines;
+        std::istringstream stream (text);
+        std::string line;
+        while (std::getline (stream, line))
+            lines.push_back (line);
+        return lines;
+    }
+}
+
+TEST_F (StreamAsyncLogTest, RecordsFromManyThreads)
+{
+    const int num_threads = 4;
+    const int num_records = 1000;
+    std::shared_ptr<StreamString> output_sp (new StreamString ());
+    std::unique_ptr<StreamAsyncLog> async_ap (new StreamAsyncLog (output_sp));
+    ASSERT_TRUE (async_ap->StartDrainThread ());
+
+    std::vector<std::thread> threads;
+    for (int thread_idx = 0; thread_idx < num_threads; ++thread_idx)
+    {
+        threads.push_back (std::thread ([&async_ap, thread_idx] () {
+            for (int record_idx = 0; record_idx < num_records; ++record_idx)
+                async_ap->Printf ("%d %d\n", thread_idx, record_idx);
+        }));
+    }
+    for (std::thread &thread : threads)
+        thread.join ();
+
+    ASSERT_EQ (0u, async_ap->GetDroppedRecordCount ());
+    // Destroying the stream writes out whatever is left
+    async_ap.reset ();
+
+    // The records of each thread come out in order
+    std::vector<int> next_record (num_threads, 0);
+    const std::vector<std::string> lines = SplitLines (output_sp->GetString ());
+    ASSERT_EQ ((size_t)(num_threads * num_records), lines.size ());
+    for (const std::string &line : lines)
+    {
+        int thread_idx = -1;
+        int record_idx = -1;
+        ASSERT_EQ (2, sscanf (line.c_str (), "%d %d", &thread_idx, &record_idx));
+        ASSERT_TRUE (thread_idx >= 0 && thread_idx < num_threads);
+        ASSERT_EQ (next_record[thread_idx], record_idx);
+        ++next_record[thread_idx];
+    }
+}
+
+TEST_F (StreamAsyncLogTest, FreesBuffersOfExitedThreads)
+{
+    // Thread pools start new threads for every batch of work, so a thread's
+    // buffer has to go away with the thread rather than with the stream
+    const int num_batches = 20;
+    const int num_threads = 8;
+    std::shared_ptr<StreamString> output_sp (new StreamString ());
+    StreamAsyncLog async (output_sp, 1024);
+    for (int batch_idx = 0; batch_idx < num_batches; ++batch_idx)
+    {
+        std::vector<std::thread> threads;
+        for (int thread_idx = 0; thread_idx < num_threads; ++thread_idx)
+        {
+            threads.push_back (std::thread ([&async, batch_idx, thread_idx] () {
+                async.Printf ("%d %d\n", batch_idx, thread_idx);
+            }));
+        }
+        for (std::thread &thread : threads)
+            thread.join ();
+
+        // The buffers of the joined threads are written out and freed
+        async.Drain ();
+        ASSERT_EQ (0u, async.GetBufferCount ());
+    }
+
+    ASSERT_EQ (0u, async.GetDroppedRecordCount ());
+    const std::vector<std::string> lines = SplitLines (output_sp->GetString ());
+    ASSERT_EQ ((size_t)(num_batches * num_threads), lines.size ());
+
+    // A live thread keeps its buffer
+    async.PutCString ("main\n");
+    async.Drain ();
+    ASSERT_EQ (1u, async.GetBufferCount ());
+}
+
+TEST_F (StreamAsyncLogTest, DropsRecordsWhenFull)
+{
+    std::shared_ptr<StreamString> output_sp (new StreamString ());
+    StreamAsyncLog async (output_sp, 1024);
+
+    // Without a drain thread nothing is written out until Drain(), so
+    // only the records that fit in the buffer are kept
+    const std::string record (99, 'x');
+    const int num_records = 100;
+    for (int i = 0; i < num_records; ++i)
+        async.Printf ("%s\n", record.c_str ());
+    const uint64_t num_dropped = async.GetDroppedRecordCount ();
+    ASSERT_GT (num_dropped, 0u);
+    ASSERT_LT (num_dropped, (uint64_t)num_records);
+    ASSERT_TRUE (output_sp->GetString ().empty ());
+
+    async.Drain ();
+    std::vector<std::string> lines = SplitLines (output_sp->GetString ());
+    ASSERT_EQ (num_records - num_dropped + 1, lines.size ());
+    StreamString warning;
+    warning.Printf ("warning: %" PRIu64 " log records were dropped because the log buffers were full", num_dropped);
+    ASSERT_EQ (warning.GetString (), lines.back ());
+
+    // There is room again once the buffer is drained
+    output_sp->Clear ();
+    async.PutCString ("after\n");
+    async.Drain ();
+    ASSERT_EQ (num_dropped, async.GetDroppedRecordCount ());
+    ASSERT_EQ (std::string ("after\n"), output_sp->GetString ());
+}
+
+TEST_F (StreamAsyncLogTest, Timestamps)
+{
+    std::shared_ptr<StreamString> output_sp (new StreamString ());
+    StreamAsyncLog async (output_sp);
+    async.SetPrependTimestamps (true);
+
+    // A line written in pieces gets one timestamp
+    async.PutCString ("first ");
+    async.PutCString ("line\n");
+    async.PutCString ("second line\n");
+    async.Drain ();
+
+    const std::vector<std::string> lines = SplitLines (output_sp->GetString ());
+    ASSERT_EQ (2u, lines.size ());
+    const char *expected_text[] = { "first line", "second line" };
+    for (size_t i = 0; i < lines.size (); ++i)
+    {
+        unsigned seconds = 0;
+        unsigned nanoseconds = 0;
+        int text_offset = 0;
+        ASSERT_EQ (2, sscanf (lines[i].c_str (), "%u.%u %n", &seconds, &nanoseconds, &text_offset));
+        ASSERT_GT (seconds, 0u);
+        ASSERT_EQ (std::string (expected_text[i]), lines[i].substr (text_offset));
+    }
+}
@@ -0,0 +1,103 @@
+//===-- AgentExpressionTest.cpp ---------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+
+#include "gtest/gtest.h"
+
+#include "lldb/Host/common/AgentExpression.h"
+
+namespace
+{
+    class AgentExpressionTest: public ::testing::Test
+    {
+    };
+}
+
+using namespace lldb_private;
+
+static Error
+Evaluate (const std::vector<uint8_t> &bytes, uint64_t &result)
+{
+    // Register n holds n * 10, memory holds its own address truncated to the read size
+    auto read_register = [] (uint32_t reg_num, uint64_t &value) -> Error
+    {
+        value = reg_num * 10;
+        return Error ();
+    };
+    auto read_memory = [] (lldb::addr_t addr, size_t size, uint64_t &value) -> Error
+    {
+        value = size < 8 ? addr & ((1ull << (size * 8)) - 1) : addr;
+        return Error ();
+    };
+    AgentExpression expr (bytes.data (), bytes.size ());
+    return expr.Evaluate (read_register, read_memory, result);
+}
+
+TEST_F (AgentExpressionTest, Constants)
+{
+    uint64_t result = 0;
+    // const8 1; end
+    ASSERT_TRUE (Evaluate ({ 0x22, 0x01, 0x27 }, result).Success ());
+    ASSERT_EQ (1u, result);
+
+    // const32 0x12345678; end
+    ASSERT_TRUE (Evaluate ({ 0x24, 0x12, 0x34, 0x56, 0x78, 0x27 }, result).Success ());
+    ASSERT_EQ (0x12345678u, result);
+}
+
+TEST_F (AgentExpressionTest, Arithmetic)
+{
+    uint64_t result = 0;
+    // reg 2; const8 20; equal; end
+    ASSERT_TRUE (Evaluate ({ 0x26, 0x00, 0x02, 0x22, 0x14, 0x13, 0x27 }, result).Success ());
+    ASSERT_EQ (1u, result);
+
+    // const8 7; const8 2; sub; const8 3; mul; end
+    ASSERT_TRUE (Evaluate ({ 0x22, 0x07, 0x22, 0x02, 0x03, 0x22, 0x03, 0x04, 0x27 }, result).Success ());
+    ASSERT_EQ (15u, result);
+
+    // const8 0xff; ext 8; end
+    ASSERT_TRUE (Evaluate ({ 0x22, 0xff, 0x16, 0x08, 0x27 }, result).Success ());
+    ASSERT_EQ (UINT64_MAX, result);
+}
+
+TEST_F (AgentExpressionTest, Memory)
+{
+    uint64_t result = 0;
+    // const16 0x1234; ref8; end
+    ASSERT_TRUE (Evaluate ({ 0x23, 0x12, 0x34, 0x17, 0x27 }, result).Success ());
+    ASSERT_EQ (0x34u, result);
+}
+
+TEST_F (AgentExpressionTest, Branches)
+{
+    uint64_t result = 0;
+    // 0: const8 0; 2: if_goto 8; 5: const8 5; 7: end; 8: const8 9; 10: end
+    const std::vector<uint8_t> skip = { 0x22, 0x00, 0x20, 0x00, 0x08, 0x22, 0x05, 0x27, 0x22, 0x09, 0x27 };
+    ASSERT_TRUE (Evaluate (skip, result).Success ());
+    ASSERT_EQ (5u, result);
+
+    // An endless loop must not hang the stub
+    ASSERT_TRUE (Evaluate ({ 0x21, 0x00, 0x00 }, result).Fail ());
+}
+
+TEST_F (AgentExpressionTest, Errors)
+{
+    uint64_t result = 0;
+    // Empty expression
+    ASSERT_TRUE (Evaluate ({}, result).Fail ());
+    // add with nothing on the stack
+    ASSERT_TRUE (Evaluate ({ 0x02, 0x27 }, result).Fail ());
+    // Truncated const32
+    ASSERT_TRUE (Evaluate ({ 0x24, 0x00, 0x01 }, result).Fail ());
+    // Division by zero
+    ASSERT_TRUE (Evaluate ({ 0x22, 0x01, 0x22, 0x00, 0x06, 0x27 }, result).Fail ());
+    // Floating point bytecodes aren't supported
+    ASSERT_TRUE (Evaluate ({ 0x01, 0x27 }, result).Fail ());
+}
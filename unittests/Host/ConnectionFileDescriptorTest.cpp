@@ -0,0 +1,164 @@
+//===-- ConnectionFileDescriptorTest.cpp ------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#if !defined(_WIN32)
+
+#include <chrono>
+#include <stdio.h>
+#include <string>
+#include <sys/socket.h>
+#include <thread>
+#include <unistd.h>
+
+#include "gtest/gtest.h"
+
+#include "lldb/Host/ConnectionFileDescriptor.h"
+#include "lldb/Host/Socket.h"
+
+using namespace lldb;
+using namespace lldb_private;
+
+class ConnectionFileDescriptorTest : public testing::Test
+{
+  protected:
+    // Connects the two connections over a local socket pair
+    void
+    CreateConnectedPair(std::unique_ptr<ConnectionFileDescriptor> *a_up, std::unique_ptr<ConnectionFileDescriptor> *b_up)
+    {
+        int fds[2];
+        ASSERT_EQ(0, ::socketpair(AF_UNIX, SOCK_STREAM, 0, fds));
+        a_up->reset(new ConnectionFileDescriptor(new Socket(fds[0], Socket::ProtocolUnixDomain, true)));
+        b_up->reset(new ConnectionFileDescriptor(new Socket(fds[1], Socket::ProtocolUnixDomain, true)));
+    }
+
+    static void
+    WriteAll(ConnectionFileDescriptor &connection, const std::string &data)
+    {
+        size_t offset = 0;
+        while (offset < data.size())
+        {
+            ConnectionStatus status;
+            Error error;
+            offset += connection.Write(data.data() + offset, data.size() - offset, status, &error);
+            ASSERT_EQ(eConnectionStatusSuccess, status);
+        }
+    }
+};
+
+TEST_F(ConnectionFileDescriptorTest, SmallReadsOfALargeWrite)
+{
+    std::unique_ptr<ConnectionFileDescriptor> a_up, b_up;
+    CreateConnectedPair(&a_up, &b_up);
+
+    std::string sent;
+    for (int i = 0; i < 1000; ++i)
+        sent += "$packet" + std::to_string(i) + "#00";
+    WriteAll(*b_up, sent);
+
+    // Hand out what was received in small pieces, like the packet reader does
+    std::string received;
+    while (received.size() < sent.size())
+    {
+        char buffer[7];
+        ConnectionStatus status;
+        Error error;
+        const size_t bytes_read = a_up->Read(buffer, sizeof(buffer), 1000000, status, &error);
+        ASSERT_EQ(eConnectionStatusSuccess, status);
+        ASSERT_LE(bytes_read, sizeof(buffer));
+        received.append(buffer, bytes_read);
+    }
+    ASSERT_EQ(sent, received);
+}
+
+TEST_F(ConnectionFileDescriptorTest, ReadTimesOut)
+{
+    std::unique_ptr<ConnectionFileDescriptor> a_up, b_up;
+    CreateConnectedPair(&a_up, &b_up);
+
+    char buffer[16];
+    ConnectionStatus status;
+    Error error;
+    ASSERT_EQ(0u, a_up->Read(buffer, sizeof(buffer), 10000, status, &error));
+    ASSERT_EQ(eConnectionStatusTimedOut, status);
+
+    // Data that arrives after a timeout is still read
+    WriteAll(*b_up, "late");
+    const size_t bytes_read = a_up->Read(buffer, sizeof(buffer), 1000000, status, &error);
+    ASSERT_EQ(eConnectionStatusSuccess, status);
+    ASSERT_EQ(std::string("late"), std::string(buffer, bytes_read));
+}
+
+TEST_F(ConnectionFileDescriptorTest, EndOfFile)
+{
+    std::unique_ptr<ConnectionFileDescriptor> a_up, b_up;
+    CreateConnectedPair(&a_up, &b_up);
+
+    WriteAll(*b_up, "bye");
+    b_up.reset();
+
+    char buffer[16];
+    ConnectionStatus status;
+    Error error;
+    ASSERT_EQ(3u, a_up->Read(buffer, sizeof(buffer), 1000000, status, &error));
+    ASSERT_EQ(eConnectionStatusSuccess, status);
+    ASSERT_EQ(0u, a_up->Read(buffer, sizeof(buffer), 1000000, status, &error));
+    ASSERT_EQ(eConnectionStatusEndOfFile, status);
+}
+
+TEST_F(ConnectionFileDescriptorTest, PacketRoundTripLatency)
+{
+    std::unique_ptr<ConnectionFileDescriptor> a_up, b_up;
+    CreateConnectedPair(&a_up, &b_up);
+
+    // Bounce a packet sized message back and forth the way a stub answers
+    // the debugger, and report how long a round trip takes
+    const int num_round_trips = 20000;
+    const std::string packet("$qC#b4");
+    std::thread echo_thread([&b_up, &packet, num_round_trips]() {
+        char buffer[64];
+        for (int i = 0; i < num_round_trips; ++i)
+        {
+            size_t total = 0;
+            while (total < packet.size())
+            {
+                ConnectionStatus status;
+                Error error;
+                total += b_up->Read(buffer + total, packet.size() - total, UINT32_MAX, status, &error);
+                if (status != eConnectionStatusSuccess)
+                    return;
+            }
+            ConnectionStatus status;
+            Error error;
+            b_up->Write(buffer, total, status, &error);
+        }
+    });
+
+    const auto start = std::chrono::steady_clock::now();
+    char buffer[64];
+    for (int i = 0; i < num_round_trips; ++i)
+    {
+        WriteAll(*a_up, packet);
+        size_t total = 0;
+        while (total < packet.size())
+        {
+            ConnectionStatus status;
+            Error error;
+            total += a_up->Read(buffer + total, packet.size() - total, 5000000, status, &error);
+            ASSERT_EQ(eConnectionStatusSuccess, status);
+        }
+        ASSERT_EQ(packet, std::string(buffer, total));
+    }
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+    echo_thread.join();
+
+    const double usec = std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count();
+    printf("%d packet round trips over a socket pair: %.2f usec per round trip\n", num_round_trips, usec / num_round_trips);
+}
+
+#endif // !defined(_WIN32)
@@ -0,0 +1,206 @@
+//===-- MemoryCacheTest.cpp -------------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "gtest/gtest.h"
+
+#include "lldb/Core/ArchSpec.h"
+#include "lldb/Core/Debugger.h"
+#include "lldb/Core/Timer.h"
+#include "lldb/Host/HostInfo.h"
+#include "lldb/Target/Memory.h"
+#include "lldb/Target/Process.h"
+#include "lldb/Target/Target.h"
+#include "lldb/Target/TargetList.h"
+
+using namespace lldb;
+using namespace lldb_private;
+
+namespace
+{
+    const addr_t kPageAddr = 0x10000;
+    const addr_t kPageSize = 0x1000;
+
+    uint8_t
+    ByteAtAddress (addr_t addr)
+    {
+        return (uint8_t)(addr ^ (addr >> 8));
+    }
+
+    //----------------------------------------------------------------------
+    // A process with a single mapped page. Like many stubs, it fails a
+    // whole read that runs off the page rather than returning the part it
+    // could read.
+    //----------------------------------------------------------------------
+    class TestProcess : public Process
+    {
+    public:
+        TestProcess (Target &target, Listener &listener) :
+            Process (target, listener),
+            m_num_reads (0)
+        {
+        }
+
+        bool
+        CanDebug (Target &target, bool plugin_specified_by_name) override
+        {
+            return true;
+        }
+
+        Error
+        DoDestroy () override
+        {
+            return Error();
+        }
+
+        void
+        RefreshStateAfterStop () override
+        {
+        }
+
+        bool
+        IsAlive () override
+        {
+            return true;
+        }
+
+        size_t
+        DoReadMemory (addr_t vm_addr, void *buf, size_t size, Error &error) override
+        {
+            ++m_num_reads;
+            if (vm_addr < kPageAddr || vm_addr + size > kPageAddr + kPageSize)
+            {
+                error.SetErrorStringWithFormat ("failed to read 0x%" PRIx64 " bytes at 0x%" PRIx64, (uint64_t)size, vm_addr);
+                return 0;
+            }
+            uint8_t *bytes = (uint8_t *)buf;
+            for (size_t i = 0; i < size; ++i)
+                bytes[i] = ByteAtAddress (vm_addr + i);
+            return size;
+        }
+
+        bool
+        UpdateThreadList (ThreadList &old_thread_list, ThreadList &new_thread_list) override
+        {
+            return false;
+        }
+
+        ConstString
+        GetPluginName () override
+        {
+            static ConstString g_name ("memory-cache-test");
+            return g_name;
+        }
+
+        uint32_t
+        GetPluginVersion () override
+        {
+            return 1;
+        }
+
+        uint32_t m_num_reads;
+    };
+
+    class MemoryCacheTest : public ::testing::Test
+    {
+    public:
+        static void
+        SetUpTestCase ()
+        {
+            HostInfo::Initialize ();
+            Timer::Initialize ();
+        }
+
+    protected:
+        void
+        SetUp ()
+        {
+            m_debugger_sp = Debugger::CreateInstance ();
+            PlatformSP platform_sp;
+            Error error (m_debugger_sp->GetTargetList().CreateTarget (*m_debugger_sp,
+                                                                      NULL,
+                                                                      ArchSpec ("x86_64-pc-linux"),
+                                                                      false,
+                                                                      platform_sp,
+                                                                      m_target_sp));
+            ASSERT_TRUE (error.Success()) << error.AsCString();
+            ASSERT_TRUE (m_target_sp.get() != NULL);
+            m_process_sp.reset (new TestProcess (*m_target_sp, m_debugger_sp->GetListener()));
+        }
+
+        void
+        TearDown ()
+        {
+            if (m_process_sp)
+                m_process_sp->Finalize ();
+            m_process_sp.reset ();
+            m_debugger_sp->GetTargetList().DeleteTarget (m_target_sp);
+            m_target_sp.reset ();
+            Debugger::Destroy (m_debugger_sp);
+        }
+
+        DebuggerSP m_debugger_sp;
+        TargetSP m_target_sp;
+        std::shared_ptr<TestProcess> m_process_sp;
+    };
+}
+
+TEST_F (MemoryCacheTest, ReadAheadRunsOffMapping)
+{
+    MemoryCache cache (*m_process_sp);
+    const uint32_t line_size = cache.GetMemoryCacheLineSize();
+    ASSERT_EQ (0u, kPageSize % line_size);
+
+    // Walking the page grows the read-ahead until it runs off the end of
+    // the page, which must not stop the lines on the page from being read
+    for (addr_t addr = kPageAddr; addr < kPageAddr + kPageSize; addr += line_size)
+    {
+        uint8_t bytes[4];
+        Error error;
+        ASSERT_EQ (sizeof(bytes), cache.Read (addr, bytes, sizeof(bytes), error)) << "at 0x" << std::hex << addr;
+        ASSERT_TRUE (error.Success()) << error.AsCString();
+        for (size_t i = 0; i < sizeof(bytes); ++i)
+            ASSERT_EQ (ByteAtAddress (addr + i), bytes[i]);
+    }
+
+    // Fewer reads than lines means the read-ahead was still used
+    ASSERT_LT (m_process_sp->m_num_reads, kPageSize / line_size);
+}
+
+TEST_F (MemoryCacheTest, LastLineAfterFailedReadAhead)
+{
+    MemoryCache cache (*m_process_sp);
+    const uint32_t line_size = cache.GetMemoryCacheLineSize();
+    const addr_t last_line_addr = kPageAddr + kPageSize - line_size;
+
+    // Two consecutive misses make the second one read ahead past the page
+    uint8_t byte;
+    Error error;
+    ASSERT_EQ (1u, cache.Read (last_line_addr - line_size, &byte, 1, error));
+    const uint32_t num_reads = m_process_sp->m_num_reads;
+    ASSERT_EQ (1u, cache.Read (last_line_addr + 1, &byte, 1, error));
+    ASSERT_TRUE (error.Success()) << error.AsCString();
+    ASSERT_EQ (ByteAtAddress (last_line_addr + 1), byte);
+    ASSERT_EQ (num_reads + 2, m_process_sp->m_num_reads);
+
+    // The line is cached now
+    ASSERT_EQ (1u, cache.Read (last_line_addr + 2, &byte, 1, error));
+    ASSERT_EQ (num_reads + 2, m_process_sp->m_num_reads);
+}
+
+TEST_F (MemoryCacheTest, UnmappedLineFails)
+{
+    MemoryCache cache (*m_process_sp);
+    const uint32_t line_size = cache.GetMemoryCacheLineSize();
+
+    uint8_t byte;
+    Error error;
+    ASSERT_EQ (1u, cache.Read (kPageAddr + kPageSize - line_size, &byte, 1, error));
+    ASSERT_EQ (0u, cache.Read (kPageAddr + kPageSize, &byte, 1, error));
+    ASSERT_TRUE (error.Fail());
+}
@@ -0,0 +1,158 @@
+//===-- HexCodingTest.cpp ---------------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "gtest/gtest.h"
+
+#include "lldb/Utility/HexCoding.h"
+
+#include <algorithm>
+#include <chrono>
+#include <ctype.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string>
+#include <vector>
+
+using namespace lldb_private;
+
+namespace
+{
+    class HexCodingTest: public ::testing::Test
+    {
+    };
+
+    std::vector<uint8_t>
+    MakeBytes (size_t size)
+    {
+        std::vector<uint8_t> bytes (size);
+        for (size_t i = 0; i < size; ++i)
+            bytes[i] = (uint8_t)(i * 131 + 7);
+        return bytes;
+    }
+
+    std::string
+    ReferenceEncode (const uint8_t *src, size_t src_len)
+    {
+        std::string hex;
+        char digits[3];
+        for (size_t i = 0; i < src_len; ++i)
+        {
+            snprintf (digits, sizeof(digits), "%2.2x", src[i]);
+            hex += digits;
+        }
+        return hex;
+    }
+
+    double
+    MegabytesPerSecond (size_t bytes, std::chrono::steady_clock::duration elapsed)
+    {
+        const double seconds = std::chrono::duration_cast<std::chrono::duration<double>> (elapsed).count ();
+        return seconds > 0 ? bytes / seconds / (1024 * 1024) : 0;
+    }
+}
+
+TEST_F (HexCodingTest, EncodeMatchesPrintf)
+{
+    // Every length up to a few vector widths, from unaligned addresses, so
+    // the vector loops and the scalar tails all get used
+    const std::vector<uint8_t> bytes = MakeBytes (300);
+    for (size_t offset = 0; offset < 4; ++offset)
+    {
+        for (size_t len = 0; len + offset <= 200; ++len)
+        {
+            std::string hex (2 * len, '\0');
+            ASSERT_EQ (2 * len, HexEncode (bytes.data () + offset, len, &hex[0]));
+            ASSERT_EQ (ReferenceEncode (bytes.data () + offset, len), hex);
+        }
+    }
+}
+
+TEST_F (HexCodingTest, DecodeRoundTrip)
+{
+    const std::vector<uint8_t> bytes = MakeBytes (300);
+    for (size_t len = 0; len <= 200; ++len)
+    {
+        std::string hex = ReferenceEncode (bytes.data (), len);
+        // Upper case digits are accepted too
+        for (size_t i = 0; i < hex.size (); i += 3)
+            hex[i] = toupper (hex[i]);
+        std::vector<uint8_t> decoded (len + 1, 0xee);
+        ASSERT_EQ (len, HexDecode (hex.data (), hex.size (), decoded.data (), len));
+        ASSERT_TRUE (std::equal (bytes.begin (), bytes.begin () + len, decoded.begin ()));
+        // Nothing is written past dst_len
+        ASSERT_EQ (0xee, decoded[len]);
+    }
+}
+
+TEST_F (HexCodingTest, DecodeStopsAtInvalidDigits)
+{
+    const std::vector<uint8_t> bytes = MakeBytes (160);
+    const std::string hex = ReferenceEncode (bytes.data (), bytes.size ());
+    const char bad_chars[] = { 'g', 'G', '/', ':', '@', '`', ' ', '\0', (char)0x80, (char)0xb0 };
+    for (size_t bad_pos = 0; bad_pos < hex.size (); ++bad_pos)
+    {
+        for (char bad_char : bad_chars)
+        {
+            std::string corrupt = hex;
+            corrupt[bad_pos] = bad_char;
+            std::vector<uint8_t> decoded (bytes.size ());
+            const size_t num_decoded = HexDecode (corrupt.data (), corrupt.size (), decoded.data (), decoded.size ());
+            ASSERT_EQ (bad_pos / 2, num_decoded);
+            ASSERT_TRUE (std::equal (bytes.begin (), bytes.begin () + num_decoded, decoded.begin ()));
+        }
+    }
+
+    // A lone trailing digit isn't decoded, and dst_len limits the output
+    uint8_t decoded[4];
+    ASSERT_EQ (2u, HexDecode ("abcde", 5, decoded, sizeof(decoded)));
+    ASSERT_EQ (1u, HexDecode ("abcdef", 6, decoded, 1));
+}
+
+TEST_F (HexCodingTest, Checksum)
+{
+    const std::vector<uint8_t> bytes = MakeBytes (1000);
+    for (size_t len = 0; len <= bytes.size (); len += 7)
+    {
+        // gdb-remote sums the payload as chars, which gives the same result
+        int expected = 0;
+        for (size_t i = 0; i < len; ++i)
+            expected += (char)bytes[i];
+        ASSERT_EQ ((uint8_t)(expected & 255), Checksum8 (bytes.data (), len));
+    }
+}
+
+TEST_F (HexCodingTest, Throughput)
+{
+    // Roughly a large memory read's worth of data
+    const size_t size = 8 * 1024 * 1024;
+    const int iterations = 8;
+    const std::vector<uint8_t> bytes = MakeBytes (size);
+    std::string hex (2 * size, '\0');
+    std::vector<uint8_t> decoded (size);
+
+    auto start = std::chrono::steady_clock::now ();
+    for (int i = 0; i < iterations; ++i)
+        HexEncode (bytes.data (), size, &hex[0]);
+    const double encode_rate = MegabytesPerSecond (size * iterations, std::chrono::steady_clock::now () - start);
+
+    start = std::chrono::steady_clock::now ();
+    for (int i = 0; i < iterations; ++i)
+        ASSERT_EQ (size, HexDecode (hex.data (), hex.size (), decoded.data (), size));
+    const double decode_rate = MegabytesPerSecond (size * iterations, std::chrono::steady_clock::now () - start);
+    ASSERT_TRUE (bytes == decoded);
+
+    uint32_t checksum = 0;
+    start = std::chrono::steady_clock::now ();
+    for (int i = 0; i < iterations; ++i)
+        checksum += Checksum8 (hex.data (), hex.size ());
+    const double checksum_rate = MegabytesPerSecond (hex.size () * iterations, std::chrono::steady_clock::now () - start);
+
+    printf ("hex encode: %.0f MB/s, hex decode: %.0f MB/s, checksum: %.0f MB/s (%u)\n",
+            encode_rate, decode_rate, checksum_rate, checksum);
+}
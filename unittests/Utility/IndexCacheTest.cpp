@@ -0,0 +1,274 @@
+//===-- IndexCacheTest.cpp --------------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include <stdio.h>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "lldb/Core/ConstString.h"
+#include "llvm/ADT/SmallString.h"
+#include "llvm/Support/FileSystem.h"
+
+#include "Utility/IndexCache.h"
+
+using namespace lldb_private;
+
+namespace
+{
+    class IndexCacheTest: public ::testing::Test
+    {
+    protected:
+        void
+        SetUp ()
+        {
+            llvm::SmallString<128> temp_dir;
+            ASSERT_FALSE (llvm::sys::fs::createUniqueDirectory ("IndexCacheTest", temp_dir));
+            m_temp_dir = temp_dir.c_str ();
+            m_cache_dir.SetFile ((m_temp_dir + "/cache").c_str (), false);
+            m_indexed_file.SetFile ((m_temp_dir + "/a.out").c_str (), false);
+            WriteFile (m_indexed_file.GetPath (), "indexed file");
+
+            const uint8_t uuid_bytes[16] = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15 };
+            m_uuid.SetBytes (uuid_bytes, sizeof(uuid_bytes));
+        }
+
+        void
+        TearDown ()
+        {
+            IndexCache index_cache (m_cache_dir, m_uuid, m_indexed_file, "test", 0);
+            llvm::sys::fs::remove (index_cache.GetCacheFile ().GetPath ());
+            llvm::sys::fs::remove (index_cache.GetCacheFile ().GetDirectory ().GetCString ());
+            llvm::sys::fs::remove (m_cache_dir.GetPath ());
+            llvm::sys::fs::remove (m_indexed_file.GetPath ());
+            llvm::sys::fs::remove (m_temp_dir);
+        }
+
+        static void
+        WriteFile (const std::string &path, const std::string &contents)
+        {
+            FILE *file = ::fopen (path.c_str (), "wb");
+            ASSERT_TRUE (file != NULL);
+            ASSERT_EQ (contents.size (), ::fwrite (contents.data (), 1, contents.size (), file));
+            ::fclose (file);
+        }
+
+        static std::string
+        ReadFile (const std::string &path)
+        {
+            std::string contents;
+            FILE *file = ::fopen (path.c_str (), "rb");
+            if (file)
+            {
+                char buffer[4096];
+                size_t n;
+                while ((n = ::fread (buffer, 1, sizeof(buffer), file)) > 0)
+                    contents.append (buffer, n);
+                ::fclose (file);
+            }
+            return contents;
+        }
+
+        // Two maps: "main" -> 1, "foo" -> 2 and 3; "foo" -> 4
+        static void
+        FillMaps (IndexCache::NameToIndexMap &map1, IndexCache::NameToIndexMap &map2)
+        {
+            map1.Append (ConstString ("main").GetCString (), 1);
+            map1.Append (ConstString ("foo").GetCString (), 2);
+            map1.Append (ConstString ("foo").GetCString (), 3);
+            map1.Sort ();
+            map2.Append (ConstString ("foo").GetCString (), 4);
+            map2.Sort ();
+        }
+
+        bool
+        Save (uint64_t signature)
+        {
+            IndexCache::NameToIndexMap map1, map2;
+            FillMaps (map1, map2);
+            std::vector<const IndexCache::NameToIndexMap *> maps;
+            maps.push_back (&map1);
+            maps.push_back (&map2);
+            IndexCache index_cache (m_cache_dir, m_uuid, m_indexed_file, "test", signature);
+            return index_cache.Save (maps);
+        }
+
+        // Loads into maps that already hold one entry, which a failed load
+        // must leave alone
+        bool
+        Load (uint64_t signature, IndexCache::NameToIndexMap &map1, IndexCache::NameToIndexMap &map2)
+        {
+            map1.Append (ConstString ("untouched").GetCString (), 100);
+            map2.Append (ConstString ("untouched").GetCString (), 200);
+            std::vector<IndexCache::NameToIndexMap *> maps;
+            maps.push_back (&map1);
+            maps.push_back (&map2);
+            IndexCache index_cache (m_cache_dir, m_uuid, m_indexed_file, "test", signature);
+            const bool loaded = index_cache.Load (maps);
+            map1.Sort ();
+            map2.Sort ();
+            return loaded;
+        }
+
+        static void
+        AssertUntouched (const IndexCache::NameToIndexMap &map1, const IndexCache::NameToIndexMap &map2)
+        {
+            ASSERT_EQ (1u, map1.GetSize ());
+            ASSERT_EQ (100u, map1.GetValueAtIndexUnchecked (0));
+            ASSERT_EQ (1u, map2.GetSize ());
+            ASSERT_EQ (200u, map2.GetValueAtIndexUnchecked (0));
+        }
+
+        std::string m_temp_dir;
+        FileSpec m_cache_dir;
+        FileSpec m_indexed_file;
+        UUID m_uuid;
+    };
+}
+
+TEST_F (IndexCacheTest, Disabled)
+{
+    // No cache directory or no UUID turns the cache off
+    IndexCache no_dir (FileSpec (), m_uuid, m_indexed_file, "test", 0);
+    ASSERT_FALSE (no_dir.IsValid ());
+    IndexCache no_uuid (m_cache_dir, UUID (), m_indexed_file, "test", 0);
+    ASSERT_FALSE (no_uuid.IsValid ());
+
+    IndexCache::NameToIndexMap map;
+    std::vector<IndexCache::NameToIndexMap *> maps (1, &map);
+    ASSERT_FALSE (no_dir.Load (maps));
+    ASSERT_FALSE (no_dir.Save (std::vector<const IndexCache::NameToIndexMap *> (1, &map)));
+}
+
+TEST_F (IndexCacheTest, SaveAndLoad)
+{
+    ASSERT_TRUE (Save (42));
+
+    IndexCache::NameToIndexMap map1, map2;
+    ASSERT_TRUE (Load (42, map1, map2));
+
+    std::vector<uint32_t> values;
+    ASSERT_EQ (3u, map1.GetSize ());
+    map1.GetValues (ConstString ("main").GetCString (), values);
+    ASSERT_EQ (std::vector<uint32_t> (1, 1), values);
+    values.clear ();
+    map1.GetValues (ConstString ("foo").GetCString (), values);
+    ASSERT_EQ (2u, values.size ());
+    ASSERT_EQ (2u, values[0]);
+    ASSERT_EQ (3u, values[1]);
+    ASSERT_EQ (UINT32_MAX, map1.Find (ConstString ("untouched").GetCString (), UINT32_MAX));
+
+    ASSERT_EQ (1u, map2.GetSize ());
+    ASSERT_EQ (4u, map2.Find (ConstString ("foo").GetCString (), UINT32_MAX));
+}
+
+TEST_F (IndexCacheTest, SignatureMismatch)
+{
+    ASSERT_TRUE (Save (42));
+
+    IndexCache::NameToIndexMap map1, map2;
+    ASSERT_FALSE (Load (43, map1, map2));
+    AssertUntouched (map1, map2);
+}
+
+TEST_F (IndexCacheTest, MapCountMismatch)
+{
+    ASSERT_TRUE (Save (42));
+
+    IndexCache::NameToIndexMap map;
+    std::vector<IndexCache::NameToIndexMap *> maps (1, &map);
+    IndexCache index_cache (m_cache_dir, m_uuid, m_indexed_file, "test", 42);
+    ASSERT_FALSE (index_cache.Load (maps));
+    ASSERT_EQ (0u, map.GetSize ());
+}
+
+TEST_F (IndexCacheTest, IndexedFileChanged)
+{
+    ASSERT_TRUE (Save (42));
+
+    // A rebuilt file invalidates the entry even when the signature, like
+    // a symbol count, happens to stay the same
+    WriteFile (m_indexed_file.GetPath (), "indexed file, rebuilt");
+    IndexCache::NameToIndexMap map1, map2;
+    ASSERT_FALSE (Load (42, map1, map2));
+    AssertUntouched (map1, map2);
+
+    // Saving replaces the stale entry
+    ASSERT_TRUE (Save (42));
+    IndexCache::NameToIndexMap new_map1, new_map2;
+    ASSERT_TRUE (Load (42, new_map1, new_map2));
+}
+
+TEST_F (IndexCacheTest, UUIDChanged)
+{
+    ASSERT_TRUE (Save (42));
+
+    const uint8_t other_uuid_bytes[16] = { 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0 };
+    UUID other_uuid (other_uuid_bytes, sizeof(other_uuid_bytes));
+    IndexCache index_cache (m_cache_dir, other_uuid, m_indexed_file, "test", 42);
+    IndexCache original (m_cache_dir, m_uuid, m_indexed_file, "test", 42);
+    ASSERT_NE (original.GetCacheFile ().GetPath (), index_cache.GetCacheFile ().GetPath ());
+
+    IndexCache::NameToIndexMap map1, map2;
+    std::vector<IndexCache::NameToIndexMap *> maps;
+    maps.push_back (&map1);
+    maps.push_back (&map2);
+    ASSERT_FALSE (index_cache.Load (maps));
+
+    // An entry copied to the wrong UUID's directory isn't used either
+    ASSERT_FALSE (llvm::sys::fs::create_directories (index_cache.GetCacheFile ().GetDirectory ().GetCString ()));
+    WriteFile (index_cache.GetCacheFile ().GetPath (), ReadFile (original.GetCacheFile ().GetPath ()));
+    ASSERT_FALSE (index_cache.Load (maps));
+    llvm::sys::fs::remove (index_cache.GetCacheFile ().GetPath ());
+    llvm::sys::fs::remove (index_cache.GetCacheFile ().GetDirectory ().GetCString ());
+}
+
+TEST_F (IndexCacheTest, CorruptEntry)
+{
+    ASSERT_TRUE (Save (42));
+    IndexCache index_cache (m_cache_dir, m_uuid, m_indexed_file, "test", 42);
+    const std::string cache_path = index_cache.GetCacheFile ().GetPath ();
+    const std::string contents = ReadFile (cache_path);
+    ASSERT_FALSE (contents.empty ());
+
+    // Every truncation of a valid entry is rejected
+    for (size_t size = 0; size < contents.size (); ++size)
+    {
+        WriteFile (cache_path, contents.substr (0, size));
+        IndexCache::NameToIndexMap map1, map2;
+        ASSERT_FALSE (Load (42, map1, map2)) << "truncated to " << size << " bytes";
+        AssertUntouched (map1, map2);
+    }
+
+    // So are trailing bytes
+    WriteFile (cache_path, contents + std::string (8, '\0'));
+    {
+        IndexCache::NameToIndexMap map1, map2;
+        ASSERT_FALSE (Load (42, map1, map2));
+        AssertUntouched (map1, map2);
+    }
+
+    // And string table offsets past the end of the string table, which
+    // are in the last entry of the last map
+    std::string bad_offset = contents;
+    bad_offset[bad_offset.size () - 8] = '\xff';
+    bad_offset[bad_offset.size () - 7] = '\xff';
+    WriteFile (cache_path, bad_offset);
+    {
+        IndexCache::NameToIndexMap map1, map2;
+        ASSERT_FALSE (Load (42, map1, map2));
+        AssertUntouched (map1, map2);
+    }
+
+    // The untouched entry still loads
+    WriteFile (cache_path, contents);
+    IndexCache::NameToIndexMap map1, map2;
+    ASSERT_TRUE (Load (42, map1, map2));
+}
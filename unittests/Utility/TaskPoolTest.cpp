@@ -0,0 +1,67 @@
+#include "gtest/gtest.h"
+
+#include "lldb/Utility/TaskPool.h"
+
+#include <atomic>
+#include <vector>
+
+using namespace lldb_private;
+
+namespace
+{
+    class TaskPoolTest: public ::testing::Test
+    {
+    };
+}
+
+TEST_F (TaskPoolTest, MapOverIntVisitsEachIndexOnce)
+{
+    const uint32_t kCount = 1000;
+    std::vector<std::atomic<uint32_t>> visits (kCount);
+    for (auto &visit : visits)
+        visit = 0;
+
+    TaskPool::MapOverInt (0, kCount, 4, [&visits](uint32_t idx, uint32_t worker_idx)
+    {
+        ++visits[idx];
+    });
+
+    for (uint32_t i = 0; i < kCount; ++i)
+        ASSERT_EQ (1u, visits[i].load());
+}
+
+TEST_F (TaskPoolTest, MapOverIntWorkerIndexes)
+{
+    const uint32_t kNumThreads = 3;
+    std::vector<uint32_t> per_worker_sum (kNumThreads, 0);
+
+    TaskPool::MapOverInt (10, 110, kNumThreads, [&per_worker_sum, kNumThreads](uint32_t idx, uint32_t worker_idx)
+    {
+        ASSERT_LT (worker_idx, kNumThreads);
+        per_worker_sum[worker_idx] += idx;
+    });
+
+    uint32_t total = 0;
+    for (uint32_t sum : per_worker_sum)
+        total += sum;
+    ASSERT_EQ (5950u, total);
+}
+
+TEST_F (TaskPoolTest, GetNumWorkers)
+{
+    ASSERT_EQ (1u, TaskPool::GetNumWorkers (0, 8));
+    ASSERT_EQ (2u, TaskPool::GetNumWorkers (2, 8));
+    ASSERT_EQ (8u, TaskPool::GetNumWorkers (100, 8));
+    ASSERT_EQ (1u, TaskPool::GetNumWorkers (100, 1));
+    ASSERT_LE (1u, TaskPool::GetNumWorkers (100, 0));
+}
+
+TEST_F (TaskPoolTest, EmptyRange)
+{
+    bool called = false;
+    TaskPool::MapOverInt (5, 5, 4, [&called](uint32_t idx, uint32_t worker_idx)
+    {
+        called = true;
+    });
+    ASSERT_FALSE (called);
+}